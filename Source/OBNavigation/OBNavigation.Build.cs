@@ -1,5 +1,6 @@
 ﻿// Copyright Epic Games, Inc. All Rights Reserved.
 
+using System.IO;
 using UnrealBuildTool;
 
 public class OBNavigation : ModuleRules
@@ -36,6 +37,9 @@ public class OBNavigation : ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
+				"DeveloperSettings",
+				"NavigationSystem",
+				"Projects",
 				"Slate",
 				"SlateCore",
 				"UMG"
@@ -50,5 +54,16 @@ public class OBNavigation : ModuleRules
 				// ... add any modules that your module loads dynamically here ...
 			}
 			);
+
+		// The navigation manifests and POI databases written by the OBNavigationManifest commandlet are not assets,
+		// so the cook does not pick them up. Stage them with the build; run the commandlet before packaging.
+		if (Target.ProjectFile != null)
+		{
+			string ManifestDirectory = Path.Combine(Target.ProjectFile.Directory.FullName, "Content", "OBNavigation", "Manifests");
+			if (Directory.Exists(ManifestDirectory))
+			{
+				RuntimeDependencies.Add("$(ProjectDir)/Content/OBNavigation/Manifests/...", StagedFileType.UFS);
+			}
+		}
 	}
 }
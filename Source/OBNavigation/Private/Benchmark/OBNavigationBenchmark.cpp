@@ -0,0 +1,657 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Benchmark/OBNavigationBenchmark.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "OBMapLayerAsset.h"
+#include "OBMinimapWidget.h"
+#include "OBNavigation.h"
+#include "OBNavigationSubsystem.h"
+#include "Core/OBMinimapProjection.h"
+#include "Data/OBMinimapConfigAsset.h"
+#include "Trace/OBMarkerTrace.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+	const FName BenchmarkLayerName(TEXT("Benchmark"));
+
+	const FName BenchmarkLLMTagName(TEXT("OBNavigation"));
+
+	// Allocator calls of the whole process so far. The allocator only counts them in builds with stats.
+	uint64 GetNumAllocatorCalls()
+	{
+#if STATS
+		return FMalloc::TotalMallocCalls + FMalloc::TotalReallocCalls;
+#else
+		return 0;
+#endif
+	}
+
+	// Live bytes tracked under the OBNavigation LLM tag, or 0 if LLM is not enabled (-llm)
+	int64 GetTrackedBytes()
+	{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+		if (FLowLevelMemTracker::IsEnabled())
+		{
+			// Moves the per-thread counters into the tag totals
+			FLowLevelMemTracker::Get().UpdateStatsPerFrame();
+			return FLowLevelMemTracker::Get().GetTagAmountForTracker(ELLMTracker::Default, BenchmarkLLMTagName,
+			                                                         ELLMTagSet::None);
+		}
+#endif
+		return 0;
+	}
+
+	const TCHAR* LexMix(const EOBBenchmarkMix Mix)
+	{
+		switch (Mix)
+		{
+		case EOBBenchmarkMix::Static: return TEXT("Static");
+		case EOBBenchmarkMix::Moving: return TEXT("Moving");
+		case EOBBenchmarkMix::Churn: return TEXT("Churn");
+		case EOBBenchmarkMix::Trace: return TEXT("Trace");
+		case EOBBenchmarkMix::Projection: return TEXT("Projection");
+		default: return TEXT("Unknown");
+		}
+	}
+
+	template <typename ActorType>
+	ActorType* SpawnBenchmarkActor(UWorld* World, const FVector& Location)
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		SpawnParameters.ObjectFlags |= RF_Transient;
+
+		ActorType* Actor = World->SpawnActor<ActorType>(ActorType::StaticClass(), FTransform(Location), SpawnParameters);
+		if (Actor && !Actor->GetRootComponent())
+		{
+			// Plain actors have no root, so give them one to be movable
+			USceneComponent* Root = NewObject<USceneComponent>(Actor, TEXT("Root"));
+			Root->SetMobility(EComponentMobility::Movable);
+			Actor->SetRootComponent(Root);
+			Root->RegisterComponent();
+			Actor->SetActorLocation(Location);
+		}
+		return Actor;
+	}
+}
+
+FOBBenchmarkOptions FOBBenchmarkOptions::Parse(const FString& CommandLine)
+{
+	FOBBenchmarkOptions Result;
+	const TCHAR* Cmd = *CommandLine;
+
+	if (FString CountsString; FParse::Value(Cmd, TEXT("Counts="), CountsString, false))
+	{
+		TArray<FString> Parts;
+		CountsString.ParseIntoArray(Parts, TEXT(","));
+		Result.MarkerCounts.Reset();
+		for (const FString& Part : Parts)
+		{
+			if (const int32 Count = FCString::Atoi(*Part); Count > 0)
+			{
+				Result.MarkerCounts.Add(Count);
+			}
+		}
+	}
+
+	if (FString MixesString; FParse::Value(Cmd, TEXT("Mixes="), MixesString, false))
+	{
+		TArray<FString> Parts;
+		MixesString.ParseIntoArray(Parts, TEXT(","));
+		Result.Mixes.Reset();
+		for (const FString& Part : Parts)
+		{
+			for (const EOBBenchmarkMix Mix : {
+				     EOBBenchmarkMix::Static, EOBBenchmarkMix::Moving, EOBBenchmarkMix::Churn,
+				     EOBBenchmarkMix::Projection
+			     })
+			{
+				if (Part.Equals(LexMix(Mix), ESearchCase::IgnoreCase))
+				{
+					Result.Mixes.AddUnique(Mix);
+				}
+			}
+		}
+	}
+
+	if (FParse::Value(Cmd, TEXT("Trace="), Result.TracePath, false) && !FCString::Stristr(Cmd, TEXT("Mixes=")))
+	{
+		Result.Mixes.Reset();
+	}
+
+	FParse::Value(Cmd, TEXT("Frames="), Result.NumFrames);
+	FParse::Value(Cmd, TEXT("ChurnFraction="), Result.ChurnFraction);
+	FParse::Value(Cmd, TEXT("Tolerance="), Result.Tolerance);
+	FParse::Value(Cmd, TEXT("NoiseFloorMs="), Result.NoiseFloorMs);
+	FParse::Value(Cmd, TEXT("Csv="), Result.CsvPath, false);
+	FParse::Value(Cmd, TEXT("Baseline="), Result.BaselinePath, false);
+	FParse::Value(Cmd, TEXT("Widget="), Result.MinimapWidgetClass, false);
+	FParse::Value(Cmd, TEXT("MinimapConfig="), Result.MinimapConfig, false);
+	FParse::Value(Cmd, TEXT("MarkerConfig="), Result.MarkerConfig, false);
+	Result.bWriteBaseline = FParse::Param(Cmd, TEXT("WriteBaseline"));
+	Result.bCountAllocations = STATS && !FParse::Param(Cmd, TEXT("NoAllocs"));
+
+	Result.NumFrames = FMath::Max(Result.NumFrames, 1);
+	Result.ChurnFraction = FMath::Clamp(Result.ChurnFraction, 0.0f, 1.0f);
+	return Result;
+}
+
+template <typename FuncType>
+void FOBNavigationBenchmark::FPhaseTimer::Measure(FuncType&& Func)
+{
+	const uint64 AllocsBefore = GetNumAllocatorCalls();
+	const double StartTime = FPlatformTime::Seconds();
+	Func();
+	TotalSeconds += FPlatformTime::Seconds() - StartTime;
+	TotalAllocs += GetNumAllocatorCalls() - AllocsBefore;
+	++NumCalls;
+}
+
+FOBNavigationBenchmark::FOBNavigationBenchmark(UWorld* InWorld, const FOBBenchmarkOptions& InOptions)
+	: World(InWorld)
+	, Options(InOptions)
+	, SpawnBounds(ForceInit)
+	, RandomStream(0x0B1A7)
+{
+}
+
+bool FOBNavigationBenchmark::Run()
+{
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	NavSubsystem = GameInstance ? GameInstance->GetSubsystem<UOBNavigationSubsystem>() : nullptr;
+	if (!NavSubsystem)
+	{
+		UE_LOG(LogOBNavigation, Error, TEXT("[%hs] - OBNavigationSubsystem is not available. Run the benchmark in a game world."),
+		       __FUNCTION__);
+		return false;
+	}
+
+	// Markers are placed inside the first map layer so that the minimap has something to project
+	SpawnBounds = NavSubsystem->AllMapLayers.Num() > 0 && NavSubsystem->AllMapLayers[0]
+		              ? NavSubsystem->GetLayerBounds(NavSubsystem->AllMapLayers[0])
+		              : FBox(FVector(-50000.0, -50000.0, 0.0), FVector(50000.0, 50000.0, 0.0));
+
+	MarkerConfig = Cast<UOBMarkerConfigAsset>(FSoftObjectPath(Options.MarkerConfig).TryLoad());
+	if (!MarkerConfig)
+	{
+		// Fall back to a default config so that the benchmark can also run without the plugin content
+		MarkerConfig = NewObject<UOBMarkerConfigAsset>(GetTransientPackage());
+	}
+	MarkerConfig->AddToRoot();
+
+	APawn* PreviousTrackedPawn = NavSubsystem->GetTrackedPlayerPawn();
+	ViewerPawn = SpawnBenchmarkActor<APawn>(World, SpawnBounds.GetCenter());
+	NavSubsystem->SetTrackedPlayerPawn(ViewerPawn);
+
+	const TSubclassOf<UOBMinimapWidget> WidgetClass = FSoftClassPath(Options.MinimapWidgetClass).TryLoadClass<UOBMinimapWidget>();
+	UOBMinimapConfigAsset* MinimapConfig = Cast<UOBMinimapConfigAsset>(FSoftObjectPath(Options.MinimapConfig).TryLoad());
+	if (WidgetClass && MinimapConfig)
+	{
+		MinimapWidget = CreateWidget<UOBMinimapWidget>(World->GetGameInstance(), WidgetClass);
+		if (MinimapWidget)
+		{
+			MinimapWidget->AddToRoot();
+			MinimapWidget->InitializeAndStartTracking(MinimapConfig);
+		}
+	}
+	if (!MinimapWidget)
+	{
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%hs] - Minimap widget '%s' could not be created. The NativeTick phase is skipped."),
+		       __FUNCTION__, *Options.MinimapWidgetClass);
+	}
+
+	for (const EOBBenchmarkMix Mix : Options.Mixes)
+	{
+		for (const int32 NumMarkers : Options.MarkerCounts)
+		{
+			UE_LOG(LogOBNavigation, Display, TEXT("[%hs] - Running %s x %d..."), __FUNCTION__, LexMix(Mix), NumMarkers);
+			if (Mix == EOBBenchmarkMix::Projection)
+			{
+				RunProjectionScenario(NumMarkers);
+				continue;
+			}
+			RunScenario(Mix, NumMarkers);
+			Cleanup();
+		}
+	}
+
+	if (!Options.TracePath.IsEmpty())
+	{
+		UE_LOG(LogOBNavigation, Display, TEXT("[%hs] - Replaying trace '%s'..."), __FUNCTION__, *Options.TracePath);
+		RunTraceScenario();
+		Cleanup();
+	}
+
+	if (MinimapWidget)
+	{
+		MinimapWidget->RemoveFromRoot();
+		MinimapWidget = nullptr;
+	}
+	if (ViewerPawn)
+	{
+		ViewerPawn->Destroy();
+		ViewerPawn = nullptr;
+	}
+	MarkerConfig->RemoveFromRoot();
+	NavSubsystem->SetTrackedPlayerPawn(PreviousTrackedPawn);
+
+	const FString CsvPath = !Options.CsvPath.IsEmpty()
+		                        ? Options.CsvPath
+		                        : FPaths::ProfilingDir() / TEXT("OBNavigation") /
+		                        FString::Printf(TEXT("Benchmark-%s.csv"), *FDateTime::Now().ToString());
+	WriteCsv(CsvPath);
+
+	bool bPassed = true;
+	if (!Options.BaselinePath.IsEmpty())
+	{
+		if (Options.bWriteBaseline)
+		{
+			WriteBaseline(Options.BaselinePath);
+		}
+		else
+		{
+			bPassed = CompareWithBaseline(Options.BaselinePath);
+		}
+	}
+	return bPassed;
+}
+
+void FOBNavigationBenchmark::RunScenario(const EOBBenchmarkMix Mix, const int32 NumMarkers)
+{
+	constexpr float DeltaTime = 1.0f / 60.0f;
+
+	if (Mix == EOBBenchmarkMix::Moving)
+	{
+		SpawnedActors.Reserve(NumMarkers);
+		for (int32 Index = 0; Index < NumMarkers; ++Index)
+		{
+			SpawnedActors.Add(SpawnBenchmarkActor<AActor>(World, RandomLocation()));
+		}
+	}
+
+	// --- Register ---
+	RegisteredMarkers.Reserve(NumMarkers);
+	const int64 TrackedBytesBefore = GetTrackedBytes();
+	FPhaseTimer RegisterTimer;
+	RegisterTimer.Measure([&]
+	{
+		for (int32 Index = 0; Index < NumMarkers; ++Index)
+		{
+			AActor* TrackedActor = SpawnedActors.IsValidIndex(Index) ? SpawnedActors[Index] : nullptr;
+			RegisteredMarkers.Add(NavSubsystem->RegisterMapMarker(TrackedActor, MarkerConfig, BenchmarkLayerName,
+			                                                      RandomLocation()));
+		}
+	});
+	const double BytesPerMarker = static_cast<double>(GetTrackedBytes() - TrackedBytesBefore) / NumMarkers;
+	AddResult(Mix, NumMarkers, TEXT("RegisterMapMarker"), RegisterTimer, NumMarkers, BytesPerMarker);
+
+	// --- Frames ---
+	const int32 NumChurnPerFrame = Mix == EOBBenchmarkMix::Churn
+		                               ? FMath::Max(1, FMath::RoundToInt32(NumMarkers * Options.ChurnFraction))
+		                               : 0;
+	int32 ChurnCursor = 0;
+
+	FPhaseTimer ChurnTimer;
+	FPhaseTimer TickTimer;
+	FPhaseTimer UpdateTimer;
+	FPhaseTimer WidgetTimer;
+	for (int32 Frame = 0; Frame < Options.NumFrames; ++Frame)
+	{
+		if (Mix == EOBBenchmarkMix::Moving)
+		{
+			// Moving the actors is part of the game's cost, not ours, so it is not measured
+			for (AActor* Actor : SpawnedActors)
+			{
+				Actor->SetActorLocation(Actor->GetActorLocation() + FVector(RandomStream.FRandRange(-50.0, 50.0),
+				                                                            RandomStream.FRandRange(-50.0, 50.0), 0.0));
+			}
+		}
+
+		if (NumChurnPerFrame > 0)
+		{
+			ChurnTimer.Measure([&]
+			{
+				for (int32 Index = 0; Index < NumChurnPerFrame; ++Index)
+				{
+					FGuid& Slot = RegisteredMarkers[ChurnCursor];
+					NavSubsystem->UnregisterMapMarker(Slot);
+					Slot = NavSubsystem->RegisterMapMarker(nullptr, MarkerConfig, BenchmarkLayerName, RandomLocation());
+					ChurnCursor = (ChurnCursor + 1) % RegisteredMarkers.Num();
+				}
+			});
+		}
+
+		TickTimer.Measure([&] { NavSubsystem->Tick(DeltaTime); });
+		UpdateTimer.Measure([&] { NavSubsystem->UpdateAllMarkers(DeltaTime); });
+
+		if (MinimapWidget)
+		{
+			WidgetTimer.Measure([&] { MinimapWidget->NativeTick(MinimapWidget->GetCachedGeometry(), DeltaTime); });
+		}
+	}
+
+	if (NumChurnPerFrame > 0)
+	{
+		AddResult(Mix, NumMarkers, TEXT("Churn"), ChurnTimer, NumChurnPerFrame * 2);
+	}
+	AddResult(Mix, NumMarkers, TEXT("SubsystemTick"), TickTimer, NumMarkers);
+	AddResult(Mix, NumMarkers, TEXT("UpdateAllMarkers"), UpdateTimer, NumMarkers);
+	if (MinimapWidget)
+	{
+		AddResult(Mix, NumMarkers, TEXT("MinimapNativeTick"), WidgetTimer, NumMarkers);
+	}
+
+	// --- Unregister ---
+	FPhaseTimer UnregisterTimer;
+	UnregisterTimer.Measure([&]
+	{
+		for (const FGuid& MarkerID : RegisteredMarkers)
+		{
+			NavSubsystem->UnregisterMapMarker(MarkerID);
+		}
+	});
+	AddResult(Mix, NumMarkers, TEXT("UnregisterMapMarker"), UnregisterTimer, NumMarkers);
+}
+
+void FOBNavigationBenchmark::RunTraceScenario()
+{
+	FOBMarkerTraceReplayer Replayer(NavSubsystem);
+	if (!Replayer.Open(Options.TracePath))
+	{
+		UE_LOG(LogOBNavigation, Error, TEXT("[%hs] - '%s' is not a readable marker trace."), __FUNCTION__,
+		       *Options.TracePath);
+		return;
+	}
+
+	// Applying a frame is the replay harness, not the cost under test, so only the ticks are measured.
+	// The recorded view replaces the viewer pawn until the replayer is stopped.
+	FPhaseTimer TickTimer;
+	FPhaseTimer WidgetTimer;
+	int64 TotalMarkers = 0;
+	int32 PeakMarkers = 0;
+	float DeltaTime = 0.0f;
+	while (Replayer.ApplyNextFrame(DeltaTime))
+	{
+		TotalMarkers += Replayer.GetNumActiveMarkers();
+		PeakMarkers = FMath::Max(PeakMarkers, Replayer.GetNumActiveMarkers());
+
+		TickTimer.Measure([&] { NavSubsystem->Tick(DeltaTime); });
+		if (MinimapWidget)
+		{
+			WidgetTimer.Measure([&] { MinimapWidget->NativeTick(MinimapWidget->GetCachedGeometry(), DeltaTime); });
+		}
+	}
+
+	const int32 AverageMarkers = TickTimer.NumCalls > 0 ? static_cast<int32>(TotalMarkers / TickTimer.NumCalls) : 0;
+	AddResult(EOBBenchmarkMix::Trace, PeakMarkers, TEXT("SubsystemTick"), TickTimer, AverageMarkers);
+	if (MinimapWidget)
+	{
+		AddResult(EOBBenchmarkMix::Trace, PeakMarkers, TEXT("MinimapNativeTick"), WidgetTimer, AverageMarkers);
+	}
+
+	UE_LOG(LogOBNavigation, Display, TEXT("[%hs] - Replayed %d frames, %d layer mismatches."), __FUNCTION__,
+	       Replayer.GetNumFramesApplied(), Replayer.GetNumLayerMismatches());
+	Replayer.Stop();
+}
+
+void FOBNavigationBenchmark::RunProjectionScenario(const int32 NumMarkers)
+{
+	using namespace OBNavigation::Projection;
+
+	// Markers spread over the whole map, so that a zoomed-in minimap clamps most of them like in a real game
+	TArray<FMarkerInput> Inputs;
+	Inputs.SetNumUninitialized(NumMarkers);
+	for (FMarkerInput& Input : Inputs)
+	{
+		Input.MapUV = FVector2D(RandomStream.FRand(), RandomStream.FRand());
+		Input.WorldYaw = RandomStream.FRandRange(-180.0f, 180.0f);
+	}
+	TArray<FMarkerOutput> Outputs;
+	Outputs.SetNumUninitialized(NumMarkers);
+
+	FFrameParams Params;
+	Params.ViewUV = FVector2D(0.5, 0.5);
+	Params.CanvasSize = FVector2D(256.0, 256.0);
+	Params.Zoom = 4.0;
+	Params.StaticRotation = 90.0;
+
+	struct FVariant
+	{
+		EMapRotation Rotation;
+		EClampShape Shape;
+		const TCHAR* Phase;
+	};
+	static constexpr FVariant Variants[] = {
+		{EMapRotation::Fixed, EClampShape::Circle, TEXT("Project_Fixed_Circle")},
+		{EMapRotation::Fixed, EClampShape::Square, TEXT("Project_Fixed_Square")},
+		{EMapRotation::FollowView, EClampShape::Circle, TEXT("Project_FollowView_Circle")},
+		{EMapRotation::FollowView, EClampShape::Square, TEXT("Project_FollowView_Square")},
+	};
+
+	for (const FVariant& Variant : Variants)
+	{
+		// Dispatch is part of the measured frame, as in UOBMinimapWidget::UpdateMinimapMarkers
+		FPhaseTimer Timer;
+		for (int32 Frame = 0; Frame < Options.NumFrames; ++Frame)
+		{
+			Params.ViewYaw = Frame * 3.0;
+			Timer.Measure([&]
+			{
+				Dispatch(Variant.Rotation, Variant.Shape, Params, [&](const auto& Projector)
+				{
+					Projector.ProjectMarkers(Inputs, Outputs);
+				});
+			});
+		}
+		AddResult(EOBBenchmarkMix::Projection, NumMarkers, Variant.Phase, Timer, NumMarkers);
+	}
+}
+
+void FOBNavigationBenchmark::AddResult(const EOBBenchmarkMix Mix, const int32 NumMarkers, const TCHAR* Phase,
+                                       const FPhaseTimer& Timer, const int32 MarkersPerCall,
+                                       const double BytesPerMarker)
+{
+	if (Timer.NumCalls == 0)
+	{
+		return;
+	}
+
+	FPhaseResult& Result = Results.AddDefaulted_GetRef();
+	Result.Mix = LexMix(Mix);
+	Result.NumMarkers = NumMarkers;
+	Result.Phase = Phase;
+	Result.AvgMs = Timer.TotalSeconds * 1000.0 / Timer.NumCalls;
+	Result.PerMarkerUs = MarkersPerCall > 0 ? Result.AvgMs * 1000.0 / MarkersPerCall : 0.0;
+	Result.AllocsPerCall = static_cast<double>(Timer.TotalAllocs) / Timer.NumCalls;
+	Result.BytesPerMarker = BytesPerMarker;
+
+	UE_LOG(LogOBNavigation, Display, TEXT("[%hs] - %s x %d | %-20s | %10.4f ms | %8.4f us/marker | %10.1f allocs/call"),
+	       __FUNCTION__, *Result.Mix, NumMarkers, Phase, Result.AvgMs, Result.PerMarkerUs, Result.AllocsPerCall);
+}
+
+FVector FOBNavigationBenchmark::RandomLocation()
+{
+	return FVector(RandomStream.FRandRange(SpawnBounds.Min.X, SpawnBounds.Max.X),
+	               RandomStream.FRandRange(SpawnBounds.Min.Y, SpawnBounds.Max.Y),
+	               SpawnBounds.GetCenter().Z);
+}
+
+void FOBNavigationBenchmark::Cleanup()
+{
+	// Markers left over (e.g., from a failed unregister) must not leak into the next scenario
+	for (const FGuid& MarkerID : RegisteredMarkers)
+	{
+		if (NavSubsystem->ActiveMarkersMap.Contains(MarkerID))
+		{
+			NavSubsystem->UnregisterMapMarker(MarkerID);
+		}
+	}
+	RegisteredMarkers.Reset();
+
+	for (AActor* Actor : SpawnedActors)
+	{
+		if (IsValid(Actor))
+		{
+			Actor->Destroy();
+		}
+	}
+	SpawnedActors.Reset();
+
+	// Let the widget release the marker widgets of the finished scenario
+	if (MinimapWidget)
+	{
+		MinimapWidget->NativeTick(MinimapWidget->GetCachedGeometry(), 0.0f);
+	}
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+}
+
+FString FOBNavigationBenchmark::FormatCsvRow(const FPhaseResult& Result)
+{
+	return FString::Printf(TEXT("%s,%d,%s,%.6f,%.6f,%.2f,%.2f"), *Result.Mix, Result.NumMarkers, *Result.Phase,
+	                       Result.AvgMs, Result.PerMarkerUs, Result.AllocsPerCall, Result.BytesPerMarker);
+}
+
+bool FOBNavigationBenchmark::WriteCsv(const FString& Path) const
+{
+	FString Csv = FString(CsvHeader) + TEXT("\n");
+	for (const FPhaseResult& Result : Results)
+	{
+		Csv += FormatCsvRow(Result) + TEXT("\n");
+	}
+
+	if (!FFileHelper::SaveStringToFile(Csv, *Path))
+	{
+		UE_LOG(LogOBNavigation, Error, TEXT("[%hs] - Could not write benchmark results to '%s'."), __FUNCTION__, *Path);
+		return false;
+	}
+
+	UE_LOG(LogOBNavigation, Display, TEXT("[%hs] - Benchmark results written to '%s'."), __FUNCTION__, *Path);
+	return true;
+}
+
+bool FOBNavigationBenchmark::WriteBaseline(const FString& Path) const
+{
+	// A run usually covers a single mix, so the rows of the other mixes are kept
+	TArray<FString> Lines;
+	FFileHelper::LoadFileToStringArray(Lines, *Path);
+	if (Lines.IsEmpty())
+	{
+		Lines.Add(CsvHeader);
+	}
+
+	for (const FPhaseResult& Result : Results)
+	{
+		const FString Key = FString::Printf(TEXT("%s,%d,%s,"), *Result.Mix, Result.NumMarkers, *Result.Phase);
+		const int32 LineIndex = Lines.IndexOfByPredicate([&Key](const FString& Line) { return Line.StartsWith(Key); });
+		if (LineIndex != INDEX_NONE)
+		{
+			Lines[LineIndex] = FormatCsvRow(Result);
+		}
+		else
+		{
+			Lines.Add(FormatCsvRow(Result));
+		}
+	}
+
+	if (!FFileHelper::SaveStringArrayToFile(Lines, *Path))
+	{
+		UE_LOG(LogOBNavigation, Error, TEXT("[%hs] - Could not write baseline '%s'."), __FUNCTION__, *Path);
+		return false;
+	}
+
+	UE_LOG(LogOBNavigation, Display, TEXT("[%hs] - Baseline '%s' updated."), __FUNCTION__, *Path);
+	return true;
+}
+
+bool FOBNavigationBenchmark::CompareWithBaseline(const FString& Path) const
+{
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *Path))
+	{
+		UE_LOG(LogOBNavigation, Error, TEXT("[%hs] - Could not read baseline '%s'."), __FUNCTION__, *Path);
+		return false;
+	}
+
+	// Key: "Mix,Markers,Phase"
+	TMap<FString, FPhaseResult> Baseline;
+	for (int32 LineIndex = 1; LineIndex < Lines.Num(); ++LineIndex)
+	{
+		TArray<FString> Columns;
+		if (Lines[LineIndex].ParseIntoArray(Columns, TEXT(",")) >= 7)
+		{
+			FPhaseResult& Expected = Baseline.Add(FString::Join(TArrayView<const FString>(Columns.GetData(), 3), TEXT(",")));
+			Expected.AvgMs = FCString::Atod(*Columns[3]);
+			Expected.AllocsPerCall = FCString::Atod(*Columns[5]);
+			Expected.BytesPerMarker = FCString::Atod(*Columns[6]);
+		}
+	}
+
+	// Budgets are only meaningful on the machine they were recorded on, so none are shipped made up
+	if (Baseline.IsEmpty())
+	{
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%hs] - Baseline '%s' has no results. Record it with -WriteBaseline on the reference machine; nothing was compared."),
+		       __FUNCTION__, *Path);
+		return true;
+	}
+
+	int32 NumRegressions = 0;
+	int32 NumMissing = 0;
+	for (const FPhaseResult& Result : Results)
+	{
+		const FString Key = FString::Printf(TEXT("%s,%d,%s"), *Result.Mix, Result.NumMarkers, *Result.Phase);
+		const FPhaseResult* Expected = Baseline.Find(Key);
+		if (!Expected)
+		{
+			++NumMissing;
+			continue;
+		}
+
+		const double AllowedMs = Expected->AvgMs * (1.0 + Options.Tolerance);
+		if (Result.AvgMs > AllowedMs && Result.AvgMs - Expected->AvgMs > Options.NoiseFloorMs)
+		{
+			UE_LOG(LogOBNavigation, Error, TEXT("[%hs] - REGRESSION %s: %.4f ms (baseline %.4f ms)"), __FUNCTION__, *Key,
+			       Result.AvgMs, Expected->AvgMs);
+			++NumRegressions;
+		}
+
+		// Allocation counts are deterministic enough to compare with the same tolerance, plus one for rounding
+		if (Options.bCountAllocations && Result.AllocsPerCall > Expected->AllocsPerCall * (1.0 + Options.Tolerance) + 1.0)
+		{
+			UE_LOG(LogOBNavigation, Error, TEXT("[%hs] - REGRESSION %s: %.1f allocs/call (baseline %.1f)"), __FUNCTION__, *Key,
+			       Result.AllocsPerCall, Expected->AllocsPerCall);
+			++NumRegressions;
+		}
+
+		// Memory is only measured with -llm; a 0 on either side means it was not, plus some slack for allocator
+		// rounding
+		if (Result.BytesPerMarker > 0.0 && Expected->BytesPerMarker > 0.0 &&
+			Result.BytesPerMarker > Expected->BytesPerMarker * (1.0 + Options.Tolerance) + MemoryNoiseFloorBytes)
+		{
+			UE_LOG(LogOBNavigation, Error, TEXT("[%hs] - REGRESSION %s: %.1f bytes/marker (baseline %.1f)"), __FUNCTION__,
+			       *Key, Result.BytesPerMarker, Expected->BytesPerMarker);
+			++NumRegressions;
+		}
+	}
+
+	if (NumMissing > 0)
+	{
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%hs] - %d result(s) have no row in baseline '%s' and were not compared. Record them with -WriteBaseline."),
+		       __FUNCTION__, NumMissing, *Path);
+	}
+
+	UE_LOG(LogOBNavigation, Display, TEXT("[%hs] - Compared against '%s': %d regression(s)."), __FUNCTION__, *Path,
+	       NumRegressions);
+	return NumRegressions == 0;
+}
+
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,153 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+class AActor;
+class APawn;
+class UOBMarkerConfigAsset;
+class UOBMinimapWidget;
+class UOBNavigationSubsystem;
+class UWorld;
+
+/**
+ * @enum EOBBenchmarkMix
+ * @brief The kind of marker population a benchmark scenario runs with.
+ */
+enum class EOBBenchmarkMix : uint8
+{
+	Static,     // Static-location markers, nothing changes between frames
+	Moving,     // Every marker tracks an actor that moves every frame
+	Churn,      // Static markers, a fraction of which is unregistered and replaced every frame
+	Projection, // The minimap projection core alone, for every rotation mode and clamp shape (no subsystem or Slate)
+	Trace       // The markers and view of a recorded marker trace (see FOBMarkerTraceRecorder)
+};
+
+/**
+ * @struct FOBBenchmarkOptions
+ * @brief Options of a benchmark run, parsed from the command line of the automation run.
+ */
+struct FOBBenchmarkOptions
+{
+	TArray<int32> MarkerCounts = {100, 1000, 10000};
+	TArray<EOBBenchmarkMix> Mixes = {
+		EOBBenchmarkMix::Static, EOBBenchmarkMix::Moving, EOBBenchmarkMix::Churn, EOBBenchmarkMix::Projection
+	};
+
+	// Number of measured frames per scenario
+	int32 NumFrames = 60;
+
+	// Fraction of the markers replaced per frame in the churn mix
+	float ChurnFraction = 0.05f;
+
+	// Marker trace to replay as an additional scenario. Without an explicit -Mixes=, only the trace is run.
+	FString TracePath;
+
+	// Output CSV. Defaults to Saved/Profiling/OBNavigation/Benchmark-<timestamp>.csv
+	FString CsvPath;
+
+	// Baseline CSV to compare against. Empty to skip the comparison.
+	FString BaselinePath;
+
+	// If true, the results replace their rows in BaselinePath instead of being compared
+	bool bWriteBaseline = false;
+
+	// Allowed relative slowdown before a phase counts as a regression
+	float Tolerance = 0.25f;
+
+	// Timing differences below this are noise and never count as regressions (in milliseconds)
+	double NoiseFloorMs = 0.02;
+
+	// Count allocator calls per phase and compare them with the baseline.
+	// The counts come from the allocator call stats, so they are process wide and need a build with stats.
+	bool bCountAllocations = true;
+
+	FString MinimapWidgetClass = TEXT("/OBNavigation/Widgets/WBP_Minimap.WBP_Minimap_C");
+	FString MinimapConfig = TEXT("/OBNavigation/Data/DA_MinimapDefaultConfig.DA_MinimapDefaultConfig");
+	FString MarkerConfig = TEXT("/OBNavigation/Data/DA_PlayerMarker.DA_PlayerMarker");
+
+	static FOBBenchmarkOptions Parse(const FString& CommandLine);
+};
+
+/**
+ * @class FOBNavigationBenchmark
+ * @brief Measures how the navigation subsystem and the minimap widget scale with the number of markers.
+ * Each scenario (mix x marker count) reports per-phase timings, allocator calls and memory per marker.
+ * Memory per marker is the growth of the OBNavigation LLM tag, so it is only reported with -llm.
+ *
+ * Runs as the OBNavigation.Performance.Benchmark automation test (see OBNavigationBenchmarkTest.cpp):
+ *   UnrealEditor-Cmd <Project> -nullrhi -unattended
+ *       -ExecCmds="Automation RunTests OBNavigation.Performance.Benchmark; Quit"
+ * A production capture (see OBNav.Trace.Record) is benchmarked with -Trace=<Path.obtrace>.
+ */
+class FOBNavigationBenchmark
+{
+public:
+	FOBNavigationBenchmark(UWorld* InWorld, const FOBBenchmarkOptions& InOptions);
+
+	// Runs every scenario. Returns false if a baseline was given and at least one phase regressed.
+	bool Run();
+
+private:
+	struct FPhaseResult
+	{
+		FString Mix;
+		int32 NumMarkers = 0;
+		FString Phase;
+		double AvgMs = 0.0;
+		double PerMarkerUs = 0.0;
+		double AllocsPerCall = 0.0;
+		double BytesPerMarker = 0.0;
+	};
+
+	// Accumulates timings and allocations of one phase over several calls.
+	struct FPhaseTimer
+	{
+		double TotalSeconds = 0.0;
+		uint64 TotalAllocs = 0;
+		int32 NumCalls = 0;
+
+		template <typename FuncType>
+		void Measure(FuncType&& Func);
+	};
+
+	void RunScenario(EOBBenchmarkMix Mix, int32 NumMarkers);
+	void RunTraceScenario();
+	void RunProjectionScenario(int32 NumMarkers);
+	void AddResult(EOBBenchmarkMix Mix, int32 NumMarkers, const TCHAR* Phase, const FPhaseTimer& Timer,
+	               int32 MarkersPerCall, double BytesPerMarker = 0.0);
+
+	FVector RandomLocation();
+	void Cleanup();
+
+	static FString FormatCsvRow(const FPhaseResult& Result);
+	bool WriteCsv(const FString& Path) const;
+	bool WriteBaseline(const FString& Path) const;
+	bool CompareWithBaseline(const FString& Path) const;
+
+	// BytesPerMarker is 0 for the phases that do not measure memory, and for all of them without -llm
+	static constexpr const TCHAR* CsvHeader = TEXT("Mix,Markers,Phase,AvgMs,PerMarkerUs,AllocsPerCall,BytesPerMarker");
+
+	// Growth in bytes per marker below this never counts as a regression
+	static constexpr double MemoryNoiseFloorBytes = 16.0;
+
+	UWorld* World = nullptr;
+	FOBBenchmarkOptions Options;
+
+	UOBNavigationSubsystem* NavSubsystem = nullptr;
+	UOBMarkerConfigAsset* MarkerConfig = nullptr;
+	UOBMinimapWidget* MinimapWidget = nullptr;
+	APawn* ViewerPawn = nullptr;
+
+	FBox SpawnBounds;
+	FRandomStream RandomStream;
+
+	TArray<FGuid> RegisteredMarkers;
+	TArray<AActor*> SpawnedActors;
+	TArray<FPhaseResult> Results;
+};
+
+#endif // !UE_BUILD_SHIPPING
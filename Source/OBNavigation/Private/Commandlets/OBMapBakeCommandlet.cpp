@@ -0,0 +1,206 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Commandlets/OBMapBakeCommandlet.h"
+
+#include "OBMapBake.h"
+#include "OBMapLayerAsset.h"
+#include "OBNavigation.h"
+#include "AI/NavigationSystemBase.h"
+#include "Engine/Texture2D.h"
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+UOBMapBakeCommandlet::UOBMapBakeCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UOBMapBakeCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamValues;
+	ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+	const FString* MapParam = ParamValues.Find(TEXT("Map"));
+	const FString* LayersParam = ParamValues.Find(TEXT("Layers"));
+	if (!MapParam || !LayersParam)
+	{
+		UE_LOG(LogOBNavigation, Error, TEXT("[%s::%hs] - Usage: -run=OBMapBake -Map=<MapPackage> -Layers=<Layer>+<Layer> [-Resolution=N] [-FitBounds] [-NoHeight] [-NoNavMesh]"),
+		       *GetName(), __FUNCTION__);
+		return 1;
+	}
+
+	FOBMapBakeSettings Settings;
+	if (const FString* ResolutionParam = ParamValues.Find(TEXT("Resolution")))
+	{
+		Settings.Resolution = FMath::Clamp(FCString::Atoi(**ResolutionParam), 16, UOBMapBake::MaxImageSize);
+	}
+	Settings.bFitBounds = Switches.Contains(TEXT("FitBounds"));
+	Settings.bTraceHeight = !Switches.Contains(TEXT("NoHeight"));
+	Settings.bDrawNavMesh = !Switches.Contains(TEXT("NoNavMesh"));
+
+	TArray<FString> LayerPaths;
+	LayersParam->ParseIntoArray(LayerPaths, TEXT("+"));
+
+	UWorld* World = LoadWorld(*MapParam);
+	if (!World)
+	{
+		return 1;
+	}
+
+	bool bSuccess = true;
+	for (const FString& LayerPath : LayerPaths)
+	{
+		bSuccess &= BakeLayer(World, LayerPath, Settings);
+	}
+
+	UnloadWorld(World);
+	return bSuccess ? 0 : 1;
+#else
+	return 1;
+#endif
+}
+
+#if WITH_EDITOR
+UWorld* UOBMapBakeCommandlet::LoadWorld(const FString& MapPackageName) const
+{
+	UPackage* Package = LoadPackage(nullptr, *MapPackageName, LOAD_None);
+	UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+	if (!World || !World->PersistentLevel)
+	{
+		UE_LOG(LogOBNavigation, Error, TEXT("[%s::%hs] - Could not load map '%s'."), *GetName(), __FUNCTION__,
+		       *MapPackageName);
+		return nullptr;
+	}
+
+	if (World->IsPartitionedWorld())
+	{
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - '%s' is a World Partition map. Only its persistent level is baked."),
+		       *GetName(), __FUNCTION__, *MapPackageName);
+	}
+
+	// A loaded map has no physics scene and no navigation system until it is initialized. Traces need the former, the
+	// navmesh serialized with the map registers with the latter.
+	World->WorldType = EWorldType::Editor;
+	World->AddToRoot();
+	if (!World->bIsWorldInitialized)
+	{
+		World->InitWorld(UWorld::InitializationValues()
+		                 .RequiresHitProxies(false)
+		                 .ShouldSimulatePhysics(false)
+		                 .EnableTraceCollision(true)
+		                 .CreatePhysicsScene(true)
+		                 .CreateNavigation(true)
+		                 .CreateAISystem(false)
+		                 .AllowAudioPlayback(false));
+	}
+	FNavigationSystem::AddNavigationSystemToWorld(*World, FNavigationSystemRunMode::EditorMode);
+	World->UpdateWorldComponents(/*bRerunConstructionScripts*/ false, /*bCurrentLevelOnly*/ false);
+	return World;
+}
+
+void UOBMapBakeCommandlet::UnloadWorld(UWorld* World)
+{
+	World->DestroyWorld(/*bInformEngineOfWorld*/ false);
+	World->RemoveFromRoot();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+}
+
+bool UOBMapBakeCommandlet::BakeLayer(UWorld* World, const FString& LayerPath, const FOBMapBakeSettings& Settings) const
+{
+	// Accept package names as well as object paths
+	const FString ObjectPath = LayerPath.Contains(TEXT("."))
+		                           ? LayerPath
+		                           : LayerPath + TEXT(".") + FPackageName::GetShortName(LayerPath);
+	UOBMapLayerAsset* Layer = LoadObject<UOBMapLayerAsset>(nullptr, *ObjectPath);
+	if (!Layer)
+	{
+		UE_LOG(LogOBNavigation, Error, TEXT("[%s::%hs] - Could not load map layer '%s'."), *GetName(), __FUNCTION__,
+		       *LayerPath);
+		return false;
+	}
+
+	if (Settings.bFitBounds)
+	{
+		const FBox FitBounds = UOBMapBake::ComputeFitBounds(World, Settings.BoundsPadding);
+		if (!FitBounds.IsValid)
+		{
+			UE_LOG(LogOBNavigation, Error, TEXT("[%s::%hs] - No navmesh or level to fit the bounds of '%s' to."),
+			       *GetName(), __FUNCTION__, *Layer->GetName());
+			return false;
+		}
+		Layer->WorldBounds = FitBounds;
+	}
+
+	UOBMapBake* MapBake = NewObject<UOBMapBake>(GetTransientPackage());
+	if (!MapBake->Bake(World, Layer, Layer->WorldBounds, Settings))
+	{
+		return false;
+	}
+
+	// The texture lives next to its layer; an existing one is updated so references to it stay valid
+	const FString TextureName = FString::Printf(TEXT("T_%s_Map"), *Layer->GetName());
+	const FString TexturePackageName = FPackageName::GetLongPackagePath(Layer->GetPackage()->GetName()) / TextureName;
+	UPackage* TexturePackage = FPackageName::DoesPackageExist(TexturePackageName)
+		                           ? LoadPackage(nullptr, *TexturePackageName, LOAD_None)
+		                           : CreatePackage(*TexturePackageName);
+	if (!TexturePackage)
+	{
+		UE_LOG(LogOBNavigation, Error, TEXT("[%s::%hs] - Could not create package '%s'."), *GetName(), __FUNCTION__,
+		       *TexturePackageName);
+		return false;
+	}
+
+	UTexture2D* Texture = FindObject<UTexture2D>(TexturePackage, *TextureName);
+	if (!Texture)
+	{
+		Texture = NewObject<UTexture2D>(TexturePackage, *TextureName, RF_Public | RF_Standalone);
+	}
+
+	const FIntPoint ImageSize = MapBake->GetImageSize();
+	Texture->PreEditChange(nullptr);
+	Texture->Source.Init(ImageSize.X, ImageSize.Y, /*NumSlices*/ 1, /*NumMips*/ 1, TSF_BGRA8,
+	                     reinterpret_cast<const uint8*>(MapBake->GetPixels().GetData()));
+	Texture->SRGB = true;
+	Texture->LODGroup = TEXTUREGROUP_UI;
+	Texture->AddressX = TA_Clamp;
+	Texture->AddressY = TA_Clamp;
+	Texture->PostEditChange();
+
+	Layer->MapTexture = Texture;
+	Layer->MarkPackageDirty();
+
+	UE_LOG(LogOBNavigation, Display, TEXT("[%s::%hs] - Baked '%s' (%dx%d) into '%s'."), *GetName(), __FUNCTION__,
+	       *Layer->GetName(), ImageSize.X, ImageSize.Y, *TexturePackageName);
+	if (Settings.bFitBounds)
+	{
+		UE_LOG(LogOBNavigation, Display, TEXT("[%s::%hs] - Bounds of '%s' changed; re-run the OBNavigationManifest commandlet."),
+		       *GetName(), __FUNCTION__, *Layer->GetName());
+	}
+
+	return SavePackage(TexturePackage, Texture) && SavePackage(Layer->GetPackage(), Layer);
+}
+
+bool UOBMapBakeCommandlet::SavePackage(UPackage* Package, UObject* Asset)
+{
+	const FString FileName = FPackageName::LongPackageNameToFilename(Package->GetName(),
+	                                                                 FPackageName::GetAssetPackageExtension());
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+	SaveArgs.SaveFlags = SAVE_NoError;
+	if (!UPackage::SavePackage(Package, Asset, *FileName, SaveArgs))
+	{
+		UE_LOG(LogOBNavigation, Error, TEXT("[%hs] - Could not save '%s'."), __FUNCTION__, *FileName);
+		return false;
+	}
+	return true;
+}
+#endif
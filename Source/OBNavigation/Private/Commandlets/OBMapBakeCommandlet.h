@@ -0,0 +1,42 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "OBMapBakeCommandlet.generated.h"
+
+class UWorld;
+struct FOBMapBakeSettings;
+
+/**
+ * @class UOBMapBakeCommandlet
+ * @brief Bakes the map images of layers from a map's collision and navmesh on the CPU (see UOBMapBake).
+ * Each image is saved as a texture next to its layer asset ("T_<Layer>_Map") and assigned as the layer's MapTexture.
+ *
+ * Usage: UnrealEditor-Cmd <Project>.uproject -run=OBMapBake -Map=/Game/Maps/A -Layers=/Game/Map/DA_Floor1+/Game/Map/DA_Floor2
+ *        [-Resolution=2048] [-FitBounds] [-NoHeight] [-NoNavMesh]
+ * -FitBounds replaces each layer's WorldBounds with the navigable area of the map; re-run the OBNavigationManifest
+ * commandlet afterwards. Returns non-zero if a layer could not be baked or saved.
+ */
+UCLASS()
+class UOBMapBakeCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UOBMapBakeCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+#if WITH_EDITOR
+private:
+	// Loads a map and initializes it as an editor world, with collision and navigation but without gameplay.
+	UWorld* LoadWorld(const FString& MapPackageName) const;
+	static void UnloadWorld(UWorld* World);
+
+	bool BakeLayer(UWorld* World, const FString& LayerPath, const FOBMapBakeSettings& Settings) const;
+
+	static bool SavePackage(UPackage* Package, UObject* Asset);
+#endif
+};
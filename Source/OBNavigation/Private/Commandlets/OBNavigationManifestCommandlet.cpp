@@ -0,0 +1,313 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Commandlets/OBNavigationManifestCommandlet.h"
+
+#include "OBMapLayerAsset.h"
+#include "OBMapMarker.h"
+#include "OBNavigation.h"
+#include "OBPointOfInterestComponent.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Data/OBMarkerSaveData.h"
+#include "Data/OBNavigationManifest.h"
+#include "Data/OBPOIDatabase.h"
+#include "Data/OBPOISetAsset.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+
+#if WITH_EDITOR
+#include "WorldPartition/WorldPartition.h"
+#include "WorldPartition/WorldPartitionActorDesc.h"
+#include "WorldPartition/WorldPartitionHelpers.h"
+#endif
+
+UOBNavigationManifestCommandlet::UOBNavigationManifestCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UOBNavigationManifestCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamValues;
+	ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.SearchAllAssets(/*bSynchronousSearch*/ true);
+
+	if (const FString* PageSizeParam = ParamValues.Find(TEXT("POIPageSize")))
+	{
+		POIPageSize = FMath::Max(FCString::Atod(**PageSizeParam), 100.0);
+	}
+
+	bool bSuccess = WriteProjectManifest();
+
+	TArray<FAssetData> POISetAssets;
+	AssetRegistry.GetAssetsByClass(UOBPOISetAsset::StaticClass()->GetClassPathName(), POISetAssets);
+	for (const FAssetData& POISetAsset : POISetAssets)
+	{
+		if (UOBPOISetAsset* POISet = Cast<UOBPOISetAsset>(POISetAsset.GetAsset()))
+		{
+			POISets.Add(POISet);
+		}
+	}
+
+	TArray<FString> MapPackageNames;
+	if (const FString* MapsParam = ParamValues.Find(TEXT("Maps")))
+	{
+		MapsParam->ParseIntoArray(MapPackageNames, TEXT("+"));
+	}
+	else
+	{
+		TArray<FAssetData> MapAssets;
+		AssetRegistry.GetAssetsByClass(UWorld::StaticClass()->GetClassPathName(), MapAssets);
+		for (const FAssetData& MapAsset : MapAssets)
+		{
+			MapPackageNames.Add(MapAsset.PackageName.ToString());
+		}
+	}
+
+	for (const FString& MapPackageName : MapPackageNames)
+	{
+		bSuccess &= WriteMapManifest(MapPackageName);
+
+		// Maps are processed one at a time; do not keep them all resident
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	return bSuccess ? 0 : 1;
+}
+
+bool UOBNavigationManifestCommandlet::WriteProjectManifest() const
+{
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	FOBNavigationManifestWriter Writer;
+
+	TArray<FAssetData> AssetData;
+	AssetRegistry.GetAssetsByClass(UOBMapLayerAsset::StaticClass()->GetClassPathName(), AssetData);
+	for (const FAssetData& Data : AssetData)
+	{
+		if (const UOBMapLayerAsset* Layer = Cast<UOBMapLayerAsset>(Data.GetAsset()))
+		{
+			Writer.AddLayer(Data.GetSoftObjectPath(), Layer->WorldBounds, Layer->Priority);
+		}
+	}
+
+	// Same order as the registry scan of UOBNavigationSubsystem::Initialize, so config indices do not depend on how
+	// the subsystem started
+	AssetData.Reset();
+	AssetRegistry.GetAssetsByClass(UOBMarkerConfigAsset::StaticClass()->GetClassPathName(), AssetData,
+	                               /*bSearchSubClasses*/ true);
+	AssetData.Sort([](const FAssetData& A, const FAssetData& B)
+	{
+		return A.PackageName.LexicalLess(B.PackageName);
+	});
+	for (const FAssetData& Data : AssetData)
+	{
+		Writer.AddMarkerConfig(Data.GetSoftObjectPath());
+	}
+
+	return SaveManifest(Writer, FOBNavigationManifestFormat::GetProjectManifestPath());
+}
+
+bool UOBNavigationManifestCommandlet::WriteMapManifest(const FString& MapPackageName) const
+{
+	UPackage* Package = LoadPackage(nullptr, *MapPackageName, LOAD_None);
+	UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+	if (!World || !World->PersistentLevel)
+	{
+		UE_LOG(LogOBNavigation, Error, TEXT("[%s::%hs] - Could not load map '%s'."), *GetName(), __FUNCTION__,
+		       *MapPackageName);
+		return false;
+	}
+
+	FOBMarkerSaveWriter MarkerWriter;
+	FOBPOIDatabaseWriter POIWriter;
+	if (World->IsPartitionedWorld())
+	{
+		// The actors of a World Partition map live in their own packages, not in its persistent level
+		const bool bVisited = ForEachPartitionedActor(World, [&](const AActor* Actor)
+		{
+			AddActorPointOfInterest(Actor, MapPackageName, MarkerWriter, POIWriter);
+		});
+		if (!bVisited)
+		{
+			UE_LOG(LogOBNavigation, Error, TEXT("[%s::%hs] - Could not load the actors of World Partition map '%s'."),
+			       *GetName(), __FUNCTION__, *MapPackageName);
+			return false;
+		}
+	}
+	else
+	{
+		for (const AActor* Actor : World->PersistentLevel->Actors)
+		{
+			AddActorPointOfInterest(Actor, MapPackageName, MarkerWriter, POIWriter);
+		}
+	}
+
+	for (const UOBPOISetAsset* POISet : POISets)
+	{
+		if (POISet->Map.ToSoftObjectPath().GetLongPackageName() != MapPackageName)
+		{
+			continue;
+		}
+
+		for (const FOBPOISetEntry& Entry : POISet->POIs)
+		{
+			if (!Entry.Config)
+			{
+				continue;
+			}
+
+			const FGuid POIID = UOBPointOfInterestComponent::MakeMarkerID(MapPackageName, Entry.Name);
+			if (!POIWriter.AddPOI(POIID, FSoftObjectPath(Entry.Config), Entry.LayerName, Entry.Location))
+			{
+				UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - POI '%s' of '%s' is skipped: its name is already used in '%s'."),
+				       *GetName(), __FUNCTION__, *Entry.Name.ToString(), *POISet->GetName(), *MapPackageName);
+			}
+		}
+	}
+
+	// Same as the manifest below: no database without POIs
+	const FString DatabasePath = FOBPOIDatabaseFormat::GetMapDatabasePath(MapPackageName);
+	bool bSuccess = true;
+	if (POIWriter.GetNumPOIs() == 0)
+	{
+		IFileManager::Get().Delete(*DatabasePath, /*RequireExists*/ false, /*EvenReadOnly*/ true, /*Quiet*/ true);
+	}
+	else
+	{
+		UE_LOG(LogOBNavigation, Display, TEXT("[%s::%hs] - Stored %d points of interest of '%s' in its POI database."),
+		       *GetName(), __FUNCTION__, POIWriter.GetNumPOIs(), *MapPackageName);
+		bSuccess = SavePOIDatabase(POIWriter, DatabasePath);
+	}
+
+	// A map without points of interest needs no manifest; drop a stale one
+	const FString ManifestPath = FOBNavigationManifestFormat::GetMapManifestPath(MapPackageName);
+	if (MarkerWriter.GetNumMarkers() == 0)
+	{
+		IFileManager::Get().Delete(*ManifestPath, /*RequireExists*/ false, /*EvenReadOnly*/ true, /*Quiet*/ true);
+		return bSuccess;
+	}
+
+	TArray<uint8> MarkerData;
+	MarkerWriter.Write(MarkerData);
+
+	FOBNavigationManifestWriter Writer;
+	Writer.SetStaticMarkers(MoveTemp(MarkerData));
+
+	UE_LOG(LogOBNavigation, Display, TEXT("[%s::%hs] - Baked %d points of interest of '%s'."), *GetName(), __FUNCTION__,
+	       MarkerWriter.GetNumMarkers(), *MapPackageName);
+	return SaveManifest(Writer, ManifestPath) && bSuccess;
+}
+
+bool UOBNavigationManifestCommandlet::ForEachPartitionedActor(UWorld* World, TFunctionRef<void(const AActor*)> Func) const
+{
+#if WITH_EDITOR
+	// Same as UOBMapBakeCommandlet: the world partition of a loaded map is only set up once the world is initialized
+	World->WorldType = EWorldType::Editor;
+	World->AddToRoot();
+	if (!World->bIsWorldInitialized)
+	{
+		World->InitWorld(UWorld::InitializationValues()
+		                 .RequiresHitProxies(false)
+		                 .ShouldSimulatePhysics(false)
+		                 .EnableTraceCollision(false)
+		                 .CreatePhysicsScene(true)
+		                 .CreateNavigation(false)
+		                 .CreateAISystem(false)
+		                 .AllowAudioPlayback(false));
+	}
+
+	UWorldPartition* WorldPartition = World->GetWorldPartition();
+	if (WorldPartition && !WorldPartition->IsInitialized())
+	{
+		WorldPartition->Initialize(World, FTransform::Identity);
+	}
+
+	if (WorldPartition)
+	{
+		// Loads the actors in batches and releases each batch before the next, so a map with hundreds of thousands of
+		// actors never has them all resident
+		FWorldPartitionHelpers::ForEachActorWithLoading(WorldPartition, AActor::StaticClass(),
+		                                                [&Func](const FWorldPartitionActorDesc* ActorDesc)
+		                                                {
+			                                                Func(ActorDesc->GetActor());
+			                                                return true;
+		                                                });
+	}
+
+	World->DestroyWorld(/*bInformEngineOfWorld*/ false);
+	World->RemoveFromRoot();
+	return WorldPartition != nullptr;
+#else
+	return false;
+#endif
+}
+
+void UOBNavigationManifestCommandlet::AddActorPointOfInterest(const AActor* Actor, const FString& MapPackageName,
+                                                              FOBMarkerSaveWriter& MarkerWriter,
+                                                              FOBPOIDatabaseWriter& POIWriter) const
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	// One marker per actor, like at runtime where the first component registers it and the others find it
+	const UOBPointOfInterestComponent* PointOfInterest = Actor->FindComponentByClass<UOBPointOfInterestComponent>();
+	if (!PointOfInterest || !PointOfInterest->MarkerConfig)
+	{
+		return;
+	}
+
+	const FGuid MarkerID = UOBPointOfInterestComponent::MakeMarkerID(MapPackageName, Actor->GetFName());
+	if (PointOfInterest->bStoreInPOIDatabase)
+	{
+		POIWriter.AddPOI(MarkerID, FSoftObjectPath(PointOfInterest->MarkerConfig), PointOfInterest->MarkerLayerName,
+		                 Actor->GetActorLocation());
+	}
+	else
+	{
+		MarkerWriter.AddMarker(MarkerID, PointOfInterest->MarkerConfig, PointOfInterest->MarkerLayerName,
+		                       Actor->GetActorLocation(), /*RemainingLifeTime*/ 0.0f);
+	}
+}
+
+bool UOBNavigationManifestCommandlet::SaveManifest(const FOBNavigationManifestWriter& Writer, const FString& FilePath)
+{
+	TArray<uint8> Data;
+	Writer.Write(Data);
+	if (!FFileHelper::SaveArrayToFile(Data, *FilePath))
+	{
+		UE_LOG(LogOBNavigation, Error, TEXT("[%hs] - Could not write navigation manifest '%s'."), __FUNCTION__, *FilePath);
+		return false;
+	}
+
+	UE_LOG(LogOBNavigation, Display, TEXT("[%hs] - Wrote navigation manifest '%s' (%d bytes)."), __FUNCTION__, *FilePath,
+	       Data.Num());
+	return true;
+}
+
+bool UOBNavigationManifestCommandlet::SavePOIDatabase(const FOBPOIDatabaseWriter& Writer, const FString& FilePath) const
+{
+	TArray<uint8> Data;
+	Writer.Write(Data, POIPageSize);
+	if (!FFileHelper::SaveArrayToFile(Data, *FilePath))
+	{
+		UE_LOG(LogOBNavigation, Error, TEXT("[%s::%hs] - Could not write POI database '%s'."), *GetName(), __FUNCTION__,
+		       *FilePath);
+		return false;
+	}
+
+	UE_LOG(LogOBNavigation, Display, TEXT("[%s::%hs] - Wrote POI database '%s' (%d bytes)."), *GetName(), __FUNCTION__,
+	       *FilePath, Data.Num());
+	return true;
+}
@@ -0,0 +1,60 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "OBNavigationManifestCommandlet.generated.h"
+
+class AActor;
+class FOBMarkerSaveWriter;
+class FOBNavigationManifestWriter;
+class FOBPOIDatabaseWriter;
+class UOBPOISetAsset;
+class UWorld;
+
+/**
+ * @class UOBNavigationManifestCommandlet
+ * @brief Cook step writing the navigation manifests (see FOBNavigationManifestFormat).
+ * Writes the project manifest (map layers, their bounds, priorities and layer grid, and every marker config) and a
+ * manifest per map with the points of interest placed in it. Points of interest flagged with bStoreInPOIDatabase,
+ * and those of the map's POI sets (see UOBPOISetAsset), go to the map's POI database instead (see FOBPOIDatabaseFormat).
+ * The actors of a World Partition map are loaded in batches, so its points of interest are baked whatever cell they
+ * live in.
+ *
+ * Usage: UnrealEditor-Cmd <Project>.uproject -run=OBNavigationManifest [-Maps=/Game/Maps/A+/Game/Maps/B]
+ *        [-POIPageSize=10000]
+ * Without -Maps, every map of the project is processed. -POIPageSize is the side (in world units) of a POI database
+ * page. Returns non-zero if a manifest could not be written.
+ */
+UCLASS()
+class UOBNavigationManifestCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UOBNavigationManifestCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	bool WriteProjectManifest() const;
+	bool WriteMapManifest(const FString& MapPackageName) const;
+
+	// Visits every actor of a World Partition map, loading them in batches. Returns false if the map could not be
+	// initialized.
+	bool ForEachPartitionedActor(UWorld* World, TFunctionRef<void(const AActor*)> Func) const;
+
+	// Adds the point of interest placed on Actor, if any, to the map manifest or the POI database
+	void AddActorPointOfInterest(const AActor* Actor, const FString& MapPackageName, FOBMarkerSaveWriter& MarkerWriter,
+	                             FOBPOIDatabaseWriter& POIWriter) const;
+
+	static bool SaveManifest(const FOBNavigationManifestWriter& Writer, const FString& FilePath);
+	bool SavePOIDatabase(const FOBPOIDatabaseWriter& Writer, const FString& FilePath) const;
+
+	double POIPageSize = 10000.0;
+
+	// Every POI set of the project, loaded once rather than per map
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UOBPOISetAsset>> POISets;
+};
@@ -0,0 +1,207 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Data/OBMarkerSaveData.h"
+
+#include "OBMapMarker.h"
+#include "Data/OBTableStringSerialization.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	using OBNavigation::Serialization::ReadTableString;
+	using OBNavigation::Serialization::WriteTableString;
+
+	constexpr double QuantizationMax = 65535.0;
+
+	template <typename T>
+	T ReadRaw(const uint8*& Cursor)
+	{
+		T Value;
+		FMemory::Memcpy(&Value, Cursor, sizeof(T));
+		Cursor += sizeof(T);
+		return Value;
+	}
+}
+
+void FOBMarkerSaveWriter::Reserve(const int32 NumMarkers)
+{
+	Markers.Reserve(NumMarkers);
+}
+
+void FOBMarkerSaveWriter::AddMarker(const FGuid& MarkerID, const UOBMarkerConfigAsset* Config, const FName LayerName,
+                                    const FVector& WorldLocation, const float RemainingLifeTime)
+{
+	if (!Config)
+	{
+		return;
+	}
+
+	uint16 ConfigIndex;
+	if (const uint16* ExistingConfigIndex = ConfigIndices.Find(Config))
+	{
+		ConfigIndex = *ExistingConfigIndex;
+	}
+	else
+	{
+		ConfigIndex = static_cast<uint16>(ConfigTable.Add(FSoftObjectPath(Config)));
+		ConfigIndices.Add(Config, ConfigIndex);
+	}
+
+	uint16 LayerIndex;
+	if (const uint16* ExistingLayerIndex = LayerIndices.Find(LayerName))
+	{
+		LayerIndex = *ExistingLayerIndex;
+	}
+	else
+	{
+		LayerIndex = static_cast<uint16>(LayerTable.Add(LayerName));
+		LayerIndices.Add(LayerName, LayerIndex);
+	}
+
+	Markers.Add({MarkerID, ConfigIndex, LayerIndex, WorldLocation, RemainingLifeTime});
+}
+
+void FOBMarkerSaveWriter::Write(TArray<uint8>& OutData) const
+{
+	static_assert(PLATFORM_LITTLE_ENDIAN, "Saved marker records are decoded with plain copies.");
+
+	OutData.Reset();
+	OutData.Reserve(128 + Markers.Num() * FOBMarkerSaveFormat::RecordSize);
+	FMemoryWriter Ar(OutData);
+
+	// Quantize inside the bounding box of the saved markers
+	FBox Bounds(ForceInit);
+	for (const FPendingMarker& Marker : Markers)
+	{
+		Bounds += Marker.WorldLocation;
+	}
+	const FVector Origin = Bounds.IsValid ? Bounds.Min : FVector::ZeroVector;
+	const FVector Extent = Bounds.IsValid ? Bounds.GetSize() : FVector::ZeroVector;
+	const FVector Step(FMath::Max(Extent.X / QuantizationMax, UE_KINDA_SMALL_NUMBER),
+	                   FMath::Max(Extent.Y / QuantizationMax, UE_KINDA_SMALL_NUMBER),
+	                   FMath::Max(Extent.Z / QuantizationMax, UE_KINDA_SMALL_NUMBER));
+
+	uint32 MagicValue = FOBMarkerSaveFormat::Magic;
+	uint16 VersionValue = FOBMarkerSaveFormat::Version;
+	uint16 NumConfigs = static_cast<uint16>(ConfigTable.Num());
+	uint16 NumLayers = static_cast<uint16>(LayerTable.Num());
+	uint32 NumMarkers = static_cast<uint32>(Markers.Num());
+	double OriginX = Origin.X, OriginY = Origin.Y, OriginZ = Origin.Z;
+	double StepX = Step.X, StepY = Step.Y, StepZ = Step.Z;
+	Ar << MagicValue << VersionValue << NumConfigs << NumLayers << NumMarkers;
+	Ar << OriginX << OriginY << OriginZ << StepX << StepY << StepZ;
+
+	for (const FSoftObjectPath& ConfigPath : ConfigTable)
+	{
+		WriteTableString(Ar, ConfigPath.ToString());
+	}
+	for (const FName& LayerName : LayerTable)
+	{
+		WriteTableString(Ar, LayerName.ToString());
+	}
+
+	for (const FPendingMarker& Marker : Markers)
+	{
+		FGuid MarkerID = Marker.MarkerID;
+		uint16 ConfigIndex = Marker.ConfigIndex;
+		uint16 LayerIndex = Marker.LayerIndex;
+		const FVector Local = (Marker.WorldLocation - Origin) / Step;
+		uint16 QuantizedX = static_cast<uint16>(FMath::Clamp(FMath::RoundToInt32(Local.X), 0, MAX_uint16));
+		uint16 QuantizedY = static_cast<uint16>(FMath::Clamp(FMath::RoundToInt32(Local.Y), 0, MAX_uint16));
+		uint16 QuantizedZ = static_cast<uint16>(FMath::Clamp(FMath::RoundToInt32(Local.Z), 0, MAX_uint16));
+
+		// 0 is reserved for infinite, so a nearly expired marker still keeps the smallest finite lifetime
+		uint16 LifeTime = 0;
+		if (Marker.RemainingLifeTime > 0.0f)
+		{
+			LifeTime = static_cast<uint16>(FMath::Clamp(FMath::RoundToInt32(Marker.RemainingLifeTime * 10.0f), 1,
+			                                            MAX_uint16));
+		}
+
+		Ar << MarkerID.A << MarkerID.B << MarkerID.C << MarkerID.D;
+		Ar << ConfigIndex << LayerIndex << QuantizedX << QuantizedY << QuantizedZ << LifeTime;
+	}
+}
+
+bool FOBMarkerSaveReader::Open(const TArrayView<const uint8> InData)
+{
+	Data = InData;
+	NumMarkers = 0;
+	ConfigTable.Reset();
+	LayerTable.Reset();
+
+	FMemoryReaderView Ar(InData);
+
+	uint32 MagicValue = 0;
+	uint16 VersionValue = 0;
+	uint16 NumConfigs = 0;
+	uint16 NumLayers = 0;
+	uint32 NumMarkersValue = 0;
+	double OriginX = 0.0, OriginY = 0.0, OriginZ = 0.0;
+	double StepX = 0.0, StepY = 0.0, StepZ = 0.0;
+	Ar << MagicValue << VersionValue << NumConfigs << NumLayers << NumMarkersValue;
+	Ar << OriginX << OriginY << OriginZ << StepX << StepY << StepZ;
+
+	if (Ar.IsError() || MagicValue != FOBMarkerSaveFormat::Magic || VersionValue != FOBMarkerSaveFormat::Version)
+	{
+		return false;
+	}
+
+	QuantizationOrigin = FVector(OriginX, OriginY, OriginZ);
+	QuantizationStep = FVector(StepX, StepY, StepZ);
+
+	FString Entry;
+	ConfigTable.Reserve(NumConfigs);
+	for (int32 Index = 0; Index < NumConfigs; ++Index)
+	{
+		if (!ReadTableString(Ar, Data, Entry))
+		{
+			return false;
+		}
+		ConfigTable.Emplace(Entry);
+	}
+
+	LayerTable.Reserve(NumLayers);
+	for (int32 Index = 0; Index < NumLayers; ++Index)
+	{
+		if (!ReadTableString(Ar, Data, Entry))
+		{
+			return false;
+		}
+		LayerTable.Emplace(*Entry);
+	}
+
+	RecordsOffset = Ar.Tell();
+	if (RecordsOffset + static_cast<int64>(NumMarkersValue) * FOBMarkerSaveFormat::RecordSize > Data.Num())
+	{
+		return false;
+	}
+
+	NumMarkers = static_cast<int32>(NumMarkersValue);
+	return true;
+}
+
+bool FOBMarkerSaveReader::ReadMarker(const int32 Index, FOBSavedMarkerRecord& OutRecord) const
+{
+	if (Index < 0 || Index >= NumMarkers)
+	{
+		return false;
+	}
+
+	const uint8* Cursor = Data.GetData() + RecordsOffset + static_cast<int64>(Index) * FOBMarkerSaveFormat::RecordSize;
+	OutRecord.MarkerID.A = ReadRaw<uint32>(Cursor);
+	OutRecord.MarkerID.B = ReadRaw<uint32>(Cursor);
+	OutRecord.MarkerID.C = ReadRaw<uint32>(Cursor);
+	OutRecord.MarkerID.D = ReadRaw<uint32>(Cursor);
+	OutRecord.ConfigIndex = ReadRaw<uint16>(Cursor);
+	OutRecord.LayerIndex = ReadRaw<uint16>(Cursor);
+
+	const uint16 QuantizedX = ReadRaw<uint16>(Cursor);
+	const uint16 QuantizedY = ReadRaw<uint16>(Cursor);
+	const uint16 QuantizedZ = ReadRaw<uint16>(Cursor);
+	OutRecord.WorldLocation = QuantizationOrigin + FVector(QuantizedX, QuantizedY, QuantizedZ) * QuantizationStep;
+	OutRecord.RemainingLifeTime = ReadRaw<uint16>(Cursor) / 10.0f;
+
+	return OutRecord.ConfigIndex < ConfigTable.Num() && OutRecord.LayerIndex < LayerTable.Num();
+}
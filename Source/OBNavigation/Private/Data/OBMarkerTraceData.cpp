@@ -0,0 +1,339 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Data/OBMarkerTraceData.h"
+
+namespace
+{
+	// Guards against absurd allocations when decoding corrupt data
+	constexpr uint32 MaxMarkerIndex = 1 << 24;
+	constexpr uint32 MaxStringLength = 4096;
+}
+
+void FOBMarkerTraceFrame::Reset()
+{
+	DeltaTime = 0.0f;
+	bHasView = false;
+	NewConfigs.Reset();
+	NewLayerNames.Reset();
+	Registrations.Reset();
+	Removals.Reset();
+	Moves.Reset();
+	bLayerChanged = false;
+	LayerPath.Reset();
+}
+
+void FOBMarkerTraceWriter::WriteHeader()
+{
+	uint32 Magic = FOBMarkerTraceFormat::Magic;
+	uint16 Version = FOBMarkerTraceFormat::Version;
+	Buffer.Append(reinterpret_cast<const uint8*>(&Magic), sizeof(Magic));
+	Buffer.Append(reinterpret_cast<const uint8*>(&Version), sizeof(Version));
+}
+
+void FOBMarkerTraceWriter::BeginFrame(const float DeltaTime)
+{
+	WriteEvent(EOBMarkerTraceEvent::BeginFrame);
+	WriteFloat(DeltaTime);
+}
+
+void FOBMarkerTraceWriter::WriteView(const FVector& Location, const float ActorYaw, const float ControlYaw)
+{
+	WriteEvent(EOBMarkerTraceEvent::View);
+	WriteFloat(Location.X);
+	WriteFloat(Location.Y);
+	WriteFloat(Location.Z);
+	WriteFloat(ActorYaw);
+	WriteFloat(ControlYaw);
+}
+
+void FOBMarkerTraceWriter::DefineConfig(const uint32 ConfigIndex, const FString& ConfigPath)
+{
+	WriteEvent(EOBMarkerTraceEvent::DefineConfig);
+	WriteVarUInt(ConfigIndex);
+	WriteString(ConfigPath);
+}
+
+void FOBMarkerTraceWriter::DefineLayerName(const uint32 LayerNameIndex, const FName LayerName)
+{
+	WriteEvent(EOBMarkerTraceEvent::DefineLayerName);
+	WriteVarUInt(LayerNameIndex);
+	WriteString(LayerName.ToString());
+}
+
+void FOBMarkerTraceWriter::Register(const uint32 MarkerIndex, const uint32 ConfigIndex, const uint32 LayerNameIndex,
+                                   const FIntVector& Position)
+{
+	WriteEvent(EOBMarkerTraceEvent::Register);
+	WriteVarUInt(MarkerIndex);
+	WriteVarUInt(ConfigIndex);
+	WriteVarUInt(LayerNameIndex);
+	WriteVarInt(Position.X);
+	WriteVarInt(Position.Y);
+	WriteVarInt(Position.Z);
+}
+
+void FOBMarkerTraceWriter::Remove(const uint32 MarkerIndex)
+{
+	WriteEvent(EOBMarkerTraceEvent::Remove);
+	WriteVarUInt(MarkerIndex);
+}
+
+void FOBMarkerTraceWriter::Move(const uint32 MarkerIndex, const FIntVector& Delta)
+{
+	WriteEvent(EOBMarkerTraceEvent::Move);
+	WriteVarUInt(MarkerIndex);
+	WriteVarInt(Delta.X);
+	WriteVarInt(Delta.Y);
+	WriteVarInt(Delta.Z);
+}
+
+void FOBMarkerTraceWriter::LayerChanged(const FString& LayerPath)
+{
+	WriteEvent(EOBMarkerTraceEvent::LayerChanged);
+	WriteString(LayerPath);
+}
+
+void FOBMarkerTraceWriter::EndFrame()
+{
+	WriteEvent(EOBMarkerTraceEvent::EndFrame);
+}
+
+FIntVector FOBMarkerTraceWriter::QuantizePosition(const FVector& WorldLocation)
+{
+	return FIntVector(FMath::RoundToInt32(WorldLocation.X), FMath::RoundToInt32(WorldLocation.Y),
+	                  FMath::RoundToInt32(WorldLocation.Z));
+}
+
+void FOBMarkerTraceWriter::WriteEvent(const EOBMarkerTraceEvent Event)
+{
+	Buffer.Add(static_cast<uint8>(Event));
+}
+
+void FOBMarkerTraceWriter::WriteVarUInt(uint32 Value)
+{
+	do
+	{
+		uint8 Byte = Value & 0x7F;
+		Value >>= 7;
+		if (Value != 0)
+		{
+			Byte |= 0x80;
+		}
+		Buffer.Add(Byte);
+	}
+	while (Value != 0);
+}
+
+void FOBMarkerTraceWriter::WriteVarInt(const int32 Value)
+{
+	// Zig-zag, so small negative deltas stay small
+	WriteVarUInt((static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31));
+}
+
+void FOBMarkerTraceWriter::WriteFloat(const float Value)
+{
+	Buffer.Append(reinterpret_cast<const uint8*>(&Value), sizeof(Value));
+}
+
+void FOBMarkerTraceWriter::WriteString(const FString& String)
+{
+	const FTCHARToUTF8 Converted(*String);
+	const uint32 Length = FMath::Min(static_cast<uint32>(Converted.Length()), MaxStringLength);
+	WriteVarUInt(Length);
+	Buffer.Append(reinterpret_cast<const uint8*>(Converted.Get()), Length);
+}
+
+bool FOBMarkerTraceReader::Open(const TArrayView<const uint8> InData)
+{
+	Data = InData;
+	MarkerPositions.Reset();
+	bError = false;
+
+	uint32 Magic = 0;
+	uint16 Version = 0;
+	if (Data.Num() < static_cast<int32>(sizeof(Magic) + sizeof(Version)))
+	{
+		bError = true;
+		return false;
+	}
+
+	FMemory::Memcpy(&Magic, Data.GetData(), sizeof(Magic));
+	FMemory::Memcpy(&Version, Data.GetData() + sizeof(Magic), sizeof(Version));
+	if (Magic != FOBMarkerTraceFormat::Magic || Version != FOBMarkerTraceFormat::Version)
+	{
+		bError = true;
+		return false;
+	}
+
+	FirstFrameOffset = sizeof(Magic) + sizeof(Version);
+	Offset = FirstFrameOffset;
+	return true;
+}
+
+void FOBMarkerTraceReader::Rewind()
+{
+	Offset = FirstFrameOffset;
+	MarkerPositions.Reset();
+	bError = false;
+}
+
+bool FOBMarkerTraceReader::ReadFrame(FOBMarkerTraceFrame& OutFrame)
+{
+	OutFrame.Reset();
+	if (bError || Offset >= Data.Num())
+	{
+		return false;
+	}
+
+	if (Data[Offset++] != static_cast<uint8>(EOBMarkerTraceEvent::BeginFrame) || !ReadFloat(OutFrame.DeltaTime))
+	{
+		bError = true;
+		return false;
+	}
+
+	// A capture cut short (e.g., by a crash) ends with a truncated frame, which is reported as an error
+	while (Offset < Data.Num())
+	{
+		bool bValid = true;
+		switch (static_cast<EOBMarkerTraceEvent>(Data[Offset++]))
+		{
+		case EOBMarkerTraceEvent::EndFrame:
+			return true;
+
+		case EOBMarkerTraceEvent::View:
+			{
+				float X, Y, Z;
+				bValid = ReadFloat(X) && ReadFloat(Y) && ReadFloat(Z) && ReadFloat(OutFrame.ViewActorYaw) &&
+					ReadFloat(OutFrame.ViewControlYaw);
+				OutFrame.ViewLocation = FVector(X, Y, Z);
+				OutFrame.bHasView = bValid;
+				break;
+			}
+
+		case EOBMarkerTraceEvent::DefineConfig:
+			{
+				TPair<uint32, FString>& Config = OutFrame.NewConfigs.AddDefaulted_GetRef();
+				bValid = ReadVarUInt(Config.Key) && ReadString(Config.Value);
+				break;
+			}
+
+		case EOBMarkerTraceEvent::DefineLayerName:
+			{
+				uint32 Index;
+				FString Name;
+				bValid = ReadVarUInt(Index) && ReadString(Name);
+				OutFrame.NewLayerNames.Emplace(Index, FName(*Name));
+				break;
+			}
+
+		case EOBMarkerTraceEvent::Register:
+			{
+				FOBMarkerTraceFrame::FRegistration& Registration = OutFrame.Registrations.AddDefaulted_GetRef();
+				FIntVector Position;
+				bValid = ReadVarUInt(Registration.MarkerIndex) && ReadVarUInt(Registration.ConfigIndex) &&
+					ReadVarUInt(Registration.LayerNameIndex) && ReadVarInt(Position.X) && ReadVarInt(Position.Y) &&
+					ReadVarInt(Position.Z) && Registration.MarkerIndex < MaxMarkerIndex;
+				if (bValid)
+				{
+					if (MarkerPositions.Num() <= static_cast<int32>(Registration.MarkerIndex))
+					{
+						MarkerPositions.SetNumZeroed(static_cast<int32>(Registration.MarkerIndex) + 1);
+					}
+					MarkerPositions[Registration.MarkerIndex] = Position;
+					Registration.WorldLocation = FVector(Position);
+				}
+				break;
+			}
+
+		case EOBMarkerTraceEvent::Remove:
+			bValid = ReadVarUInt(OutFrame.Removals.AddDefaulted_GetRef());
+			break;
+
+		case EOBMarkerTraceEvent::Move:
+			{
+				uint32 Index;
+				FIntVector Delta;
+				bValid = ReadVarUInt(Index) && ReadVarInt(Delta.X) && ReadVarInt(Delta.Y) && ReadVarInt(Delta.Z) &&
+					MarkerPositions.IsValidIndex(Index);
+				if (bValid)
+				{
+					MarkerPositions[Index] += Delta;
+					OutFrame.Moves.Emplace(Index, FVector(MarkerPositions[Index]));
+				}
+				break;
+			}
+
+		case EOBMarkerTraceEvent::LayerChanged:
+			bValid = ReadString(OutFrame.LayerPath);
+			OutFrame.bLayerChanged = bValid;
+			break;
+
+		default:
+			bValid = false;
+			break;
+		}
+
+		if (!bValid)
+		{
+			break;
+		}
+	}
+
+	bError = true;
+	return false;
+}
+
+bool FOBMarkerTraceReader::ReadVarUInt(uint32& OutValue)
+{
+	OutValue = 0;
+	for (int32 Shift = 0; Shift < 35; Shift += 7)
+	{
+		if (Offset >= Data.Num())
+		{
+			return false;
+		}
+		const uint8 Byte = Data[Offset++];
+		OutValue |= static_cast<uint32>(Byte & 0x7F) << Shift;
+		if ((Byte & 0x80) == 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FOBMarkerTraceReader::ReadVarInt(int32& OutValue)
+{
+	uint32 Encoded;
+	if (!ReadVarUInt(Encoded))
+	{
+		return false;
+	}
+	OutValue = static_cast<int32>((Encoded >> 1) ^ (~(Encoded & 1) + 1));
+	return true;
+}
+
+bool FOBMarkerTraceReader::ReadFloat(float& OutValue)
+{
+	if (Offset + static_cast<int32>(sizeof(float)) > Data.Num())
+	{
+		return false;
+	}
+	FMemory::Memcpy(&OutValue, Data.GetData() + Offset, sizeof(float));
+	Offset += sizeof(float);
+	return true;
+}
+
+bool FOBMarkerTraceReader::ReadString(FString& OutString)
+{
+	uint32 Length;
+	if (!ReadVarUInt(Length) || Length > MaxStringLength || static_cast<int64>(Offset) + Length > Data.Num())
+	{
+		return false;
+	}
+
+	const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data.GetData() + Offset), Length);
+	OutString = FString(Converted.Length(), Converted.Get());
+	Offset += static_cast<int32>(Length);
+	return true;
+}
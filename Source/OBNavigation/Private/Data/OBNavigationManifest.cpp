@@ -0,0 +1,377 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Data/OBNavigationManifest.h"
+
+#include "Data/OBTableStringSerialization.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	using OBNavigation::Serialization::ReadTableString;
+	using OBNavigation::Serialization::WriteTableString;
+
+	FString GetManifestDirectory()
+	{
+		return FPaths::ProjectContentDir() / TEXT("OBNavigation/Manifests");
+	}
+}
+
+FString FOBNavigationManifestFormat::GetProjectManifestPath()
+{
+	return GetManifestDirectory() / TEXT("Project.obnav");
+}
+
+FString FOBNavigationManifestFormat::GetMapManifestPath(const FString& MapPackageName)
+{
+	// "/Game/Maps/Arena" -> "Maps/Game/Maps/Arena.obnav"
+	FString RelativePath = MapPackageName;
+	RelativePath.RemoveFromStart(TEXT("/"));
+	return GetManifestDirectory() / TEXT("Maps") / RelativePath + TEXT(".obnav");
+}
+
+void FOBLayerGrid::Build(const TConstArrayView<FBox> InLayerBounds)
+{
+	Reset();
+	check(InLayerBounds.Num() <= MAX_uint16);
+
+	// Layers with empty bounds never contain a point and are left out of the cells
+	FBox2D Union(ForceInit);
+	LayerBounds.Reserve(InLayerBounds.Num());
+	for (const FBox& Bounds : InLayerBounds)
+	{
+		const FBox2D& LayerBox = LayerBounds.Emplace_GetRef(FVector2D(Bounds.Min), FVector2D(Bounds.Max));
+		if (LayerBox.Min.X < LayerBox.Max.X && LayerBox.Min.Y < LayerBox.Max.Y)
+		{
+			Union += LayerBox;
+		}
+	}
+
+	CellStarts.Add(0);
+	if (!Union.bIsValid)
+	{
+		return;
+	}
+
+	const int32 CellsPerAxis = FMath::Clamp(LayerBounds.Num() * 4, 1, MaxCellsPerAxis);
+	const FVector2D Size = Union.GetSize();
+	NumCells = FIntPoint(CellsPerAxis);
+	Origin = Union.Min;
+	InvCellSize = FVector2D(CellsPerAxis / FMath::Max(Size.X, UE_KINDA_SMALL_NUMBER),
+	                        CellsPerAxis / FMath::Max(Size.Y, UE_KINDA_SMALL_NUMBER));
+
+	auto ForEachCell = [this](const FBox2D& Box, auto&& Func)
+	{
+		const FVector2D LocalMin = (Box.Min - Origin) * InvCellSize;
+		const FVector2D LocalMax = (Box.Max - Origin) * InvCellSize;
+		const int32 MinX = FMath::Clamp(FMath::FloorToInt32(LocalMin.X), 0, NumCells.X - 1);
+		const int32 MinY = FMath::Clamp(FMath::FloorToInt32(LocalMin.Y), 0, NumCells.Y - 1);
+		const int32 MaxX = FMath::Clamp(FMath::FloorToInt32(LocalMax.X), 0, NumCells.X - 1);
+		const int32 MaxY = FMath::Clamp(FMath::FloorToInt32(LocalMax.Y), 0, NumCells.Y - 1);
+		for (int32 Y = MinY; Y <= MaxY; ++Y)
+		{
+			for (int32 X = MinX; X <= MaxX; ++X)
+			{
+				Func(Y * NumCells.X + X);
+			}
+		}
+	};
+
+	// Count, then fill, so the layers of a cell are contiguous and keep their priority order
+	CellStarts.SetNumZeroed(NumCells.X * NumCells.Y + 1);
+	for (const FBox2D& Box : LayerBounds)
+	{
+		if (Box.Min.X < Box.Max.X && Box.Min.Y < Box.Max.Y)
+		{
+			ForEachCell(Box, [this](const int32 Cell) { ++CellStarts[Cell + 1]; });
+		}
+	}
+	for (int32 Cell = 1; Cell < CellStarts.Num(); ++Cell)
+	{
+		CellStarts[Cell] += CellStarts[Cell - 1];
+	}
+
+	CellLayers.SetNumUninitialized(static_cast<int32>(CellStarts.Last()));
+	TArray<uint32> Cursors(CellStarts);
+	for (int32 LayerIndex = 0; LayerIndex < LayerBounds.Num(); ++LayerIndex)
+	{
+		const FBox2D& Box = LayerBounds[LayerIndex];
+		if (Box.Min.X < Box.Max.X && Box.Min.Y < Box.Max.Y)
+		{
+			ForEachCell(Box, [this, &Cursors, LayerIndex](const int32 Cell)
+			{
+				CellLayers[Cursors[Cell]++] = static_cast<uint16>(LayerIndex);
+			});
+		}
+	}
+}
+
+void FOBLayerGrid::Reset()
+{
+	LayerBounds.Reset();
+	Origin = FVector2D::ZeroVector;
+	InvCellSize = FVector2D::ZeroVector;
+	NumCells = FIntPoint::ZeroValue;
+	CellStarts.Reset();
+	CellLayers.Reset();
+}
+
+int32 FOBLayerGrid::FindLayer(const FVector& WorldLocation) const
+{
+	const FVector2D Location(WorldLocation);
+	const FVector2D Local = (Location - Origin) * InvCellSize;
+	if (Local.X < 0.0 || Local.Y < 0.0 || Local.X >= NumCells.X || Local.Y >= NumCells.Y)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 Cell = FMath::FloorToInt32(Local.Y) * NumCells.X + FMath::FloorToInt32(Local.X);
+	for (uint32 Entry = CellStarts[Cell]; Entry < CellStarts[Cell + 1]; ++Entry)
+	{
+		// Same strict test as FBox::IsInsideXY
+		if (LayerBounds[CellLayers[Entry]].IsInside(Location))
+		{
+			return CellLayers[Entry];
+		}
+	}
+	return INDEX_NONE;
+}
+
+void FOBLayerGrid::Write(FArchive& Ar) const
+{
+	uint16 NumLayers = static_cast<uint16>(LayerBounds.Num());
+	Ar << NumLayers;
+	for (const FBox2D& Box : LayerBounds)
+	{
+		double MinX = Box.Min.X, MinY = Box.Min.Y, MaxX = Box.Max.X, MaxY = Box.Max.Y;
+		Ar << MinX << MinY << MaxX << MaxY;
+	}
+
+	double OriginX = Origin.X, OriginY = Origin.Y;
+	double InvCellSizeX = InvCellSize.X, InvCellSizeY = InvCellSize.Y;
+	int32 NumCellsX = NumCells.X, NumCellsY = NumCells.Y;
+	uint32 NumEntries = static_cast<uint32>(CellLayers.Num());
+	Ar << OriginX << OriginY << InvCellSizeX << InvCellSizeY << NumCellsX << NumCellsY << NumEntries;
+
+	for (uint32 Start : CellStarts)
+	{
+		Ar << Start;
+	}
+	for (uint16 LayerIndex : CellLayers)
+	{
+		Ar << LayerIndex;
+	}
+}
+
+bool FOBLayerGrid::Read(FArchive& Ar)
+{
+	Reset();
+
+	uint16 NumLayers = 0;
+	Ar << NumLayers;
+	LayerBounds.Reserve(NumLayers);
+	for (int32 Index = 0; Index < NumLayers && !Ar.IsError(); ++Index)
+	{
+		double MinX = 0.0, MinY = 0.0, MaxX = 0.0, MaxY = 0.0;
+		Ar << MinX << MinY << MaxX << MaxY;
+		LayerBounds.Emplace(FVector2D(MinX, MinY), FVector2D(MaxX, MaxY));
+	}
+
+	double OriginX = 0.0, OriginY = 0.0, InvCellSizeX = 0.0, InvCellSizeY = 0.0;
+	int32 NumCellsX = 0, NumCellsY = 0;
+	uint32 NumEntries = 0;
+	Ar << OriginX << OriginY << InvCellSizeX << InvCellSizeY << NumCellsX << NumCellsY << NumEntries;
+
+	// Bound every count by the bytes left before allocating anything
+	const int64 NumStarts = static_cast<int64>(NumCellsX) * NumCellsY + 1;
+	const int64 NumCellBytes = NumStarts * static_cast<int64>(sizeof(uint32)) +
+		static_cast<int64>(NumEntries) * static_cast<int64>(sizeof(uint16));
+	if (Ar.IsError() || NumCellsX < 0 || NumCellsX > MaxCellsPerAxis || NumCellsY < 0 || NumCellsY > MaxCellsPerAxis ||
+		(NumCellsX == 0) != (NumCellsY == 0) ||
+		NumCellBytes > Ar.TotalSize() - Ar.Tell())
+	{
+		Reset();
+		return false;
+	}
+
+	Origin = FVector2D(OriginX, OriginY);
+	InvCellSize = FVector2D(InvCellSizeX, InvCellSizeY);
+	NumCells = FIntPoint(NumCellsX, NumCellsY);
+
+	CellStarts.SetNumUninitialized(static_cast<int32>(NumStarts));
+	for (uint32& Start : CellStarts)
+	{
+		Ar << Start;
+	}
+	CellLayers.SetNumUninitialized(static_cast<int32>(NumEntries));
+	for (uint16& LayerIndex : CellLayers)
+	{
+		Ar << LayerIndex;
+	}
+
+	bool bValid = !Ar.IsError() && CellStarts[0] == 0 && CellStarts.Last() == NumEntries;
+	for (int32 Cell = 1; bValid && Cell < CellStarts.Num(); ++Cell)
+	{
+		bValid = CellStarts[Cell - 1] <= CellStarts[Cell];
+	}
+	for (int32 Entry = 0; bValid && Entry < CellLayers.Num(); ++Entry)
+	{
+		bValid = CellLayers[Entry] < NumLayers;
+	}
+
+	if (!bValid)
+	{
+		Reset();
+	}
+	return bValid;
+}
+
+void FOBNavigationManifestWriter::AddLayer(const FSoftObjectPath& LayerPath, const FBox& WorldBounds,
+                                           const int32 Priority)
+{
+	Layers.Add({LayerPath, WorldBounds, Priority});
+}
+
+void FOBNavigationManifestWriter::AddMarkerConfig(const FSoftObjectPath& ConfigPath)
+{
+	MarkerConfigs.Add(ConfigPath);
+}
+
+void FOBNavigationManifestWriter::SetStaticMarkers(TArray<uint8>&& InMarkerData)
+{
+	StaticMarkerData = MoveTemp(InMarkerData);
+}
+
+void FOBNavigationManifestWriter::Write(TArray<uint8>& OutData) const
+{
+	OutData.Reset();
+	OutData.Reserve(1024 + StaticMarkerData.Num());
+	FMemoryWriter Ar(OutData);
+
+	// Highest priority first, the order UOBNavigationSubsystem::FindBestLayerForLocation searches in
+	TArray<FPendingLayer> SortedLayers = Layers;
+	SortedLayers.StableSort([](const FPendingLayer& A, const FPendingLayer& B)
+	{
+		return A.Priority > B.Priority;
+	});
+
+	uint32 MagicValue = FOBNavigationManifestFormat::Magic;
+	uint16 VersionValue = FOBNavigationManifestFormat::Version;
+	uint16 NumLayers = static_cast<uint16>(FMath::Min(SortedLayers.Num(), static_cast<int32>(MAX_uint16)));
+	uint32 NumConfigs = static_cast<uint32>(MarkerConfigs.Num());
+	uint32 StaticMarkerSize = static_cast<uint32>(StaticMarkerData.Num());
+	Ar << MagicValue << VersionValue << NumLayers << NumConfigs << StaticMarkerSize;
+
+	TArray<FBox> LayerBounds;
+	LayerBounds.Reserve(NumLayers);
+	for (int32 Index = 0; Index < NumLayers; ++Index)
+	{
+		const FPendingLayer& Layer = SortedLayers[Index];
+		int32 Priority = Layer.Priority;
+		WriteTableString(Ar, Layer.Path.ToString());
+		Ar << Priority;
+		LayerBounds.Add(Layer.WorldBounds);
+	}
+
+	FOBLayerGrid LayerGrid;
+	LayerGrid.Build(LayerBounds);
+	LayerGrid.Write(Ar);
+
+	for (const FSoftObjectPath& ConfigPath : MarkerConfigs)
+	{
+		WriteTableString(Ar, ConfigPath.ToString());
+	}
+
+	Ar.Serialize(const_cast<uint8*>(StaticMarkerData.GetData()), StaticMarkerData.Num());
+}
+
+bool FOBNavigationManifestReader::VisitFile(const FString& FilePath,
+                                            const TFunctionRef<void(TArrayView<const uint8>)> Visitor)
+{
+	// Prefer mapping the file so the tables are decoded straight from the page cache
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (const TUniquePtr<IMappedFileHandle> MappedFile(PlatformFile.OpenMapped(*FilePath)); MappedFile)
+	{
+		if (const TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile->MapRegion()); MappedRegion)
+		{
+			Visitor(TArrayView<const uint8>(MappedRegion->GetMappedPtr(), static_cast<int32>(MappedRegion->GetMappedSize())));
+			return true;
+		}
+	}
+
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *FilePath, FILEREAD_Silent))
+	{
+		return false;
+	}
+	Visitor(Data);
+	return true;
+}
+
+bool FOBNavigationManifestReader::Open(const TArrayView<const uint8> InData)
+{
+	LayerPaths.Reset();
+	LayerPriorities.Reset();
+	LayerGrid.Reset();
+	MarkerConfigPaths.Reset();
+	StaticMarkerData = TArrayView<const uint8>();
+
+	FMemoryReaderView Ar(InData);
+
+	uint32 MagicValue = 0;
+	uint16 VersionValue = 0;
+	uint16 NumLayers = 0;
+	uint32 NumConfigs = 0;
+	uint32 StaticMarkerSize = 0;
+	Ar << MagicValue << VersionValue << NumLayers << NumConfigs << StaticMarkerSize;
+
+	// Every config takes at least its length prefix, which bounds the table before reserving it
+	if (Ar.IsError() || MagicValue != FOBNavigationManifestFormat::Magic ||
+		VersionValue != FOBNavigationManifestFormat::Version ||
+		static_cast<int64>(NumConfigs) * static_cast<int64>(sizeof(uint16)) > InData.Num())
+	{
+		return false;
+	}
+
+	FString Entry;
+	LayerPaths.Reserve(NumLayers);
+	LayerPriorities.Reserve(NumLayers);
+	for (int32 Index = 0; Index < NumLayers; ++Index)
+	{
+		int32 Priority = 0;
+		if (!ReadTableString(Ar, InData, Entry))
+		{
+			return false;
+		}
+		Ar << Priority;
+		LayerPaths.Emplace(Entry);
+		LayerPriorities.Add(Priority);
+	}
+
+	if (!LayerGrid.Read(Ar) || LayerGrid.GetNumLayers() != NumLayers)
+	{
+		return false;
+	}
+
+	MarkerConfigPaths.Reserve(NumConfigs);
+	for (uint32 Index = 0; Index < NumConfigs; ++Index)
+	{
+		if (!ReadTableString(Ar, InData, Entry))
+		{
+			return false;
+		}
+		MarkerConfigPaths.Emplace(Entry);
+	}
+
+	if (Ar.IsError() || Ar.Tell() + StaticMarkerSize > InData.Num())
+	{
+		return false;
+	}
+
+	StaticMarkerData = InData.Slice(static_cast<int32>(Ar.Tell()), static_cast<int32>(StaticMarkerSize));
+	return true;
+}
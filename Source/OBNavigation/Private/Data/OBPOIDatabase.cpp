@@ -0,0 +1,506 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Data/OBPOIDatabase.h"
+
+#include "OBNavigation.h"
+#include "Data/OBTableStringSerialization.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Crc.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	using OBNavigation::Serialization::ReadTableString;
+	using OBNavigation::Serialization::WriteTableString;
+
+	// Magic, version and header size: enough to know how much to read before the records
+	constexpr int32 PrefixSize = sizeof(uint32) + sizeof(uint16) + sizeof(uint32);
+	constexpr int32 HeaderSizeOffset = sizeof(uint32) + sizeof(uint16);
+	constexpr int32 ContentHashOffset = PrefixSize + sizeof(uint32);
+
+	constexpr int32 IDEntrySize = sizeof(FGuid) + sizeof(uint32);
+	constexpr int32 RecordAlignment = 16;
+
+	// Guards against absurd allocations when decoding a corrupt header
+	constexpr uint32 MaxHeaderSize = 64 * 1024 * 1024;
+}
+
+FString FOBPOIDatabaseFormat::GetMapDatabasePath(const FString& MapPackageName)
+{
+	// "/Game/Maps/Arena" -> "Maps/Game/Maps/Arena.obpoi"
+	FString RelativePath = MapPackageName;
+	RelativePath.RemoveFromStart(TEXT("/"));
+	return FPaths::ProjectContentDir() / TEXT("OBNavigation/Manifests/Maps") / RelativePath + TEXT(".obpoi");
+}
+
+bool FOBPOIDatabaseWriter::AddPOI(const FGuid& ID, const FSoftObjectPath& ConfigPath, const FName LayerName,
+                                  const FVector& WorldLocation)
+{
+	// The ID table is searched by ID, so an ID must lead to exactly one POI
+	if (AddedIDs.Contains(ID))
+	{
+		return false;
+	}
+
+	const uint16* ConfigIndex = ConfigIndices.Find(ConfigPath);
+	if (!ConfigIndex)
+	{
+		if (ConfigPaths.Num() > MAX_uint16)
+		{
+			return false;
+		}
+		ConfigIndex = &ConfigIndices.Add(ConfigPath, static_cast<uint16>(ConfigPaths.Add(ConfigPath)));
+	}
+
+	const uint16* LayerIndex = LayerIndices.Find(LayerName);
+	if (!LayerIndex)
+	{
+		if (LayerNames.Num() > MAX_uint16)
+		{
+			return false;
+		}
+		LayerIndex = &LayerIndices.Add(LayerName, static_cast<uint16>(LayerNames.Add(LayerName)));
+	}
+
+	AddedIDs.Add(ID);
+	POIs.Add({ID, WorldLocation, *ConfigIndex, *LayerIndex});
+	return true;
+}
+
+void FOBPOIDatabaseWriter::Write(TArray<uint8>& OutData, double PageSize) const
+{
+	OutData.Reset();
+
+	FBox2D Bounds(ForceInit);
+	for (const FPendingPOI& POI : POIs)
+	{
+		Bounds += FVector2D(POI.Location);
+	}
+	const FVector2D Origin = Bounds.bIsValid ? Bounds.Min : FVector2D::ZeroVector;
+	const FVector2D Extent = Bounds.bIsValid ? Bounds.GetSize() : FVector2D::ZeroVector;
+
+	// A POI on the max edge lands in the page after the extent, hence MaxPagesPerAxis - 1
+	constexpr double MaxPageSpan = FOBPOIDatabaseFormat::MaxPagesPerAxis - 1;
+	PageSize = FMath::Max3(FMath::Max(PageSize, 1.0), Extent.X / MaxPageSpan, Extent.Y / MaxPageSpan);
+	int32 NumPagesX = FMath::Clamp(FMath::FloorToInt32(Extent.X / PageSize) + 1, 1, FOBPOIDatabaseFormat::MaxPagesPerAxis);
+	int32 NumPagesY = FMath::Clamp(FMath::FloorToInt32(Extent.Y / PageSize) + 1, 1, FOBPOIDatabaseFormat::MaxPagesPerAxis);
+
+	// Records are grouped by page, so a page is one contiguous range of the file
+	TArray<int32> PageOfPOI;
+	TArray<uint32> PageCounts;
+	PageOfPOI.SetNumUninitialized(POIs.Num());
+	PageCounts.SetNumZeroed(NumPagesX * NumPagesY);
+	for (int32 Index = 0; Index < POIs.Num(); ++Index)
+	{
+		const FVector2D Local = (FVector2D(POIs[Index].Location) - Origin) / PageSize;
+		const int32 PageX = FMath::Clamp(FMath::FloorToInt32(Local.X), 0, NumPagesX - 1);
+		const int32 PageY = FMath::Clamp(FMath::FloorToInt32(Local.Y), 0, NumPagesY - 1);
+		PageOfPOI[Index] = PageY * NumPagesX + PageX;
+		++PageCounts[PageOfPOI[Index]];
+	}
+
+	TArray<int32> Order;
+	Order.SetNumUninitialized(POIs.Num());
+	for (int32 Index = 0; Index < Order.Num(); ++Index)
+	{
+		Order[Index] = Index;
+	}
+	Order.StableSort([&PageOfPOI](const int32 A, const int32 B)
+	{
+		return PageOfPOI[A] < PageOfPOI[B];
+	});
+
+	FMemoryWriter Ar(OutData);
+
+	uint32 MagicValue = FOBPOIDatabaseFormat::Magic;
+	uint16 VersionValue = FOBPOIDatabaseFormat::Version;
+	uint32 HeaderSize = 0; // Patched once the tables are written
+	uint32 NumPOIs = static_cast<uint32>(POIs.Num());
+	uint32 ContentHash = 0; // Patched once the records and IDs are written
+	double OriginX = Origin.X, OriginY = Origin.Y;
+	uint16 NumConfigs = static_cast<uint16>(ConfigPaths.Num());
+	uint16 NumLayers = static_cast<uint16>(LayerNames.Num());
+	Ar << MagicValue << VersionValue << HeaderSize << NumPOIs << ContentHash << OriginX << OriginY << PageSize
+		<< NumPagesX << NumPagesY << NumConfigs << NumLayers;
+
+	for (const FSoftObjectPath& ConfigPath : ConfigPaths)
+	{
+		WriteTableString(Ar, ConfigPath.ToString());
+	}
+	for (const FName LayerName : LayerNames)
+	{
+		WriteTableString(Ar, LayerName.ToString());
+	}
+
+	uint32 FirstPOI = 0;
+	for (uint32 Count : PageCounts)
+	{
+		Ar << FirstPOI << Count;
+		FirstPOI += Count;
+	}
+
+	// Aligned so mapped records can be read in place
+	OutData.SetNumZeroed(Align(OutData.Num(), RecordAlignment));
+	HeaderSize = static_cast<uint32>(OutData.Num());
+	FMemory::Memcpy(OutData.GetData() + HeaderSizeOffset, &HeaderSize, sizeof(HeaderSize));
+
+	OutData.Reserve(OutData.Num() + POIs.Num() * (sizeof(FOBPOIRecord) + IDEntrySize));
+	for (const int32 Index : Order)
+	{
+		const FPendingPOI& POI = POIs[Index];
+		FOBPOIRecord Record;
+		Record.X = static_cast<float>(POI.Location.X);
+		Record.Y = static_cast<float>(POI.Location.Y);
+		Record.Z = static_cast<float>(POI.Location.Z);
+		Record.ConfigIndex = POI.ConfigIndex;
+		Record.LayerIndex = POI.LayerIndex;
+		OutData.Append(reinterpret_cast<const uint8*>(&Record), sizeof(Record));
+	}
+
+	// The ID table maps IDs to the database order, not to the order POIs were added in
+	TArray<TPair<FGuid, uint32>> IDs;
+	IDs.Reserve(Order.Num());
+	for (int32 DatabaseIndex = 0; DatabaseIndex < Order.Num(); ++DatabaseIndex)
+	{
+		IDs.Emplace(POIs[Order[DatabaseIndex]].ID, static_cast<uint32>(DatabaseIndex));
+	}
+	IDs.Sort([](const TPair<FGuid, uint32>& A, const TPair<FGuid, uint32>& B)
+	{
+		return A.Key < B.Key;
+	});
+	for (const TPair<FGuid, uint32>& ID : IDs)
+	{
+		OutData.Append(reinterpret_cast<const uint8*>(&ID.Key), sizeof(FGuid));
+		OutData.Append(reinterpret_cast<const uint8*>(&ID.Value), sizeof(uint32));
+	}
+
+	ContentHash = FCrc::MemCrc32(OutData.GetData() + HeaderSize, OutData.Num() - static_cast<int32>(HeaderSize));
+	FMemory::Memcpy(OutData.GetData() + ContentHashOffset, &ContentHash, sizeof(ContentHash));
+}
+
+FOBPOIDatabase::~FOBPOIDatabase()
+{
+	Close();
+}
+
+bool FOBPOIDatabase::Open(const FString& InFilePath)
+{
+	Close();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	TUniquePtr<IFileHandle> Handle(PlatformFile.OpenRead(*InFilePath));
+	if (!Handle)
+	{
+		return false;
+	}
+
+	// Only the header is read; the records stay on disk until their page is needed
+	uint8 Prefix[PrefixSize];
+	uint32 MagicValue = 0;
+	uint16 VersionValue = 0;
+	uint32 HeaderSize = 0;
+	const int64 FileSize = Handle->Size();
+	if (!Handle->Read(Prefix, PrefixSize))
+	{
+		return false;
+	}
+	FMemory::Memcpy(&MagicValue, Prefix, sizeof(MagicValue));
+	FMemory::Memcpy(&VersionValue, Prefix + sizeof(MagicValue), sizeof(VersionValue));
+	FMemory::Memcpy(&HeaderSize, Prefix + HeaderSizeOffset, sizeof(HeaderSize));
+	if (MagicValue != FOBPOIDatabaseFormat::Magic || VersionValue != FOBPOIDatabaseFormat::Version ||
+		HeaderSize < PrefixSize || HeaderSize > MaxHeaderSize || HeaderSize > FileSize || HeaderSize % RecordAlignment != 0)
+	{
+		return false;
+	}
+
+	TArray<uint8> Header;
+	Header.SetNumUninitialized(static_cast<int32>(HeaderSize));
+	if (!Handle->Seek(0) || !Handle->Read(Header.GetData(), HeaderSize))
+	{
+		return false;
+	}
+
+	FMemoryReaderView Ar(Header);
+	Ar.Seek(PrefixSize);
+
+	double OriginX = 0.0, OriginY = 0.0, PageSize = 0.0;
+	int32 NumPagesX = 0, NumPagesY = 0;
+	uint16 NumConfigs = 0, NumLayers = 0;
+	Ar << NumPOIs << ContentHash << OriginX << OriginY << PageSize << NumPagesX << NumPagesY << NumConfigs << NumLayers;
+
+	const int64 IDTableOffset = HeaderSize + static_cast<int64>(NumPOIs) * static_cast<int64>(sizeof(FOBPOIRecord));
+	const int64 IDTableSize = static_cast<int64>(NumPOIs) * IDEntrySize;
+	if (Ar.IsError() || !(PageSize > 0.0) || NumPagesX < 1 || NumPagesX > FOBPOIDatabaseFormat::MaxPagesPerAxis ||
+		NumPagesY < 1 || NumPagesY > FOBPOIDatabaseFormat::MaxPagesPerAxis || IDTableOffset + IDTableSize > FileSize)
+	{
+		Close();
+		return false;
+	}
+
+	FString Entry;
+	ConfigPaths.Reserve(NumConfigs);
+	for (int32 Index = 0; Index < NumConfigs; ++Index)
+	{
+		if (!ReadTableString(Ar, Header, Entry))
+		{
+			Close();
+			return false;
+		}
+		ConfigPaths.Emplace(Entry);
+	}
+	LayerNames.Reserve(NumLayers);
+	for (int32 Index = 0; Index < NumLayers; ++Index)
+	{
+		if (!ReadTableString(Ar, Header, Entry))
+		{
+			Close();
+			return false;
+		}
+		LayerNames.Emplace(*Entry);
+	}
+
+	// Pages must tile the records exactly, in order
+	Pages.SetNumUninitialized(NumPagesX * NumPagesY);
+	uint32 ExpectedFirstPOI = 0;
+	bool bValid = true;
+	for (FPageEntry& Page : Pages)
+	{
+		Ar << Page.FirstPOI << Page.NumPOIs;
+		bValid &= Page.FirstPOI == ExpectedFirstPOI && Page.NumPOIs <= NumPOIs - ExpectedFirstPOI;
+		ExpectedFirstPOI += bValid ? Page.NumPOIs : 0;
+	}
+	if (!bValid || Ar.IsError() || ExpectedFirstPOI != NumPOIs)
+	{
+		Close();
+		return false;
+	}
+
+	Origin = FVector2D(OriginX, OriginY);
+	InvPageSize = 1.0 / PageSize;
+	NumPages = FIntPoint(NumPagesX, NumPagesY);
+	RecordsOffset = HeaderSize;
+	UnreadablePages.Init(false, Pages.Num());
+	FilePath = InFilePath;
+
+	// Prefer mapping, so a resident page costs address space rather than memory the OS cannot reclaim
+	if (TUniquePtr<IMappedFileHandle> Mapped(PlatformFile.OpenMapped(*InFilePath)); Mapped)
+	{
+		if (IDTableSize > 0)
+		{
+			IDRegion.Reset(Mapped->MapRegion(IDTableOffset, IDTableSize));
+		}
+		if (IDRegion || IDTableSize == 0)
+		{
+			IDTable = IDRegion ? TArrayView<const uint8>(IDRegion->GetMappedPtr(), static_cast<int32>(IDTableSize))
+				          : TArrayView<const uint8>();
+			MappedFile = MoveTemp(Mapped);
+			return true;
+		}
+	}
+
+	IDData.SetNumUninitialized(static_cast<int32>(IDTableSize));
+	if (!Handle->Seek(IDTableOffset) || !Handle->Read(IDData.GetData(), IDTableSize))
+	{
+		Close();
+		return false;
+	}
+	IDTable = IDData;
+	FileHandle = MoveTemp(Handle);
+	return true;
+}
+
+void FOBPOIDatabase::Close()
+{
+	// Regions before the file they map
+	ResidentPages.Reset();
+	IDTable = TArrayView<const uint8>();
+	IDRegion.Reset();
+	IDData.Empty();
+	MappedFile.Reset();
+	FileHandle.Reset();
+	FilePath.Reset();
+
+	Origin = FVector2D::ZeroVector;
+	InvPageSize = 0.0;
+	NumPages = FIntPoint::ZeroValue;
+	RecordsOffset = 0;
+	NumPOIs = 0;
+	ContentHash = 0;
+	ConfigPaths.Reset();
+	LayerNames.Reset();
+	Pages.Reset();
+	UnreadablePages.Reset();
+}
+
+int32 FOBPOIDatabase::FindPOI(const FGuid& ID) const
+{
+	// Lower bound over the entries, ordered by FGuid
+	int32 Low = 0;
+	int32 High = static_cast<int32>(NumPOIs);
+	FGuid EntryID;
+	while (Low < High)
+	{
+		const int32 Mid = Low + (High - Low) / 2;
+		FMemory::Memcpy(&EntryID, IDTable.GetData() + Mid * IDEntrySize, sizeof(FGuid));
+		if (EntryID < ID)
+		{
+			Low = Mid + 1;
+		}
+		else
+		{
+			High = Mid;
+		}
+	}
+
+	if (Low < static_cast<int32>(NumPOIs))
+	{
+		FMemory::Memcpy(&EntryID, IDTable.GetData() + Low * IDEntrySize, sizeof(FGuid));
+		if (EntryID == ID)
+		{
+			uint32 Index = 0;
+			FMemory::Memcpy(&Index, IDTable.GetData() + Low * IDEntrySize + sizeof(FGuid), sizeof(Index));
+			return Index < NumPOIs ? static_cast<int32>(Index) : INDEX_NONE;
+		}
+	}
+	return INDEX_NONE;
+}
+
+int32 FOBPOIDatabase::UpdateResidentPages(const TConstArrayView<FBox2D> Regions, const int32 MaxResidentPages,
+                                          const int32 MaxPageLoads)
+{
+	if (!IsOpen())
+	{
+		return 0;
+	}
+
+	// Pages touched by this update are never evicted by it
+	const uint64 UseStamp = ++UseCounter;
+	int32 NumLoaded = 0;
+	for (const FBox2D& Region : Regions)
+	{
+		const FIntRect PageRect = GetPageRect(Region);
+		for (int32 PageY = PageRect.Min.Y; PageY < PageRect.Max.Y; ++PageY)
+		{
+			for (int32 PageX = PageRect.Min.X; PageX < PageRect.Max.X; ++PageX)
+			{
+				const int32 PageIndex = PageY * NumPages.X + PageX;
+				if (Pages[PageIndex].NumPOIs == 0 || UnreadablePages[PageIndex])
+				{
+					continue;
+				}
+
+				if (FResidentPage* Page = ResidentPages.Find(PageIndex))
+				{
+					Page->LastUsed = UseStamp;
+					continue;
+				}
+
+				if (NumLoaded >= MaxPageLoads ||
+					(ResidentPages.Num() >= MaxResidentPages && !EvictLeastRecentlyUsedPage(UseStamp)))
+				{
+					continue;
+				}
+
+				FResidentPage NewPage;
+				if (!LoadPage(PageIndex, NewPage))
+				{
+					UE_LOG(LogOBNavigation, Warning, TEXT("[%hs] - Page %d of POI database '%s' could not be read."),
+					       __FUNCTION__, PageIndex, *FilePath);
+					UnreadablePages[PageIndex] = true;
+					continue;
+				}
+
+				NewPage.LastUsed = UseStamp;
+				ResidentPages.Add(PageIndex, MoveTemp(NewPage));
+				++NumLoaded;
+			}
+		}
+	}
+
+	// The budget may have been lowered since the last update
+	while (ResidentPages.Num() > MaxResidentPages)
+	{
+		if (!EvictLeastRecentlyUsedPage(UseStamp))
+		{
+			break;
+		}
+	}
+
+	return NumLoaded;
+}
+
+FIntRect FOBPOIDatabase::GetPageRect(const FBox2D& Region) const
+{
+	if (!Region.bIsValid || Pages.IsEmpty())
+	{
+		return FIntRect();
+	}
+
+	// Clamped as doubles first: a region far outside the grid must not overflow the conversion
+	const FVector2D Min = (Region.Min - Origin) * InvPageSize;
+	const FVector2D Max = (Region.Max - Origin) * InvPageSize;
+	return FIntRect(FMath::FloorToInt32(FMath::Clamp(Min.X, 0.0, static_cast<double>(NumPages.X))),
+	                FMath::FloorToInt32(FMath::Clamp(Min.Y, 0.0, static_cast<double>(NumPages.Y))),
+	                FMath::FloorToInt32(FMath::Clamp(Max.X + 1.0, 0.0, static_cast<double>(NumPages.X))),
+	                FMath::FloorToInt32(FMath::Clamp(Max.Y + 1.0, 0.0, static_cast<double>(NumPages.Y))));
+}
+
+bool FOBPOIDatabase::LoadPage(const int32 PageIndex, FResidentPage& OutPage) const
+{
+	const FPageEntry& Entry = Pages[PageIndex];
+	const int64 Offset = RecordsOffset + static_cast<int64>(Entry.FirstPOI) * static_cast<int64>(sizeof(FOBPOIRecord));
+	const int64 Size = static_cast<int64>(Entry.NumPOIs) * static_cast<int64>(sizeof(FOBPOIRecord));
+
+	if (MappedFile)
+	{
+		OutPage.MappedRegion.Reset(MappedFile->MapRegion(Offset, Size));
+		if (!OutPage.MappedRegion)
+		{
+			return false;
+		}
+		OutPage.Records = reinterpret_cast<const FOBPOIRecord*>(OutPage.MappedRegion->GetMappedPtr());
+	}
+	else
+	{
+		OutPage.Data.SetNumUninitialized(static_cast<int32>(Size));
+		if (!FileHandle->Seek(Offset) || !FileHandle->Read(OutPage.Data.GetData(), Size))
+		{
+			return false;
+		}
+		OutPage.Records = reinterpret_cast<const FOBPOIRecord*>(OutPage.Data.GetData());
+	}
+
+	// Validated once per load, so the tables can be indexed without checks afterwards
+	for (uint32 Index = 0; Index < Entry.NumPOIs; ++Index)
+	{
+		if (OutPage.Records[Index].ConfigIndex >= ConfigPaths.Num() || OutPage.Records[Index].LayerIndex >= LayerNames.Num())
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FOBPOIDatabase::EvictLeastRecentlyUsedPage(const uint64 UseStamp)
+{
+	// A linear scan: the budget keeps a few hundred pages resident at most, and only a few are loaded per update
+	int32 OldestPage = INDEX_NONE;
+	uint64 OldestUse = UseStamp;
+	for (const TPair<int32, FResidentPage>& Pair : ResidentPages)
+	{
+		if (Pair.Value.LastUsed < OldestUse)
+		{
+			OldestPage = Pair.Key;
+			OldestUse = Pair.Value.LastUsed;
+		}
+	}
+
+	if (OldestPage == INDEX_NONE)
+	{
+		return false;
+	}
+	ResidentPages.Remove(OldestPage);
+	return true;
+}
@@ -0,0 +1,35 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/Archive.h"
+
+// String tables shared by the binary formats of the plugin (marker saves, navigation manifests, POI databases)
+namespace OBNavigation::Serialization
+{
+	// Writes a string as its UTF-8 length (uint16) followed by its UTF-8 bytes. Longer strings are truncated.
+	inline void WriteTableString(FArchive& Ar, const FString& String)
+	{
+		const FTCHARToUTF8 Converted(*String);
+		uint16 Length = static_cast<uint16>(FMath::Min(Converted.Length(), static_cast<int32>(MAX_uint16)));
+		Ar << Length;
+		Ar.Serialize(const_cast<ANSICHAR*>(Converted.Get()), Length);
+	}
+
+	// Reads a string written by WriteTableString from Ar, a reader over Data. Returns false if it runs past Data.
+	inline bool ReadTableString(FArchive& Ar, const TArrayView<const uint8>& Data, FString& OutString)
+	{
+		uint16 Length = 0;
+		Ar << Length;
+		if (Ar.IsError() || Ar.Tell() + Length > Data.Num())
+		{
+			return false;
+		}
+
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data.GetData() + Ar.Tell()), Length);
+		OutString = FString(Converted.Length(), Converted.Get());
+		Ar.Seek(Ar.Tell() + Length);
+		return true;
+	}
+}
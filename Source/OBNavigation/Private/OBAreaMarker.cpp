@@ -0,0 +1,113 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "OBAreaMarker.h"
+
+#include "OBPolylineUtils.h"
+
+FOBAreaMarker FOBAreaMarker::MakeCircle(const FVector2D& Center, const double Radius)
+{
+	FOBAreaMarker Area;
+	Area.Shape = EOBAreaShape::Circle;
+	Area.LocalOutline.Reserve(NumCircleSegments);
+	for (int32 Segment = 0; Segment < NumCircleSegments; ++Segment)
+	{
+		double Sin, Cos;
+		FMath::SinCos(&Sin, &Cos, UE_TWO_PI * Segment / NumCircleSegments);
+		Area.LocalOutline.Emplace(Cos, Sin);
+	}
+	Area.StartCenter = Area.TargetCenter = Center;
+	Area.StartScale = Area.TargetScale = Radius;
+	return Area;
+}
+
+FOBAreaMarker FOBAreaMarker::MakeRectangle(const FVector2D& Center, const FVector2D& HalfExtents, const double Yaw)
+{
+	FOBAreaMarker Area;
+	Area.Shape = EOBAreaShape::Rectangle;
+	for (const FVector2D& Corner : {FVector2D(-1.0, -1.0), FVector2D(1.0, -1.0), FVector2D(1.0, 1.0), FVector2D(-1.0, 1.0)})
+	{
+		Area.LocalOutline.Add((Corner * HalfExtents).GetRotated(Yaw));
+	}
+	Area.StartCenter = Area.TargetCenter = Center;
+	return Area;
+}
+
+FOBAreaMarker FOBAreaMarker::MakePolygon(const TConstArrayView<FVector2D> WorldPoints)
+{
+	FOBAreaMarker Area;
+	Area.Shape = EOBAreaShape::Polygon;
+	if (WorldPoints.Num() < 3)
+	{
+		return Area;
+	}
+
+	// Centered on the average of the points, so scaling shrinks the polygon towards its middle
+	FVector2D Center = FVector2D::ZeroVector;
+	for (const FVector2D& Point : WorldPoints)
+	{
+		Center += Point;
+	}
+	Center /= WorldPoints.Num();
+
+	Area.LocalOutline.Reserve(WorldPoints.Num());
+	for (const FVector2D& Point : WorldPoints)
+	{
+		Area.LocalOutline.Add(Point - Center);
+	}
+	if (!OBNavigation::Polyline::TriangulatePolygon(Area.LocalOutline, Area.TriangleIndices))
+	{
+		Area.LocalOutline.Reset();
+		Area.TriangleIndices.Reset();
+	}
+	Area.StartCenter = Area.TargetCenter = Center;
+	return Area;
+}
+
+void FOBAreaMarker::Evaluate(const double Time, FVector2D& OutCenter, double& OutScale) const
+{
+	const double Alpha = AnimationDuration > 0.0
+		                     ? FMath::Clamp((Time - AnimationStartTime) / AnimationDuration, 0.0, 1.0)
+		                     : 1.0;
+	OutCenter = FMath::Lerp(StartCenter, TargetCenter, Alpha);
+	OutScale = FMath::Lerp(StartScale, TargetScale, Alpha);
+}
+
+void FOBAreaMarker::Animate(const double Time, const FVector2D& InTargetCenter, const double InTargetScale,
+                            const double Duration)
+{
+	Evaluate(Time, StartCenter, StartScale);
+	TargetCenter = InTargetCenter;
+	TargetScale = InTargetScale;
+	AnimationStartTime = Time;
+	AnimationDuration = FMath::Max(Duration, 0.0);
+}
+
+bool FOBAreaMarker::IsInside(const FVector& WorldLocation, const double Time) const
+{
+	FVector2D Center;
+	double Scale;
+	Evaluate(Time, Center, Scale);
+	if (!IsValid() || Scale <= UE_SMALL_NUMBER)
+	{
+		return false;
+	}
+
+	const FVector2D Local = (FVector2D(WorldLocation) - Center) / Scale;
+	if (Shape == EOBAreaShape::Circle)
+	{
+		return Local.SizeSquared() <= 1.0;
+	}
+
+	// Even-odd crossing test, valid for any simple polygon
+	bool bInside = false;
+	for (int32 Index = 0, Previous = LocalOutline.Num() - 1; Index < LocalOutline.Num(); Previous = Index++)
+	{
+		const FVector2D& A = LocalOutline[Index];
+		const FVector2D& B = LocalOutline[Previous];
+		if ((A.Y > Local.Y) != (B.Y > Local.Y) && Local.X < A.X + (Local.Y - A.Y) * (B.X - A.X) / (B.Y - A.Y))
+		{
+			bInside = !bInside;
+		}
+	}
+	return bInside;
+}
@@ -0,0 +1,319 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "OBExplorationMask.h"
+
+#include "OBMapLayerAsset.h"
+#include "OBNavigation.h"
+#include "OBNavigationTextureUtils.h"
+#include "Engine/Texture2D.h"
+
+namespace
+{
+	// Bumped whenever the layout of the RLE data changes
+	constexpr uint8 ExplorationRLEVersion = 1;
+
+	void WriteVarUInt(TArray<uint8>& OutData, uint32 Value)
+	{
+		do
+		{
+			uint8 Byte = Value & 0x7F;
+			Value >>= 7;
+			if (Value != 0)
+			{
+				Byte |= 0x80;
+			}
+			OutData.Add(Byte);
+		}
+		while (Value != 0);
+	}
+
+	bool ReadVarUInt(const TArray<uint8>& InData, int32& InOutOffset, uint32& OutValue)
+	{
+		OutValue = 0;
+		for (int32 Shift = 0; Shift < 35; Shift += 7)
+		{
+			if (!InData.IsValidIndex(InOutOffset))
+			{
+				return false;
+			}
+			const uint8 Byte = InData[InOutOffset++];
+			OutValue |= static_cast<uint32>(Byte & 0x7F) << Shift;
+			if ((Byte & 0x80) == 0)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+void UOBExplorationMask::Init(const UOBMapLayerAsset* InLayer, const FBox& InWorldBounds)
+{
+	GridSize = FIntPoint::ZeroValue;
+	ExploredBits.Empty();
+	ExploredCount = 0;
+	bHasDirtyCells = false;
+
+	if (!InLayer)
+	{
+		return;
+	}
+
+	const FBox& Bounds = InWorldBounds;
+	BoundsMin = FVector2D(Bounds.Min.X, Bounds.Min.Y);
+	BoundsMax = FVector2D(Bounds.Max.X, Bounds.Max.Y);
+	const FVector2D WorldSize = BoundsMax - BoundsMin;
+	if (WorldSize.X <= UE_KINDA_SMALL_NUMBER || WorldSize.Y <= UE_KINDA_SMALL_NUMBER)
+	{
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - MapLayer '%s' has zero size on X or Y axis."), *GetName(),
+		       __FUNCTION__, *InLayer->GetName());
+		return;
+	}
+
+	// Columns follow world Y (map U), rows follow world X (map V)
+	const double RequestedCellSize = FMath::Max(InLayer->ExplorationCellSize, 1.0f);
+	GridSize.X = FMath::Clamp(FMath::CeilToInt32(WorldSize.Y / RequestedCellSize), 1, MaxGridSize);
+	GridSize.Y = FMath::Clamp(FMath::CeilToInt32(WorldSize.X / RequestedCellSize), 1, MaxGridSize);
+	CellSizeY = WorldSize.Y / GridSize.X;
+	CellSizeX = WorldSize.X / GridSize.Y;
+
+	ExploredBits.Init(false, GridSize.X * GridSize.Y);
+	MarkAllDirty();
+
+	// A texture from a previous initialization no longer matches the grid
+	MaskTexture = nullptr;
+}
+
+FIntPoint UOBExplorationMask::WorldToCell(const FVector& WorldLocation) const
+{
+	if (GridSize.X <= 0 || WorldLocation.X < BoundsMin.X || WorldLocation.X > BoundsMax.X ||
+		WorldLocation.Y < BoundsMin.Y || WorldLocation.Y > BoundsMax.Y)
+	{
+		return FIntPoint(INDEX_NONE, INDEX_NONE);
+	}
+
+	// North (+X) is the top row, matching UOBNavigationSubsystem::WorldToMapUV
+	const int32 Column = FMath::Clamp(FMath::FloorToInt32((WorldLocation.Y - BoundsMin.Y) / CellSizeY), 0, GridSize.X - 1);
+	const int32 Row = FMath::Clamp(FMath::FloorToInt32((BoundsMax.X - WorldLocation.X) / CellSizeX), 0, GridSize.Y - 1);
+	return FIntPoint(Column, Row);
+}
+
+FVector UOBExplorationMask::GetCellCenter(const FIntPoint& Cell) const
+{
+	return FVector(BoundsMax.X - (Cell.Y + 0.5) * CellSizeX, BoundsMin.Y + (Cell.X + 0.5) * CellSizeY, 0.0);
+}
+
+bool UOBExplorationMask::RevealCircle(const FVector& WorldLocation, const float Radius)
+{
+	if (GridSize.X <= 0)
+	{
+		return false;
+	}
+
+	const int32 MinColumn = FMath::Max(FMath::FloorToInt32((WorldLocation.Y - Radius - BoundsMin.Y) / CellSizeY), 0);
+	const int32 MaxColumn = FMath::Min(FMath::FloorToInt32((WorldLocation.Y + Radius - BoundsMin.Y) / CellSizeY),
+	                                   GridSize.X - 1);
+	const int32 MinRow = FMath::Max(FMath::FloorToInt32((BoundsMax.X - (WorldLocation.X + Radius)) / CellSizeX), 0);
+	const int32 MaxRow = FMath::Min(FMath::FloorToInt32((BoundsMax.X - (WorldLocation.X - Radius)) / CellSizeX),
+	                                GridSize.Y - 1);
+
+	bool bChanged = false;
+	const double RadiusSquared = FMath::Square(static_cast<double>(Radius));
+	for (int32 Row = MinRow; Row <= MaxRow; ++Row)
+	{
+		const double CellCenterX = BoundsMax.X - (Row + 0.5) * CellSizeX;
+		const double DeltaXSquared = FMath::Square(CellCenterX - WorldLocation.X);
+		if (DeltaXSquared > RadiusSquared)
+		{
+			continue;
+		}
+
+		for (int32 Column = MinColumn; Column <= MaxColumn; ++Column)
+		{
+			const double CellCenterY = BoundsMin.Y + (Column + 0.5) * CellSizeY;
+			if (DeltaXSquared + FMath::Square(CellCenterY - WorldLocation.Y) > RadiusSquared)
+			{
+				continue;
+			}
+
+			FBitReference Bit = ExploredBits[Row * GridSize.X + Column];
+			if (!Bit)
+			{
+				Bit = true;
+				++ExploredCount;
+				MarkDirty(FIntPoint(Column, Row));
+				bChanged = true;
+			}
+		}
+	}
+
+	// Always reveal the cell the revealer is standing in, even for radii smaller than half a cell
+	if (const FIntPoint Cell = WorldToCell(WorldLocation); Cell.X != INDEX_NONE)
+	{
+		FBitReference Bit = ExploredBits[Cell.Y * GridSize.X + Cell.X];
+		if (!Bit)
+		{
+			Bit = true;
+			++ExploredCount;
+			MarkDirty(Cell);
+			bChanged = true;
+		}
+	}
+
+	return bChanged;
+}
+
+bool UOBExplorationMask::IsExplored(const FVector& WorldLocation) const
+{
+	const FIntPoint Cell = WorldToCell(WorldLocation);
+	return Cell.X != INDEX_NONE && ExploredBits[Cell.Y * GridSize.X + Cell.X];
+}
+
+float UOBExplorationMask::GetExploredFraction() const
+{
+	const int32 NumCells = ExploredBits.Num();
+	return NumCells > 0 ? static_cast<float>(ExploredCount) / NumCells : 0.0f;
+}
+
+void UOBExplorationMask::ResetExploration()
+{
+	ExploredBits.Init(false, GridSize.X * GridSize.Y);
+	ExploredCount = 0;
+	MarkAllDirty();
+}
+
+UTexture2D* UOBExplorationMask::GetMaskTexture()
+{
+	if (!MaskTexture && GridSize.X > 0)
+	{
+		MaskTexture = OBNavigation::TextureUtils::CreateOverlayTexture(GridSize.X, GridSize.Y, PF_G8, true);
+		MarkAllDirty();
+		FlushTextureUpdates();
+	}
+	return MaskTexture;
+}
+
+void UOBExplorationMask::FlushTextureUpdates()
+{
+	if (!bHasDirtyCells || !MaskTexture)
+	{
+		return;
+	}
+
+	const FIntRect Region = DirtyRect;
+	OBNavigation::TextureUtils::UploadTextureRegion(MaskTexture, Region, sizeof(uint8),
+	                                                [this, &Region](uint8* RowData, const int32 Row)
+	                                                {
+		                                                const int32 RowStart = Row * GridSize.X;
+		                                                for (int32 Column = Region.Min.X; Column < Region.Max.X; ++Column)
+		                                                {
+			                                                *RowData++ = ExploredBits[RowStart + Column] ? 255 : 0;
+		                                                }
+	                                                });
+	bHasDirtyCells = false;
+}
+
+void UOBExplorationMask::SaveRLE(TArray<uint8>& OutData) const
+{
+	OutData.Reset();
+	OutData.Add(ExplorationRLEVersion);
+	WriteVarUInt(OutData, GridSize.X);
+	WriteVarUInt(OutData, GridSize.Y);
+
+	// Runs alternate unexplored / explored, always starting with an unexplored run (which may be empty).
+	// Walking only the set bits keeps this cheap for mostly unexplored maps.
+	int32 RunEnd = 0;
+	int32 ExploredRunStart = INDEX_NONE;
+	for (TConstSetBitIterator<> It(ExploredBits); It; ++It)
+	{
+		const int32 Index = It.GetIndex();
+		if (ExploredRunStart != INDEX_NONE && Index == RunEnd)
+		{
+			++RunEnd;
+			continue;
+		}
+
+		if (ExploredRunStart != INDEX_NONE)
+		{
+			WriteVarUInt(OutData, RunEnd - ExploredRunStart);
+		}
+		WriteVarUInt(OutData, Index - RunEnd);
+		ExploredRunStart = Index;
+		RunEnd = Index + 1;
+	}
+
+	if (ExploredRunStart != INDEX_NONE)
+	{
+		WriteVarUInt(OutData, RunEnd - ExploredRunStart);
+	}
+	// The trailing unexplored run is implied by the grid size
+}
+
+bool UOBExplorationMask::LoadRLE(const TArray<uint8>& InData)
+{
+	int32 Offset = 0;
+	uint32 SavedWidth = 0;
+	uint32 SavedHeight = 0;
+	if (InData.Num() < 1 || InData[Offset++] != ExplorationRLEVersion ||
+		!ReadVarUInt(InData, Offset, SavedWidth) || !ReadVarUInt(InData, Offset, SavedHeight))
+	{
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - Exploration data is corrupt or has an unknown version."),
+		       *GetName(), __FUNCTION__);
+		return false;
+	}
+
+	if (static_cast<int32>(SavedWidth) != GridSize.X || static_cast<int32>(SavedHeight) != GridSize.Y)
+	{
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - Exploration data grid %ux%u does not match layer grid %dx%d."),
+		       *GetName(), __FUNCTION__, SavedWidth, SavedHeight, GridSize.X, GridSize.Y);
+		return false;
+	}
+
+	const int32 NumCells = GridSize.X * GridSize.Y;
+	TBitArray<> LoadedBits(false, NumCells);
+	int32 LoadedCount = 0;
+	int32 Index = 0;
+	bool bExploredRun = false;
+	while (Offset < InData.Num())
+	{
+		uint32 RunLength = 0;
+		if (!ReadVarUInt(InData, Offset, RunLength) || Index + static_cast<int64>(RunLength) > NumCells)
+		{
+			UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - Exploration data is corrupt."), *GetName(), __FUNCTION__);
+			return false;
+		}
+
+		if (bExploredRun && RunLength > 0)
+		{
+			LoadedBits.SetRange(Index, RunLength, true);
+			LoadedCount += RunLength;
+		}
+		Index += RunLength;
+		bExploredRun = !bExploredRun;
+	}
+
+	ExploredBits = MoveTemp(LoadedBits);
+	ExploredCount = LoadedCount;
+	MarkAllDirty();
+	return true;
+}
+
+void UOBExplorationMask::MarkDirty(const FIntPoint& Cell)
+{
+	if (bHasDirtyCells)
+	{
+		DirtyRect.Min = DirtyRect.Min.ComponentMin(Cell);
+		DirtyRect.Max = DirtyRect.Max.ComponentMax(Cell + FIntPoint(1, 1));
+	}
+	else
+	{
+		DirtyRect = FIntRect(Cell, Cell + FIntPoint(1, 1));
+		bHasDirtyCells = true;
+	}
+}
+
+void UOBExplorationMask::MarkAllDirty()
+{
+	DirtyRect = FIntRect(FIntPoint::ZeroValue, GridSize);
+	bHasDirtyCells = GridSize.X > 0 && GridSize.Y > 0;
+}
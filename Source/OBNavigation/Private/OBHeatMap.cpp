@@ -0,0 +1,220 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "OBHeatMap.h"
+
+#include "OBMapLayerAsset.h"
+#include "OBNavigation.h"
+#include "OBNavigationTextureUtils.h"
+#include "Engine/Texture2D.h"
+
+namespace
+{
+	// Texels hold up to this many times the saturation, so heat that is still saturated after decaying for a whole
+	// half-life since the epoch is not clipped
+	constexpr float TextureHeadroom = 2.0f;
+
+	// Byte offset of each channel (R, G, B, A) in a PF_B8G8R8A8 texel
+	constexpr int32 ChannelByteOffsets[UOBHeatMap::NumChannels] = {2, 1, 0, 3};
+}
+
+void UOBHeatMap::Init(const UOBMapLayerAsset* InLayer, const FBox& InWorldBounds, const double InTime)
+{
+	GridSize = FIntPoint::ZeroValue;
+	NumTiles = FIntPoint::ZeroValue;
+	Heat.Empty();
+	DirtyTiles.Empty();
+	bHasDirtyTiles = false;
+	Epoch = InTime;
+
+	if (!InLayer)
+	{
+		return;
+	}
+
+	const FBox& Bounds = InWorldBounds;
+	BoundsMin = FVector2D(Bounds.Min.X, Bounds.Min.Y);
+	BoundsMax = FVector2D(Bounds.Max.X, Bounds.Max.Y);
+	const FVector2D WorldSize = BoundsMax - BoundsMin;
+	if (WorldSize.X <= UE_KINDA_SMALL_NUMBER || WorldSize.Y <= UE_KINDA_SMALL_NUMBER)
+	{
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - MapLayer '%s' has zero size on X or Y axis."), *GetName(),
+		       __FUNCTION__, *InLayer->GetName());
+		return;
+	}
+
+	// Columns follow world Y (map U), rows follow world X (map V)
+	const double RequestedCellSize = FMath::Max(InLayer->HeatMapCellSize, 1.0f);
+	GridSize.X = FMath::Clamp(FMath::CeilToInt32(WorldSize.Y / RequestedCellSize), 1, MaxGridSize);
+	GridSize.Y = FMath::Clamp(FMath::CeilToInt32(WorldSize.X / RequestedCellSize), 1, MaxGridSize);
+	CellSizeY = WorldSize.Y / GridSize.X;
+	CellSizeX = WorldSize.X / GridSize.Y;
+	NumTiles = FIntPoint(FMath::DivideAndRoundUp(GridSize.X, TileSize), FMath::DivideAndRoundUp(GridSize.Y, TileSize));
+
+	DecayRate = InLayer->HeatMapHalfLife > 0.0f ? UE_LN2 / InLayer->HeatMapHalfLife : 0.0;
+	Saturation = FMath::Max(InLayer->HeatMapSaturation, UE_KINDA_SMALL_NUMBER);
+
+	Heat.SetNumZeroed(GridSize.X * GridSize.Y * NumChannels);
+	DirtyTiles.Init(false, NumTiles.X * NumTiles.Y);
+	MarkAllDirty();
+
+	// A texture from a previous initialization no longer matches the grid
+	HeatTexture = nullptr;
+}
+
+int32 UOBHeatMap::AddEvents(const TConstArrayView<FOBHeatMapEvent> Events, const double InTime)
+{
+	if (GridSize.X <= 0 || Events.IsEmpty())
+	{
+		return 0;
+	}
+
+	// Keeps the scale-up of new events (and the texels) bounded. Time going backwards means a new world started.
+	double Decay = GetDecay(InTime);
+	if (Decay < 0.5 || InTime < Epoch)
+	{
+		Rebase(InTime);
+		Decay = 1.0;
+	}
+	const double EventScale = 1.0 / Decay;
+
+	int32 NumAdded = 0;
+	for (const FOBHeatMapEvent& Event : Events)
+	{
+		const FIntPoint Cell = WorldToCell(Event.Location);
+		if (Cell.X == INDEX_NONE || Event.Channel < 0 || Event.Channel >= NumChannels)
+		{
+			continue;
+		}
+
+		float& CellHeat = Heat[(Cell.Y * GridSize.X + Cell.X) * NumChannels + Event.Channel];
+		CellHeat = FMath::Max(CellHeat + static_cast<float>(Event.Weight * EventScale), 0.0f);
+		MarkDirty(Cell);
+		++NumAdded;
+	}
+	return NumAdded;
+}
+
+FIntPoint UOBHeatMap::WorldToCell(const FVector& WorldLocation) const
+{
+	if (GridSize.X <= 0 || WorldLocation.X < BoundsMin.X || WorldLocation.X > BoundsMax.X ||
+		WorldLocation.Y < BoundsMin.Y || WorldLocation.Y > BoundsMax.Y)
+	{
+		return FIntPoint(INDEX_NONE, INDEX_NONE);
+	}
+
+	// North (+X) is the top row, matching UOBNavigationSubsystem::WorldToMapUV
+	const int32 Column = FMath::Clamp(FMath::FloorToInt32((WorldLocation.Y - BoundsMin.Y) / CellSizeY), 0, GridSize.X - 1);
+	const int32 Row = FMath::Clamp(FMath::FloorToInt32((BoundsMax.X - WorldLocation.X) / CellSizeX), 0, GridSize.Y - 1);
+	return FIntPoint(Column, Row);
+}
+
+float UOBHeatMap::GetHeat(const FVector& WorldLocation, const int32 Channel, const double InTime) const
+{
+	const FIntPoint Cell = WorldToCell(WorldLocation);
+	if (Cell.X == INDEX_NONE || Channel < 0 || Channel >= NumChannels)
+	{
+		return 0.0f;
+	}
+	return Heat[(Cell.Y * GridSize.X + Cell.X) * NumChannels + Channel] * GetDecay(InTime);
+}
+
+void UOBHeatMap::ResetHeat()
+{
+	FMemory::Memzero(Heat.GetData(), Heat.Num() * Heat.GetTypeSize());
+	MarkAllDirty();
+}
+
+UTexture2D* UOBHeatMap::GetHeatTexture()
+{
+	if (!HeatTexture && GridSize.X > 0)
+	{
+		HeatTexture = OBNavigation::TextureUtils::CreateOverlayTexture(GridSize.X, GridSize.Y, PF_B8G8R8A8, true);
+		MarkAllDirty();
+		FlushTextureUpdates();
+	}
+	return HeatTexture;
+}
+
+float UOBHeatMap::GetTextureScale(const double InTime) const
+{
+	return TextureHeadroom * GetDecay(InTime);
+}
+
+void UOBHeatMap::FlushTextureUpdates()
+{
+	if (!bHasDirtyTiles || !HeatTexture)
+	{
+		return;
+	}
+
+	const float TexelScale = 255.0f / (TextureHeadroom * Saturation);
+	auto UploadRegion = [this, TexelScale](const FIntRect& Region)
+	{
+		auto FillRow = [this, &Region, TexelScale](uint8* RowData, const int32 Row)
+		{
+			const float* CellHeat = &Heat[(Row * GridSize.X + Region.Min.X) * NumChannels];
+			for (int32 Column = Region.Min.X; Column < Region.Max.X; ++Column)
+			{
+				for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+				{
+					RowData[ChannelByteOffsets[Channel]] = static_cast<uint8>(FMath::Min(*CellHeat++ * TexelScale + 0.5f,
+					                                                                     255.0f));
+				}
+				RowData += NumChannels;
+			}
+		};
+		OBNavigation::TextureUtils::UploadTextureRegion(HeatTexture, Region, NumChannels, FillRow);
+	};
+
+	// Horizontal runs of dirty tiles are uploaded as one region each
+	for (int32 TileRow = 0; TileRow < NumTiles.Y; ++TileRow)
+	{
+		int32 RunStart = INDEX_NONE;
+		for (int32 TileColumn = 0; TileColumn <= NumTiles.X; ++TileColumn)
+		{
+			const bool bDirty = TileColumn < NumTiles.X && DirtyTiles[TileRow * NumTiles.X + TileColumn];
+			if (bDirty && RunStart == INDEX_NONE)
+			{
+				RunStart = TileColumn;
+			}
+			else if (!bDirty && RunStart != INDEX_NONE)
+			{
+				const FIntPoint Min(RunStart * TileSize, TileRow * TileSize);
+				const FIntPoint Max = FIntPoint(TileColumn * TileSize, (TileRow + 1) * TileSize).ComponentMin(GridSize);
+				UploadRegion(FIntRect(Min, Max));
+				RunStart = INDEX_NONE;
+			}
+		}
+	}
+
+	DirtyTiles.SetRange(0, DirtyTiles.Num(), false);
+	bHasDirtyTiles = false;
+}
+
+double UOBHeatMap::GetDecay(const double InTime) const
+{
+	return DecayRate > 0.0 ? FMath::Exp(-DecayRate * FMath::Max(InTime - Epoch, 0.0)) : 1.0;
+}
+
+void UOBHeatMap::Rebase(const double InTime)
+{
+	const float Decay = static_cast<float>(GetDecay(InTime));
+	for (float& CellHeat : Heat)
+	{
+		CellHeat *= Decay;
+	}
+	Epoch = InTime;
+	MarkAllDirty();
+}
+
+void UOBHeatMap::MarkDirty(const FIntPoint& Cell)
+{
+	DirtyTiles[(Cell.Y / TileSize) * NumTiles.X + Cell.X / TileSize] = true;
+	bHasDirtyTiles = true;
+}
+
+void UOBHeatMap::MarkAllDirty()
+{
+	DirtyTiles.SetRange(0, DirtyTiles.Num(), true);
+	bHasDirtyTiles = DirtyTiles.Num() > 0;
+}
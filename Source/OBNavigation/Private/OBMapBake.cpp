@@ -0,0 +1,377 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "OBMapBake.h"
+
+#include "OBMapLayerAsset.h"
+#include "OBNavigation.h"
+#include "OBNavigationStats.h"
+#include "OBNavigationTextureUtils.h"
+#include "NavigationSystem.h"
+#include "CollisionQueryParams.h"
+#include "Engine/Level.h"
+#include "Engine/LevelBounds.h"
+#include "Engine/Texture2D.h"
+#include "Engine/World.h"
+#include "NavMesh/RecastNavMesh.h"
+
+namespace
+{
+	// Vertical range traced when the layer bounds are flat (authored bounds often leave Z at 0)
+	constexpr double DefaultHalfHeight = 500000.0;
+
+	// Brightness of a vertical surface relative to flat ground
+	constexpr float SteepShade = 0.55f;
+
+	const ARecastNavMesh* FindNavMesh(UWorld* World)
+	{
+		UNavigationSystemV1* NavSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+		return NavSystem ? Cast<ARecastNavMesh>(NavSystem->GetDefaultNavDataInstance(FNavigationSystem::DontCreate)) : nullptr;
+	}
+
+	/**
+	 * Calls Visit for every navmesh polygon of the tiles overlapping Box, with the polygon's vertices.
+	 * Detour polygons are convex, so callers may fan-triangulate them.
+	 */
+	template <typename VisitorType>
+	void ForEachNavMeshPoly(const ARecastNavMesh& NavMesh, const FBox& Box, VisitorType&& Visit)
+	{
+#if WITH_RECAST
+		TArray<FNavPoly> Polys;
+		TArray<FVector> Vertices;
+		const int32 NumTiles = NavMesh.GetNavMeshTilesCount();
+		for (int32 TileIndex = 0; TileIndex < NumTiles; ++TileIndex)
+		{
+			if (!NavMesh.GetNavMeshTileBounds(TileIndex).Intersect(Box))
+			{
+				continue;
+			}
+
+			Polys.Reset();
+			if (!NavMesh.GetPolysInTile(TileIndex, Polys))
+			{
+				continue;
+			}
+
+			for (const FNavPoly& Poly : Polys)
+			{
+				Vertices.Reset();
+				if (NavMesh.GetPolyVerts(Poly.Ref, Vertices) && Vertices.Num() >= 3)
+				{
+					Visit(Poly, Vertices);
+				}
+			}
+		}
+#endif
+	}
+
+	// Sets the bit of every pixel of the region whose center lies inside the triangle (pixel space, either winding).
+	void FillTriangle(FVector2D A, FVector2D B, FVector2D C, const FIntRect& Region, TBitArray<>& InOutBits)
+	{
+		auto Edge = [](const FVector2D& From, const FVector2D& To, const FVector2D& Point)
+		{
+			return (To.X - From.X) * (Point.Y - From.Y) - (To.Y - From.Y) * (Point.X - From.X);
+		};
+
+		const double Area = Edge(A, B, C);
+		if (FMath::Abs(Area) < UE_SMALL_NUMBER)
+		{
+			return;
+		}
+		if (Area < 0.0)
+		{
+			Swap(B, C);
+		}
+
+		const int32 MinColumn = FMath::Max(FMath::FloorToInt32(FMath::Min3(A.X, B.X, C.X)), Region.Min.X);
+		const int32 MaxColumn = FMath::Min(FMath::CeilToInt32(FMath::Max3(A.X, B.X, C.X)), Region.Max.X - 1);
+		const int32 MinRow = FMath::Max(FMath::FloorToInt32(FMath::Min3(A.Y, B.Y, C.Y)), Region.Min.Y);
+		const int32 MaxRow = FMath::Min(FMath::CeilToInt32(FMath::Max3(A.Y, B.Y, C.Y)), Region.Max.Y - 1);
+
+		const int32 RegionWidth = Region.Width();
+		for (int32 Row = MinRow; Row <= MaxRow; ++Row)
+		{
+			for (int32 Column = MinColumn; Column <= MaxColumn; ++Column)
+			{
+				const FVector2D Point(Column + 0.5, Row + 0.5);
+				if (Edge(A, B, Point) >= 0.0 && Edge(B, C, Point) >= 0.0 && Edge(C, A, Point) >= 0.0)
+				{
+					InOutBits[(Row - Region.Min.Y) * RegionWidth + (Column - Region.Min.X)] = true;
+				}
+			}
+		}
+	}
+}
+
+FBox UOBMapBake::ComputeFitBounds(UWorld* World, const float Padding)
+{
+	FBox Bounds(ForceInit);
+	if (!World)
+	{
+		return Bounds;
+	}
+
+	if (const ARecastNavMesh* NavMesh = FindNavMesh(World))
+	{
+		ForEachNavMeshPoly(*NavMesh, FBox(FVector(-UE_BIG_NUMBER), FVector(UE_BIG_NUMBER)),
+		                   [&Bounds](const FNavPoly&, const TArray<FVector>& Vertices)
+		                   {
+			                   for (const FVector& Vertex : Vertices)
+			                   {
+				                   Bounds += Vertex;
+			                   }
+		                   });
+	}
+
+	if (!Bounds.IsValid && World->PersistentLevel)
+	{
+		Bounds = ALevelBounds::CalculateLevelBounds(World->PersistentLevel);
+	}
+	return Bounds.IsValid ? Bounds.ExpandBy(Padding) : Bounds;
+}
+
+bool UOBMapBake::Bake(UWorld* InWorld, const UOBMapLayerAsset* InLayer, const FBox& InWorldBounds,
+                      const FOBMapBakeSettings& InSettings)
+{
+	OBNAV_SCOPE_CYCLE_COUNTER(STAT_OBNav_MapBake);
+	LLM_SCOPE_BYTAG(OBNavigation);
+
+	World = InWorld;
+	Settings = InSettings;
+	ImageSize = FIntPoint::ZeroValue;
+	Pixels.Empty();
+
+	if (!InWorld || !InLayer)
+	{
+		return false;
+	}
+
+	const FBox& Bounds = InWorldBounds;
+	BoundsMin = FVector2D(Bounds.Min.X, Bounds.Min.Y);
+	BoundsMax = FVector2D(Bounds.Max.X, Bounds.Max.Y);
+	const FVector2D WorldSize = BoundsMax - BoundsMin;
+	if (WorldSize.X <= UE_KINDA_SMALL_NUMBER || WorldSize.Y <= UE_KINDA_SMALL_NUMBER)
+	{
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - MapLayer '%s' has zero size on X or Y axis."), *GetName(),
+		       __FUNCTION__, *InLayer->GetName());
+		return false;
+	}
+
+	if (Bounds.Max.Z > Bounds.Min.Z)
+	{
+		MinZ = Bounds.Min.Z;
+		MaxZ = Bounds.Max.Z;
+	}
+	else
+	{
+		MinZ = -DefaultHalfHeight;
+		MaxZ = DefaultHalfHeight;
+	}
+
+	// Columns follow world Y (map U), rows follow world X (map V)
+	const int32 Resolution = FMath::Clamp(Settings.Resolution, 1, MaxImageSize);
+	const double LongestSide = FMath::Max(WorldSize.X, WorldSize.Y);
+	ImageSize.X = FMath::Clamp(FMath::RoundToInt32(Resolution * WorldSize.Y / LongestSide), 1, MaxImageSize);
+	ImageSize.Y = FMath::Clamp(FMath::RoundToInt32(Resolution * WorldSize.X / LongestSide), 1, MaxImageSize);
+	PixelSizeY = WorldSize.Y / ImageSize.X;
+	PixelSizeX = WorldSize.X / ImageSize.Y;
+
+	Pixels.SetNumUninitialized(ImageSize.X * ImageSize.Y);
+	Rasterize(FIntRect(FIntPoint::ZeroValue, ImageSize), /*bFitHeightRange*/ true);
+
+	// A texture from a previous bake no longer matches the image
+	Texture = nullptr;
+
+	UE_LOG(LogOBNavigation, Log, TEXT("[%s::%hs] - Baked MapLayer '%s' (%dx%d)."), *GetName(), __FUNCTION__,
+	       *InLayer->GetName(), ImageSize.X, ImageSize.Y);
+	return true;
+}
+
+void UOBMapBake::Patch(const FBox& DirtyBounds)
+{
+	const FIntRect Region = WorldBoxToRegion(DirtyBounds);
+	if (Region.IsEmpty() || !World.IsValid())
+	{
+		return;
+	}
+
+	OBNAV_SCOPE_CYCLE_COUNTER(STAT_OBNav_MapBake);
+	Rasterize(Region, /*bFitHeightRange*/ false);
+
+	// Nothing to upload if the texture has never been requested; it starts from the patched pixels
+	if (Texture)
+	{
+		UploadRegion(Region);
+	}
+}
+
+UTexture2D* UOBMapBake::GetTexture()
+{
+	if (!Texture && !Pixels.IsEmpty())
+	{
+		LLM_SCOPE_BYTAG(OBNavigation);
+
+		// FColor is laid out as BGRA in memory
+		Texture = OBNavigation::TextureUtils::CreateOverlayTexture(ImageSize.X, ImageSize.Y, PF_B8G8R8A8,
+		                                                           /*bBilinear*/ true, /*bSRGB*/ true);
+		UploadRegion(FIntRect(FIntPoint::ZeroValue, ImageSize));
+	}
+	return Texture;
+}
+
+void UOBMapBake::UploadRegion(const FIntRect& Region)
+{
+	const int32 RowBytes = Region.Width() * sizeof(FColor);
+	OBNavigation::TextureUtils::UploadTextureRegion(Texture, Region, sizeof(FColor),
+	                                                [this, &Region, RowBytes](uint8* RowData, const int32 Row)
+	                                                {
+		                                                FMemory::Memcpy(RowData, &Pixels[Row * ImageSize.X + Region.Min.X], RowBytes);
+	                                                });
+}
+
+void UOBMapBake::Rasterize(const FIntRect& Region, const bool bFitHeightRange)
+{
+	const int32 RegionWidth = Region.Width();
+	const int32 NumRegionPixels = RegionWidth * Region.Height();
+
+	SampleHeights.SetNumUninitialized(NumRegionPixels, /*bAllowShrinking*/ false);
+	SampleSlopes.SetNumUninitialized(NumRegionPixels, /*bAllowShrinking*/ false);
+	TraceHeights(Region, bFitHeightRange);
+
+	WalkableBits.Init(false, NumRegionPixels);
+	RasterizeNavMesh(Region);
+
+	const FLinearColor Low(Settings.LowColor);
+	const FLinearColor High(Settings.HighColor);
+	const FLinearColor Walkable(Settings.WalkableColor);
+	const double HeightRange = FMath::Max(HighHeight - LowHeight, 1.0);
+
+	for (int32 Row = Region.Min.Y; Row < Region.Max.Y; ++Row)
+	{
+		for (int32 Column = Region.Min.X; Column < Region.Max.X; ++Column)
+		{
+			const int32 SampleIndex = (Row - Region.Min.Y) * RegionWidth + (Column - Region.Min.X);
+			const bool bHasGround = SampleHeights[SampleIndex] != MAX_flt;
+			const bool bWalkable = WalkableBits[SampleIndex];
+
+			FColor& Pixel = Pixels[Row * ImageSize.X + Column];
+			if (!bHasGround && !bWalkable)
+			{
+				Pixel = Settings.EmptyColor;
+				continue;
+			}
+
+			FLinearColor Color = FLinearColor(Settings.EmptyColor);
+			if (bHasGround)
+			{
+				const float HeightAlpha = FMath::Clamp(
+					static_cast<float>((SampleHeights[SampleIndex] - LowHeight) / HeightRange), 0.0f, 1.0f);
+				Color = FMath::Lerp(Low, High, HeightAlpha) * FMath::Lerp(SteepShade, 1.0f, SampleSlopes[SampleIndex]);
+				Color.A = 1.0f;
+			}
+			if (bWalkable)
+			{
+				Color = FMath::Lerp(Color, Walkable, Walkable.A);
+				Color.A = FMath::Max(Color.A, Walkable.A);
+			}
+			Pixel = Color.ToFColor(/*bSRGB*/ true);
+		}
+	}
+}
+
+void UOBMapBake::TraceHeights(const FIntRect& Region, const bool bFitHeightRange)
+{
+	for (float& Height : SampleHeights)
+	{
+		Height = MAX_flt;
+	}
+
+	UWorld* BakeWorld = World.Get();
+	if (!Settings.bTraceHeight || !BakeWorld)
+	{
+		return;
+	}
+
+	const int32 RegionWidth = Region.Width();
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(OBNavMapBake), /*bTraceComplex*/ false);
+	double MinHit = TNumericLimits<double>::Max();
+	double MaxHit = TNumericLimits<double>::Lowest();
+
+	FHitResult Hit;
+	for (int32 Row = Region.Min.Y; Row < Region.Max.Y; ++Row)
+	{
+		for (int32 Column = Region.Min.X; Column < Region.Max.X; ++Column)
+		{
+			const FVector2D Center = GetPixelCenter(Column, Row);
+			if (!BakeWorld->LineTraceSingleByChannel(Hit, FVector(Center, MaxZ), FVector(Center, MinZ),
+			                                         Settings.TraceChannel, QueryParams))
+			{
+				continue;
+			}
+
+			const int32 SampleIndex = (Row - Region.Min.Y) * RegionWidth + (Column - Region.Min.X);
+			SampleHeights[SampleIndex] = static_cast<float>(Hit.ImpactPoint.Z);
+			SampleSlopes[SampleIndex] = FMath::Clamp(static_cast<float>(Hit.ImpactNormal.Z), 0.0f, 1.0f);
+			MinHit = FMath::Min(MinHit, Hit.ImpactPoint.Z);
+			MaxHit = FMath::Max(MaxHit, Hit.ImpactPoint.Z);
+		}
+	}
+
+	if (bFitHeightRange && MinHit <= MaxHit)
+	{
+		LowHeight = MinHit;
+		HighHeight = MaxHit;
+	}
+}
+
+void UOBMapBake::RasterizeNavMesh(const FIntRect& Region)
+{
+	const ARecastNavMesh* NavMesh = Settings.bDrawNavMesh ? FindNavMesh(World.Get()) : nullptr;
+	if (!NavMesh)
+	{
+		return;
+	}
+
+	const FBox RegionBox(
+		FVector(BoundsMax.X - Region.Max.Y * PixelSizeX, BoundsMin.Y + Region.Min.X * PixelSizeY, MinZ),
+		FVector(BoundsMax.X - Region.Min.Y * PixelSizeX, BoundsMin.Y + Region.Max.X * PixelSizeY, MaxZ));
+
+	ForEachNavMeshPoly(*NavMesh, RegionBox, [this, &Region](const FNavPoly& Poly, const TArray<FVector>& Vertices)
+	{
+		// Polygons of other floors share the tiles of a layered level
+		if (Poly.Center.Z < MinZ || Poly.Center.Z > MaxZ)
+		{
+			return;
+		}
+
+		const FVector2D First = WorldToPixel(Vertices[0]);
+		for (int32 Index = 1; Index + 1 < Vertices.Num(); ++Index)
+		{
+			FillTriangle(First, WorldToPixel(Vertices[Index]), WorldToPixel(Vertices[Index + 1]), Region, WalkableBits);
+		}
+	});
+}
+
+FIntRect UOBMapBake::WorldBoxToRegion(const FBox& WorldBox) const
+{
+	if (ImageSize.X <= 0 || !WorldBox.IsValid)
+	{
+		return FIntRect();
+	}
+
+	// North (+X) is the top row, matching UOBNavigationSubsystem::WorldToMapUV
+	const FIntPoint Min(FMath::Clamp(FMath::FloorToInt32((WorldBox.Min.Y - BoundsMin.Y) / PixelSizeY), 0, ImageSize.X),
+	                    FMath::Clamp(FMath::FloorToInt32((BoundsMax.X - WorldBox.Max.X) / PixelSizeX), 0, ImageSize.Y));
+	const FIntPoint Max(FMath::Clamp(FMath::CeilToInt32((WorldBox.Max.Y - BoundsMin.Y) / PixelSizeY), 0, ImageSize.X),
+	                    FMath::Clamp(FMath::CeilToInt32((BoundsMax.X - WorldBox.Min.X) / PixelSizeX), 0, ImageSize.Y));
+	return Min.X < Max.X && Min.Y < Max.Y ? FIntRect(Min, Max) : FIntRect();
+}
+
+FVector2D UOBMapBake::WorldToPixel(const FVector& WorldLocation) const
+{
+	return FVector2D((WorldLocation.Y - BoundsMin.Y) / PixelSizeY, (BoundsMax.X - WorldLocation.X) / PixelSizeX);
+}
+
+FVector2D UOBMapBake::GetPixelCenter(const int32 Column, const int32 Row) const
+{
+	return FVector2D(BoundsMax.X - (Row + 0.5) * PixelSizeX, BoundsMin.Y + (Column + 0.5) * PixelSizeY);
+}
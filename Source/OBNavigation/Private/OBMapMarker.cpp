@@ -5,7 +5,39 @@
 
 #include "OBMapMarker.h" // Make sure this include is at the top
 
-// ... other includes if you have them ...
+#include "Engine/Texture2D.h"
+#include "Materials/MaterialInterface.h"
+
+const FPrimaryAssetType UOBMarkerConfigAsset::PrimaryAssetType = TEXT("OBMarkerConfig");
+const FName UOBMarkerConfigAsset::IconBundleName = TEXT("Icons");
+
+FPrimaryAssetId UOBMarkerConfigAsset::GetPrimaryAssetId() const
+{
+	return FPrimaryAssetId(PrimaryAssetType, GetFName());
+}
+
+bool UOBMarkerConfigAsset::AreIconsLoaded() const
+{
+	return (IdentifierIconTexture.IsNull() || IdentifierIconTexture.IsValid()) &&
+		(IndicatorMaterial.IsNull() || IndicatorMaterial.IsValid()) &&
+		(Animation.Material.IsNull() || Animation.Material.IsValid());
+}
+
+void UOBMarkerConfigAsset::GetIconPaths(TArray<FSoftObjectPath>& OutPaths) const
+{
+	if (!IdentifierIconTexture.IsNull())
+	{
+		OutPaths.Add(IdentifierIconTexture.ToSoftObjectPath());
+	}
+	if (!IndicatorMaterial.IsNull())
+	{
+		OutPaths.Add(IndicatorMaterial.ToSoftObjectPath());
+	}
+	if (!Animation.Material.IsNull())
+	{
+		OutPaths.Add(Animation.Material.ToSoftObjectPath());
+	}
+}
 
 void UOBMapMarker::Init(const FGuid& InID, AActor* InTrackedActor, UOBMarkerConfigAsset* InConfig, FName InLayerName, FVector InStaticLocation)
 {
@@ -31,14 +63,121 @@ void UOBMapMarker::Init(const FGuid& InID, AActor* InTrackedActor, UOBMarkerConf
 	{
 		this->CurrentLifeTime = ConfigAsset->LifeTime;
 	}
+
+	StartAnimation(CurrentLifeTime);
+	ResetPositionSamples();
 }
 
 // You should also add the implementation for other functions declared in the header
-void UOBMapMarker::UpdateLocation()
+void UOBMapMarker::UpdateLocation(const double CurrentTime)
 {
+	const FOBMarkerDeadReckoning* DeadReckoning = GetDeadReckoning();
+
 	// If this marker is tracking a valid actor, update its WorldLocation
-	if (TrackedActor.IsValid())
+	if (const AActor* Actor = TrackedActor.Get())
+	{
+		const FVector ActorLocation = Actor->GetActorLocation();
+		if (!DeadReckoning)
+		{
+			WorldLocation = ActorLocation;
+			return;
+		}
+
+		// A replicated actor only moves when an update arrives, so every move is a new sample
+		if (!bHasPositionSample || ActorLocation != SampleLocation)
+		{
+			FVector Velocity = Actor->GetVelocity();
+			if (DeadReckoning->bDeriveVelocity)
+			{
+				const double SampleInterval = CurrentTime - MoveSampleTime;
+				Velocity = bHasPositionSample && SampleInterval > UE_KINDA_SMALL_NUMBER
+					           ? (ActorLocation - SampleLocation) / SampleInterval
+					           : FVector::ZeroVector;
+				MoveSampleInterval = bHasPositionSample ? SampleInterval : 0.0;
+			}
+			AddPositionSample(ActorLocation, Velocity, CurrentTime);
+			MoveSampleTime = CurrentTime;
+		}
+		else if (DeadReckoning->bDeriveVelocity && !SampleVelocity.IsZero() &&
+			CurrentTime - MoveSampleTime > MoveSampleInterval)
+		{
+			// No move within the usual sample interval: the actor stopped. Without this sample the marker would run on
+			// along the derived velocity for MaxExtrapolationTime; the overshoot is blended back onto the actor instead.
+			AddPositionSample(ActorLocation, FVector::ZeroVector, CurrentTime);
+		}
+	}
+
+	if (!DeadReckoning || !bHasPositionSample)
+	{
+		return;
+	}
+
+	WorldLocation = GetDeadReckonedLocation(*DeadReckoning, CurrentTime);
+}
+
+FVector UOBMapMarker::GetDeadReckonedLocation(const FOBMarkerDeadReckoning& DeadReckoning, const double Time) const
+{
+	// Extrapolation stops after MaxExtrapolationTime, so a source that went silent drifts by a bounded amount
+	const double Elapsed = FMath::Max(Time - SampleTime, 0.0);
+	const double ExtrapolationTime = FMath::Min(Elapsed, static_cast<double>(DeadReckoning.MaxExtrapolationTime));
+
+	// Exponential, with 5% of the error left after CorrectionTime. It has no start time to restart, so a new sample
+	// only adds its own error to what is left of the previous ones.
+	const double CorrectionWeight = DeadReckoning.CorrectionTime > 0.0f
+		                                ? FMath::Exp(-3.0 * Elapsed / DeadReckoning.CorrectionTime)
+		                                : 0.0;
+	return SampleLocation + SampleVelocity * ExtrapolationTime + CorrectionOffset * CorrectionWeight;
+}
+
+void UOBMapMarker::AddPositionSample(const FVector& InLocation, const FVector& InVelocity, const double InTime)
+{
+	const FOBMarkerDeadReckoning* DeadReckoning = GetDeadReckoning();
+
+	// The error is measured against where the marker is shown at the sample's time, so it never jumps when a sample
+	// disagrees with it. A tracked actor moving every frame yields a sample every frame; measuring against the stale
+	// WorldLocation and restarting the blend each time would hold the marker in place.
+	CorrectionOffset = FVector::ZeroVector;
+	if (DeadReckoning && bHasPositionSample)
 	{
-		WorldLocation = TrackedActor->GetActorLocation();
+		const FVector Error = GetDeadReckonedLocation(*DeadReckoning, InTime) - InLocation;
+		if (Error.SizeSquared() <= FMath::Square(DeadReckoning->SnapDistance))
+		{
+			CorrectionOffset = Error;
+		}
 	}
+
+	SampleLocation = InLocation;
+	SampleVelocity = DeadReckoning ? InVelocity : FVector::ZeroVector;
+	SampleTime = InTime;
+	bHasPositionSample = true;
+	WorldLocation = InLocation + CorrectionOffset;
+}
+
+void UOBMapMarker::ResetPositionSamples()
+{
+	SampleLocation = WorldLocation;
+	SampleVelocity = FVector::ZeroVector;
+	CorrectionOffset = FVector::ZeroVector;
+	SampleTime = 0.0;
+	MoveSampleTime = 0.0;
+	MoveSampleInterval = 0.0;
+	bHasPositionSample = false;
+}
+
+void UOBMapMarker::StartAnimation(const float InLifeTime)
+{
+	AnimationStartTime = GetAnimationTime();
+	SetAnimationLifeTime(InLifeTime);
+}
+
+void UOBMapMarker::SetAnimationLifeTime(const float InRemainingLifeTime)
+{
+	AnimationEndTime = InRemainingLifeTime > 0.0f ? GetAnimationTime() + InRemainingLifeTime : 0.0;
+	++AnimationSerial;
+}
+
+double UOBMapMarker::GetAnimationTime()
+{
+	// Same base as the time the Slate renderer passes to UI materials
+	return FPlatformTime::Seconds() - GStartTime;
 }
@@ -4,22 +4,48 @@
 #include "Components/Image.h"
 #include "Components/CanvasPanel.h"
 #include "Components/CanvasPanelSlot.h"
+#include "OBNavigation.h"
+#include "OBNavigationDebug.h"
+#include "OBNavigationStats.h"
 #include "OBNavigationSubsystem.h"
+#include "OBExplorationMask.h"
+#include "OBHeatMap.h"
 #include "OBMapLayerAsset.h"
+#include "OBPolylineUtils.h"
 #include "Data/OBMinimapConfigAsset.h"
+#include "Engine/Canvas.h"
+#include "Engine/Texture2D.h"
+#include "Fonts/FontMeasure.h"
+#include "Framework/Application/SlateApplication.h"
+#include "GameFramework/PlayerController.h"
 #include "Materials/MaterialInstanceDynamic.h"
+#include "Rendering/DrawElements.h"
+#include "Rendering/SlateRenderer.h"
+#include "Styling/CoreStyle.h"
+
+namespace
+{
+	// Widgets kept collapsed on the canvas for reuse; beyond this, released widgets are destroyed
+	constexpr int32 MaxFreeMarkerWidgets = 32;
+
+	// Number of sides of the polygon area fills are clipped against on a circular minimap
+	constexpr int32 NumAreaClipSegments = 64;
+
+	// Measured label strings kept; the cache starts over past this (e.g., for labels showing a changing distance)
+	constexpr int32 MaxCachedLabelSizes = 1024;
+}
 
 void UOBMinimapWidget::InitializeAndStartTracking(UOBMinimapConfigAsset* InConfigAsset)
 {
 	if (bIsInitializedAndTracking)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[%s::%hs] - Widget is already initialized."), *GetName(), __FUNCTION__);
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - Widget is already initialized."), *GetName(), __FUNCTION__);
 		return;
 	}
 
 	if (!InConfigAsset)
 	{
-		UE_LOG(LogTemp, Error, TEXT("[%s::%hs] - Initialization failed: Invalid ConfigAsset provided."), *GetName(),
+		UE_LOG(LogOBNavigation, Error, TEXT("[%s::%hs] - Initialization failed: Invalid ConfigAsset provided."), *GetName(),
 		       __FUNCTION__);
 		SetVisibility(ESlateVisibility::Collapsed);
 		return;
@@ -30,6 +56,10 @@ void UOBMinimapWidget::InitializeAndStartTracking(UOBMinimapConfigAsset* InConfi
 	// --- 1. COPY CONFIG VALUES TO INTERNAL STATE ---
 	CurrentMapRotationOffset = ConfigAsset->MapRotationOffset;
 	CurrentMinimapShape = ConfigAsset->MinimapShape;
+	LabelFont = ConfigAsset->LabelFont.HasValidFont()
+		            ? ConfigAsset->LabelFont
+		            : FCoreStyle::GetDefaultFontStyle("Regular", 10);
+	LabelSizeCache.Reset();
 
 	// --- 2. SETUP VISUAL ASSETS FROM CONFIG ---
 	if (MapImage && ConfigAsset->MinimapBackgroundMaterial)
@@ -39,7 +69,7 @@ void UOBMinimapWidget::InitializeAndStartTracking(UOBMinimapConfigAsset* InConfi
 	}
 	else
 	{
-		UE_LOG(LogTemp, Error, TEXT("[%s::%hs] - Failed to set up MapImage material."), *GetName(), __FUNCTION__);
+		UE_LOG(LogOBNavigation, Error, TEXT("[%s::%hs] - Failed to set up MapImage material."), *GetName(), __FUNCTION__);
 	}
 
 	if (CompassRingImage && ConfigAsset->CompassRingTexture)
@@ -65,7 +95,7 @@ void UOBMinimapWidget::InitializeAndStartTracking(UOBMinimapConfigAsset* InConfi
 				PlayerMarkerID = NavSubsystem->GetMarkerIDForActor(TrackedPawn);
 				if (!PlayerMarkerID.IsValid())
 				{
-					UE_LOG(LogTemp, Warning,
+					UE_LOG(LogOBNavigation, Warning,
 					       TEXT(
 						       "[%s::%hs] - Could not find a pre-registered marker for the tracked player pawn. The player marker might not be shown correctly."
 					       ), *GetName(), __FUNCTION__);
@@ -81,7 +111,7 @@ void UOBMinimapWidget::InitializeAndStartTracking(UOBMinimapConfigAsset* InConfi
 	// --- 5. VALIDATE AND START ---
 	if (!MinimapMaterialInstance || !NavSubsystem)
 	{
-		UE_LOG(LogTemp, Error, TEXT("[%s::%hs] - Initialization failed due to missing subsystem or material instance."),
+		UE_LOG(LogOBNavigation, Error, TEXT("[%s::%hs] - Initialization failed due to missing subsystem or material instance."),
 		       *GetName(), __FUNCTION__);
 		SetVisibility(ESlateVisibility::Collapsed);
 		return;
@@ -89,7 +119,7 @@ void UOBMinimapWidget::InitializeAndStartTracking(UOBMinimapConfigAsset* InConfi
 
 	bIsInitializedAndTracking = true;
 	SetVisibility(ESlateVisibility::SelfHitTestInvisible); // Make it visible
-	UE_LOG(LogTemp, Log, TEXT("[%s::%hs] - Minimap initialized and tracking started."), *GetName(), __FUNCTION__);
+	UE_LOG(LogOBNavigation, Log, TEXT("[%s::%hs] - Minimap initialized and tracking started."), *GetName(), __FUNCTION__);
 }
 
 void UOBMinimapWidget::SetMapRotationOffset(const float NewOffsetYaw)
@@ -117,39 +147,41 @@ void UOBMinimapWidget::SetMinimapShape(const EMinimapShape NewShape)
 	}
 }
 
+void UOBMinimapWidget::NativeDestruct()
+{
+#if !UE_BUILD_SHIPPING
+	OBNavigation::Debug::RemoveOverlayRegistration(DebugOverlayHandle);
+#endif
+	Super::NativeDestruct();
+}
+
 void UOBMinimapWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
 {
+	OBNAV_SCOPE_CYCLE_COUNTER(STAT_OBNav_MinimapTick);
+	LLM_SCOPE_BYTAG(OBNavigation);
+
 	Super::NativeTick(MyGeometry, InDeltaTime);
 
 	if (!bIsInitializedAndTracking || !ConfigAsset) return;
-	if (!NavSubsystem || !NavSubsystem->GetTrackedPlayerPawn()) return;
+	FOBTrackedView TrackedView; // The tracked pawn, or the recorded view while a marker trace is replayed
+	if (!NavSubsystem || !NavSubsystem->GetTrackedView(TrackedView)) return;
 
-	const APawn* TrackedPawn = NavSubsystem->GetTrackedPlayerPawn();
 	const UOBMapLayerAsset* CurrentLayer = NavSubsystem->GetCurrentMinimapLayer();
 	const float AlignmentAngle = GetAlignmentAngle();
 	const float TotalStaticRotation = CurrentMapRotationOffset + AlignmentAngle;
-	const float CharacterWorldYaw = TrackedPawn->GetActorRotation().Yaw; // Tính một lần ở đây
 	float DynamicMapYaw = 0.0f;
 
 	// --- MINIMAP MATERIAL LOGIC ---
 	if (CurrentLayer && MinimapMaterialInstance)
 	{
-		if (FVector2D PlayerUV; NavSubsystem->WorldToMapUV(CurrentLayer, TrackedPawn->GetActorLocation(), PlayerUV))
+		if (FVector2D PlayerUV; NavSubsystem->WorldToMapUV(CurrentLayer, TrackedView.Location, PlayerUV))
 		{
 			MinimapMaterialInstance->SetVectorParameterValue("PlayerPositionUV",
 			                                                 FLinearColor(PlayerUV.X, PlayerUV.Y, 0.0f, 0.0f));
 
 			if (ConfigAsset->bShouldRotateMap)
 			{
-				switch (ConfigAsset->RotationSource)
-				{
-				case EMinimapRotationSource::ControlRotation:
-					DynamicMapYaw = TrackedPawn->GetControlRotation().Yaw;
-					break;
-				case EMinimapRotationSource::ActorRotation:
-					DynamicMapYaw = TrackedPawn->GetActorRotation().Yaw;
-					break;
-				}
+				DynamicMapYaw = GetRotationSourceYaw(TrackedView);
 			}
 			MinimapMaterialInstance->SetScalarParameterValue("PlayerYaw", FMath::DegreesToRadians(DynamicMapYaw));
 			MinimapMaterialInstance->SetScalarParameterValue("Zoom", ConfigAsset->Zoom);
@@ -158,13 +190,43 @@ void UOBMinimapWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime
 			MinimapMaterialInstance->SetScalarParameterValue("MapRotationOffsetRad",
 			                                                 FMath::DegreesToRadians(TotalStaticRotation));
 		}
+
+		// The heat map fades out through this single scalar; its texture is only touched when events come in
+		if (CurrentHeatMap)
+		{
+			MinimapMaterialInstance->SetScalarParameterValue("HeatMapScale",
+			                                                 CurrentHeatMap->GetTextureScale(GetWorld()->GetTimeSeconds()));
+		}
+	}
+	// --- ROUTE AND BREADCRUMB POLYLINES ---
+	NumRoutePaintRuns = 0;
+	NumBreadcrumbPaintRuns = 0;
+	AreaFillVertices.Reset();
+	AreaFillIndices.Reset();
+	AreaOutlineRunStyles.Reset();
+	MarkerLabels.Reset();
+	POIIcons.Reset();
+	if (FVector2D PlayerUV; CurrentLayer && MinimapMarkerCanvas &&
+		NavSubsystem->WorldToMapUV(CurrentLayer, TrackedView.Location, PlayerUV))
+	{
+		UpdateAreaMarkers(CurrentLayer, PlayerUV, TotalStaticRotation + DynamicMapYaw);
+		if (ConfigAsset->bShowPointsOfInterest)
+		{
+			UpdatePOIIcons(TrackedView, CurrentLayer, PlayerUV, TotalStaticRotation);
+		}
+		UpdateRoutePolyline(PlayerUV, TotalStaticRotation + DynamicMapYaw);
+		if (ConfigAsset->bShowBreadcrumbs)
+		{
+			UpdateBreadcrumbPolyline(PlayerUV, TotalStaticRotation + DynamicMapYaw);
+		}
 	}
+
 	TSet<FGuid> HandledMarkerIDs; // Keep track of markers processed in this frame
 
 	// --- Pass 1: MINIMAP MARKERS ---
 	if (MinimapMarkerCanvas)
 	{
-		UpdateMinimapMarkers(TrackedPawn, TotalStaticRotation, HandledMarkerIDs);
+		UpdateMinimapMarkers(TrackedView, TotalStaticRotation, HandledMarkerIDs);
 	}
 
 	// --- Pass 3: CLEANUP UNUSED WIDGETS ---
@@ -182,60 +244,66 @@ void UOBMinimapWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime
 	{
 		if (UOBMapMarkerWidget* WidgetToRemove = ActiveMinimapMarkerWidgets.FindRef(ID))
 		{
-			WidgetToRemove->RemoveFromParent();
+			// Short-lived markers (pings, kill feeds...) come and go constantly, so their widgets are pooled
+			if (FreeMarkerWidgets.Num() < MaxFreeMarkerWidgets)
+			{
+				WidgetToRemove->SetVisibility(ESlateVisibility::Collapsed);
+				FreeMarkerWidgets.Add(WidgetToRemove);
+			}
+			else
+			{
+				WidgetToRemove->RemoveFromParent();
+			}
 		}
 		ActiveMinimapMarkerWidgets.Remove(ID);
 	}
 
-	// --- DEBUG LOGS (Sửa lại) ---
-	if (GEngine && ConfigAsset->bShowDebugMessages)
-	{
-		const float FinalIconYaw = CharacterWorldYaw + TotalStaticRotation;
-
-		GEngine->AddOnScreenDebugMessage(-1, 0.0f, FColor::Cyan,
-		                                 FString::Printf(TEXT("--- MINIMAP DEBUG ---")));
-		GEngine->AddOnScreenDebugMessage(-1, 0.0f, FColor::White,
-		                                 FString::Printf(TEXT("Character World Yaw: %.2f"), CharacterWorldYaw));
-		GEngine->AddOnScreenDebugMessage(-1, 0.0f, FColor::White,
-		                                 FString::Printf(TEXT("Alignment Angle: %.2f"), AlignmentAngle));
-		GEngine->AddOnScreenDebugMessage(-1, 0.0f, FColor::White,
-		                                 FString::Printf(
-			                                 TEXT("Map Offset: %.2f"), ConfigAsset->MapRotationOffset));
-		GEngine->AddOnScreenDebugMessage(-1, 0.0f, FColor::Yellow,
-		                                 FString::Printf(
-			                                 TEXT("=> Total Static Rotation: %.2f"), TotalStaticRotation));
-		GEngine->AddOnScreenDebugMessage(-1, 0.0f, FColor::Yellow,
-		                                 FString::Printf(TEXT("=> Final Icon Yaw: %.2f"), FinalIconYaw));
-		GEngine->AddOnScreenDebugMessage(-1, 0.0f, FColor::Yellow,
-		                                 FString::Printf(
-			                                 TEXT("=> Mat Param [PlayerYaw]: %.2f deg"), DynamicMapYaw));
-		GEngine->AddOnScreenDebugMessage(-1, 0.0f, FColor::Yellow,
-		                                 FString::Printf(
-			                                 TEXT("=> Mat Param [MapRotationOffset]: %.2f deg"),
-			                                 TotalStaticRotation));
-	}
+	SET_DWORD_STAT(STAT_OBNav_NumMarkerWidgets, ActiveMinimapMarkerWidgets.Num());
+	CSV_CUSTOM_STAT(OBNavigation, MarkerWidgets, ActiveMinimapMarkerWidgets.Num(), ECsvCustomStatOp::Set);
+
+#if !UE_BUILD_SHIPPING
+	DebugState.CharacterWorldYaw = TrackedView.ActorYaw;
+	DebugState.AlignmentAngle = AlignmentAngle;
+	DebugState.TotalStaticRotation = TotalStaticRotation;
+	DebugState.DynamicMapYaw = DynamicMapYaw;
+	OBNavigation::Debug::SyncOverlayRegistration(DebugOverlayHandle, [this]
+	{
+		return FDebugDrawDelegate::CreateUObject(this, &UOBMinimapWidget::DrawDebugOverlay);
+	});
+#endif
 }
 
-void UOBMinimapWidget::UpdateMinimapMarkers(const APawn* TrackedPawn, const float InTotalStaticRotation,
+void UOBMinimapWidget::UpdateMinimapMarkers(const FOBTrackedView& TrackedView, const float InTotalStaticRotation,
                                             TSet<FGuid>& OutHandledMarkerIDs)
 {
+	OBNAV_SCOPE_CYCLE_COUNTER(STAT_OBNav_MinimapMarkers);
+
 	if (!MarkerWidgetClass || !NavSubsystem || !ConfigAsset) return;
 
 	const UOBMapLayerAsset* CurrentLayer = NavSubsystem->GetCurrentMinimapLayer();
 	if (!CurrentLayer) return;
 
+	// The minimap fits the canvas: its radius is half the smaller canvas side (see TProjector)
 	const FVector2D CanvasSize = MinimapMarkerCanvas->GetCachedGeometry().GetLocalSize();
-	const FVector2D CanvasCenter = CanvasSize / 2.0f;
-	// Bán kính của minimap (giả sử nó vừa vặn với canvas)
-	const float MinimapRadius = FMath::Min(CanvasCenter.X, CanvasCenter.Y);
 
 	FVector2D PlayerUV;
-	NavSubsystem->WorldToMapUV(CurrentLayer, TrackedPawn->GetActorLocation(), PlayerUV);
+	NavSubsystem->WorldToMapUV(CurrentLayer, TrackedView.Location, PlayerUV);
 
+	// --- Pass 1: collect the visible markers, creating missing widgets ---
+	VisibleMarkers.Reset();
+	MarkerProjectionInputs.Reset();
+	int32 ViewerMarkerIndex = INDEX_NONE;
 	for (UOBMapMarker* Marker : NavSubsystem->GetAllActiveMarkers())
 	{
 		// SỬA LẠI ĐIỀU KIỆN LỌC: BÂY GIỜ CHỈ CẦN LỌC MINIMAP
-		if (!Marker || !Marker->ConfigAsset || !Marker->ConfigAsset->Visibility.bShowOnMinimap)
+		if (!Marker || !Marker->ConfigAsset || !Marker->ConfigAsset->Visibility.bShowOnMinimap ||
+			Marker->bHiddenByLineOfSight)
+		{
+			continue;
+		}
+
+		// The subsystem streams the icons in when the marker registers; the marker shows up once they are resident
+		if (!Marker->ConfigAsset->AreIconsLoaded())
 		{
 			continue;
 		}
@@ -244,10 +312,22 @@ void UOBMinimapWidget::UpdateMinimapMarkers(const APawn* TrackedPawn, const floa
 
 		// --- LOGIC TẠO/LẤY WIDGET (giữ nguyên từ trước) ---
 		UOBMapMarkerWidget* MarkerWidget = ActiveMinimapMarkerWidgets.FindRef(Marker->MarkerID);
-		if (!MarkerWidget)
+		if (!MarkerWidget && !FreeMarkerWidgets.IsEmpty())
+		{
+			// Pooled widgets are still on the canvas, with their centered alignment
+			MarkerWidget = FreeMarkerWidgets.Pop(/*bAllowShrinking*/ false);
+			MarkerWidget->SetVisibility(ESlateVisibility::HitTestInvisible);
+			ActiveMinimapMarkerWidgets.Add(Marker->MarkerID, MarkerWidget);
+		}
+		else if (!MarkerWidget)
 		{
 			MarkerWidget = CreateWidget<UOBMapMarkerWidget>(this, MarkerWidgetClass);
 			if (!MarkerWidget) continue;
+			INC_DWORD_STAT(STAT_OBNav_NumMarkerWidgetsCreated);
+			CSV_CUSTOM_STAT(OBNavigation, MarkerWidgetsCreated, 1, ECsvCustomStatOp::Accumulate);
+#if !UE_BUILD_SHIPPING
+			++DebugState.NumMarkerWidgetsCreated;
+#endif
 			// Thêm widget vào canvas
 
 			// --- FIX PART 1: FORCE CENTER ALIGNMENT ---
@@ -258,107 +338,61 @@ void UOBMinimapWidget::UpdateMinimapMarkers(const APawn* TrackedPawn, const floa
 				NewSlot->SetAlignment(FVector2D(0.5f, 0.5f));
 			}
 			ActiveMinimapMarkerWidgets.Add(Marker->MarkerID, MarkerWidget);
-
-			MarkerWidget->InitializeMarker(Marker->ConfigAsset->IdentifierIconTexture,
-			                               Marker->ConfigAsset->IndicatorMaterial);
 		}
 
-		// --- START: REPLACEMENT LOGIC FOR POSITION AND ROTATION ---
-		FVector2D FinalPosition;
-		float IndicatorAngle = 0.0f;
+		// Does nothing unless the widget is new, recycled, or its marker changed config (e.g., a recycled ping)
+		MarkerWidget->InitializeMarker(Marker->ConfigAsset->IdentifierIconTexture.Get(),
+		                               Marker->ConfigAsset->IndicatorMaterial.Get());
+		// Same: only sends parameters when the marker's animation timing changed, the material animates on its own
+		MarkerWidget->UpdateAnimation(Marker);
 
-		// This block now correctly handles all rotation cases based on map type
 		if (Marker->MarkerID == PlayerMarkerID)
 		{
-			// The player is always in the center.
-			FinalPosition = CanvasCenter;
-
-			if (ConfigAsset->bShouldRotateMap)
-			{
-				// On a rotating map, the player's icon should always point "up".
-				IndicatorAngle = 0.0f;
-			}
-			else
-			{
-				// On a static map, the player's icon must show its true world orientation,
-				// compensating for the map's static rotation.
-				// We SUBTRACT the static rotation, not add it.
-				IndicatorAngle = TrackedPawn->GetActorRotation().Yaw - InTotalStaticRotation;
-			}
+			ViewerMarkerIndex = VisibleMarkers.Num();
 		}
-		else
-		{
-			// Logic for all other markers (NPCs, objectives, etc.)
-			FVector2D MarkerUV;
-			NavSubsystem->WorldToMapUV(CurrentLayer, Marker->WorldLocation, MarkerUV);
 
-			const FVector2D UVDifference = MarkerUV - PlayerUV;
-			const FVector2D PixelOffset = UVDifference * CanvasSize * ConfigAsset->Zoom;
-			FVector2D RotatedPixelOffset;
+		OBNavigation::Projection::FMarkerInput& Input = MarkerProjectionInputs.AddDefaulted_GetRef();
+		NavSubsystem->WorldToMapUV(CurrentLayer, Marker->WorldLocation, Input.MapUV);
+		// Static markers point to World North (+X)
+		Input.WorldYaw = Marker->TrackedActor.IsValid() ? Marker->TrackedActor->GetActorRotation().Yaw : 0.0;
 
-			// This part correctly calculates the marker's position on the canvas
-			if (ConfigAsset->bShouldRotateMap)
-			{
-				float DynamicMapYaw = 0.0f;
-				switch (ConfigAsset->RotationSource)
-				{
-				case EMinimapRotationSource::ControlRotation:
-					DynamicMapYaw = TrackedPawn->GetControlRotation().Yaw;
-					break;
-				case EMinimapRotationSource::ActorRotation:
-					DynamicMapYaw = TrackedPawn->GetActorRotation().Yaw;
-					break;
-				}
-				RotatedPixelOffset = PixelOffset.GetRotated(-(InTotalStaticRotation + DynamicMapYaw));
-			}
-			else
-			{
-				RotatedPixelOffset = PixelOffset.GetRotated(-InTotalStaticRotation);
-			}
+		VisibleMarkers.Add({Marker, MarkerWidget});
+	}
 
-			// --- Clamping and Angle Calculation Logic ---
-			if (RotatedPixelOffset.SizeSquared() > FMath::Square(MinimapRadius))
+	// --- Pass 2: project, with the projector specialized once for this frame's config ---
+	OBNavigation::Projection::FFrameParams Params;
+	Params.ViewUV = PlayerUV;
+	Params.CanvasSize = CanvasSize;
+	Params.Zoom = ConfigAsset->Zoom;
+	Params.StaticRotation = InTotalStaticRotation;
+	Params.ViewYaw = GetRotationSourceYaw(TrackedView);
+	Params.ViewerActorYaw = TrackedView.ActorYaw;
+
+	MarkerProjectionOutputs.SetNumUninitialized(MarkerProjectionInputs.Num(), /*bAllowShrinking*/ false);
+	OBNavigation::Projection::Dispatch(
+		ConfigAsset->bShouldRotateMap
+			? OBNavigation::Projection::EMapRotation::FollowView
+			: OBNavigation::Projection::EMapRotation::Fixed,
+		CurrentMinimapShape == EMinimapShape::Circle
+			? OBNavigation::Projection::EClampShape::Circle
+			: OBNavigation::Projection::EClampShape::Square,
+		Params, [this, ViewerMarkerIndex](const auto& Projector)
+		{
+			Projector.ProjectMarkers(MarkerProjectionInputs, MarkerProjectionOutputs);
+			if (ViewerMarkerIndex != INDEX_NONE)
 			{
-				// CASE 1: The marker is clamped to the edge of the minimap.
-				// Its indicator should point from the center towards its off-screen location.
-				// This existing logic is correct and remains unchanged.
-				const FVector2D ClampedOffset = RotatedPixelOffset.GetSafeNormal() * MinimapRadius;
-				FinalPosition = CanvasCenter + ClampedOffset;
-				IndicatorAngle = FMath::RadiansToDegrees(FMath::Atan2(RotatedPixelOffset.Y, RotatedPixelOffset.X));
+				// The player is always in the center.
+				MarkerProjectionOutputs[ViewerMarkerIndex] = Projector.ProjectViewer();
 			}
-			else
-			{
-				// CASE 2: The marker is visible inside the minimap.
-				FinalPosition = CanvasCenter + RotatedPixelOffset;
-
-				float ActorWorldYaw = 0.0f; // Default for static markers (points to World North +X)
-				if (Marker->TrackedActor.IsValid())
-				{
-					ActorWorldYaw = Marker->TrackedActor->GetActorRotation().Yaw;
-				}
+		});
 
-				if (ConfigAsset->bShouldRotateMap)
-				{
-					// On a rotating map, the marker's angle is relative to the player's view.
-					float PlayerYaw = 0.0f;
-					switch (ConfigAsset->RotationSource)
-					{
-					case EMinimapRotationSource::ControlRotation: PlayerYaw = TrackedPawn->GetControlRotation().Yaw;
-						break;
-					case EMinimapRotationSource::ActorRotation: PlayerYaw = TrackedPawn->GetActorRotation().Yaw;
-						break;
-					}
-					IndicatorAngle = ActorWorldYaw - PlayerYaw;
-				}
-				else
-				{
-					// On a static map, the marker shows its true world orientation,
-					// compensating for the map's static rotation.
-					IndicatorAngle = ActorWorldYaw - InTotalStaticRotation;
-				}
-			}
-		}
-		// --- END: REPLACEMENT LOGIC ---
+	// --- Pass 3: apply the results to the widgets ---
+	for (int32 Index = 0; Index < VisibleMarkers.Num(); ++Index)
+	{
+		const UOBMapMarker* Marker = VisibleMarkers[Index].Marker;
+		UOBMapMarkerWidget* MarkerWidget = VisibleMarkers[Index].Widget;
+		const FVector2D FinalPosition = MarkerProjectionOutputs[Index].Position;
+		const float IndicatorAngle = MarkerProjectionOutputs[Index].IndicatorAngle;
 
 		MarkerWidget->UpdateVisuals(IndicatorAngle, 90.0f, 1.0f);
 
@@ -371,7 +405,7 @@ void UOBMinimapWidget::UpdateMinimapMarkers(const APawn* TrackedPawn, const floa
 			const FVector2D MarkerSize = Marker->ConfigAsset->Size;
 			FVector2D SlotPosition;
 
-			if (Marker->MarkerID == PlayerMarkerID)
+			if (Index == ViewerMarkerIndex)
 			{
 				SlotPosition = FinalPosition;
 			}
@@ -388,33 +422,462 @@ void UOBMinimapWidget::UpdateMinimapMarkers(const APawn* TrackedPawn, const floa
 			// This overrides any incorrect default layout size from the Blueprint and fixes the distortion.
 			CanvasSlot->SetSize(MarkerSize);
 			CanvasSlot->SetPosition(SlotPosition);
-			CanvasSlot->SetZOrder(Marker->MarkerID == PlayerMarkerID ? 10 : 1);
+			CanvasSlot->SetZOrder(Index == ViewerMarkerIndex ? 10 : 1);
 
 			// --- FIX ENDS HERE ---
 		}
+	}
+
+	// --- Pass 4: place the labels around the final positions ---
+	if (ConfigAsset->bShowLabels)
+	{
+		UpdateMarkerLabels();
+	}
+
+	SET_DWORD_STAT(STAT_OBNav_NumVisibleMarkers, OutHandledMarkerIDs.Num());
+	CSV_CUSTOM_STAT(OBNavigation, VisibleMarkers, OutHandledMarkerIDs.Num(), ECsvCustomStatOp::Set);
+#if !UE_BUILD_SHIPPING
+	DebugState.NumVisibleMarkers = OutHandledMarkerIDs.Num();
+#endif
+}
+
+void UOBMinimapWidget::UpdateMarkerLabels()
+{
+	OBNAV_SCOPE_CYCLE_COUNTER(STAT_OBNav_MinimapLabels);
+
+	// Text is measured by the Slate renderer, which does not exist everywhere (e.g., in a commandlet)
+	if (!FSlateApplication::IsInitialized())
+	{
+		return;
+	}
+
+	LabelCandidates.Reset();
+	for (int32 Index = 0; Index < VisibleMarkers.Num(); ++Index)
+	{
+		// A marker pinned to the edge is off the map; its label would only add clutter there
+		const UOBMarkerConfigAsset* MarkerConfig = VisibleMarkers[Index].Marker->ConfigAsset;
+		if (MarkerConfig->bShowLabel && !MarkerProjectionOutputs[Index].bClamped)
+		{
+			LabelCandidates.Add({Index, MarkerConfig->LabelPriority});
+		}
+	}
+
+	// Stable, so labels of equal priority do not take turns from one tick to the next
+	LabelCandidates.StableSort([](const FLabelCandidate& A, const FLabelCandidate& B)
+	{
+		return A.Priority > B.Priority;
+	});
+
+	// Slate only clips to rectangles, so on a circular minimap a label leaving the circle is dropped instead.
+	// On a square minimap the paint clip cuts labels at the edge, like the area and route runs.
+	const FVector2D CanvasCenter = MinimapMarkerCanvas->GetCachedGeometry().GetLocalSize() / 2.0;
+	const double MinimapRadius = FMath::Min(CanvasCenter.X, CanvasCenter.Y);
+	const bool bCircle = CurrentMinimapShape == EMinimapShape::Circle;
+
+	// Each label is tested against the ones kept before it only, through the grid cells it covers
+	const FVector2D HalfSpacing(ConfigAsset->LabelSpacing * 0.5f);
+	LabelGrid.Reset();
+	for (const FLabelCandidate& Candidate : LabelCandidates)
+	{
+		const UOBMapMarker* Marker = VisibleMarkers[Candidate.VisibleMarkerIndex].Marker;
+		const FText& Text = Marker->Label.IsEmpty() ? Marker->ConfigAsset->DefaultLabel : Marker->Label;
+		if (Text.IsEmpty())
+		{
+			continue;
+		}
+
+		const FVector2D Size = GetLabelSize(Text);
+		const FVector2D MarkerBottom = MarkerProjectionOutputs[Candidate.VisibleMarkerIndex].Position +
+			FVector2D(0.0, Marker->ConfigAsset->Size.Y * 0.5);
+		const FVector2D Position = MarkerBottom + ConfigAsset->LabelOffset - FVector2D(Size.X * 0.5, 0.0);
+		if (bCircle)
+		{
+			const FVector2D FarthestCorner(
+				FMath::Max(FMath::Abs(Position.X - CanvasCenter.X), FMath::Abs(Position.X + Size.X - CanvasCenter.X)),
+				FMath::Max(FMath::Abs(Position.Y - CanvasCenter.Y), FMath::Abs(Position.Y + Size.Y - CanvasCenter.Y)));
+			if (FarthestCorner.SizeSquared() > FMath::Square(MinimapRadius))
+			{
+				continue;
+			}
+		}
+		if (LabelGrid.TryAdd(Position - HalfSpacing, Position + Size + HalfSpacing))
+		{
+			MarkerLabels.Add({Text, Position, Size});
+		}
+	}
+
+#if !UE_BUILD_SHIPPING
+	DebugState.NumLabelCandidates = LabelCandidates.Num();
+#endif
+}
+
+void UOBMinimapWidget::UpdatePOIIcons(const FOBTrackedView& TrackedView, const UOBMapLayerAsset* InLayer,
+                                      const FVector2D& PlayerUV, const float InTotalStaticRotation)
+{
+	OBNAV_SCOPE_CYCLE_COUNTER(STAT_OBNav_MinimapPOIs);
+
+	const FBox& LayerBounds = NavSubsystem->GetLayerBounds(InLayer);
+	const FVector WorldSize = LayerBounds.GetSize();
+	if (NavSubsystem->GetNumPOIs() == 0 || ConfigAsset->Zoom <= 0.0f || FMath::IsNearlyZero(WorldSize.X) ||
+		FMath::IsNearlyZero(WorldSize.Y))
+	{
+		SET_DWORD_STAT(STAT_OBNav_NumVisiblePOIs, 0);
+		return;
+	}
+
+	// The minimap shows 0.5 / Zoom of the map on either side of the view, and up to sqrt(2) times that along the
+	// diagonals once the map is rotated. Only the POIs of that square are gathered.
+	const double UVExtent = UE_SQRT_2 * 0.5 / ConfigAsset->Zoom;
+	const FVector2D ViewCenter(TrackedView.Location);
+	const FVector2D WorldExtent(WorldSize.X * UVExtent, WorldSize.Y * UVExtent);
+	LightweightMarkers.Reset();
+	NavSubsystem->GatherLightweightMarkers(FBox2D(ViewCenter - WorldExtent, ViewCenter + WorldExtent),
+	                                       LightweightMarkers);
+
+	OBNavigation::Projection::FFrameParams Params;
+	Params.ViewUV = PlayerUV;
+	Params.CanvasSize = MinimapMarkerCanvas->GetCachedGeometry().GetLocalSize();
+	Params.Zoom = ConfigAsset->Zoom;
+	Params.StaticRotation = InTotalStaticRotation;
+	Params.ViewYaw = GetRotationSourceYaw(TrackedView);
+
+	const FVector& BoundsMin = LayerBounds.Min;
+	OBNavigation::Projection::Dispatch(
+		ConfigAsset->bShouldRotateMap
+			? OBNavigation::Projection::EMapRotation::FollowView
+			: OBNavigation::Projection::EMapRotation::Fixed,
+		CurrentMinimapShape == EMinimapShape::Circle
+			? OBNavigation::Projection::EClampShape::Circle
+			: OBNavigation::Projection::EClampShape::Square,
+		Params, [this, &WorldSize, &BoundsMin](const auto& Projector)
+		{
+			for (const FOBLightweightMarker& Marker : LightweightMarkers)
+			{
+				const UOBMarkerConfigAsset* MarkerConfig = Marker.Config;
+				if (!MarkerConfig->Visibility.bShowOnMinimap || !MarkerConfig->AreIconsLoaded())
+				{
+					continue;
+				}
+
+				// Same mapping as WorldToMapUV; POIs off the layer are off the minimap as well
+				OBNavigation::Projection::FMarkerInput Input;
+				Input.MapUV = FVector2D((Marker.WorldLocation.Y - BoundsMin.Y) / WorldSize.Y,
+				                        1.0 - (Marker.WorldLocation.X - BoundsMin.X) / WorldSize.X);
+				const OBNavigation::Projection::FMarkerOutput Output = Projector.ProjectMarker(Input);
+
+				// POIs have no indicator to point at them from the edge
+				if (Output.bClamped)
+				{
+					continue;
+				}
+
+				const int32* BrushIndex = POIBrushIndices.Find(MarkerConfig);
+				if (!BrushIndex)
+				{
+					UTexture2D* IconTexture = MarkerConfig->IdentifierIconTexture.Get();
+					if (!IconTexture)
+					{
+						continue;
+					}
+
+					FSlateBrush& Brush = POIBrushes.AddDefaulted_GetRef();
+					Brush.SetResourceObject(IconTexture);
+					Brush.ImageSize = MarkerConfig->Size;
+					BrushIndex = &POIBrushIndices.Add(MarkerConfig, POIBrushes.Num() - 1);
+				}
+
+				POIIcons.Add({Output.Position - MarkerConfig->Size * 0.5, MarkerConfig->Size, *BrushIndex});
+			}
+		});
+
+	SET_DWORD_STAT(STAT_OBNav_NumVisiblePOIs, POIIcons.Num());
+}
+
+FVector2D UOBMinimapWidget::GetLabelSize(const FText& Text)
+{
+	const FString& String = Text.ToString();
+	if (const FVector2D* CachedSize = LabelSizeCache.Find(String))
+	{
+		return *CachedSize;
+	}
+
+	if (LabelSizeCache.Num() >= MaxCachedLabelSizes)
+	{
+		LabelSizeCache.Reset();
+	}
+
+	const TSharedRef<FSlateFontMeasure> FontMeasure = FSlateApplication::Get().GetRenderer()->GetFontMeasureService();
+	return LabelSizeCache.Add(String, FVector2D(FontMeasure->Measure(String, LabelFont)));
+}
+
+void UOBMinimapWidget::UpdateRoutePolyline(const FVector2D& PlayerUV, const float InMapRotation)
+{
+	OBNAV_SCOPE_CYCLE_COUNTER(STAT_OBNav_MinimapRoute);
+
+	const TArray<FVector2D>& RouteMapPoints = NavSubsystem->GetRouteMapPoints();
+	if (RouteMapPoints.Num() < 2)
+	{
+		return;
+	}
+
+	const FVector2D CanvasSize = MinimapMarkerCanvas->GetCachedGeometry().GetLocalSize();
+	const FVector2D CanvasCenter = CanvasSize / 2.0f;
+	const float MinimapRadius = FMath::Min(CanvasCenter.X, CanvasCenter.Y);
+
+	// Same projection as the markers: offset from the player in UV, scaled to the canvas, rotated with the map
+	RouteProjectedPoints.Reset(RouteMapPoints.Num());
+	for (const FVector2D& MapPoint : RouteMapPoints)
+	{
+		const FVector2D PixelOffset = (MapPoint - PlayerUV) * CanvasSize * ConfigAsset->Zoom;
+		RouteProjectedPoints.Add(CanvasCenter + PixelOffset.GetRotated(-InMapRotation));
+	}
+
+	NumRoutePaintRuns = OBNavigation::Polyline::ClipPolyline(RouteProjectedPoints, CanvasCenter, MinimapRadius,
+	                                                         CurrentMinimapShape == EMinimapShape::Circle,
+	                                                         RoutePaintRuns);
+}
+
+void UOBMinimapWidget::UpdateBreadcrumbPolyline(const FVector2D& PlayerUV, const float InMapRotation)
+{
+	OBNAV_SCOPE_CYCLE_COUNTER(STAT_OBNav_MinimapBreadcrumbs);
+
+	TConstArrayView<FVector2D> OlderPoints;
+	TConstArrayView<FVector2D> NewerPoints;
+	NavSubsystem->GetBreadcrumbMapPoints(OlderPoints, NewerPoints);
+	if (OlderPoints.IsEmpty())
+	{
+		return;
+	}
+
+	// The trail is already in map space (each point is projected once, when the subsystem records it);
+	// only the per-frame pan, zoom and rotation are applied here
+	const FVector2D CanvasSize = MinimapMarkerCanvas->GetCachedGeometry().GetLocalSize();
+	const FVector2D CanvasCenter = CanvasSize / 2.0f;
+	const float MinimapRadius = FMath::Min(CanvasCenter.X, CanvasCenter.Y);
+	const FVector2D Scale = CanvasSize * ConfigAsset->Zoom;
+
+	BreadcrumbProjectedPoints.Reset(OlderPoints.Num() + NewerPoints.Num() + 1);
+	for (const TConstArrayView<FVector2D>& Points : {OlderPoints, NewerPoints})
+	{
+		for (const FVector2D& MapPoint : Points)
+		{
+			BreadcrumbProjectedPoints.Add(CanvasCenter + ((MapPoint - PlayerUV) * Scale).GetRotated(-InMapRotation));
+		}
+	}
+	BreadcrumbProjectedPoints.Add(CanvasCenter);
+
+	NumBreadcrumbPaintRuns = OBNavigation::Polyline::ClipPolyline(BreadcrumbProjectedPoints, CanvasCenter,
+	                                                              MinimapRadius,
+	                                                              CurrentMinimapShape == EMinimapShape::Circle,
+	                                                              BreadcrumbPaintRuns);
+}
+
+void UOBMinimapWidget::UpdateAreaMarkers(const UOBMapLayerAsset* InLayer, const FVector2D& PlayerUV,
+                                         const float InMapRotation)
+{
+	OBNAV_SCOPE_CYCLE_COUNTER(STAT_OBNav_MinimapAreas);
+
+	const TMap<FGuid, FOBAreaMarker>& Areas = NavSubsystem->GetAreaMarkers();
+	const FBox& LayerBounds = NavSubsystem->GetLayerBounds(InLayer);
+	const FVector WorldSize = LayerBounds.GetSize();
+	if (Areas.IsEmpty() || FMath::IsNearlyZero(WorldSize.X) || FMath::IsNearlyZero(WorldSize.Y))
+	{
+		return;
+	}
+
+	const FVector2D CanvasSize = MinimapMarkerCanvas->GetCachedGeometry().GetLocalSize();
+	const FVector2D CanvasCenter = CanvasSize / 2.0f;
+	const float MinimapRadius = FMath::Min(CanvasCenter.X, CanvasCenter.Y);
+	const bool bCircle = CurrentMinimapShape == EMinimapShape::Circle;
+
+	// Fills are clipped as polygons, so the circle is approximated; outlines are clipped against the exact shape
+	AreaClipPolygon.Reset();
+	if (bCircle)
+	{
+		for (int32 Segment = 0; Segment < NumAreaClipSegments; ++Segment)
+		{
+			double Sin, Cos;
+			FMath::SinCos(&Sin, &Cos, UE_TWO_PI * Segment / NumAreaClipSegments);
+			AreaClipPolygon.Add(CanvasCenter + FVector2D(Cos, Sin) * MinimapRadius);
+		}
+	}
+	else
+	{
+		AreaClipPolygon.Append({
+			CanvasCenter + FVector2D(-MinimapRadius, -MinimapRadius), CanvasCenter + FVector2D(MinimapRadius, -MinimapRadius),
+			CanvasCenter + FVector2D(MinimapRadius, MinimapRadius), CanvasCenter + FVector2D(-MinimapRadius, MinimapRadius)
+		});
+	}
 
-		if (GEngine && ConfigAsset->bShowDebugMessages)
+	// World XY to canvas in one step: map UV (same mapping as WorldToMapUV), then the marker projection
+	const FVector& BoundsMin = LayerBounds.Min;
+	const FVector2D Scale = CanvasSize * ConfigAsset->Zoom;
+	auto WorldToCanvas = [&](const FVector2D& WorldPoint)
+	{
+		const FVector2D MapUV((WorldPoint.Y - BoundsMin.Y) / WorldSize.Y, 1.0 - (WorldPoint.X - BoundsMin.X) / WorldSize.X);
+		return CanvasCenter + ((MapUV - PlayerUV) * Scale).GetRotated(-InMapRotation);
+	};
+
+	const double Time = GetWorld()->GetTimeSeconds();
+	int32 NumOutlineRuns = 0;
+	for (const TPair<FGuid, FOBAreaMarker>& Pair : Areas)
+	{
+		const FOBAreaMarker& Area = Pair.Value;
+		FVector2D AreaCenter;
+		double AreaScale;
+		Area.Evaluate(Time, AreaCenter, AreaScale);
+
+		// Only the animated center and scale change from frame to frame; the outline itself is never rebuilt
+		AreaProjectedPoints.Reset(Area.LocalOutline.Num() + 1);
+		for (const FVector2D& LocalPoint : Area.LocalOutline)
 		{
-			const FColor DebugColor = (Marker->MarkerID == PlayerMarkerID) ? FColor::Magenta : FColor::Green;
-			GEngine->AddOnScreenDebugMessage(
-				-1, 0.0f, DebugColor,
-				FString::Printf(TEXT("Marker [%s]: Final Pos: %s"),
-				                *Marker->MarkerID.ToString().Left(8),
-				                *FinalPosition.ToString()
-				)
-			);
+			AreaProjectedPoints.Add(WorldToCanvas(AreaCenter + LocalPoint * AreaScale));
 		}
 
-		if (GEngine && ConfigAsset->bShowDebugMessages && Marker->MarkerID == PlayerMarkerID)
+		if (Area.Style.FillColor.A > 0.0f)
 		{
-			GEngine->AddOnScreenDebugMessage(
-				-1, 0.0f, FColor::White,
-				FString::Printf(TEXT("Player Marker Widget Visibility: %d"), MarkerWidget->GetVisibility())
-			);
+			if (Area.IsConvex())
+			{
+				AppendAreaFill(AreaProjectedPoints, Area.Style.FillColor);
+			}
+			else
+			{
+				for (int32 Index = 0; Index + 2 < Area.TriangleIndices.Num(); Index += 3)
+				{
+					const FVector2D Triangle[3] = {
+						AreaProjectedPoints[Area.TriangleIndices[Index]], AreaProjectedPoints[Area.TriangleIndices[Index + 1]],
+						AreaProjectedPoints[Area.TriangleIndices[Index + 2]]
+					};
+					AppendAreaFill(Triangle, Area.Style.FillColor);
+				}
+			}
+		}
+
+		if (Area.Style.OutlineThickness > 0.0f && Area.Style.OutlineColor.A > 0.0f)
+		{
+			AreaProjectedPoints.Add(AreaProjectedPoints[0]);
+			const int32 NumRuns = OBNavigation::Polyline::ClipPolyline(AreaProjectedPoints, CanvasCenter, MinimapRadius,
+			                                                           bCircle, AreaOutlinePaintRuns, NumOutlineRuns);
+			NumOutlineRuns += NumRuns;
+			for (int32 Run = 0; Run < NumRuns; ++Run)
+			{
+				AreaOutlineRunStyles.Emplace(Area.Style.OutlineColor, Area.Style.OutlineThickness);
+			}
 		}
 	}
 }
 
+void UOBMinimapWidget::AppendAreaFill(const TConstArrayView<FVector2D> Points, const FLinearColor& Color)
+{
+	OBNavigation::Polyline::ClipConvexPolygon(Points, AreaClipPolygon, AreaClippedPoints);
+	if (AreaClippedPoints.Num() < 3)
+	{
+		return;
+	}
+
+	const int32 FirstVertex = AreaFillVertices.Num();
+	for (const FVector2D& Point : AreaClippedPoints)
+	{
+		AreaFillVertices.Add({FVector2f(Point), Color});
+	}
+	for (int32 Index = 1; Index + 1 < AreaClippedPoints.Num(); ++Index)
+	{
+		AreaFillIndices.Add(static_cast<SlateIndex>(FirstVertex));
+		AreaFillIndices.Add(static_cast<SlateIndex>(FirstVertex + Index));
+		AreaFillIndices.Add(static_cast<SlateIndex>(FirstVertex + Index + 1));
+	}
+}
+
+int32 UOBMinimapWidget::NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry,
+                                    const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements,
+                                    int32 LayerId, const FWidgetStyle& InWidgetStyle, const bool bParentEnabled) const
+{
+	OBNAV_SCOPE_CYCLE_COUNTER(STAT_OBNav_MinimapPaint);
+
+	LayerId = Super::NativePaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle,
+	                             bParentEnabled);
+
+	if ((NumRoutePaintRuns == 0 && NumBreadcrumbPaintRuns == 0 && AreaFillIndices.IsEmpty() &&
+		AreaOutlineRunStyles.IsEmpty() && MarkerLabels.IsEmpty() && POIIcons.IsEmpty()) || !MinimapMarkerCanvas ||
+		!ConfigAsset)
+	{
+		return LayerId;
+	}
+
+	// The runs are in canvas space, so draw them with the canvas geometry. Usually the whole route is a single run.
+	// Areas go first, then the POI icons, the trail and the route, each run as a single line element. Labels go on
+	// top of them all.
+	++LayerId;
+	const FGeometry& CanvasGeometry = MinimapMarkerCanvas->GetCachedGeometry();
+	const FPaintGeometry CanvasPaintGeometry = CanvasGeometry.ToPaintGeometry();
+	if (!AreaFillIndices.IsEmpty())
+	{
+		// Every area fill in one draw call. Without a texture, Slate draws it with its white texture, so the vertex
+		// colors are the final colors.
+		const FSlateRenderTransform& RenderTransform = CanvasGeometry.GetAccumulatedRenderTransform();
+		const FLinearColor Tint = InWidgetStyle.GetColorAndOpacityTint();
+		AreaSlateVertices.Reset(AreaFillVertices.Num());
+		for (const FAreaFillVertex& Vertex : AreaFillVertices)
+		{
+			AreaSlateVertices.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(
+				RenderTransform, Vertex.Position, FVector2f::ZeroVector, (Vertex.Color * Tint).ToFColor(true)));
+		}
+		FSlateDrawElement::MakeCustomVerts(OutDrawElements, LayerId, FSlateResourceHandle(), AreaSlateVertices,
+		                                   AreaFillIndices, nullptr, 0, 0);
+	}
+
+	for (int32 RunIndex = 0; RunIndex < AreaOutlineRunStyles.Num(); ++RunIndex)
+	{
+		const TPair<FLinearColor, float>& RunStyle = AreaOutlineRunStyles[RunIndex];
+		FSlateDrawElement::MakeLines(OutDrawElements, LayerId, CanvasPaintGeometry, AreaOutlinePaintRuns[RunIndex],
+		                             ESlateDrawEffect::None, RunStyle.Key * InWidgetStyle.GetColorAndOpacityTint(), true,
+		                             RunStyle.Value);
+	}
+
+	// Icons sharing a brush are batched by the Slate renderer, so thousands of POIs cost a few draw calls
+	for (const FPOIIcon& Icon : POIIcons)
+	{
+		FSlateDrawElement::MakeBox(OutDrawElements, LayerId,
+		                           CanvasGeometry.ToPaintGeometry(Icon.Size, FSlateLayoutTransform(Icon.Position)),
+		                           &POIBrushes[Icon.BrushIndex], ESlateDrawEffect::None,
+		                           InWidgetStyle.GetColorAndOpacityTint());
+	}
+
+	const FLinearColor BreadcrumbTint = ConfigAsset->BreadcrumbColor * InWidgetStyle.GetColorAndOpacityTint();
+	for (int32 RunIndex = 0; RunIndex < NumBreadcrumbPaintRuns; ++RunIndex)
+	{
+		FSlateDrawElement::MakeLines(OutDrawElements, LayerId, CanvasPaintGeometry, BreadcrumbPaintRuns[RunIndex],
+		                             ESlateDrawEffect::None, BreadcrumbTint, true, ConfigAsset->BreadcrumbThickness);
+	}
+
+	const FLinearColor RouteTint = ConfigAsset->RouteColor * InWidgetStyle.GetColorAndOpacityTint();
+	for (int32 RunIndex = 0; RunIndex < NumRoutePaintRuns; ++RunIndex)
+	{
+		FSlateDrawElement::MakeLines(OutDrawElements, LayerId, CanvasPaintGeometry, RoutePaintRuns[RunIndex],
+		                             ESlateDrawEffect::None, RouteTint, true, ConfigAsset->RouteThickness);
+	}
+
+	if (!MarkerLabels.IsEmpty())
+	{
+		// Clipped to the minimap square (labels leaving a circular minimap were already dropped)
+		const FVector2D CanvasCenter = CanvasGeometry.GetLocalSize() / 2.0;
+		const FVector2D MinimapExtent(FMath::Min(CanvasCenter.X, CanvasCenter.Y));
+		OutDrawElements.PushClip(FSlateClippingZone(CanvasGeometry.ToPaintGeometry(
+			MinimapExtent * 2.0, FSlateLayoutTransform(CanvasCenter - MinimapExtent))));
+
+		++LayerId;
+		const FLinearColor LabelTint = ConfigAsset->LabelColor * InWidgetStyle.GetColorAndOpacityTint();
+		for (const FMarkerLabel& Label : MarkerLabels)
+		{
+			FSlateDrawElement::MakeText(OutDrawElements, LayerId,
+			                            CanvasGeometry.ToPaintGeometry(Label.Size, FSlateLayoutTransform(Label.Position)),
+			                            Label.Text, LabelFont, ESlateDrawEffect::None, LabelTint);
+		}
+		OutDrawElements.PopClip();
+	}
+	return LayerId;
+}
+
 void UOBMinimapWidget::OnMinimapLayerChanged(UOBMapLayerAsset* NewLayer)
 {
 	if (!MinimapMaterialInstance || !MapImage)
@@ -422,14 +885,55 @@ void UOBMinimapWidget::OnMinimapLayerChanged(UOBMapLayerAsset* NewLayer)
 		return;
 	}
 
-	if (NewLayer && NewLayer->MapTexture)
+	// Layers baked at runtime show their baked image instead of their MapTexture
+	UTexture2D* MapTexture = NavSubsystem ? NavSubsystem->GetMapTexture(NewLayer)
+	                                      : NewLayer ? NewLayer->MapTexture.Get() : nullptr;
+	if (NewLayer && MapTexture)
 	{
-		MinimapMaterialInstance->SetTextureParameterValue("MapTexture", NewLayer->MapTexture);
+		MinimapMaterialInstance->SetTextureParameterValue("MapTexture", MapTexture);
 		MapImage->SetVisibility(ESlateVisibility::HitTestInvisible);
+
+		// The mask texture is updated in place by the subsystem, so binding it once per layer is enough.
+		// The material multiplies the map by "ExplorationMask" (sampled with the map UVs) when "ExplorationMaskEnabled" is 1.
+		UOBExplorationMask* ExplorationMask = NavSubsystem ? NavSubsystem->FindOrCreateExplorationMask(NewLayer) : nullptr;
+		if (UTexture2D* MaskTexture = ExplorationMask ? ExplorationMask->GetMaskTexture() : nullptr)
+		{
+			MinimapMaterialInstance->SetTextureParameterValue("ExplorationMask", MaskTexture);
+			MinimapMaterialInstance->SetScalarParameterValue("ExplorationMaskEnabled", 1.0f);
+		}
+		else
+		{
+			MinimapMaterialInstance->SetScalarParameterValue("ExplorationMaskEnabled", 0.0f);
+		}
+
+		// Likewise for the heat map, blended from "HeatMap" (one heat channel per RGBA component) when "HeatMapEnabled"
+		// is 1. The decay is applied by the material: heat = saturate(HeatMap * HeatMapScale), see NativeTick.
+		CurrentHeatMap = NavSubsystem ? NavSubsystem->FindOrCreateHeatMap(NewLayer) : nullptr;
+		if (UTexture2D* HeatTexture = CurrentHeatMap ? CurrentHeatMap->GetHeatTexture() : nullptr)
+		{
+			MinimapMaterialInstance->SetTextureParameterValue("HeatMap", HeatTexture);
+			MinimapMaterialInstance->SetScalarParameterValue("HeatMapEnabled", 1.0f);
+		}
+		else
+		{
+			CurrentHeatMap = nullptr;
+			MinimapMaterialInstance->SetScalarParameterValue("HeatMapEnabled", 0.0f);
+		}
 	}
 	else
 	{
 		MapImage->SetVisibility(ESlateVisibility::Collapsed);
+		CurrentHeatMap = nullptr;
+	}
+}
+
+float UOBMinimapWidget::GetRotationSourceYaw(const FOBTrackedView& TrackedView) const
+{
+	switch (ConfigAsset->RotationSource)
+	{
+	case EMinimapRotationSource::ControlRotation: return TrackedView.ControlYaw;
+	case EMinimapRotationSource::ActorRotation: return TrackedView.ActorYaw;
+	default: return 0.0f;
 	}
 }
 
@@ -444,3 +948,28 @@ float UOBMinimapWidget::GetAlignmentAngle() const
 	default: return 0.0f;
 	}
 }
+
+#if !UE_BUILD_SHIPPING
+void UOBMinimapWidget::DrawDebugOverlay(UCanvas* Canvas, APlayerController* PlayerController)
+{
+	if (!Canvas || !PlayerController || PlayerController->GetWorld() != GetWorld() || !ConfigAsset)
+	{
+		return;
+	}
+
+	// Drawn next to the subsystem's block
+	OBNavigation::Debug::FOverlayTextWriter Writer(Canvas, 400.0f, 50.0f);
+	Writer.Line(FColor::Cyan, FString::Printf(TEXT("--- MINIMAP %s ---"), *GetName()));
+	Writer.Line(FColor::White, FString::Printf(TEXT("Character World Yaw: %.2f"), DebugState.CharacterWorldYaw));
+	Writer.Line(FColor::White, FString::Printf(TEXT("Alignment Angle: %.2f"), DebugState.AlignmentAngle));
+	Writer.Line(FColor::White, FString::Printf(TEXT("Map Offset: %.2f"), CurrentMapRotationOffset));
+	Writer.Line(FColor::Yellow, FString::Printf(TEXT("=> Total Static Rotation: %.2f"), DebugState.TotalStaticRotation));
+	Writer.Line(FColor::Yellow, FString::Printf(TEXT("=> Mat Param [PlayerYaw]: %.2f deg"), DebugState.DynamicMapYaw));
+	Writer.Line(FColor::Green, FString::Printf(TEXT("Visible Markers: %d"), DebugState.NumVisibleMarkers));
+	Writer.Line(FColor::Green, FString::Printf(TEXT("Marker Widgets: %d (%d created)"),
+	                                           ActiveMinimapMarkerWidgets.Num(), DebugState.NumMarkerWidgetsCreated));
+	Writer.Line(FColor::Green, FString::Printf(TEXT("Route Runs: %d"), NumRoutePaintRuns));
+	Writer.Line(FColor::Green, FString::Printf(TEXT("Labels: %d of %d (%d sizes cached)"), MarkerLabels.Num(),
+	                                           DebugState.NumLabelCandidates, LabelSizeCache.Num()));
+}
+#endif
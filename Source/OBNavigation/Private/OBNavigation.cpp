@@ -1,6 +1,44 @@
 ﻿// Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "OBNavigation.h"
+#include "OBNavigationStats.h"
+
+DEFINE_LOG_CATEGORY(LogOBNavigation);
+
+DEFINE_STAT(STAT_OBNav_SubsystemTick);
+DEFINE_STAT(STAT_OBNav_UpdateActiveLayer);
+DEFINE_STAT(STAT_OBNav_UpdateMarkers);
+DEFINE_STAT(STAT_OBNav_UpdateExploration);
+DEFINE_STAT(STAT_OBNav_UpdateHeatMaps);
+DEFINE_STAT(STAT_OBNav_UpdateLineOfSight);
+DEFINE_STAT(STAT_OBNav_UpdateRegions);
+DEFINE_STAT(STAT_OBNav_UpdateRoute);
+DEFINE_STAT(STAT_OBNav_RegisterMarker);
+DEFINE_STAT(STAT_OBNav_UnregisterMarker);
+DEFINE_STAT(STAT_OBNav_ProcessMarkerCommands);
+DEFINE_STAT(STAT_OBNav_MapBake);
+DEFINE_STAT(STAT_OBNav_PublishMarkerSnapshot);
+DEFINE_STAT(STAT_OBNav_UpdatePOIPages);
+DEFINE_STAT(STAT_OBNav_MinimapTick);
+DEFINE_STAT(STAT_OBNav_MinimapMarkers);
+DEFINE_STAT(STAT_OBNav_MinimapRoute);
+DEFINE_STAT(STAT_OBNav_MinimapAreas);
+DEFINE_STAT(STAT_OBNav_MinimapBreadcrumbs);
+DEFINE_STAT(STAT_OBNav_MinimapLabels);
+DEFINE_STAT(STAT_OBNav_MinimapPOIs);
+DEFINE_STAT(STAT_OBNav_MinimapPaint);
+DEFINE_STAT(STAT_OBNav_NumMarkers);
+DEFINE_STAT(STAT_OBNav_NumVisibleMarkers);
+DEFINE_STAT(STAT_OBNav_NumMarkerCommands);
+DEFINE_STAT(STAT_OBNav_NumLineOfSightTraces);
+DEFINE_STAT(STAT_OBNav_NumMarkerWidgets);
+DEFINE_STAT(STAT_OBNav_NumMarkerWidgetsCreated);
+DEFINE_STAT(STAT_OBNav_NumResidentPOIPages);
+DEFINE_STAT(STAT_OBNav_NumVisiblePOIs);
+
+CSV_DEFINE_CATEGORY(OBNavigation, true);
+
+LLM_DEFINE_TAG(OBNavigation);
 
 #define LOCTEXT_NAMESPACE "FOBNavigationModule"
 
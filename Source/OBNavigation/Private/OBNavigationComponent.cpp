@@ -3,6 +3,7 @@
 
 #include "OBNavigationComponent.h"
 
+#include "OBNavigation.h"
 #include "OBNavigationSubsystem.h"
 #include "GameFramework/Character.h"
 
@@ -24,7 +25,7 @@ void UOBNavigationComponent::BeginPlay()
 
 	if (!NavSubsystem)
 	{
-		UE_LOG(LogTemp, Error, TEXT("[%s::%hs] - OBNavigationSubsystem is not valid! Cannot perform navigation tasks."),
+		UE_LOG(LogOBNavigation, Error, TEXT("[%s::%hs] - OBNavigationSubsystem is not valid! Cannot perform navigation tasks."),
 			   *GetName(), __FUNCTION__);
 		return;
 	}
@@ -37,7 +38,7 @@ void UOBNavigationComponent::BeginPlay()
 	if (OwnerCharacter->IsLocallyControlled())
 	{
 		NavSubsystem->SetTrackedPlayerPawn(OwnerCharacter);
-		UE_LOG(LogTemp, Log, TEXT("[%s::%hs] - Local player '%s' assigned to OBNavigationSubsystem."), *GetName(),
+		UE_LOG(LogOBNavigation, Log, TEXT("[%s::%hs] - Local player '%s' assigned to OBNavigationSubsystem."), *GetName(),
 			   __FUNCTION__, *OwnerCharacter->GetName());
 	}
 
@@ -67,7 +68,7 @@ void UOBNavigationComponent::RegisterCharacterMarker()
 {
 	if (!NavSubsystem || !CharacterMapMarkerConfig || !GetOwner())
 	{
-		UE_LOG(LogTemp, Warning,
+		UE_LOG(LogOBNavigation, Warning,
 			   TEXT("[%s::%hs] - Failed to register character marker for '%s'. Subsystem, config, or owner is invalid."
 			   ), *GetName(), __FUNCTION__, *GetNameSafe(GetOwner()));
 		return;
@@ -80,12 +81,12 @@ void UOBNavigationComponent::RegisterCharacterMarker()
 															CharacterMapMarkerLayerName);
 		if (CharacterMarkerID.IsValid())
 		{
-			UE_LOG(LogTemp, Log, TEXT("[%s::%hs] - Registered character marker for '%s' (ID: %s)."), *GetName(),
+			UE_LOG(LogOBNavigation, Log, TEXT("[%s::%hs] - Registered character marker for '%s' (ID: %s)."), *GetName(),
 				   __FUNCTION__, *GetNameSafe(GetOwner()), *CharacterMarkerID.ToString());
 		}
 		else
 		{
-			UE_LOG(LogTemp, Error,
+			UE_LOG(LogOBNavigation, Error,
 				   TEXT("[%s::%hs] - Failed to register character marker for '%s'. Subsystem returned invalid ID."),
 				   *GetName(), __FUNCTION__, *GetNameSafe(GetOwner()));
 		}
@@ -96,9 +97,14 @@ void UOBNavigationComponent::UnregisterCharacterMarker()
 {
 	if (NavSubsystem && CharacterMarkerID.IsValid())
 	{
-		NavSubsystem->UnregisterMapMarker(CharacterMarkerID);
-		UE_LOG(LogTemp, Log, TEXT("[%s::%hs] - Unregistered character marker for '%s' (ID: %s)."), *GetName(),
-			   __FUNCTION__, *GetNameSafe(GetOwner()), *CharacterMarkerID.ToString());
+		// The subsystem already removes the marker when its tracked actor ends play, which runs before this
+		// component's EndPlay
+		if (NavSubsystem->HasMarker(CharacterMarkerID))
+		{
+			NavSubsystem->UnregisterMapMarker(CharacterMarkerID);
+			UE_LOG(LogOBNavigation, Log, TEXT("[%s::%hs] - Unregistered character marker for '%s' (ID: %s)."),
+				   *GetName(), __FUNCTION__, *GetNameSafe(GetOwner()), *CharacterMarkerID.ToString());
+		}
 		CharacterMarkerID.Invalidate();
 	}
 }
@@ -0,0 +1,73 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "OBNavigationDebug.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "Engine/Canvas.h"
+#include "Engine/Engine.h"
+#include "Engine/Font.h"
+#include "HAL/IConsoleManager.h"
+
+namespace
+{
+	int32 GOBNavigationDebugOverlay = 0;
+	FAutoConsoleVariableRef CVarOBNavigationDebugOverlay(
+		TEXT("OBNav.Debug.Overlay"),
+		GOBNavigationDebugOverlay,
+		TEXT("Draws the navigation subsystem and minimap state on screen (0 = off, 1 = on)."));
+}
+
+bool OBNavigation::Debug::IsOverlayEnabled()
+{
+	return GOBNavigationDebugOverlay != 0;
+}
+
+void OBNavigation::Debug::SyncOverlayRegistration(FDelegateHandle& Handle,
+                                                  const TFunctionRef<FDebugDrawDelegate()> MakeDelegate)
+{
+	if (IsOverlayEnabled() == Handle.IsValid())
+	{
+		return;
+	}
+
+	if (Handle.IsValid())
+	{
+		RemoveOverlayRegistration(Handle);
+	}
+	else
+	{
+		Handle = UDebugDrawService::Register(TEXT("Game"), MakeDelegate());
+	}
+}
+
+void OBNavigation::Debug::RemoveOverlayRegistration(FDelegateHandle& Handle)
+{
+	if (Handle.IsValid())
+	{
+		UDebugDrawService::Unregister(Handle);
+		Handle.Reset();
+	}
+}
+
+OBNavigation::Debug::FOverlayTextWriter::FOverlayTextWriter(UCanvas* InCanvas, const float InX, const float InY)
+	: Canvas(InCanvas)
+	, X(InX)
+	, Y(InY)
+{
+}
+
+void OBNavigation::Debug::FOverlayTextWriter::Line(const FColor& Color, const FString& Text)
+{
+	if (!Canvas || !GEngine)
+	{
+		return;
+	}
+
+	const UFont* Font = GEngine->GetSmallFont();
+	Canvas->SetDrawColor(Color);
+	Canvas->DrawText(Font, Text, X, Y);
+	Y += Font->GetMaxCharHeight() + 2.0f;
+}
+
+#endif // !UE_BUILD_SHIPPING
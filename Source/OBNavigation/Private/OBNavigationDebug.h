@@ -0,0 +1,42 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "Debug/DebugDrawService.h"
+#include "Templates/Function.h"
+
+class UCanvas;
+
+namespace OBNavigation::Debug
+{
+	// True while the "OBNav.Debug.Overlay" console variable is set.
+	bool IsOverlayEnabled();
+
+	/**
+	 * @brief Keeps a debug draw delegate registered exactly while the overlay is enabled. Cheap enough to call every tick.
+	 * @param Handle Handle of the registration. Reset when the delegate is unregistered.
+	 * @param MakeDelegate Creates the delegate to register. Only called when registering.
+	 */
+	void SyncOverlayRegistration(FDelegateHandle& Handle, TFunctionRef<FDebugDrawDelegate()> MakeDelegate);
+
+	// Unregisters the delegate, e.g. when its owner is torn down.
+	void RemoveOverlayRegistration(FDelegateHandle& Handle);
+
+	// Writes consecutive lines of overlay text starting at an origin on the canvas.
+	struct FOverlayTextWriter
+	{
+		FOverlayTextWriter(UCanvas* InCanvas, float InX, float InY);
+
+		void Line(const FColor& Color, const FString& Text);
+
+		UCanvas* Canvas;
+		float X;
+		float Y;
+	};
+}
+
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,14 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "OBNavigationSettings.h"
+
+UOBNavigationSettings::UOBNavigationSettings()
+{
+	CategoryName = TEXT("Plugins");
+	SectionName = TEXT("OB Navigation");
+}
+
+bool UOBNavigationSettings::ShouldUseNavigationManifest() const
+{
+	return bUseNavigationManifest && (!GIsEditor || bUseNavigationManifestInEditor);
+}
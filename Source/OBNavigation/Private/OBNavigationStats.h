@@ -0,0 +1,60 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Stats/Stats.h"
+
+// "stat OBNavigation"
+DECLARE_STATS_GROUP(TEXT("OBNavigation"), STATGROUP_OBNavigation, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Subsystem Tick"), STAT_OBNav_SubsystemTick, STATGROUP_OBNavigation, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Active Layer"), STAT_OBNav_UpdateActiveLayer, STATGROUP_OBNavigation, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Markers"), STAT_OBNav_UpdateMarkers, STATGROUP_OBNavigation, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Exploration"), STAT_OBNav_UpdateExploration, STATGROUP_OBNavigation, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Heat Maps"), STAT_OBNav_UpdateHeatMaps, STATGROUP_OBNavigation, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Line Of Sight"), STAT_OBNav_UpdateLineOfSight, STATGROUP_OBNavigation, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Regions"), STAT_OBNav_UpdateRegions, STATGROUP_OBNavigation, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Route"), STAT_OBNav_UpdateRoute, STATGROUP_OBNavigation, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Register Marker"), STAT_OBNav_RegisterMarker, STATGROUP_OBNavigation, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Unregister Marker"), STAT_OBNav_UnregisterMarker, STATGROUP_OBNavigation, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Process Marker Commands"), STAT_OBNav_ProcessMarkerCommands, STATGROUP_OBNavigation, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Map Bake"), STAT_OBNav_MapBake, STATGROUP_OBNavigation, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Publish Marker Snapshot"), STAT_OBNav_PublishMarkerSnapshot, STATGROUP_OBNavigation, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update POI Pages"), STAT_OBNav_UpdatePOIPages, STATGROUP_OBNavigation, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Minimap Tick"), STAT_OBNav_MinimapTick, STATGROUP_OBNavigation, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Minimap Markers"), STAT_OBNav_MinimapMarkers, STATGROUP_OBNavigation, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Minimap Route"), STAT_OBNav_MinimapRoute, STATGROUP_OBNavigation, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Minimap Areas"), STAT_OBNav_MinimapAreas, STATGROUP_OBNavigation, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Minimap Breadcrumbs"), STAT_OBNav_MinimapBreadcrumbs, STATGROUP_OBNavigation, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Minimap Labels"), STAT_OBNav_MinimapLabels, STATGROUP_OBNavigation, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Minimap POIs"), STAT_OBNav_MinimapPOIs, STATGROUP_OBNavigation, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Minimap Paint"), STAT_OBNav_MinimapPaint, STATGROUP_OBNavigation, );
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Markers"), STAT_OBNav_NumMarkers, STATGROUP_OBNavigation, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Visible Markers"), STAT_OBNav_NumVisibleMarkers, STATGROUP_OBNavigation, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Marker Commands"), STAT_OBNav_NumMarkerCommands, STATGROUP_OBNavigation, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Line Of Sight Traces"), STAT_OBNav_NumLineOfSightTraces,
+                                  STATGROUP_OBNavigation, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Marker Widgets"), STAT_OBNav_NumMarkerWidgets, STATGROUP_OBNavigation, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Marker Widgets Created"), STAT_OBNav_NumMarkerWidgetsCreated,
+                                  STATGROUP_OBNavigation, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Resident POI Pages"), STAT_OBNav_NumResidentPOIPages, STATGROUP_OBNavigation, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Visible POIs"), STAT_OBNav_NumVisiblePOIs, STATGROUP_OBNavigation, );
+
+// "csvprofile start" with -csvCategories=OBNavigation
+CSV_DECLARE_CATEGORY_EXTERN(OBNavigation);
+
+// "stat LLM" / -llm
+LLM_DECLARE_TAG(OBNavigation);
+
+// Cycle stat for "stat OBNavigation". Where stats are compiled out (Test builds) it still leaves an Insights scope.
+// Stat scopes already show up in Insights, so both are never emitted at once.
+#if STATS
+#define OBNAV_SCOPE_CYCLE_COUNTER(Stat) SCOPE_CYCLE_COUNTER(Stat)
+#else
+#define OBNAV_SCOPE_CYCLE_COUNTER(Stat) TRACE_CPUPROFILER_EVENT_SCOPE(Stat)
+#endif
@@ -3,44 +3,153 @@
 
 #include "OBNavigationSubsystem.h"
 
+#include "OBExplorationMask.h"
 #include "OBMapLayerAsset.h"
+#include "OBNavigation.h"
+#include "OBNavigationDebug.h"
+#include "OBNavigationSettings.h"
+#include "OBNavigationStats.h"
+#include "OBPolylineUtils.h"
+#include "Trace/OBMarkerTrace.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "Data/OBMarkerSaveData.h"
+#include "Data/OBProxyMarkerSetAsset.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Engine/AssetManager.h"
+#include "Engine/Canvas.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/FileHelper.h"
+#include "NavigationData.h"
+#include "NavigationSystem.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	// "PersistentLevel.Vendor_3" -> "Vendor_3"
+	FName GetProxyActorKey(const TSoftObjectPtr<AActor>& Actor)
+	{
+		FString SubPath = Actor.ToSoftObjectPath().GetSubPathString();
+		if (int32 DotIndex; SubPath.FindLastChar(TEXT('.'), DotIndex))
+		{
+			SubPath.RightChopInline(DotIndex + 1);
+		}
+		return FName(*SubPath);
+	}
+}
 
 void UOBNavigationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
 
-	// Load all map layer assets from the project
-	const FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(
-		"AssetRegistry");
-	TArray<FAssetData> AssetData;
-	AssetRegistryModule.Get().GetAssetsByClass(UOBMapLayerAsset::StaticClass()->GetClassPathName(), AssetData);
-
-	for (const FAssetData& Data : AssetData)
+	// The cooked manifest replaces both registry scans and the synchronous layer loads
+	if (!LoadProjectManifest())
 	{
-		if (UOBMapLayerAsset* LoadedLayer = Cast<UOBMapLayerAsset>(Data.GetAsset()))
+		// Load all map layer assets from the project
+		const FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(
+			"AssetRegistry");
+		TArray<FAssetData> AssetData;
+		AssetRegistryModule.Get().GetAssetsByClass(UOBMapLayerAsset::StaticClass()->GetClassPathName(), AssetData);
+
+		for (const FAssetData& Data : AssetData)
 		{
-			AllMapLayers.Add(LoadedLayer);
+			if (UOBMapLayerAsset* LoadedLayer = Cast<UOBMapLayerAsset>(Data.GetAsset()))
+			{
+				AllMapLayers.Add(LoadedLayer);
+			}
 		}
-	}
 
-	UE_LOG(LogTemp, Log, TEXT("[%s::%hs] - Loaded %d map layer assets."), *GetName(), __FUNCTION__, AllMapLayers.Num());
+		UE_LOG(LogOBNavigation, Log, TEXT("[%s::%hs] - Loaded %d map layer assets."), *GetName(), __FUNCTION__, AllMapLayers.Num());
+
+		// Sort layers by priority to optimize the search later
+		AllMapLayers.Sort([](const UOBMapLayerAsset& A, const UOBMapLayerAsset& B)
+		{
+			return A.Priority > B.Priority;
+		});
+
+		RebuildLayerGrid();
+
+		// Index every marker config without loading it. Sorted by package name, like the manifest, so config indices
+		// are the same whichever way the subsystem started.
+		AssetData.Reset();
+		AssetRegistryModule.Get().GetAssetsByClass(UOBMarkerConfigAsset::StaticClass()->GetClassPathName(), AssetData,
+		                                           /*bSearchSubClasses*/ true);
+		AssetData.Sort([](const FAssetData& A, const FAssetData& B)
+		{
+			return A.PackageName.LexicalLess(B.PackageName);
+		});
+
+		for (const FAssetData& Data : AssetData)
+		{
+			IndexMarkerConfig(Data.AssetName, Data.GetSoftObjectPath());
+		}
+	}
 
-	// Sort layers by priority to optimize the search later
-	AllMapLayers.Sort([](const UOBMapLayerAsset& A, const UOBMapLayerAsset& B)
+	// Stream every config in. Their icons are soft references, so this only loads the small config objects; icons
+	// follow per config when a marker uses it.
+	if (!MarkerConfigPaths.IsEmpty())
 	{
-		return A.Priority > B.Priority;
-	});
+		MarkerConfigsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MarkerConfigPaths);
+	}
+
+	UE_LOG(LogOBNavigation, Log, TEXT("[%s::%hs] - Registered %d marker configs."), *GetName(), __FUNCTION__,
+	       MarkerConfigPaths.Num());
 
-	// Register our custom tick function
-	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
-		FTickerDelegate::CreateUObject(this, &UOBNavigationSubsystem::Tick));
+	LevelAddedToWorldHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(
+		this, &UOBNavigationSubsystem::OnLevelAddedToWorld);
+
+	// The trail never allocates after this
+	const int32 MaxBreadcrumbs = GetDefault<UOBNavigationSettings>()->MaxBreadcrumbs;
+	BreadcrumbWorldPoints.SetNumZeroed(MaxBreadcrumbs);
+	BreadcrumbMapPoints.SetNumZeroed(MaxBreadcrumbs);
 }
 
 void UOBNavigationSubsystem::Deinitialize()
 {
-	// Unregister the tick function
-	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	StopTraceRecording();
+	StopTraceReplay();
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedToWorldHandle);
+
+	// Tracked actors may outlive the subsystem (e.g., across a seamless travel), so drop their notifications
+	for (const TPair<TObjectKey<AActor>, TArray<FGuid, TInlineAllocator<2>>>& Pair : TrackedActorMarkers)
+	{
+		if (AActor* Actor = Pair.Key.ResolveObjectPtrEvenIfPendingKill())
+		{
+			Actor->OnDestroyed.RemoveDynamic(this, &UOBNavigationSubsystem::OnTrackedActorDestroyed);
+			Actor->OnEndPlay.RemoveDynamic(this, &UOBNavigationSubsystem::OnTrackedActorEndPlay);
+		}
+	}
+	TrackedActorMarkers.Reset();
+	UnboundProxyMarkers.Reset();
+	LineOfSightTargets.Empty();
+	LineOfSightTargetIndices.Reset();
+	ClosePOIDatabase();
+
+	for (TPair<FObjectKey, TSharedPtr<FStreamableHandle>>& Pair : MarkerIconHandles)
+	{
+		if (Pair.Value.IsValid())
+		{
+			Pair.Value->ReleaseHandle();
+		}
+	}
+	MarkerIconHandles.Reset();
+	if (MarkerConfigsHandle.IsValid())
+	{
+		MarkerConfigsHandle->ReleaseHandle();
+		MarkerConfigsHandle.Reset();
+	}
+	if (MapLayersHandle.IsValid())
+	{
+		MapLayersHandle->ReleaseHandle();
+		MapLayersHandle.Reset();
+	}
+#if !UE_BUILD_SHIPPING
+	OBNavigation::Debug::RemoveOverlayRegistration(DebugOverlayHandle);
+#endif
 	Super::Deinitialize();
 }
 
@@ -49,7 +158,7 @@ void UOBNavigationSubsystem::SetTrackedPlayerPawn(APawn* PlayerPawn)
 	if (PlayerPawn)
 	{
 		TrackedPlayerPawn = PlayerPawn;
-		UE_LOG(LogTemp, Log, TEXT("[%s::%hs] - Now tracking pawn: %s"), *GetName(), __FUNCTION__,
+		UE_LOG(LogOBNavigation, Log, TEXT("[%s::%hs] - Now tracking pawn: %s"), *GetName(), __FUNCTION__,
 		       *PlayerPawn->GetName());
 		// Force an immediate update
 		UpdateActiveMinimapLayer();
@@ -57,268 +166,2608 @@ void UOBNavigationSubsystem::SetTrackedPlayerPawn(APawn* PlayerPawn)
 	else
 	{
 		TrackedPlayerPawn.Reset();
-		UE_LOG(LogTemp, Warning, TEXT("[%s::%hs] - Stopped tracking pawn."), *GetName(), __FUNCTION__);
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - Stopped tracking pawn."), *GetName(), __FUNCTION__);
+	}
+}
+
+bool UOBNavigationSubsystem::GetTrackedView(FOBTrackedView& OutView) const
+{
+	if (TrackedViewOverride.IsSet())
+	{
+		OutView = TrackedViewOverride.GetValue();
+		return true;
+	}
+
+	const APawn* Pawn = TrackedPlayerPawn.Get();
+	if (!Pawn)
+	{
+		return false;
 	}
+
+	OutView.Location = Pawn->GetActorLocation();
+	OutView.ActorYaw = Pawn->GetActorRotation().Yaw;
+	OutView.ControlYaw = Pawn->GetControlRotation().Yaw;
+	return true;
+}
+
+void UOBNavigationSubsystem::SetTrackedViewOverride(const FOBTrackedView& InView)
+{
+	TrackedViewOverride = InView;
+}
+
+void UOBNavigationSubsystem::ClearTrackedViewOverride()
+{
+	TrackedViewOverride.Reset();
 }
 
 FGuid UOBNavigationSubsystem::RegisterMapMarker(AActor* InTrackedActor, UOBMarkerConfigAsset* InConfig,
                                                 const FName InLayerName, const FVector InStaticLocation)
 {
+	OBNAV_SCOPE_CYCLE_COUNTER(STAT_OBNav_RegisterMarker);
+	LLM_SCOPE_BYTAG(OBNavigation);
+
 	// Ensure the config is valid before proceeding
 	if (!InConfig)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[%s::%hs] - Failed to register marker: InConfig is null."), *GetName(),
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - Failed to register marker: InConfig is null."), *GetName(),
 		       __FUNCTION__);
 		return FGuid(); // Return invalid Guid
 	}
 
-	if (InTrackedActor && TrackedActorToMarkerIDMap.Contains(InTrackedActor))
+	if (InTrackedActor && (!IsValid(InTrackedActor) || InTrackedActor->IsActorBeingDestroyed()))
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[%s::%hs] - Actor '%s' already has a registered marker. Skipping."), *GetName(), __FUNCTION__, *InTrackedActor->GetName());
-		return TrackedActorToMarkerIDMap.FindRef(InTrackedActor);
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - Failed to register marker: actor '%s' is being destroyed."),
+		       *GetName(), __FUNCTION__, *GetNameSafe(InTrackedActor));
+		return FGuid();
 	}
 
 	// Create a new marker object
-	UOBMapMarker* NewMarker = NewObject<UOBMapMarker>(this);
 	const FGuid NewGuid = FGuid::NewGuid();
+	CreateMarker(NewGuid, InTrackedActor, InConfig, InLayerName, InStaticLocation);
+
+	// Broadcast changes
+	RebuildActiveMarkersArray();
+	OnMarkersUpdated.Broadcast();
+
+	UE_LOG(LogOBNavigation, Verbose, TEXT("[%s::%hs] - Registered new marker with ID: %s"), *GetName(), __FUNCTION__,
+	       *NewGuid.ToString());
+
+	return NewGuid;
+}
 
-	NewMarker->Init(NewGuid, InTrackedActor, InConfig, InLayerName, InStaticLocation);
+bool UOBNavigationSubsystem::RegisterStaticMarkerWithID(const FGuid& MarkerID, UOBMarkerConfigAsset* InConfig,
+                                                        const FName InLayerName, const FVector& InLocation)
+{
+	OBNAV_SCOPE_CYCLE_COUNTER(STAT_OBNav_RegisterMarker);
+	LLM_SCOPE_BYTAG(OBNavigation);
 
-	// Add to our map and broadcast changes
-	ActiveMarkersMap.Add(NewGuid, NewMarker);
-	if (InTrackedActor)
+	if (!InConfig || !MarkerID.IsValid() || ActiveMarkersMap.Contains(MarkerID))
 	{
-		TrackedActorToMarkerIDMap.Add(InTrackedActor, NewGuid);
+		return false;
 	}
 
+	CreateMarker(MarkerID, nullptr, InConfig, InLayerName, InLocation);
+
 	RebuildActiveMarkersArray();
 	OnMarkersUpdated.Broadcast();
+	return true;
+}
 
-	UE_LOG(LogTemp, Log, TEXT("[%s::%hs] - Registered new marker with ID: %s"), *GetName(), __FUNCTION__,
-	       *NewGuid.ToString());
+FGuid UOBNavigationSubsystem::EnqueueRegisterMarker(AActor* InTrackedActor, UOBMarkerConfigAsset* InConfig,
+                                                   const FName InLayerName, const FVector& InStaticLocation)
+{
+	if (!InConfig)
+	{
+		return FGuid();
+	}
 
-	return NewGuid;
+	FMarkerCommand Command;
+	Command.Type = FMarkerCommand::EType::Register;
+	Command.MarkerID = FGuid::NewGuid();
+	Command.bTracksActor = InTrackedActor != nullptr;
+	Command.TrackedActor = InTrackedActor;
+	Command.Config = InConfig;
+	Command.LayerName = InLayerName;
+	Command.Location = InStaticLocation;
+
+	const FGuid MarkerID = Command.MarkerID;
+	MarkerCommands.Enqueue(MoveTemp(Command));
+	return MarkerID;
 }
 
-void UOBNavigationSubsystem::UnregisterMapMarker(const FGuid& MarkerID)
+void UOBNavigationSubsystem::EnqueueUnregisterMarker(const FGuid& MarkerID)
 {
-	if (!MarkerID.IsValid())
+	FMarkerCommand Command;
+	Command.Type = FMarkerCommand::EType::Unregister;
+	Command.MarkerID = MarkerID;
+	MarkerCommands.Enqueue(MoveTemp(Command));
+}
+
+void UOBNavigationSubsystem::EnqueueMoveMarker(const FGuid& MarkerID, const FVector& InWorldLocation,
+                                               const FVector& InVelocity)
+{
+	FMarkerCommand Command;
+	Command.Type = FMarkerCommand::EType::Move;
+	Command.MarkerID = MarkerID;
+	Command.Location = InWorldLocation;
+	Command.Velocity = InVelocity;
+	MarkerCommands.Enqueue(MoveTemp(Command));
+}
+
+void UOBNavigationSubsystem::EnqueueSetMarkerLifeTime(const FGuid& MarkerID, const float InLifeTime)
+{
+	FMarkerCommand Command;
+	Command.Type = FMarkerCommand::EType::SetLifeTime;
+	Command.MarkerID = MarkerID;
+	Command.LifeTime = FMath::Max(InLifeTime, 0.0f);
+	MarkerCommands.Enqueue(MoveTemp(Command));
+}
+
+void UOBNavigationSubsystem::ProcessMarkerCommands()
+{
+	if (MarkerCommands.IsEmpty())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[%s::%hs] - Attempted to unregister an invalid marker ID."), *GetName(),
-		       __FUNCTION__);
 		return;
 	}
 
-	// Tìm marker trước khi xóa
-	if (const auto FoundMarkerPtr = ActiveMarkersMap.Find(MarkerID))
+	OBNAV_SCOPE_CYCLE_COUNTER(STAT_OBNav_ProcessMarkerCommands);
+	LLM_SCOPE_BYTAG(OBNavigation);
+
+	int32 NumCommands = 0;
+	bool bMarkersChanged = false;
+	FMarkerCommand Command;
+	while (MarkerCommands.Dequeue(Command))
 	{
-		if (const UOBMapMarker* MarkerToRemove = *FoundMarkerPtr; MarkerToRemove && MarkerToRemove->TrackedActor.IsValid())
+		++NumCommands;
+		switch (Command.Type)
 		{
-			// Xóa khỏi map tra cứu ngược
-			TrackedActorToMarkerIDMap.Remove(MarkerToRemove->TrackedActor.Get());
+		case FMarkerCommand::EType::Register:
+			{
+				UOBMarkerConfigAsset* Config = Command.Config.Get();
+				AActor* TrackedActor = Command.TrackedActor.Get();
+				if (!Config || ActiveMarkersMap.Contains(Command.MarkerID) ||
+					(Command.bTracksActor && (!TrackedActor || TrackedActor->IsActorBeingDestroyed())))
+				{
+					UE_LOG(LogOBNavigation, Verbose, TEXT("[%s::%hs] - Dropped queued marker %s: its config or actor is gone."),
+					       *GetName(), __FUNCTION__, *Command.MarkerID.ToString());
+					break;
+				}
+				CreateMarker(Command.MarkerID, TrackedActor, Config, Command.LayerName, Command.Location);
+				bMarkersChanged = true;
+				break;
+			}
+
+		case FMarkerCommand::EType::Unregister:
+			bMarkersChanged |= RemoveMarker(Command.MarkerID);
+			break;
+
+		case FMarkerCommand::EType::Move:
+			if (UOBMapMarker* Marker = ActiveMarkersMap.FindRef(Command.MarkerID); Marker && !Marker->TrackedActor.IsValid())
+			{
+				Marker->AddPositionSample(Command.Location, Command.Velocity, GetWorldTime());
+			}
+			break;
+
+		case FMarkerCommand::EType::SetLifeTime:
+			if (UOBMapMarker* Marker = ActiveMarkersMap.FindRef(Command.MarkerID))
+			{
+				Marker->CurrentLifeTime = Command.LifeTime;
+				Marker->SetAnimationLifeTime(Command.LifeTime);
+				bHasExpiringMarkers |= Command.LifeTime > 0.0f;
+			}
+			break;
 		}
 	}
 
-	if (ActiveMarkersMap.Remove(MarkerID) > 0)
+	// A single rebuild and broadcast for the whole batch
+	if (bMarkersChanged)
+	{
+		RebuildActiveMarkersArray();
+		OnMarkersUpdated.Broadcast();
+	}
+
+	SET_DWORD_STAT(STAT_OBNav_NumMarkerCommands, NumCommands);
+}
+
+UOBMapMarker* UOBNavigationSubsystem::CreateMarker(const FGuid& InMarkerID, AActor* InTrackedActor,
+                                                   UOBMarkerConfigAsset* InConfig, const FName InLayerName,
+                                                   const FVector& InStaticLocation)
+{
+	UOBMapMarker* NewMarker = NewObject<UOBMapMarker>(this);
+	NewMarker->Init(InMarkerID, InTrackedActor, InConfig, InLayerName, InStaticLocation);
+	AddMarker(NewMarker);
+	return NewMarker;
+}
+
+void UOBNavigationSubsystem::AddMarker(UOBMapMarker* InMarker)
+{
+	ActiveMarkersMap.Add(InMarker->MarkerID, InMarker);
+	bHasExpiringMarkers |= InMarker->CurrentLifeTime > 0.0f;
+	RequestMarkerConfigIcons(InMarker->ConfigAsset);
+	if (AActor* TrackedActor = InMarker->TrackedActor.Get())
+	{
+		AddTrackedActorMarker(TrackedActor, InMarker->MarkerID);
+	}
+	// A re-added marker (e.g., a recycled ping slot) may have changed config, so its previous target is dropped
+	RemoveLineOfSightTarget(InMarker->MarkerID);
+	if (InMarker->ConfigAsset && InMarker->ConfigAsset->Visibility.bRequiresLineOfSight)
+	{
+		AddLineOfSightTarget(InMarker);
+	}
+}
+
+void UOBNavigationSubsystem::UnregisterMapMarker(const FGuid& MarkerID)
+{
+	OBNAV_SCOPE_CYCLE_COUNTER(STAT_OBNav_UnregisterMarker);
+
+	if (!MarkerID.IsValid())
+	{
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - Attempted to unregister an invalid marker ID."), *GetName(),
+		       __FUNCTION__);
+		return;
+	}
+
+	if (RemoveMarker(MarkerID))
 	{
 		// If removal was successful, update the cached array and notify the UI
 		RebuildActiveMarkersArray();
 		OnMarkersUpdated.Broadcast();
-		UE_LOG(LogTemp, Log, TEXT("[%s::%hs] - Unregistered marker with ID: %s"), *GetName(), __FUNCTION__,
+		UE_LOG(LogOBNavigation, Verbose, TEXT("[%s::%hs] - Unregistered marker with ID: %s"), *GetName(), __FUNCTION__,
 		       *MarkerID.ToString());
 	}
 	else
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[%s::%hs] - Could not find marker with ID to unregister: %s"), *GetName(),
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - Could not find marker with ID to unregister: %s"), *GetName(),
 		       __FUNCTION__, *MarkerID.ToString());
 	}
 }
 
-FGuid UOBNavigationSubsystem::GetMarkerIDForActor(AActor* InActor) const
+void UOBNavigationSubsystem::SetMarkerLabel(const FGuid& MarkerID, const FText& InLabel)
 {
-	if (InActor)
+	if (UOBMapMarker* Marker = ActiveMarkersMap.FindRef(MarkerID))
 	{
-		return TrackedActorToMarkerIDMap.FindRef(InActor);
+		Marker->Label = InLabel;
 	}
-	return FGuid();
 }
 
-void UOBNavigationSubsystem::RebuildActiveMarkersArray()
+void UOBNavigationSubsystem::SetMarkerPositionSample(const FGuid& MarkerID, const FVector InLocation,
+                                                     const FVector InVelocity)
 {
-	// Clear the old array
-	ActiveMarkers.Empty();
-	// Re-populate the array with the current values from the map
-	ActiveMarkersMap.GenerateValueArray(ActiveMarkers);
+	if (UOBMapMarker* Marker = ActiveMarkersMap.FindRef(MarkerID); Marker && !Marker->TrackedActor.IsValid())
+	{
+		Marker->AddPositionSample(InLocation, InVelocity, GetWorldTime());
+	}
 }
 
-bool UOBNavigationSubsystem::WorldToMapUV(const UOBMapLayerAsset* MapLayer, const FVector& WorldLocation,
-                                          FVector2D& OutMapUV) const
+bool UOBNavigationSubsystem::RemoveMarker(const FGuid& InMarkerID)
 {
-	if (!MapLayer)
+	// Tìm marker trước khi xóa
+	if (const auto FoundMarkerPtr = ActiveMarkersMap.Find(InMarkerID))
 	{
-		return false;
+		// The actor is still resolvable while its OnDestroyed/OnEndPlay notifications are running
+		if (const UOBMapMarker* MarkerToRemove = *FoundMarkerPtr; MarkerToRemove)
+		{
+			if (AActor* TrackedActor = MarkerToRemove->TrackedActor.Get(/*bEvenIfPendingKill*/ true))
+			{
+				// Xóa khỏi map tra cứu ngược
+				RemoveTrackedActorMarker(TrackedActor, InMarkerID);
+			}
+			else if (MarkerToRemove->IsProxy())
+			{
+				const FName ProxyKey = GetProxyActorKey(MarkerToRemove->ProxyActor);
+				if (TArray<FGuid, TInlineAllocator<1>>* ProxyMarkerIDs = UnboundProxyMarkers.Find(ProxyKey))
+				{
+					ProxyMarkerIDs->RemoveSingle(InMarkerID);
+					if (ProxyMarkerIDs->IsEmpty())
+					{
+						UnboundProxyMarkers.Remove(ProxyKey);
+					}
+				}
+			}
+		}
 	}
 
-	const FBox& Bounds = MapLayer->WorldBounds;
-	if (!Bounds.IsInsideXY(WorldLocation))
+	RemoveLineOfSightTarget(InMarkerID);
+	return ActiveMarkersMap.Remove(InMarkerID) > 0;
+}
+
+void UOBNavigationSubsystem::AddTrackedActorMarker(AActor* InActor, const FGuid& InMarkerID)
+{
+	TArray<FGuid, TInlineAllocator<2>>& MarkerIDs = TrackedActorMarkers.FindOrAdd(InActor);
+	if (MarkerIDs.IsEmpty())
 	{
-		return false;
+		InActor->OnDestroyed.AddUniqueDynamic(this, &UOBNavigationSubsystem::OnTrackedActorDestroyed);
+		InActor->OnEndPlay.AddUniqueDynamic(this, &UOBNavigationSubsystem::OnTrackedActorEndPlay);
 	}
+	MarkerIDs.Add(InMarkerID);
+}
 
-	const FVector WorldSize = Bounds.GetSize();
-	if (FMath::IsNearlyZero(WorldSize.X) || FMath::IsNearlyZero(WorldSize.Y))
+void UOBNavigationSubsystem::RemoveTrackedActorMarker(AActor* InActor, const FGuid& InMarkerID)
+{
+	TArray<FGuid, TInlineAllocator<2>>* MarkerIDs = TrackedActorMarkers.Find(InActor);
+	if (!MarkerIDs)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[%s::%hs] - MapLayer '%s' has zero size on X or Y axis."), *GetName(),
-		       __FUNCTION__, *MapLayer->GetName());
-		return false;
+		return;
 	}
 
-	const double LocalX = WorldLocation.X - Bounds.Min.X;
-	const double LocalY = WorldLocation.Y - Bounds.Min.Y;
-
-	// STANDARD MAPPING:
-	// World +Y (Right) maps to the horizontal U coordinate.
-	OutMapUV.X = LocalY / WorldSize.Y;
-
-	// World +X (Forward/North) maps to the vertical V coordinate.
-	// We flip it so North (+X) is at the top of the map (V=0).
-	OutMapUV.Y = 1.0 - (LocalX / WorldSize.X);
+	MarkerIDs->RemoveSingle(InMarkerID);
+	if (MarkerIDs->IsEmpty())
+	{
+		TrackedActorMarkers.Remove(InActor);
+		InActor->OnDestroyed.RemoveDynamic(this, &UOBNavigationSubsystem::OnTrackedActorDestroyed);
+		InActor->OnEndPlay.RemoveDynamic(this, &UOBNavigationSubsystem::OnTrackedActorEndPlay);
+	}
+}
 
-	// // --- DEBUG LOG ---
-	// if (GEngine)
-	// {
-	// 	const FString DebugMsg = FString::Printf(
-	// 		TEXT("[WorldToMapUV] WorldLoc: %s -> UV: %s"), *WorldLocation.ToString(), *OutMapUV.ToString());
-	// 	GEngine->AddOnScreenDebugMessage(-1, 0.0f, FColor::Green, DebugMsg);
-	// }
+void UOBNavigationSubsystem::OnTrackedActorDestroyed(AActor* DestroyedActor)
+{
+	ReleaseTrackedActor(DestroyedActor, false);
+}
 
-	return true;
+void UOBNavigationSubsystem::OnTrackedActorEndPlay(AActor* Actor, const EEndPlayReason::Type EndPlayReason)
+{
+	// Covers level streaming and world teardown, where actors leave play without being destroyed.
+	// An actor streamed out (e.g., with its World Partition cell) comes back later, so its proxy markers stay.
+	ReleaseTrackedActor(Actor, EndPlayReason == EEndPlayReason::RemovedFromWorld);
 }
 
-bool UOBNavigationSubsystem::Tick(float DeltaTime)
+void UOBNavigationSubsystem::ReleaseTrackedActor(AActor* InActor, const bool bKeepProxyMarkers)
 {
-	// Get the world context
-	const UWorld* MyWorld = GetWorld();
-	if (!MyWorld)
+	const TArray<FGuid, TInlineAllocator<2>>* MarkerIDs = TrackedActorMarkers.Find(InActor);
+	if (!MarkerIDs)
 	{
-		return true; // Cannot proceed without a world, but keep the ticker alive
+		return;
 	}
 
-	// Get the current network mode
-
-	// Update the active layer based on the tracked pawn.
-	// This is purely client-side visual logic and should not run on a dedicated server.
-	// It will run on NM_Client (a client connected to a dedicated server)
-	// and NM_ListenServer (the server that is also a player).
-	// NM_Standalone is also effectively a client.
-	if (const ENetMode NetMode = MyWorld->GetNetMode(); NetMode != NM_DedicatedServer)
+	// RemoveMarker and UnbindProxyMarker shrink the index entry, so iterate over a copy
+	const TArray<FGuid, TInlineAllocator<2>> ActorMarkerIDs = *MarkerIDs;
+	int32 NumRemoved = 0;
+	for (const FGuid& MarkerID : ActorMarkerIDs)
 	{
-		if (TrackedPlayerPawn.IsValid())
+		UOBMapMarker* Marker = ActiveMarkersMap.FindRef(MarkerID);
+		if (bKeepProxyMarkers && Marker && Marker->IsProxy())
 		{
-			UpdateActiveMinimapLayer();
+			UnbindProxyMarker(Marker, InActor);
+		}
+		else if (RemoveMarker(MarkerID))
+		{
+			++NumRemoved;
 		}
 	}
 
-	// Update all registered markers (position, lifetime, etc.).
-	// This needs to run on all instances:
-	// - Clients need it to update visual positions.
-	// - Server needs it to manage authoritative markers (like Ping lifetime).
-	UpdateAllMarkers(DeltaTime);
-
-	return true; // Keep the ticker registered
-}
+	UE_LOG(LogOBNavigation, Verbose, TEXT("[%s::%hs] - Actor '%s' left play. Removed %d of %d marker(s)."), *GetName(),
+	       __FUNCTION__, *GetNameSafe(InActor), NumRemoved, ActorMarkerIDs.Num());
 
-void UOBNavigationSubsystem::UpdateActiveMinimapLayer()
-{
-	if (!TrackedPlayerPawn.IsValid())
+	// Unbound proxy markers are still registered, so only removals change the marker list
+	if (NumRemoved > 0)
 	{
-		return;
+		RebuildActiveMarkersArray();
+		OnMarkersUpdated.Broadcast();
 	}
+}
 
-	const FVector PawnLocation = TrackedPlayerPawn->GetActorLocation();
-	UOBMapLayerAsset* BestLayer = nullptr;
+FGuid UOBNavigationSubsystem::RegisterProxyMarker(const TSoftObjectPtr<AActor>& InActor, UOBMarkerConfigAsset* InConfig,
+                                                  const FName InLayerName, const FVector InLocation)
+{
+	OBNAV_SCOPE_CYCLE_COUNTER(STAT_OBNav_RegisterMarker);
+	LLM_SCOPE_BYTAG(OBNavigation);
 
-	// Since the array is pre-sorted by priority, the first valid layer we find is the best one.
-	for (UOBMapLayerAsset* Layer : AllMapLayers)
+	UOBMapMarker* Marker = CreateProxyMarker(InActor, InConfig, InLayerName, InLocation);
+	if (!Marker)
 	{
-		if (Layer && Layer->WorldBounds.IsInsideXY(PawnLocation))
-		{
-			BestLayer = Layer;
-			break; // Found the highest priority layer
-		}
+		return FGuid();
 	}
 
-	// If the best layer has changed, update it and notify listeners
-	if (BestLayer != CurrentMinimapLayer)
+	// An actor that is already loaded binds right away, later ones when their level streams in
+	if (AActor* Actor = InActor.Get(); IsValid(Actor) && !Actor->IsActorBeingDestroyed())
 	{
-		CurrentMinimapLayer = BestLayer;
-		UE_LOG(LogTemp, Log, TEXT("[%s::%hs] - Minimap layer changed to: %s"), *GetName(), __FUNCTION__,
-		       BestLayer ? *BestLayer->GetName() : TEXT("None"));
-		OnMinimapLayerChanged.Broadcast(CurrentMinimapLayer);
+		BindProxyMarker(Marker, Actor);
 	}
+
+	RebuildActiveMarkersArray();
+	OnMarkersUpdated.Broadcast();
+	return Marker->MarkerID;
 }
 
-void UOBNavigationSubsystem::UpdateAllMarkers(const float DeltaTime)
+int32 UOBNavigationSubsystem::RegisterProxyMarkerSet(const UOBProxyMarkerSetAsset* InSet, TArray<FGuid>& OutMarkerIDs)
 {
-	// A list to store IDs of markers that need to be removed (e.g., expired lifetime)
-	TArray<FGuid> MarkersToRemove;
+	OBNAV_SCOPE_CYCLE_COUNTER(STAT_OBNav_RegisterMarker);
+	LLM_SCOPE_BYTAG(OBNavigation);
 
-	// Iterate through all active markers using the TMap for efficiency
-	for (auto& Pair : ActiveMarkersMap)
+	OutMarkerIDs.Reset();
+	if (!InSet)
 	{
-		UOBMapMarker* Marker = Pair.Value;
-		if (!Marker)
-		{
-			// This case should be rare but good to handle. Mark for removal.
-			MarkersToRemove.Add(Pair.Key);
-			continue;
-		}
-
-		// --- 1. Update Position ---
-		// Call the marker's own update logic.
-		Marker->UpdateLocation();
+		return 0;
+	}
 
-		// --- 2. Update Lifetime ---
-		// If the marker has a limited lifetime (e.g., Pings)
-		if (Marker->CurrentLifeTime > 0.0f)
+	OutMarkerIDs.Reserve(InSet->Markers.Num());
+	for (const FOBProxyMarkerEntry& Entry : InSet->Markers)
+	{
+		if (const UOBMapMarker* Marker = CreateProxyMarker(Entry.Actor, Entry.Config, Entry.LayerName, Entry.Location))
 		{
-			Marker->CurrentLifeTime -= DeltaTime;
-			if (Marker->CurrentLifeTime <= 0.0f)
-			{
-				// Mark for removal if lifetime has expired
-				MarkersToRemove.Add(Pair.Key);
-			}
+			OutMarkerIDs.Add(Marker->MarkerID);
 		}
+	}
 
-		// --- 3. (Optional) Check for invalid tracked actors ---
-		// If a marker is tracking an actor that has been destroyed.
-		if (Marker->TrackedActor.IsStale() && !Marker->TrackedActor.IsValid())
+	// One pass over the loaded levels binds every actor of the set that is already loaded
+	if (const UWorld* World = GetWorld(); World && !OutMarkerIDs.IsEmpty())
+	{
+		for (const ULevel* Level : World->GetLevels())
 		{
-			// Depending on the design, you might want to remove the marker or keep it at its last known location.
-			// For now, let's remove it.
-			UE_LOG(LogTemp, Log, TEXT("[%s::%hs] - Tracked actor for marker %s is stale. Removing marker."), *GetName(),
-			       __FUNCTION__, *Marker->MarkerID.ToString());
-			MarkersToRemove.Add(Pair.Key);
+			BindProxyMarkers(Level);
 		}
 	}
 
-	// --- Cleanup ---
-	// Remove all markers that were marked for removal in a single batch operation.
-	// This is safer than removing them during the loop.
-	if (!MarkersToRemove.IsEmpty())
+	if (!OutMarkerIDs.IsEmpty())
+	{
+		RebuildActiveMarkersArray();
+		OnMarkersUpdated.Broadcast();
+	}
+
+	UE_LOG(LogOBNavigation, Log, TEXT("[%s::%hs] - Registered %d proxy markers from '%s'."), *GetName(), __FUNCTION__,
+	       OutMarkerIDs.Num(), *InSet->GetName());
+	return OutMarkerIDs.Num();
+}
+
+UOBMapMarker* UOBNavigationSubsystem::CreateProxyMarker(const TSoftObjectPtr<AActor>& InActor,
+                                                        UOBMarkerConfigAsset* InConfig, const FName InLayerName,
+                                                        const FVector& InLocation)
+{
+	if (!InConfig || InActor.IsNull())
+	{
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - Failed to register proxy marker for '%s': %s is null."),
+		       *GetName(), __FUNCTION__, *InActor.ToString(), InConfig ? TEXT("the actor") : TEXT("the config"));
+		return nullptr;
+	}
+
+	UOBMapMarker* Marker = CreateMarker(FGuid::NewGuid(), nullptr, InConfig, InLayerName, InLocation);
+	Marker->ProxyActor = InActor;
+	UnboundProxyMarkers.FindOrAdd(GetProxyActorKey(InActor)).Add(Marker->MarkerID);
+	return Marker;
+}
+
+void UOBNavigationSubsystem::BindProxyMarker(UOBMapMarker* Marker, AActor* Actor)
+{
+	const FName ProxyKey = GetProxyActorKey(Marker->ProxyActor);
+	if (TArray<FGuid, TInlineAllocator<1>>* ProxyMarkerIDs = UnboundProxyMarkers.Find(ProxyKey))
+	{
+		ProxyMarkerIDs->RemoveSingle(Marker->MarkerID);
+		if (ProxyMarkerIDs->IsEmpty())
+		{
+			UnboundProxyMarkers.Remove(ProxyKey);
+		}
+	}
+
+	Marker->TrackedActor = Actor;
+	Marker->ResetPositionSamples();
+	Marker->UpdateLocation(GetWorldTime());
+	AddTrackedActorMarker(Actor, Marker->MarkerID);
+}
+
+void UOBNavigationSubsystem::UnbindProxyMarker(UOBMapMarker* Marker, AActor* Actor)
+{
+	// Keep the marker where the actor was last seen, without extrapolating it any further
+	Marker->UpdateLocation(GetWorldTime());
+	Marker->ResetPositionSamples();
+	Marker->TrackedActor.Reset();
+	RemoveTrackedActorMarker(Actor, Marker->MarkerID);
+	UnboundProxyMarkers.FindOrAdd(GetProxyActorKey(Marker->ProxyActor)).Add(Marker->MarkerID);
+}
+
+void UOBNavigationSubsystem::OnLevelAddedToWorld(ULevel* InLevel, UWorld* InWorld)
+{
+	if (InWorld == GetWorld())
+	{
+		BindProxyMarkers(InLevel);
+	}
+}
+
+void UOBNavigationSubsystem::BindProxyMarkers(const ULevel* InLevel)
+{
+	if (!InLevel || UnboundProxyMarkers.IsEmpty())
+	{
+		return;
+	}
+
+	for (AActor* Actor : InLevel->Actors)
+	{
+		if (!IsValid(Actor))
+		{
+			continue;
+		}
+
+		const TArray<FGuid, TInlineAllocator<1>>* ProxyMarkerIDs = UnboundProxyMarkers.Find(Actor->GetFName());
+		if (!ProxyMarkerIDs)
+		{
+			continue;
+		}
+
+		// BindProxyMarker shrinks the entry, so iterate over a copy
+		const TArray<FGuid, TInlineAllocator<1>> MarkerIDs = *ProxyMarkerIDs;
+		for (const FGuid& MarkerID : MarkerIDs)
+		{
+			if (UOBMapMarker* Marker = ActiveMarkersMap.FindRef(MarkerID))
+			{
+				BindProxyMarker(Marker, Actor);
+			}
+		}
+	}
+}
+
+void UOBNavigationSubsystem::IndexMarkerConfig(const FName AssetName, const FSoftObjectPath& ConfigPath)
+{
+	if (MarkerConfigIndices.Contains(AssetName))
+	{
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - Marker config name '%s' is not unique. '%s' can only be used by pointer."),
+		       *GetName(), __FUNCTION__, *AssetName.ToString(), *ConfigPath.ToString());
+		return;
+	}
+	MarkerConfigIndices.Add(AssetName, MarkerConfigPaths.Add(ConfigPath));
+}
+
+UOBMarkerConfigAsset* UOBNavigationSubsystem::FindMarkerConfig(const FName ConfigName) const
+{
+	const int32* Index = MarkerConfigIndices.Find(ConfigName);
+	if (!Index)
+	{
+		return nullptr;
+	}
+	if (UOBMarkerConfigAsset* Config = GetMarkerConfigByIndex(*Index))
+	{
+		return Config;
+	}
+
+	// Callers need the config now. Only happens while the initial streaming is still in flight.
+	UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - Marker config '%s' requested before it finished streaming in. Loading it synchronously."),
+	       *GetName(), __FUNCTION__, *MarkerConfigPaths[*Index].ToString());
+	return Cast<UOBMarkerConfigAsset>(UAssetManager::GetStreamableManager().LoadSynchronous(MarkerConfigPaths[*Index]));
+}
+
+int32 UOBNavigationSubsystem::GetMarkerConfigIndex(const UOBMarkerConfigAsset* InConfig) const
+{
+	if (const int32* Index = InConfig ? MarkerConfigIndices.Find(InConfig->GetFName()) : nullptr;
+		Index && MarkerConfigPaths[*Index] == FSoftObjectPath(InConfig))
+	{
+		return *Index;
+	}
+	return INDEX_NONE;
+}
+
+UOBMarkerConfigAsset* UOBNavigationSubsystem::GetMarkerConfigByIndex(const int32 Index) const
+{
+	if (!MarkerConfigPaths.IsValidIndex(Index))
+	{
+		return nullptr;
+	}
+
+	return Cast<UOBMarkerConfigAsset>(MarkerConfigPaths[Index].ResolveObject());
+}
+
+void UOBNavigationSubsystem::RequestMarkerConfigIcons(const UOBMarkerConfigAsset* InConfig)
+{
+	// Icons are only displayed by widgets, which a dedicated server never creates
+	if (!InConfig || IsRunningDedicatedServer() || InConfig->AreIconsLoaded() || MarkerIconHandles.Contains(InConfig))
+	{
+		return;
+	}
+
+	TArray<FSoftObjectPath> IconPaths;
+	InConfig->GetIconPaths(IconPaths);
+	MarkerIconHandles.Add(InConfig, UAssetManager::GetStreamableManager().RequestAsyncLoad(IconPaths));
+}
+
+FGuid UOBNavigationSubsystem::GetMarkerIDForActor(AActor* InActor) const
+{
+	if (const TArray<FGuid, TInlineAllocator<2>>* MarkerIDs = TrackedActorMarkers.Find(InActor);
+		MarkerIDs && !MarkerIDs->IsEmpty())
+	{
+		return (*MarkerIDs)[0];
+	}
+	return FGuid();
+}
+
+TArray<FGuid> UOBNavigationSubsystem::GetMarkerIDsForActor(AActor* InActor) const
+{
+	if (const TArray<FGuid, TInlineAllocator<2>>* MarkerIDs = TrackedActorMarkers.Find(InActor))
+	{
+		return TArray<FGuid>(*MarkerIDs);
+	}
+	return TArray<FGuid>();
+}
+
+void UOBNavigationSubsystem::RebuildActiveMarkersArray()
+{
+	// Clear the old array
+	ActiveMarkers.Empty();
+	// Re-populate the array with the current values from the map
+	ActiveMarkersMap.GenerateValueArray(ActiveMarkers);
+}
+
+const FBox& UOBNavigationSubsystem::GetLayerBounds(const UOBMapLayerAsset* MapLayer) const
+{
+	check(MapLayer);
+	const FBox* OverrideBounds = LayerBoundsOverrides.IsEmpty() ? nullptr : LayerBoundsOverrides.Find(MapLayer);
+	return OverrideBounds ? *OverrideBounds : MapLayer->WorldBounds;
+}
+
+bool UOBNavigationSubsystem::WorldToMapUV(const UOBMapLayerAsset* MapLayer, const FVector& WorldLocation,
+                                          FVector2D& OutMapUV) const
+{
+	if (!MapLayer)
+	{
+		return false;
+	}
+
+	const FBox& Bounds = GetLayerBounds(MapLayer);
+	if (!Bounds.IsInsideXY(WorldLocation))
+	{
+		return false;
+	}
+
+	const FVector WorldSize = Bounds.GetSize();
+	if (FMath::IsNearlyZero(WorldSize.X) || FMath::IsNearlyZero(WorldSize.Y))
+	{
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - MapLayer '%s' has zero size on X or Y axis."), *GetName(),
+		       __FUNCTION__, *MapLayer->GetName());
+		return false;
+	}
+
+	const double LocalX = WorldLocation.X - Bounds.Min.X;
+	const double LocalY = WorldLocation.Y - Bounds.Min.Y;
+
+	// STANDARD MAPPING:
+	// World +Y (Right) maps to the horizontal U coordinate.
+	OutMapUV.X = LocalY / WorldSize.Y;
+
+	// World +X (Forward/North) maps to the vertical V coordinate.
+	// We flip it so North (+X) is at the top of the map (V=0).
+	OutMapUV.Y = 1.0 - (LocalX / WorldSize.X);
+
+	// // --- DEBUG LOG ---
+	// if (GEngine)
+	// {
+	// 	const FString DebugMsg = FString::Printf(
+	// 		TEXT("[WorldToMapUV] WorldLoc: %s -> UV: %s"), *WorldLocation.ToString(), *OutMapUV.ToString());
+	// 	GEngine->AddOnScreenDebugMessage(-1, 0.0f, FColor::Green, DebugMsg);
+	// }
+
+	return true;
+}
+
+void UOBNavigationSubsystem::Tick(float DeltaTime)
+{
+	OBNAV_SCOPE_CYCLE_COUNTER(STAT_OBNav_SubsystemTick);
+	LLM_SCOPE_BYTAG(OBNavigation);
+
+	// Get the world context
+	const UWorld* MyWorld = GetWorld();
+	if (!MyWorld)
+	{
+		return; // Cannot proceed without a world
+	}
+
+	// A replay feeds the recorded frame (markers, view) before anything is updated, with the recorded frame time
+	if (TraceReplayer.IsValid())
+	{
+		if (!TraceReplayer->ApplyNextFrame(DeltaTime) && !(bLoopTraceReplay && TraceReplayer->Restart() &&
+			TraceReplayer->ApplyNextFrame(DeltaTime)))
+		{
+			StopTraceReplay();
+		}
+	}
+
+	ProcessMarkerCommands();
+
+	// Get the current network mode
+
+	// Update the active layer based on the tracked pawn.
+	// This is purely client-side visual logic and should not run on a dedicated server.
+	// It will run on NM_Client (a client connected to a dedicated server)
+	// and NM_ListenServer (the server that is also a player).
+	// NM_Standalone is also effectively a client.
+	if (const ENetMode NetMode = MyWorld->GetNetMode(); NetMode != NM_DedicatedServer)
+	{
+		UpdateActiveMinimapLayer();
+	}
+
+	// Update all registered markers (position, lifetime, etc.).
+	// This needs to run on all instances:
+	// - Clients need it to update visual positions.
+	// - Server needs it to manage authoritative markers (like Ping lifetime).
+	UpdateAllMarkers(DeltaTime);
+
+	// Region events drive gameplay (e.g., discovery on the server), so they are evaluated in every net mode.
+	UpdateRegions();
+
+	// POI streaming, exploration, line of sight and route guidance only feed the minimap, so a dedicated server has
+	// nothing to do here.
+	if (MyWorld->GetNetMode() != NM_DedicatedServer)
+	{
+		UpdatePOIPages();
+		UpdateLineOfSight();
+		UpdateExploration();
+		UpdateHeatMaps();
+		UpdateBreadcrumbs();
+		UpdateRoute();
+	}
+
+	if (TraceRecorder.IsValid())
+	{
+		TraceRecorder->CaptureFrame(*this, DeltaTime);
+	}
+
+	// Last, so readers see the complete state of the frame (including line of sight)
+	if (HasMarkerSnapshotReaders())
+	{
+		PublishMarkerSnapshot();
+	}
+
+	SET_DWORD_STAT(STAT_OBNav_NumMarkers, ActiveMarkers.Num());
+	CSV_CUSTOM_STAT(OBNavigation, Markers, ActiveMarkers.Num(), ECsvCustomStatOp::Set);
+
+#if !UE_BUILD_SHIPPING
+	OBNavigation::Debug::SyncOverlayRegistration(DebugOverlayHandle, [this]
+	{
+		return FDebugDrawDelegate::CreateUObject(this, &UOBNavigationSubsystem::DrawDebugOverlay);
+	});
+#endif
+}
+
+bool UOBNavigationSubsystem::IsTickNeeded() const
+{
+	return TrackedPlayerPawn.IsValid() || TrackedViewOverride.IsSet() || TraceRecorder.IsValid() ||
+		TraceReplayer.IsValid() || bHasExpiringMarkers || bHasHeatMapUpdates ||
+		(!LineOfSightTargets.IsEmpty() && GetWorld() && GetWorld()->GetNetMode() != NM_DedicatedServer) ||
+		(!Regions.IsEmpty() && (!RegionTrackers.IsEmpty() || TrackedPawnRegionTracker.Actor.IsValid())) ||
+		!TrackedPawnRegionTracker.Regions.IsEmpty() || !PendingRegionEvents.IsEmpty() ||
+		bRegionIndexDirty || !MarkerCommands.IsEmpty() || HasMarkerSnapshotReaders() ||
+		(POIViewRegion.IsSet() && POIDatabase.IsOpen());
+}
+
+void UOBNavigationSubsystem::PublishMarkerSnapshot()
+{
+	OBNAV_SCOPE_CYCLE_COUNTER(STAT_OBNav_PublishMarkerSnapshot);
+
+	// Markers share a handful of configs, so each one is resolved once per publication rather than once per marker
+	TMap<const UOBMarkerConfigAsset*, int32, TInlineSetAllocator<16>> ConfigIndices;
+	MarkerSnapshots->Publish([this, &ConfigIndices](OBNavigation::Snapshots::FMarkerSnapshot& Snapshot)
+	{
+		Snapshot.FrameNumber = GFrameCounter;
+		Snapshot.WorldTime = GetWorldTime();
+		Snapshot.MinimapLayerName = CurrentMinimapLayer ? CurrentMinimapLayer->GetFName() : NAME_None;
+
+		// The slot holds an older snapshot; its array keeps its capacity
+		Snapshot.Markers.Reset(ActiveMarkers.Num());
+		for (const UOBMapMarker* Marker : ActiveMarkers)
+		{
+			if (!Marker)
+			{
+				continue;
+			}
+
+			const UOBMarkerConfigAsset* Config = Marker->ConfigAsset;
+			const int32* ConfigIndex = ConfigIndices.Find(Config);
+			if (!ConfigIndex)
+			{
+				ConfigIndex = &ConfigIndices.Add(Config, GetMarkerConfigIndex(Config));
+			}
+
+			OBNavigation::Snapshots::FMarkerSnapshotEntry& Entry = Snapshot.Markers.AddDefaulted_GetRef();
+			Entry.MarkerID = Marker->MarkerID;
+			Entry.WorldLocation = Marker->WorldLocation;
+			Entry.LayerName = Marker->MarkerLayerName;
+			Entry.ConfigIndex = *ConfigIndex;
+			Entry.RemainingLifeTime = FMath::Max(Marker->CurrentLifeTime, 0.0f);
+			Entry.bTracksActor = Marker->TrackedActor.IsValid();
+			Entry.bHiddenByLineOfSight = Marker->bHiddenByLineOfSight;
+		}
+	});
+}
+
+void UOBNavigationSubsystem::UpdateActiveMinimapLayer()
+{
+	OBNAV_SCOPE_CYCLE_COUNTER(STAT_OBNav_UpdateActiveLayer);
+
+	FOBTrackedView View;
+	if (!GetTrackedView(View))
+	{
+		return;
+	}
+
+	UOBMapLayerAsset* BestLayer = FindBestLayerForLocation(View.Location);
+
+	// If the best layer has changed, update it and notify listeners
+	if (BestLayer != CurrentMinimapLayer)
+	{
+		CurrentMinimapLayer = BestLayer;
+		CSV_CUSTOM_STAT(OBNavigation, LayerSwitches, 1, ECsvCustomStatOp::Accumulate);
+		UE_LOG(LogOBNavigation, Log, TEXT("[%s::%hs] - Minimap layer changed to: %s"), *GetName(), __FUNCTION__,
+		       BestLayer ? *BestLayer->GetName() : TEXT("None"));
+		OnMinimapLayerChanged.Broadcast(CurrentMinimapLayer);
+	}
+}
+
+void UOBNavigationSubsystem::UpdateAllMarkers(const float DeltaTime)
+{
+	OBNAV_SCOPE_CYCLE_COUNTER(STAT_OBNav_UpdateMarkers);
+
+	// A list to store IDs of markers that need to be removed (e.g., expired lifetime)
+	TArray<FGuid> MarkersToRemove;
+	bHasExpiringMarkers = false;
+	const double WorldTime = GetWorldTime();
+
+	// Iterate through all active markers using the TMap for efficiency
+	for (auto& Pair : ActiveMarkersMap)
+	{
+		UOBMapMarker* Marker = Pair.Value;
+		if (!Marker)
+		{
+			// This case should be rare but good to handle. Mark for removal.
+			MarkersToRemove.Add(Pair.Key);
+			continue;
+		}
+
+		// --- 1. Update Position ---
+		// Call the marker's own update logic.
+		Marker->UpdateLocation(WorldTime);
+
+		// --- 2. Update Lifetime ---
+		// If the marker has a limited lifetime (e.g., Pings)
+		if (Marker->CurrentLifeTime > 0.0f)
+		{
+			Marker->CurrentLifeTime -= DeltaTime;
+			if (Marker->CurrentLifeTime <= 0.0f)
+			{
+				// Mark for removal if lifetime has expired
+				MarkersToRemove.Add(Pair.Key);
+			}
+			else
+			{
+				bHasExpiringMarkers = true;
+			}
+		}
+	}
+
+	// --- Cleanup ---
+	// Remove all markers that were marked for removal in a single batch operation.
+	// This is safer than removing them during the loop.
+	if (!MarkersToRemove.IsEmpty())
 	{
 		for (const FGuid& MarkerID : MarkersToRemove)
 		{
-			// Use the existing Unregister function, but we can optimize by not broadcasting for every single one.
-			if (ActiveMarkersMap.Remove(MarkerID) > 0)
-			{
-				UE_LOG(LogTemp, Log, TEXT("[%s::%hs] - Automatically unregistered marker with ID: %s"), *GetName(),
-				       __FUNCTION__, *MarkerID.ToString());
-			}
+			// Same removal as UnregisterMapMarker, but with a single rebuild and broadcast for the whole batch.
+			if (RemoveMarker(MarkerID))
+			{
+				UE_LOG(LogOBNavigation, Verbose, TEXT("[%s::%hs] - Automatically unregistered marker with ID: %s"), *GetName(),
+				       __FUNCTION__, *MarkerID.ToString());
+			}
+		}
+
+		// After removing, rebuild the array and broadcast a single update.
+		RebuildActiveMarkersArray();
+		OnMarkersUpdated.Broadcast();
+	}
+}
+
+UOBMapLayerAsset* UOBNavigationSubsystem::FindBestLayerForLocation(const FVector& WorldLocation) const
+{
+	// The grid only tests the layers overlapping the location's cell, in priority order. A manifest layer that has
+	// not streamed in yet resolves to no layer rather than to a lower priority one.
+	const int32 LayerIndex = LayerGrid.FindLayer(WorldLocation);
+	return AllMapLayers.IsValidIndex(LayerIndex) ? AllMapLayers[LayerIndex].Get() : nullptr;
+}
+
+void UOBNavigationSubsystem::RegisterExplorationRevealer(AActor* InRevealer, const float InRevealRadius)
+{
+	if (!InRevealer)
+	{
+		return;
+	}
+
+	// Re-registering only updates the radius
+	for (FExplorationRevealer& Revealer : ExplorationRevealers)
+	{
+		if (Revealer.Actor == InRevealer)
+		{
+			Revealer.RevealRadius = InRevealRadius;
+			Revealer.LastCell = FIntPoint(INDEX_NONE, INDEX_NONE);
+			return;
+		}
+	}
+
+	FExplorationRevealer& NewRevealer = ExplorationRevealers.AddDefaulted_GetRef();
+	NewRevealer.Actor = InRevealer;
+	NewRevealer.RevealRadius = InRevealRadius;
+}
+
+void UOBNavigationSubsystem::UnregisterExplorationRevealer(AActor* InRevealer)
+{
+	ExplorationRevealers.RemoveAllSwap([InRevealer](const FExplorationRevealer& Revealer)
+	{
+		return Revealer.Actor == InRevealer;
+	});
+}
+
+UOBExplorationMask* UOBNavigationSubsystem::FindOrCreateExplorationMask(UOBMapLayerAsset* MapLayer)
+{
+	if (!MapLayer || !MapLayer->bEnableExploration)
+	{
+		return nullptr;
+	}
+
+	if (const TObjectPtr<UOBExplorationMask>* ExistingMask = ExplorationMasks.Find(MapLayer))
+	{
+		return *ExistingMask;
+	}
+
+	LLM_SCOPE_BYTAG(OBNavigation);
+	UOBExplorationMask* NewMask = NewObject<UOBExplorationMask>(this);
+	NewMask->Init(MapLayer, GetLayerBounds(MapLayer));
+	ExplorationMasks.Add(MapLayer, NewMask);
+	return NewMask;
+}
+
+bool UOBNavigationSubsystem::SaveExplorationData(UOBMapLayerAsset* MapLayer, TArray<uint8>& OutData)
+{
+	const UOBExplorationMask* Mask = FindOrCreateExplorationMask(MapLayer);
+	if (!Mask)
+	{
+		return false;
+	}
+
+	Mask->SaveRLE(OutData);
+	return true;
+}
+
+bool UOBNavigationSubsystem::LoadExplorationData(UOBMapLayerAsset* MapLayer, const TArray<uint8>& InData)
+{
+	UOBExplorationMask* Mask = FindOrCreateExplorationMask(MapLayer);
+	return Mask && Mask->LoadRLE(InData);
+}
+
+void UOBNavigationSubsystem::UpdateExploration()
+{
+	OBNAV_SCOPE_CYCLE_COUNTER(STAT_OBNav_UpdateExploration);
+
+	if (FOBTrackedView View; CurrentMinimapLayer && GetTrackedView(View))
+	{
+		TrackedPawnRevealer.Actor = TrackedPlayerPawn;
+		TrackedPawnRevealer.RevealRadius = CurrentMinimapLayer->PlayerRevealRadius;
+		UpdateExplorationRevealer(TrackedPawnRevealer, CurrentMinimapLayer, View.Location);
+	}
+
+	for (int32 Index = ExplorationRevealers.Num() - 1; Index >= 0; --Index)
+	{
+		FExplorationRevealer& Revealer = ExplorationRevealers[Index];
+		const AActor* RevealerActor = Revealer.Actor.Get();
+		if (!RevealerActor)
+		{
+			ExplorationRevealers.RemoveAtSwap(Index);
+			continue;
+		}
+
+		const FVector Location = RevealerActor->GetActorLocation();
+		UpdateExplorationRevealer(Revealer, FindBestLayerForLocation(Location), Location);
+	}
+
+	// Upload only the cells touched this frame, once per mask
+	for (const auto& Pair : ExplorationMasks)
+	{
+		if (Pair.Value)
+		{
+			Pair.Value->FlushTextureUpdates();
+		}
+	}
+}
+
+void UOBNavigationSubsystem::RegisterLineOfSightObserver(AActor* InObserver)
+{
+	if (InObserver)
+	{
+		LineOfSightObservers.AddUnique(InObserver);
+	}
+}
+
+void UOBNavigationSubsystem::UnregisterLineOfSightObserver(AActor* InObserver)
+{
+	LineOfSightObservers.RemoveSingleSwap(InObserver);
+}
+
+void UOBNavigationSubsystem::AddLineOfSightTarget(UOBMapMarker* InMarker)
+{
+	if (LineOfSightTargetIndices.Contains(InMarker->MarkerID))
+	{
+		return;
+	}
+
+	// The target index is carried in 16 bits of the trace user data
+	if (LineOfSightTargets.Num() > static_cast<int32>(MAX_uint16))
+	{
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - Too many markers require line of sight. '%s' is always shown."),
+		       *GetName(), __FUNCTION__, *InMarker->MarkerID.ToString());
+		return;
+	}
+
+	FLineOfSightTarget NewTarget;
+	NewTarget.MarkerID = InMarker->MarkerID;
+	LineOfSightTargetIndices.Add(InMarker->MarkerID, LineOfSightTargets.Add(MoveTemp(NewTarget)));
+	InMarker->bHiddenByLineOfSight = true;
+}
+
+void UOBNavigationSubsystem::RemoveLineOfSightTarget(const FGuid& InMarkerID)
+{
+	if (int32 TargetIndex; LineOfSightTargetIndices.RemoveAndCopyValue(InMarkerID, TargetIndex))
+	{
+		LineOfSightTargets.RemoveAt(TargetIndex);
+	}
+}
+
+void UOBNavigationSubsystem::UpdateLineOfSight()
+{
+	OBNAV_SCOPE_CYCLE_COUNTER(STAT_OBNav_UpdateLineOfSight);
+
+	if (LineOfSightTargets.IsEmpty())
+	{
+		SET_DWORD_STAT(STAT_OBNav_NumLineOfSightTraces, 0);
+		return;
+	}
+
+	// Observers of this frame: the tracked pawn and the registered actors still alive
+	TArray<const AActor*, TInlineAllocator<16>> Observers;
+	if (const APawn* Pawn = TrackedPlayerPawn.Get())
+	{
+		Observers.Add(Pawn);
+	}
+	for (int32 Index = LineOfSightObservers.Num() - 1; Index >= 0; --Index)
+	{
+		if (const AActor* Observer = LineOfSightObservers[Index].Get())
+		{
+			Observers.AddUnique(Observer);
+		}
+		else
+		{
+			LineOfSightObservers.RemoveAtSwap(Index);
+		}
+	}
+
+	const UOBNavigationSettings* Settings = GetDefault<UOBNavigationSettings>();
+	const double Now = GetWorldTime();
+	// The observer slot of a trace is carried in 8 bits of its user data; ClampMax only applies in the editor, not to
+	// a budget set in an ini file
+	const int32 FrameTraceBudget = FMath::Clamp(Settings->LineOfSightTraceBudget, 1, static_cast<int32>(MAX_uint8));
+	int32 TraceBudget = FrameTraceBudget;
+
+	// Round-robin from where the budget ran out last frame, so every target gets its turn
+	const int32 MaxIndex = LineOfSightTargets.GetMaxIndex();
+	for (int32 Step = 0; Step < MaxIndex && TraceBudget > 0; ++Step)
+	{
+		const int32 TargetIndex = (LineOfSightCursor + Step) % MaxIndex;
+		if (!LineOfSightTargets.IsValidIndex(TargetIndex))
+		{
+			continue;
+		}
+
+		// Cached results stay until they expire; a query in progress waits for its traces in flight
+		FLineOfSightTarget& Target = LineOfSightTargets[TargetIndex];
+		if (Target.PendingTraces > 0 || (!Target.bQueryActive && Now < Target.ExpireTime))
+		{
+			continue;
+		}
+
+		if (!Target.bQueryActive)
+		{
+			Target.bQueryActive = true;
+			Target.bTriedLastSeenBy = false;
+			Target.bTracedAllObservers = false;
+			Target.bSeenInQuery = false;
+			Target.NextObserver = 0;
+			Target.QuerySerial = ++LineOfSightQuerySerial;
+		}
+
+		// A marker without an actor (e.g., an unbound proxy) has nothing to be seen
+		const UOBMapMarker* Marker = ActiveMarkersMap.FindRef(Target.MarkerID);
+		const AActor* TargetActor = Marker ? Marker->TrackedActor.Get() : nullptr;
+		if (!TargetActor)
+		{
+			Target.bTracedAllObservers = true;
+		}
+		else
+		{
+			const int32 NumTraces = IssueLineOfSightTraces(Target, TargetIndex, TargetActor, Observers, TraceBudget);
+			TraceBudget -= NumTraces;
+			if (NumTraces > 0)
+			{
+				LineOfSightCursor = (TargetIndex + 1) % MaxIndex;
+			}
+		}
+
+		// Decided without tracing (no observer in range, the target observing itself, ...)
+		if (Target.PendingTraces == 0 && (Target.bSeenInQuery || Target.bTracedAllObservers))
+		{
+			FinishLineOfSightQuery(Target);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_OBNav_NumLineOfSightTraces, FrameTraceBudget - TraceBudget);
+}
+
+int32 UOBNavigationSubsystem::IssueLineOfSightTraces(FLineOfSightTarget& Target, const int32 TargetIndex,
+                                                     const AActor* TargetActor,
+                                                     const TConstArrayView<const AActor*> Observers, const int32 MaxTraces)
+{
+	const UOBNavigationSettings* Settings = GetDefault<UOBNavigationSettings>();
+	const FVector TargetLocation = TargetActor->GetActorLocation();
+	const double MaxDistanceSquared = Settings->LineOfSightMaxDistance > 0.0f
+		                                  ? FMath::Square(static_cast<double>(Settings->LineOfSightMaxDistance))
+		                                  : UE_DOUBLE_BIG_NUMBER;
+	const FTraceDelegate TraceDelegate =
+		FTraceDelegate::CreateUObject(this, &UOBNavigationSubsystem::OnLineOfSightTraceDone);
+	UWorld* World = GetWorld();
+
+	Target.BatchObservers.Reset();
+
+	// Returns true if a trace was issued
+	auto TraceFrom = [&](const AActor* Observer)
+	{
+		if (Observer == TargetActor)
+		{
+			Target.bSeenInQuery = true;
+			Target.LastSeenBy = Observer;
+			return false;
+		}
+
+		FVector EyeLocation;
+		FRotator EyeRotation;
+		Observer->GetActorEyesViewPoint(EyeLocation, EyeRotation);
+		if (FVector::DistSquared(EyeLocation, TargetLocation) > MaxDistanceSquared)
+		{
+			return false;
+		}
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(OBNavLineOfSight), /*bTraceComplex*/ false);
+		QueryParams.AddIgnoredActor(Observer);
+		QueryParams.AddIgnoredActor(TargetActor);
+
+		// User data: target index (16 bits), query serial (8 bits), observer slot in the batch (8 bits)
+		const uint32 UserData = static_cast<uint32>(TargetIndex) | static_cast<uint32>(Target.QuerySerial) << 16 |
+			static_cast<uint32>(Target.BatchObservers.Num()) << 24;
+		World->AsyncLineTraceByChannel(EAsyncTraceType::Single, EyeLocation, TargetLocation,
+		                               Settings->LineOfSightTraceChannel, QueryParams,
+		                               FCollisionResponseParams::DefaultResponseParam, &TraceDelegate, UserData);
+		Target.BatchObservers.Add(Observer);
+		++Target.PendingTraces;
+		return true;
+	};
+
+	// The last observer to see the target is traced alone: if it still does, that is the only trace of the query
+	if (!Target.bTriedLastSeenBy)
+	{
+		Target.bTriedLastSeenBy = true;
+		if (const AActor* LastSeenBy = Target.LastSeenBy.Get(); LastSeenBy && Observers.Contains(LastSeenBy) &&
+			TraceFrom(LastSeenBy))
+		{
+			return 1;
+		}
+		if (Target.bSeenInQuery)
+		{
+			return 0;
+		}
+	}
+
+	int32 NumTraces = 0;
+	const AActor* LastSeenBy = Target.LastSeenBy.Get();
+	while (Target.NextObserver < Observers.Num() && NumTraces < MaxTraces && !Target.bSeenInQuery)
+	{
+		const AActor* Observer = Observers[Target.NextObserver++];
+		if (Observer != LastSeenBy && TraceFrom(Observer))
+		{
+			++NumTraces;
+		}
+	}
+	Target.bTracedAllObservers = Target.NextObserver >= Observers.Num();
+	return NumTraces;
+}
+
+void UOBNavigationSubsystem::FinishLineOfSightQuery(FLineOfSightTarget& Target)
+{
+	Target.bQueryActive = false;
+	Target.ExpireTime = GetWorldTime() + GetDefault<UOBNavigationSettings>()->LineOfSightCacheDuration;
+	if (!Target.bSeenInQuery)
+	{
+		Target.LastSeenBy.Reset();
+	}
+
+	if (UOBMapMarker* Marker = ActiveMarkersMap.FindRef(Target.MarkerID))
+	{
+		Marker->bHiddenByLineOfSight = !Target.bSeenInQuery;
+	}
+}
+
+void UOBNavigationSubsystem::OnLineOfSightTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	const int32 TargetIndex = static_cast<int32>(Datum.UserData & 0xFFFF);
+	const uint8 QuerySerial = static_cast<uint8>(Datum.UserData >> 16);
+	const int32 ObserverSlot = static_cast<int32>(Datum.UserData >> 24);
+	if (!LineOfSightTargets.IsValidIndex(TargetIndex))
+	{
+		return;
+	}
+
+	FLineOfSightTarget& Target = LineOfSightTargets[TargetIndex];
+	if (Target.QuerySerial != QuerySerial || Target.PendingTraces == 0)
+	{
+		return;
+	}
+
+	const bool bBlocked = Datum.OutHits.ContainsByPredicate([](const FHitResult& Hit)
+	{
+		return Hit.bBlockingHit;
+	});
+	if (!bBlocked && !Target.bSeenInQuery)
+	{
+		Target.bSeenInQuery = true;
+		if (Target.BatchObservers.IsValidIndex(ObserverSlot))
+		{
+			Target.LastSeenBy = Target.BatchObservers[ObserverSlot];
+		}
+	}
+
+	// Without a sighting, the next batch goes out on the next update until every observer was traced
+	if (--Target.PendingTraces == 0 && (Target.bSeenInQuery || Target.bTracedAllObservers))
+	{
+		FinishLineOfSightQuery(Target);
+	}
+}
+
+void UOBNavigationSubsystem::RegisterBoxRegion(const FName RegionName, const FVector Center, const FVector HalfExtents,
+                                               const float Yaw)
+{
+	if (RegionName.IsNone())
+	{
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - Failed to register region: RegionName is None."), *GetName(),
+		       __FUNCTION__);
+		return;
+	}
+
+	Regions.Add(RegionName, FOBRegionShape(Center, HalfExtents, Yaw));
+	bRegionIndexDirty = true;
+}
+
+void UOBNavigationSubsystem::UnregisterRegion(const FName RegionName)
+{
+	if (Regions.Remove(RegionName) > 0)
+	{
+		bRegionIndexDirty = true;
+	}
+}
+
+void UOBNavigationSubsystem::RegisterRegionTracker(AActor* InActor)
+{
+	if (!InActor || RegionTrackers.ContainsByPredicate([InActor](const FRegionTracker& Tracker)
+	{
+		return Tracker.Actor == InActor;
+	}))
+	{
+		return;
+	}
+
+	RegionTrackers.AddDefaulted_GetRef().Actor = InActor;
+}
+
+void UOBNavigationSubsystem::UnregisterRegionTracker(AActor* InActor)
+{
+	RegionTrackers.RemoveAllSwap([InActor](const FRegionTracker& Tracker)
+	{
+		return Tracker.Actor == InActor;
+	});
+}
+
+TArray<FName> UOBNavigationSubsystem::GetActorRegions(AActor* InActor) const
+{
+	if (!InActor)
+	{
+		return {};
+	}
+
+	if (TrackedPawnRegionTracker.Actor == InActor)
+	{
+		return TArray<FName>(TrackedPawnRegionTracker.Regions);
+	}
+
+	for (const FRegionTracker& Tracker : RegionTrackers)
+	{
+		if (Tracker.Actor == InActor)
+		{
+			return TArray<FName>(Tracker.Regions);
+		}
+	}
+	return {};
+}
+
+void UOBNavigationSubsystem::UpdateRegions()
+{
+	OBNAV_SCOPE_CYCLE_COUNTER(STAT_OBNav_UpdateRegions);
+
+	// Nothing registered since the last (empty) build: every tracker is already outside every region, unless the exits
+	// of a pawn that is no longer tracked are still due
+	if (Regions.IsEmpty() && !bRegionIndexDirty && TrackedPawnRegionTracker.Regions.IsEmpty() &&
+		PendingRegionEvents.IsEmpty())
+	{
+		return;
+	}
+
+	if (bRegionIndexDirty)
+	{
+		const UOBNavigationSettings* Settings = GetDefault<UOBNavigationSettings>();
+		RegionIndex.Build(Regions, Settings->RegionGridCellSize, Settings->MaxRegionCells);
+		bRegionIndexDirty = false;
+	}
+
+	// A newly tracked pawn starts outside every region, so it gets the entry events of where it stands.
+	// The previous pawn leaves the regions it was in, so listeners never keep stale state for it. The weak pointers are
+	// compared, not the pawns: a destroyed pawn resolves to null like an unset one, and its exits would be lost.
+	const TWeakObjectPtr<AActor> TrackedPawn(TrackedPlayerPawn);
+	if (TrackedPawnRegionTracker.Actor != TrackedPawn ||
+		(!TrackedPawnRegionTracker.Actor.IsValid() && !TrackedPawnRegionTracker.Regions.IsEmpty()))
+	{
+		for (const FName RegionName : TrackedPawnRegionTracker.Regions)
+		{
+			PendingRegionEvents.Add({TrackedPawnRegionTracker.Actor, RegionName, false});
+		}
+		TrackedPawnRegionTracker = FRegionTracker();
+		TrackedPawnRegionTracker.Actor = TrackedPawn;
+	}
+	if (AActor* Pawn = TrackedPawnRegionTracker.Actor.Get())
+	{
+		UpdateRegionTracker(TrackedPawnRegionTracker, Pawn);
+	}
+
+	for (int32 Index = RegionTrackers.Num() - 1; Index >= 0; --Index)
+	{
+		if (AActor* Actor = RegionTrackers[Index].Actor.Get())
+		{
+			UpdateRegionTracker(RegionTrackers[Index], Actor);
+		}
+		else
+		{
+			// Same as the tracked pawn: a destroyed actor leaves its regions
+			for (const FName RegionName : RegionTrackers[Index].Regions)
+			{
+				PendingRegionEvents.Add({RegionTrackers[Index].Actor, RegionName, false});
+			}
+			RegionTrackers.RemoveAtSwap(Index);
+		}
+	}
+
+	// Broadcast once every tracker is up to date, so listeners may register or unregister trackers and regions
+	for (const FRegionEvent& Event : PendingRegionEvents)
+	{
+		// A destroyed actor is still handed to the exit listeners until it is garbage collected; after that, its exits
+		// are broadcast without an actor rather than dropped
+		AActor* Actor = Event.Actor.Get(/*bEvenIfPendingKill*/ true);
+		if (!Actor && Event.bEntered)
+		{
+			continue;
+		}
+
+		UE_LOG(LogOBNavigation, Verbose, TEXT("[%s::%hs] - '%s' %s region '%s'."), *GetName(), __FUNCTION__,
+		       *GetNameSafe(Actor), Event.bEntered ? TEXT("entered") : TEXT("left"), *Event.RegionName.ToString());
+		if (Event.bEntered)
+		{
+			OnRegionEnteredNative.Broadcast(Actor, Event.RegionName);
+			OnRegionEntered.Broadcast(Actor, Event.RegionName);
+		}
+		else
+		{
+			OnRegionExitedNative.Broadcast(Actor, Event.RegionName);
+			OnRegionExited.Broadcast(Actor, Event.RegionName);
+		}
+	}
+	PendingRegionEvents.Reset();
+}
+
+void UOBNavigationSubsystem::UpdateRegionTracker(FRegionTracker& Tracker, AActor* Actor)
+{
+	const FVector Location = Actor->GetActorLocation();
+	const FIntVector Cell = RegionIndex.GetCell(Location);
+
+	// Still in a cell no boundary runs through, with the same regions: nothing can have changed
+	if (Tracker.bUniformCell && Tracker.Cell == Cell && Tracker.IndexVersion == RegionIndex.GetVersion())
+	{
+		return;
+	}
+
+	TArray<FName, TInlineAllocator<4>> NewRegions;
+	Tracker.bUniformCell = RegionIndex.FindRegions(Cell, Location, NewRegions);
+	Tracker.Cell = Cell;
+	Tracker.IndexVersion = RegionIndex.GetVersion();
+
+	// Exits first, so a listener never sees an actor in two exclusive regions at once
+	for (const FName RegionName : Tracker.Regions)
+	{
+		if (!NewRegions.Contains(RegionName))
+		{
+			PendingRegionEvents.Add({Actor, RegionName, false});
+		}
+	}
+	for (const FName RegionName : NewRegions)
+	{
+		if (!Tracker.Regions.Contains(RegionName))
+		{
+			PendingRegionEvents.Add({Actor, RegionName, true});
+		}
+	}
+	Tracker.Regions = MoveTemp(NewRegions);
+}
+
+FGuid UOBNavigationSubsystem::RegisterCircleArea(const FVector InCenter, const float InRadius,
+                                                const FOBAreaMarkerStyle& InStyle)
+{
+	return AddAreaMarker(FOBAreaMarker::MakeCircle(FVector2D(InCenter), InRadius), InStyle);
+}
+
+FGuid UOBNavigationSubsystem::RegisterRectangleArea(const FVector InCenter, const FVector2D InHalfExtents,
+                                                   const float InYaw, const FOBAreaMarkerStyle& InStyle)
+{
+	return AddAreaMarker(FOBAreaMarker::MakeRectangle(FVector2D(InCenter), InHalfExtents, InYaw), InStyle);
+}
+
+FGuid UOBNavigationSubsystem::RegisterPolygonArea(const TArray<FVector>& InWorldPoints,
+                                                 const FOBAreaMarkerStyle& InStyle)
+{
+	TArray<FVector2D, TInlineAllocator<32>> Points;
+	Points.Reserve(InWorldPoints.Num());
+	for (const FVector& WorldPoint : InWorldPoints)
+	{
+		Points.Emplace(WorldPoint);
+	}
+	return AddAreaMarker(FOBAreaMarker::MakePolygon(Points), InStyle);
+}
+
+FGuid UOBNavigationSubsystem::AddAreaMarker(FOBAreaMarker&& InArea, const FOBAreaMarkerStyle& InStyle)
+{
+	if (!InArea.IsValid())
+	{
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - Invalid area shape (too few points or self-intersecting)."),
+		       *GetName(), __FUNCTION__);
+		return FGuid();
+	}
+
+	const FGuid AreaID = FGuid::NewGuid();
+	InArea.Style = InStyle;
+	AreaMarkers.Add(AreaID, MoveTemp(InArea));
+	return AreaID;
+}
+
+void UOBNavigationSubsystem::UnregisterArea(const FGuid& AreaID)
+{
+	AreaMarkers.Remove(AreaID);
+}
+
+void UOBNavigationSubsystem::AnimateArea(const FGuid& AreaID, const FVector InTargetCenter, const float InTargetScale,
+                                         const float InDuration)
+{
+	if (FOBAreaMarker* Area = AreaMarkers.Find(AreaID))
+	{
+		Area->Animate(GetWorldTime(), FVector2D(InTargetCenter), InTargetScale, InDuration);
+	}
+}
+
+bool UOBNavigationSubsystem::IsInsideArea(const FGuid& AreaID, const FVector WorldLocation) const
+{
+	const FOBAreaMarker* Area = AreaMarkers.Find(AreaID);
+	return Area && Area->IsInside(WorldLocation, GetWorldTime());
+}
+
+double UOBNavigationSubsystem::GetWorldTime() const
+{
+	const UWorld* World = GetWorld();
+	return World ? World->GetTimeSeconds() : 0.0;
+}
+
+void UOBNavigationSubsystem::SubmitHeatMapEvents(const TArray<FOBHeatMapEvent>& Events, UOBMapLayerAsset* MapLayer)
+{
+	// Heat maps are only uploaded by clients, so a server would accumulate them (and keep ticking) for nothing
+	const UWorld* World = GetWorld();
+	if (Events.IsEmpty() || !World || World->GetNetMode() == NM_DedicatedServer)
+	{
+		return;
+	}
+
+	const double Now = World->GetTimeSeconds();
+	if (MapLayer)
+	{
+		if (UOBHeatMap* HeatMap = FindOrCreateHeatMap(MapLayer))
+		{
+			bHasHeatMapUpdates |= HeatMap->AddEvents(Events, Now) > 0;
+		}
+		return;
+	}
+
+	// Consecutive events on the same layer (the common case) are accumulated as one batch
+	int32 RunStart = 0;
+	UOBMapLayerAsset* RunLayer = FindBestLayerForLocation(Events[0].Location);
+	for (int32 Index = 1; Index <= Events.Num(); ++Index)
+	{
+		UOBMapLayerAsset* Layer = Index < Events.Num() ? FindBestLayerForLocation(Events[Index].Location) : nullptr;
+		if (Index < Events.Num() && Layer == RunLayer)
+		{
+			continue;
+		}
+
+		if (UOBHeatMap* HeatMap = FindOrCreateHeatMap(RunLayer))
+		{
+			bHasHeatMapUpdates |= HeatMap->AddEvents(MakeArrayView(Events).Slice(RunStart, Index - RunStart), Now) > 0;
+		}
+		RunStart = Index;
+		RunLayer = Layer;
+	}
+}
+
+UOBHeatMap* UOBNavigationSubsystem::FindOrCreateHeatMap(UOBMapLayerAsset* MapLayer)
+{
+	if (!MapLayer || !MapLayer->bEnableHeatMap)
+	{
+		return nullptr;
+	}
+
+	if (const TObjectPtr<UOBHeatMap>* ExistingHeatMap = HeatMaps.Find(MapLayer))
+	{
+		return *ExistingHeatMap;
+	}
+
+	LLM_SCOPE_BYTAG(OBNavigation);
+	UOBHeatMap* NewHeatMap = NewObject<UOBHeatMap>(this);
+	const UWorld* World = GetWorld();
+	NewHeatMap->Init(MapLayer, GetLayerBounds(MapLayer), World ? World->GetTimeSeconds() : 0.0);
+	HeatMaps.Add(MapLayer, NewHeatMap);
+	return NewHeatMap;
+}
+
+UTexture2D* UOBNavigationSubsystem::BakeMapLayer(UOBMapLayerAsset* MapLayer, const FOBMapBakeSettings& Settings)
+{
+	UWorld* World = GetWorld();
+	if (!MapLayer || !World)
+	{
+		return nullptr;
+	}
+
+	// The layer asset is shared (by other worlds, PIE sessions and the editor), so fitted bounds stay in the subsystem
+	const FBox PreviousBounds = GetLayerBounds(MapLayer);
+	if (Settings.bFitBounds)
+	{
+		const FBox FitBounds = UOBMapBake::ComputeFitBounds(World, Settings.BoundsPadding);
+		if (FitBounds.IsValid)
+		{
+			LayerBoundsOverrides.Add(MapLayer, FitBounds);
+		}
+		else
+		{
+			UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - No navmesh or level to fit the bounds of MapLayer '%s' to."),
+			       *GetName(), __FUNCTION__, *MapLayer->GetName());
+		}
+	}
+	else
+	{
+		LayerBoundsOverrides.Remove(MapLayer);
+	}
+
+	if (!GetLayerBounds(MapLayer).Equals(PreviousBounds))
+	{
+		RebuildLayerGrid();
+
+		// Map points projected with the previous bounds
+		if (MapLayer == BreadcrumbMapLayer)
+		{
+			RebuildBreadcrumbMapPoints();
+		}
+		if (MapLayer == RouteMapLayer)
+		{
+			RebuildRouteMapPoints();
+		}
+
+		// Grids sized for the previous bounds no longer match the map
+		if (UOBExplorationMask* ExplorationMask = ExplorationMasks.FindRef(MapLayer))
+		{
+			ExplorationMask->Init(MapLayer, GetLayerBounds(MapLayer));
+		}
+		if (UOBHeatMap* HeatMap = HeatMaps.FindRef(MapLayer))
+		{
+			HeatMap->Init(MapLayer, GetLayerBounds(MapLayer), World->GetTimeSeconds());
+		}
+	}
+
+	LLM_SCOPE_BYTAG(OBNavigation);
+	UOBMapBake* MapBake = NewObject<UOBMapBake>(this);
+	if (!MapBake->Bake(World, MapLayer, GetLayerBounds(MapLayer), Settings))
+	{
+		return nullptr;
+	}
+	MapBakes.Add(MapLayer, MapBake);
+
+	// The minimap binds the map texture when the layer becomes current
+	if (MapLayer == CurrentMinimapLayer)
+	{
+		OnMinimapLayerChanged.Broadcast(CurrentMinimapLayer);
+	}
+	return MapBake->GetTexture();
+}
+
+void UOBNavigationSubsystem::PatchMapLayer(UOBMapLayerAsset* MapLayer, const FBox& DirtyBounds)
+{
+	if (UOBMapBake* MapBake = MapBakes.FindRef(MapLayer))
+	{
+		MapBake->Patch(DirtyBounds);
+	}
+}
+
+UTexture2D* UOBNavigationSubsystem::GetMapTexture(UOBMapLayerAsset* MapLayer) const
+{
+	if (!MapLayer)
+	{
+		return nullptr;
+	}
+
+	const TObjectPtr<UOBMapBake>* MapBake = MapBakes.Find(MapLayer);
+	return MapBake && *MapBake ? (*MapBake)->GetTexture() : MapLayer->MapTexture.Get();
+}
+
+void UOBNavigationSubsystem::SetPOIViewRegion(const FBox2D& WorldRegion)
+{
+	POIViewRegion = WorldRegion;
+}
+
+void UOBNavigationSubsystem::ClearPOIViewRegion()
+{
+	POIViewRegion.Reset();
+}
+
+void UOBNavigationSubsystem::GatherLightweightMarkers(const FBox2D& WorldRegion,
+                                                      TArray<FOBLightweightMarker>& OutMarkers) const
+{
+	const TArray<FName>& LayerNames = POIDatabase.GetLayerNames();
+	POIDatabase.ForEachResidentPOI(WorldRegion, [this, &LayerNames, &OutMarkers](const int32 POIIndex,
+	                                                                            const FOBPOIRecord& Record)
+	{
+		// Record indices were validated when the page was loaded
+		const UOBMarkerConfigAsset* Config = POIConfigs[Record.ConfigIndex];
+		if (!Config || HiddenPOIs[POIIndex])
+		{
+			return;
+		}
+
+		FOBLightweightMarker& Marker = OutMarkers.AddDefaulted_GetRef();
+		Marker.WorldLocation = Record.GetLocation();
+		Marker.Config = Config;
+		Marker.LayerName = LayerNames[Record.LayerIndex];
+		Marker.POIIndex = POIIndex;
+	});
+}
+
+int32 UOBNavigationSubsystem::FindPOIIndex(const FGuid& POIID) const
+{
+	return POIDatabase.FindPOI(POIID);
+}
+
+void UOBNavigationSubsystem::ReportMissingPOI(const AActor* POIActor)
+{
+	if (bReportedMissingPOI || POIDatabasePath.IsEmpty())
+	{
+		return;
+	}
+	bReportedMissingPOI = true;
+
+	if (!POIDatabase.IsOpen())
+	{
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - '%s' is stored in the POI database, but '%s' is missing or unreadable. Its points of interest are shown as markers; run the OBNavigationManifest commandlet and stage its output."),
+		       *GetName(), __FUNCTION__, *GetNameSafe(POIActor), *POIDatabasePath);
+	}
+	else
+	{
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - '%s' is stored in the POI database, but not in '%s', which is stale. Points of interest missing from it are shown as markers; run the OBNavigationManifest commandlet."),
+		       *GetName(), __FUNCTION__, *GetNameSafe(POIActor), *POIDatabasePath);
+	}
+}
+
+void UOBNavigationSubsystem::SetPOIHidden(const int32 POIIndex, const bool bHidden)
+{
+	if (HiddenPOIs.IsValidIndex(POIIndex))
+	{
+		HiddenPOIs[POIIndex] = bHidden;
+	}
+}
+
+bool UOBNavigationSubsystem::IsPOIHidden(const int32 POIIndex) const
+{
+	return HiddenPOIs.IsValidIndex(POIIndex) && HiddenPOIs[POIIndex];
+}
+
+void UOBNavigationSubsystem::SavePOIStates(TArray<uint8>& OutData) const
+{
+	OutData.Reset();
+	FMemoryWriter Ar(OutData);
+
+	uint32 ContentHash = POIDatabase.GetContentHash();
+	uint32 NumPOIs = static_cast<uint32>(HiddenPOIs.Num());
+	Ar << ContentHash << NumPOIs;
+
+	// Bits past the last POI are always clear in a TBitArray, so its words are saved as is
+	const int32 NumWords = FMath::DivideAndRoundUp(HiddenPOIs.Num(), NumBitsPerDWORD);
+	Ar.Serialize(const_cast<uint32*>(HiddenPOIs.GetData()), NumWords * sizeof(uint32));
+}
+
+bool UOBNavigationSubsystem::LoadPOIStates(const TArray<uint8>& InData)
+{
+	FMemoryReader Ar(InData);
+
+	uint32 ContentHash = 0;
+	uint32 NumPOIs = 0;
+	Ar << ContentHash << NumPOIs;
+
+	const int32 NumWords = FMath::DivideAndRoundUp(HiddenPOIs.Num(), NumBitsPerDWORD);
+	if (Ar.IsError() || ContentHash != POIDatabase.GetContentHash() || NumPOIs != static_cast<uint32>(HiddenPOIs.Num()) ||
+		Ar.TotalSize() - Ar.Tell() < NumWords * static_cast<int64>(sizeof(uint32)))
+	{
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - POI states do not match the POI database of the current map."),
+		       *GetName(), __FUNCTION__);
+		return false;
+	}
+
+	Ar.Serialize(HiddenPOIs.GetData(), NumWords * sizeof(uint32));
+	if (const int32 NumTailBits = HiddenPOIs.Num() % NumBitsPerDWORD; NumTailBits != 0)
+	{
+		// Keep the bits past the last POI clear, whatever the data held
+		HiddenPOIs.GetData()[NumWords - 1] &= (1u << NumTailBits) - 1;
+	}
+	return true;
+}
+
+void UOBNavigationSubsystem::UpdatePOIPages()
+{
+	if (!POIDatabase.IsOpen())
+	{
+		return;
+	}
+
+	OBNAV_SCOPE_CYCLE_COUNTER(STAT_OBNav_UpdatePOIPages);
+
+	// The pages around the view come first, so they are loaded before those of a large view region
+	const UOBNavigationSettings* Settings = GetDefault<UOBNavigationSettings>();
+	TArray<FBox2D, TInlineAllocator<2>> Regions;
+	if (FOBTrackedView View; GetTrackedView(View))
+	{
+		const FVector2D Center(View.Location);
+		const FVector2D Extent(Settings->POIStreamingRadius);
+		Regions.Emplace(Center - Extent, Center + Extent);
+	}
+	if (POIViewRegion.IsSet())
+	{
+		Regions.Add(POIViewRegion.GetValue());
+	}
+
+	POIDatabase.UpdateResidentPages(Regions, Settings->MaxResidentPOIPages, Settings->MaxPOIPageLoadsPerUpdate);
+	SET_DWORD_STAT(STAT_OBNav_NumResidentPOIPages, POIDatabase.GetNumResidentPages());
+}
+
+void UOBNavigationSubsystem::UpdateHeatMaps()
+{
+	if (!bHasHeatMapUpdates)
+	{
+		return;
+	}
+
+	OBNAV_SCOPE_CYCLE_COUNTER(STAT_OBNav_UpdateHeatMaps);
+
+	// However many batches were submitted, each heat map uploads its touched tiles once per frame
+	for (const auto& Pair : HeatMaps)
+	{
+		if (Pair.Value)
+		{
+			Pair.Value->FlushTextureUpdates();
+		}
+	}
+	bHasHeatMapUpdates = false;
+}
+
+void UOBNavigationSubsystem::UpdateExplorationRevealer(FExplorationRevealer& Revealer, UOBMapLayerAsset* Layer,
+                                                       const FVector& Location)
+{
+	UOBExplorationMask* Mask = FindOrCreateExplorationMask(Layer);
+	if (!Mask)
+	{
+		Revealer.LastMask.Reset();
+		return;
+	}
+
+	// Reveal around the center of the revealer's cell, so nothing can change until it crosses into another cell
+	const FIntPoint Cell = Mask->WorldToCell(Location);
+	if (Cell.X == INDEX_NONE || (Revealer.LastMask == Mask && Revealer.LastCell == Cell))
+	{
+		return;
+	}
+
+	Revealer.LastMask = Mask;
+	Revealer.LastCell = Cell;
+	Mask->RevealCircle(Mask->GetCellCenter(Cell), Revealer.RevealRadius);
+}
+
+int32 UOBNavigationSubsystem::SaveStaticMarkers(TArray<uint8>& OutData, const FName LayerFilter) const
+{
+	FOBMarkerSaveWriter Writer;
+	Writer.Reserve(ActiveMarkers.Num());
+
+	for (const UOBMapMarker* Marker : ActiveMarkers)
+	{
+		// Actor-tracking and proxy markers are re-registered by their actors or sets, so only static markers are persisted.
+		// Markers owned elsewhere (recycled ping slots) are transient.
+		if (!Marker || Marker->GetOuter() != this || Marker->TrackedActor.IsValid() || Marker->IsProxy() || (!LayerFilter.IsNone() && Marker->MarkerLayerName != LayerFilter))
+		{
+			continue;
+		}
+
+		Writer.AddMarker(Marker->MarkerID, Marker->ConfigAsset, Marker->MarkerLayerName, Marker->WorldLocation,
+		                 Marker->CurrentLifeTime);
+	}
+
+	Writer.Write(OutData);
+	return Writer.GetNumMarkers();
+}
+
+int32 UOBNavigationSubsystem::LoadStaticMarkers(const TArray<uint8>& InData)
+{
+	return LoadStaticMarkersFromView(InData);
+}
+
+bool UOBNavigationSubsystem::SaveStaticMarkersToFile(const FString& FilePath, const FName LayerFilter) const
+{
+	TArray<uint8> Data;
+	SaveStaticMarkers(Data, LayerFilter);
+	return FFileHelper::SaveArrayToFile(Data, *FilePath);
+}
+
+int32 UOBNavigationSubsystem::LoadStaticMarkersFromFile(const FString& FilePath)
+{
+	// Prefer mapping the file so records are decoded straight from the page cache
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (const TUniquePtr<IMappedFileHandle> MappedFile(PlatformFile.OpenMapped(*FilePath)); MappedFile)
+	{
+		if (const TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile->MapRegion()); MappedRegion)
+		{
+			return LoadStaticMarkersFromView(TArrayView<const uint8>(MappedRegion->GetMappedPtr(),
+			                                                         static_cast<int32>(MappedRegion->GetMappedSize())));
+		}
+	}
+
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *FilePath))
+	{
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - Could not read marker file '%s'."), *GetName(), __FUNCTION__,
+		       *FilePath);
+		return 0;
+	}
+	return LoadStaticMarkersFromView(Data);
+}
+
+int32 UOBNavigationSubsystem::LoadStaticMarkersFromView(const TArrayView<const uint8> InData, TArray<FGuid>* OutMarkerIDs)
+{
+	LLM_SCOPE_BYTAG(OBNavigation);
+
+	FOBMarkerSaveReader Reader;
+	if (!Reader.Open(InData))
+	{
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - Saved marker data is corrupt or has an unknown version."),
+		       *GetName(), __FUNCTION__);
+		return 0;
+	}
+
+	// Resolve each referenced config once, not once per marker. Configs are streamed in at initialization, so they are
+	// normally resident by the time markers are restored.
+	const TArray<FSoftObjectPath>& ConfigTable = Reader.GetConfigTable();
+	TArray<UOBMarkerConfigAsset*, TInlineAllocator<16>> Configs;
+	TArray<FSoftObjectPath> MissingConfigPaths;
+	Configs.Reserve(ConfigTable.Num());
+	for (const FSoftObjectPath& ConfigPath : ConfigTable)
+	{
+		UOBMarkerConfigAsset* Config = Cast<UOBMarkerConfigAsset>(ConfigPath.ResolveObject());
+		if (!Config)
+		{
+			MissingConfigPaths.Add(ConfigPath);
+		}
+		Configs.Add(Config);
+	}
+
+	// The markers must exist when this returns (points of interest look theirs up as they begin play), so the rest
+	// cannot be deferred: they are requested together and waited for
+	if (!MissingConfigPaths.IsEmpty())
+	{
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - %d marker configs are not resident yet. Waiting for them to load."),
+		       *GetName(), __FUNCTION__, MissingConfigPaths.Num());
+		if (const TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MissingConfigPaths))
+		{
+			Handle->WaitUntilComplete();
+			Handle->ReleaseHandle(); // The markers keep their config
+		}
+
+		for (int32 ConfigIndex = 0; ConfigIndex < ConfigTable.Num(); ++ConfigIndex)
+		{
+			if (!Configs[ConfigIndex])
+			{
+				Configs[ConfigIndex] = Cast<UOBMarkerConfigAsset>(ConfigTable[ConfigIndex].ResolveObject());
+				UE_CLOG(!Configs[ConfigIndex], LogOBNavigation, Warning,
+				        TEXT("[%s::%hs] - Marker config '%s' could not be loaded. Its markers are skipped."), *GetName(),
+				        __FUNCTION__, *ConfigTable[ConfigIndex].ToString());
+			}
+		}
+	}
+
+	ActiveMarkersMap.Reserve(ActiveMarkersMap.Num() + Reader.GetNumMarkers());
+
+	int32 NumRestored = 0;
+	FOBSavedMarkerRecord Record;
+	for (int32 Index = 0; Index < Reader.GetNumMarkers(); ++Index)
+	{
+		if (!Reader.ReadMarker(Index, Record) || !Configs[Record.ConfigIndex] || ActiveMarkersMap.Contains(Record.MarkerID))
+		{
+			continue;
+		}
+
+		UOBMapMarker* Marker = CreateMarker(Record.MarkerID, nullptr, Configs[Record.ConfigIndex],
+		                                    Reader.GetLayerTable()[Record.LayerIndex], Record.WorldLocation);
+		Marker->CurrentLifeTime = Record.RemainingLifeTime;
+		Marker->SetAnimationLifeTime(Marker->CurrentLifeTime);
+		bHasExpiringMarkers |= Marker->CurrentLifeTime > 0.0f;
+		++NumRestored;
+		if (OutMarkerIDs)
+		{
+			OutMarkerIDs->Add(Record.MarkerID);
+		}
+	}
+
+	// A single rebuild and broadcast for the whole batch
+	if (NumRestored > 0)
+	{
+		RebuildActiveMarkersArray();
+		OnMarkersUpdated.Broadcast();
+	}
+
+	UE_LOG(LogOBNavigation, Log, TEXT("[%s::%hs] - Restored %d of %d saved markers."), *GetName(), __FUNCTION__, NumRestored,
+	       Reader.GetNumMarkers());
+	return NumRestored;
+}
+
+bool UOBNavigationSubsystem::LoadProjectManifest()
+{
+	if (!GetDefault<UOBNavigationSettings>()->ShouldUseNavigationManifest())
+	{
+		return false;
+	}
+
+	const FString ManifestPath = FOBNavigationManifestFormat::GetProjectManifestPath();
+	bool bOpened = false;
+	const bool bFound = FOBNavigationManifestReader::VisitFile(ManifestPath, [this, &bOpened](
+		const TArrayView<const uint8> Data)
+	{
+		FOBNavigationManifestReader Reader;
+		bOpened = Reader.Open(Data);
+		if (bOpened)
+		{
+			ManifestLayerPaths = Reader.GetLayerPaths();
+			LayerGrid = Reader.GetLayerGrid();
+			for (const FSoftObjectPath& ConfigPath : Reader.GetMarkerConfigPaths())
+			{
+				IndexMarkerConfig(FName(*ConfigPath.GetAssetName()), ConfigPath);
+			}
+		}
+	});
+
+	if (!bFound)
+	{
+		// Outside the editor, the manifest is expected to be baked and staged (see the README)
+		UE_CLOG(!GIsEditor, LogOBNavigation, Warning,
+		        TEXT("[%s::%hs] - No navigation manifest at '%s'. Scanning the asset registry; run the OBNavigationManifest commandlet before packaging."),
+		        *GetName(), __FUNCTION__, *ManifestPath);
+		UE_CLOG(GIsEditor, LogOBNavigation, Verbose,
+		        TEXT("[%s::%hs] - No navigation manifest at '%s'. Scanning the asset registry."), *GetName(),
+		        __FUNCTION__, *ManifestPath);
+		return false;
+	}
+	if (!bOpened)
+	{
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - Navigation manifest '%s' is corrupt or has an unknown version. Scanning the asset registry."),
+		       *GetName(), __FUNCTION__, *ManifestPath);
+		return false;
+	}
+
+	// The slots exist right away so grid indices stay valid; the layers fill them once streamed in
+	AllMapLayers.SetNum(ManifestLayerPaths.Num());
+	if (!ManifestLayerPaths.IsEmpty())
+	{
+		MapLayersHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+			ManifestLayerPaths, FStreamableDelegate::CreateUObject(this, &UOBNavigationSubsystem::OnManifestLayersLoaded));
+	}
+
+	UE_LOG(LogOBNavigation, Log, TEXT("[%s::%hs] - Started from navigation manifest: %d map layers, %d marker configs."),
+	       *GetName(), __FUNCTION__, ManifestLayerPaths.Num(), MarkerConfigPaths.Num());
+	return true;
+}
+
+void UOBNavigationSubsystem::RebuildLayerGrid()
+{
+	// Layers still streaming in get empty bounds, which the grid leaves out
+	TArray<FBox> LayerBounds;
+	LayerBounds.Reserve(AllMapLayers.Num());
+	for (const UOBMapLayerAsset* Layer : AllMapLayers)
+	{
+		LayerBounds.Add(Layer ? GetLayerBounds(Layer) : FBox(ForceInit));
+	}
+	LayerGrid.Build(LayerBounds);
+}
+
+void UOBNavigationSubsystem::OnManifestLayersLoaded()
+{
+	for (int32 Index = 0; Index < ManifestLayerPaths.Num(); ++Index)
+	{
+		AllMapLayers[Index] = Cast<UOBMapLayerAsset>(ManifestLayerPaths[Index].ResolveObject());
+		if (!AllMapLayers[Index])
+		{
+			UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - Map layer '%s' listed in the navigation manifest could not be loaded."),
+			       *GetName(), __FUNCTION__, *ManifestLayerPaths[Index].ToString());
+		}
+	}
+
+	// The grid was built while the layers were streaming in (and may predate bounds overrides), and the minimap may
+	// still show no layer or a worse one; update both now that the layers are in
+	RebuildLayerGrid();
+	UpdateActiveMinimapLayer();
+}
+
+void UOBNavigationSubsystem::LoadMapManifest(const UWorld* InWorld)
+{
+	UnloadMapManifest();
+
+	// Same as character markers: a dedicated server has no map to show them on
+	if (!InWorld || InWorld->GetNetMode() == NM_DedicatedServer ||
+		!GetDefault<UOBNavigationSettings>()->ShouldUseNavigationManifest())
+	{
+		return;
+	}
+
+	const FString MapPackageName = UWorld::RemovePIEPrefix(InWorld->GetOutermost()->GetName());
+	const FString ManifestPath = FOBNavigationManifestFormat::GetMapManifestPath(MapPackageName);
+	FOBNavigationManifestReader::VisitFile(ManifestPath, [this, &ManifestPath](const TArrayView<const uint8> Data)
+	{
+		FOBNavigationManifestReader Reader;
+		if (!Reader.Open(Data))
+		{
+			UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - Navigation manifest '%s' is corrupt or has an unknown version."),
+			       *GetName(), __FUNCTION__, *ManifestPath);
+			return;
 		}
 
-		// After removing, rebuild the array and broadcast a single update.
+		// Registered before any actor begins play, so points of interest find their marker and skip registration
+		if (!Reader.GetStaticMarkerData().IsEmpty())
+		{
+			LoadStaticMarkersFromView(Reader.GetStaticMarkerData(), &ManifestMarkerIDs);
+		}
+	});
+
+	// Same: points of interest stored in the database find their POI and skip registration
+	OpenPOIDatabase(MapPackageName);
+}
+
+void UOBNavigationSubsystem::UnloadMapManifest()
+{
+	bool bRemovedAny = false;
+	for (const FGuid& MarkerID : ManifestMarkerIDs)
+	{
+		bRemovedAny |= RemoveMarker(MarkerID);
+	}
+	ManifestMarkerIDs.Reset();
+
+	if (bRemovedAny)
+	{
 		RebuildActiveMarkersArray();
 		OnMarkersUpdated.Broadcast();
 	}
+
+	ClosePOIDatabase();
+}
+
+void UOBNavigationSubsystem::OpenPOIDatabase(const FString& MapPackageName)
+{
+	ClosePOIDatabase();
+
+	// Maps without a POI stored in the database have no file; a missing one is reported by the points of interest
+	// that expected it (see ReportMissingPOI)
+	const FString DatabasePath = FOBPOIDatabaseFormat::GetMapDatabasePath(MapPackageName);
+	POIDatabasePath = DatabasePath;
+	if (!FPlatformFileManager::Get().GetPlatformFile().FileExists(*DatabasePath))
+	{
+		return;
+	}
+
+	if (!POIDatabase.Open(DatabasePath))
+	{
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - POI database '%s' is corrupt or has an unknown version."),
+		       *GetName(), __FUNCTION__, *DatabasePath);
+		return;
+	}
+
+	// A database uses a handful of configs; they are resolved once, not per POI. Those not resident yet are streamed in.
+	TArray<FSoftObjectPath> MissingConfigPaths;
+	for (const FSoftObjectPath& ConfigPath : POIDatabase.GetConfigPaths())
+	{
+		UOBMarkerConfigAsset* Config = Cast<UOBMarkerConfigAsset>(ConfigPath.ResolveObject());
+		if (Config)
+		{
+			RequestMarkerConfigIcons(Config);
+		}
+		else
+		{
+			MissingConfigPaths.Add(ConfigPath);
+		}
+		POIConfigs.Add(Config);
+	}
+
+	HiddenPOIs.Init(false, POIDatabase.GetNumPOIs());
+
+	if (!MissingConfigPaths.IsEmpty())
+	{
+		POIConfigsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+			MissingConfigPaths, FStreamableDelegate::CreateUObject(this, &UOBNavigationSubsystem::OnPOIConfigsLoaded));
+	}
+
+	UE_LOG(LogOBNavigation, Log, TEXT("[%s::%hs] - Opened POI database '%s' (%d POIs)."), *GetName(), __FUNCTION__,
+	       *DatabasePath, POIDatabase.GetNumPOIs());
+}
+
+void UOBNavigationSubsystem::OnPOIConfigsLoaded()
+{
+	const TArray<FSoftObjectPath>& ConfigPaths = POIDatabase.GetConfigPaths();
+	for (int32 ConfigIndex = 0; ConfigIndex < POIConfigs.Num() && ConfigIndex < ConfigPaths.Num(); ++ConfigIndex)
+	{
+		if (POIConfigs[ConfigIndex])
+		{
+			continue;
+		}
+
+		POIConfigs[ConfigIndex] = Cast<UOBMarkerConfigAsset>(ConfigPaths[ConfigIndex].ResolveObject());
+		if (!POIConfigs[ConfigIndex])
+		{
+			UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - Marker config '%s' of POI database '%s' could not be loaded. Its POIs are not shown."),
+			       *GetName(), __FUNCTION__, *ConfigPaths[ConfigIndex].ToString(), *POIDatabasePath);
+			continue;
+		}
+		RequestMarkerConfigIcons(POIConfigs[ConfigIndex]);
+	}
+}
+
+void UOBNavigationSubsystem::ClosePOIDatabase()
+{
+	// A database closed while its configs stream in must not receive them
+	if (POIConfigsHandle.IsValid())
+	{
+		POIConfigsHandle->CancelHandle();
+		POIConfigsHandle.Reset();
+	}
+	POIDatabase.Close();
+	POIConfigs.Reset();
+	HiddenPOIs.Empty();
+	POIViewRegion.Reset();
+	POIDatabasePath.Reset();
+	bReportedMissingPOI = false;
+	SET_DWORD_STAT(STAT_OBNav_NumResidentPOIPages, 0);
+}
+
+bool UOBNavigationSubsystem::StartTraceRecording(const FString& FilePath)
+{
+	StopTraceRecording();
+
+	const TSharedPtr<FOBMarkerTraceRecorder> NewRecorder = MakeShared<FOBMarkerTraceRecorder>();
+	if (!NewRecorder->Open(FilePath))
+	{
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - Could not create trace file '%s'."), *GetName(), __FUNCTION__,
+		       *FilePath);
+		return false;
+	}
+
+	TraceRecorder = NewRecorder;
+	UE_LOG(LogOBNavigation, Log, TEXT("[%s::%hs] - Recording marker trace to '%s'."), *GetName(), __FUNCTION__,
+	       *FilePath);
+	return true;
+}
+
+void UOBNavigationSubsystem::StopTraceRecording()
+{
+	if (TraceRecorder.IsValid())
+	{
+		TraceRecorder->Close();
+		UE_LOG(LogOBNavigation, Log, TEXT("[%s::%hs] - Recorded %d frames (%lld bytes)."), *GetName(), __FUNCTION__,
+		       TraceRecorder->GetNumFrames(), TraceRecorder->GetNumBytesWritten());
+		TraceRecorder.Reset();
+	}
+}
+
+bool UOBNavigationSubsystem::StartTraceReplay(const FString& FilePath, const bool bLoop)
+{
+	StopTraceReplay();
+
+	const TSharedPtr<FOBMarkerTraceReplayer> NewReplayer = MakeShared<FOBMarkerTraceReplayer>(this);
+	if (!NewReplayer->Open(FilePath))
+	{
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - '%s' is not a readable marker trace."), *GetName(),
+		       __FUNCTION__, *FilePath);
+		return false;
+	}
+
+	TraceReplayer = NewReplayer;
+	bLoopTraceReplay = bLoop;
+	UE_LOG(LogOBNavigation, Log, TEXT("[%s::%hs] - Replaying marker trace '%s'."), *GetName(), __FUNCTION__, *FilePath);
+	return true;
+}
+
+void UOBNavigationSubsystem::StopTraceReplay()
+{
+	if (TraceReplayer.IsValid())
+	{
+		// Removes the replayed markers and the view override
+		TraceReplayer->Stop();
+		UE_LOG(LogOBNavigation, Log, TEXT("[%s::%hs] - Replayed %d frames (%d layer mismatches)."), *GetName(),
+		       __FUNCTION__, TraceReplayer->GetNumFramesApplied(), TraceReplayer->GetNumLayerMismatches());
+		TraceReplayer.Reset();
+	}
+}
+
+bool UOBNavigationSubsystem::StartRouteToMarker(const FGuid& TargetMarkerID)
+{
+	if (!ActiveMarkersMap.Contains(TargetMarkerID))
+	{
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - Could not find marker to navigate to: %s"), *GetName(),
+		       __FUNCTION__, *TargetMarkerID.ToString());
+		return false;
+	}
+
+	StopRoute();
+	RouteTargetMarkerID = TargetMarkerID;
+
+	// The first query is issued on the next tick, once the pawn and target positions are up to date
+	return true;
+}
+
+void UOBNavigationSubsystem::StopRoute()
+{
+	const bool bHadRoute = RouteTargetMarkerID.IsValid() || !RouteMapPoints.IsEmpty();
+
+	// Any query still in flight is ignored when it completes
+	RoutePendingQueryID = INVALID_NAVQUERYID;
+	RouteTargetMarkerID.Invalidate();
+	RouteWorldPoints.Reset();
+	RouteMapPoints.Reset();
+	RouteMapLayer.Reset();
+	RouteLastQueryTime = -UE_BIG_NUMBER;
+
+	if (bHadRoute)
+	{
+		OnRouteUpdated.Broadcast();
+	}
+}
+
+void UOBNavigationSubsystem::UpdateRoute()
+{
+	OBNAV_SCOPE_CYCLE_COUNTER(STAT_OBNav_UpdateRoute);
+
+	if (!RouteTargetMarkerID.IsValid())
+	{
+		return;
+	}
+
+	const TObjectPtr<UOBMapMarker>* TargetMarker = ActiveMarkersMap.Find(RouteTargetMarkerID);
+	if (!TargetMarker || !*TargetMarker)
+	{
+		// The target marker was removed (expired, actor destroyed, ...)
+		StopRoute();
+		return;
+	}
+
+	if (!TrackedPlayerPawn.IsValid())
+	{
+		return;
+	}
+
+	if (RouteMapLayer != CurrentMinimapLayer && !RouteWorldPoints.IsEmpty())
+	{
+		RebuildRouteMapPoints();
+		OnRouteUpdated.Broadcast();
+	}
+
+	// Never stack queries; a new one is considered once the current one completes
+	if (RoutePendingQueryID != INVALID_NAVQUERYID)
+	{
+		return;
+	}
+
+	const UOBNavigationSettings* Settings = GetDefault<UOBNavigationSettings>();
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (Now - RouteLastQueryTime < Settings->RouteMinRepathInterval)
+	{
+		return;
+	}
+
+	const FVector TargetLocation = (*TargetMarker)->WorldLocation;
+	const bool bTargetMoved = FVector::DistSquared(TargetLocation, RouteQueriedTargetLocation) >
+		FMath::Square(Settings->RouteRepathTargetDistance);
+	const bool bLeftCorridor = OBNavigation::Polyline::DistanceSquaredToPolylineXY(
+		RouteWorldPoints, TrackedPlayerPawn->GetActorLocation()) > FMath::Square(Settings->RouteCorridorWidth);
+
+	if (RouteWorldPoints.IsEmpty() || bTargetMoved || bLeftCorridor)
+	{
+		RequestRoutePath(TargetLocation);
+	}
+}
+
+void UOBNavigationSubsystem::RequestRoutePath(const FVector& TargetLocation)
+{
+	UWorld* World = GetWorld();
+	const APawn* Pawn = TrackedPlayerPawn.Get();
+	UNavigationSystemV1* NavSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	if (!Pawn || !NavSystem)
+	{
+		return;
+	}
+
+	RouteLastQueryTime = World->GetTimeSeconds();
+	RouteQueriedTargetLocation = TargetLocation;
+
+	const FVector StartLocation = Pawn->GetNavAgentLocation();
+	const FNavAgentProperties& AgentProperties = Pawn->GetNavAgentPropertiesRef();
+	const ANavigationData* NavData = NavSystem->GetNavDataForProps(AgentProperties, StartLocation);
+	if (!NavData)
+	{
+		UE_LOG(LogOBNavigation, Verbose, TEXT("[%s::%hs] - No navigation data for the tracked pawn. Route not updated."),
+		       *GetName(), __FUNCTION__);
+		return;
+	}
+
+	FPathFindingQuery Query(Pawn, *NavData, StartLocation, TargetLocation, NavData->GetDefaultQueryFilter());
+	Query.SetAllowPartialPaths(true);
+
+	// The path is computed by the navigation system's async query processing; the result arrives on the game thread
+	RoutePendingQueryID = NavSystem->FindPathAsync(
+		AgentProperties, Query, FNavPathQueryDelegate::CreateUObject(this, &UOBNavigationSubsystem::OnRoutePathFound));
+}
+
+void UOBNavigationSubsystem::OnRoutePathFound(const uint32 QueryID, const ENavigationQueryResult::Type Result,
+                                              FNavPathSharedPtr Path)
+{
+	// Results of superseded or cancelled queries are dropped
+	if (QueryID != RoutePendingQueryID)
+	{
+		return;
+	}
+	RoutePendingQueryID = INVALID_NAVQUERYID;
+
+	if (Result != ENavigationQueryResult::Success || !Path.IsValid())
+	{
+		UE_LOG(LogOBNavigation, Verbose, TEXT("[%s::%hs] - Route query failed. Keeping the previous route."), *GetName(),
+		       __FUNCTION__);
+		return;
+	}
+
+	const TArray<FNavPathPoint>& PathPoints = Path->GetPathPoints();
+	RouteWorldPoints.Reset(PathPoints.Num());
+	for (const FNavPathPoint& PathPoint : PathPoints)
+	{
+		RouteWorldPoints.Add(PathPoint.Location);
+	}
+
+	RebuildRouteMapPoints();
+	OnRouteUpdated.Broadcast();
+}
+
+void UOBNavigationSubsystem::ClearBreadcrumbs()
+{
+	BreadcrumbStart = 0;
+	NumBreadcrumbs = 0;
+	BreadcrumbMergedPoints.Reset();
+}
+
+void UOBNavigationSubsystem::GetBreadcrumbMapPoints(TConstArrayView<FVector2D>& OutOlder,
+                                                    TConstArrayView<FVector2D>& OutNewer) const
+{
+	const int32 NumOlder = FMath::Min(NumBreadcrumbs, BreadcrumbMapPoints.Num() - BreadcrumbStart);
+	OutOlder = MakeArrayView(BreadcrumbMapPoints).Slice(BreadcrumbStart, NumOlder);
+	OutNewer = MakeArrayView(BreadcrumbMapPoints).Slice(0, NumBreadcrumbs - NumOlder);
+}
+
+void UOBNavigationSubsystem::UpdateBreadcrumbs()
+{
+	const APawn* Pawn = TrackedPlayerPawn.Get();
+	if (!Pawn || BreadcrumbWorldPoints.Num() < 2)
+	{
+		return;
+	}
+
+	if (BreadcrumbPawn != Pawn)
+	{
+		ClearBreadcrumbs();
+		BreadcrumbPawn = Pawn;
+	}
+
+	if (BreadcrumbMapLayer != CurrentMinimapLayer)
+	{
+		RebuildBreadcrumbMapPoints();
+	}
+
+	const UOBNavigationSettings* Settings = GetDefault<UOBNavigationSettings>();
+	const FVector Location = Pawn->GetActorLocation();
+	if (NumBreadcrumbs > 0)
+	{
+		const FVector& Last = BreadcrumbWorldPoints[GetBreadcrumbIndex(NumBreadcrumbs - 1)];
+		const double DistanceSquared = FVector::DistSquared(Location, Last);
+		if (DistanceSquared < FMath::Square(Settings->BreadcrumbMinSpacing))
+		{
+			return;
+		}
+
+		if (DistanceSquared > FMath::Square(Settings->BreadcrumbTeleportDistance))
+		{
+			ClearBreadcrumbs();
+		}
+		else if (NumBreadcrumbs >= 2 && BreadcrumbMergedPoints.Num() < BreadcrumbMergedPoints.Max())
+		{
+			// The last point is redundant if it, and every sample merged before it, stays close to the segment from
+			// the point before it to the new location. Checking the merged samples too keeps slow curves from
+			// collapsing into a single chord.
+			const FVector& Anchor = BreadcrumbWorldPoints[GetBreadcrumbIndex(NumBreadcrumbs - 2)];
+			const double ToleranceSquared = FMath::Square(Settings->BreadcrumbCollinearTolerance);
+			bool bCollinear = FMath::PointDistToSegmentSquared(Last, Anchor, Location) <= ToleranceSquared;
+			for (int32 Index = 0; bCollinear && Index < BreadcrumbMergedPoints.Num(); ++Index)
+			{
+				bCollinear = FMath::PointDistToSegmentSquared(BreadcrumbMergedPoints[Index], Anchor, Location) <=
+					ToleranceSquared;
+			}
+
+			if (bCollinear)
+			{
+				MoveLastBreadcrumb(Location);
+				return;
+			}
+		}
+	}
+
+	AppendBreadcrumb(Location);
+}
+
+void UOBNavigationSubsystem::AppendBreadcrumb(const FVector& WorldLocation)
+{
+	int32 Index;
+	if (NumBreadcrumbs < BreadcrumbWorldPoints.Num())
+	{
+		Index = GetBreadcrumbIndex(NumBreadcrumbs++);
+	}
+	else
+	{
+		Index = BreadcrumbStart;
+		BreadcrumbStart = GetBreadcrumbIndex(1);
+	}
+
+	BreadcrumbWorldPoints[Index] = WorldLocation;
+	BreadcrumbMapPoints[Index] = GetBreadcrumbMapPoint(WorldLocation);
+	BreadcrumbMergedPoints.Reset();
+}
+
+void UOBNavigationSubsystem::MoveLastBreadcrumb(const FVector& WorldLocation)
+{
+	const int32 Index = GetBreadcrumbIndex(NumBreadcrumbs - 1);
+	BreadcrumbMergedPoints.Add(BreadcrumbWorldPoints[Index]);
+	BreadcrumbWorldPoints[Index] = WorldLocation;
+	BreadcrumbMapPoints[Index] = GetBreadcrumbMapPoint(WorldLocation);
+}
+
+void UOBNavigationSubsystem::RebuildBreadcrumbMapPoints()
+{
+	BreadcrumbMapLayer = CurrentMinimapLayer;
+	for (int32 Index = 0; Index < NumBreadcrumbs; ++Index)
+	{
+		const int32 RingIndex = GetBreadcrumbIndex(Index);
+		BreadcrumbMapPoints[RingIndex] = GetBreadcrumbMapPoint(BreadcrumbWorldPoints[RingIndex]);
+	}
+}
+
+FVector2D UOBNavigationSubsystem::GetBreadcrumbMapPoint(const FVector& WorldLocation) const
+{
+	// Same mapping as WorldToMapUV, but without rejecting points outside the bounds: the minimap clips them
+	const UOBMapLayerAsset* Layer = BreadcrumbMapLayer.Get();
+	const FVector WorldSize = Layer ? GetLayerBounds(Layer).GetSize() : FVector::ZeroVector;
+	if (FMath::IsNearlyZero(WorldSize.X) || FMath::IsNearlyZero(WorldSize.Y))
+	{
+		return FVector2D::ZeroVector;
+	}
+
+	const FVector& BoundsMin = GetLayerBounds(Layer).Min;
+	return FVector2D((WorldLocation.Y - BoundsMin.Y) / WorldSize.Y, 1.0 - (WorldLocation.X - BoundsMin.X) / WorldSize.X);
+}
+
+void UOBNavigationSubsystem::RebuildRouteMapPoints()
+{
+	RouteMapPoints.Reset();
+	RouteMapLayer = CurrentMinimapLayer;
+	if (!CurrentMinimapLayer || RouteWorldPoints.IsEmpty())
+	{
+		return;
+	}
+
+	const FBox& Bounds = GetLayerBounds(CurrentMinimapLayer);
+	const FVector WorldSize = Bounds.GetSize();
+	if (FMath::IsNearlyZero(WorldSize.X) || FMath::IsNearlyZero(WorldSize.Y))
+	{
+		return;
+	}
+
+	// Simplify in map space scaled back to world units (U * SizeY, V * SizeX), so the tolerance is isotropic
+	// even for non-square layers. Same mapping as WorldToMapUV, but without rejecting points outside the
+	// bounds: off-layer parts of the route are clipped by the minimap instead.
+	TArray<FVector2D, TInlineAllocator<64>> MapSpacePoints;
+	MapSpacePoints.Reserve(RouteWorldPoints.Num());
+	for (const FVector& WorldPoint : RouteWorldPoints)
+	{
+		MapSpacePoints.Emplace(WorldPoint.Y - Bounds.Min.Y, WorldSize.X - (WorldPoint.X - Bounds.Min.X));
+	}
+
+	OBNavigation::Polyline::SimplifyDouglasPeucker(MapSpacePoints,
+	                                               GetDefault<UOBNavigationSettings>()->RouteSimplifyTolerance,
+	                                               RouteMapPoints);
+
+	for (FVector2D& MapPoint : RouteMapPoints)
+	{
+		MapPoint.X /= WorldSize.Y;
+		MapPoint.Y /= WorldSize.X;
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+void UOBNavigationSubsystem::DrawDebugOverlay(UCanvas* Canvas, APlayerController* PlayerController)
+{
+	// Debug draw delegates are global, so skip viewports of other worlds (e.g., other PIE instances)
+	if (!Canvas || !PlayerController || PlayerController->GetWorld() != GetWorld())
+	{
+		return;
+	}
+
+	OBNavigation::Debug::FOverlayTextWriter Writer(Canvas, 50.0f, 50.0f);
+	Writer.Line(FColor::Cyan, TEXT("--- OB NAVIGATION ---"));
+	Writer.Line(FColor::White, FString::Printf(TEXT("Tracked Pawn: %s"),
+	                                           TrackedPlayerPawn.IsValid() ? *TrackedPlayerPawn->GetName() : TEXT("None")));
+	Writer.Line(FColor::White, FString::Printf(TEXT("Layer: %s"),
+	                                           CurrentMinimapLayer ? *CurrentMinimapLayer->GetName() : TEXT("None")));
+	Writer.Line(FColor::White, FString::Printf(TEXT("Markers: %d (%d tracked actors)"), ActiveMarkers.Num(),
+	                                           TrackedActorMarkers.Num()));
+
+	if (const TObjectPtr<UOBExplorationMask>* Mask = ExplorationMasks.Find(CurrentMinimapLayer); Mask && *Mask)
+	{
+		Writer.Line(FColor::White, FString::Printf(TEXT("Explored: %.1f%% (%d extra revealers)"),
+		                                           (*Mask)->GetExploredFraction() * 100.0f, ExplorationRevealers.Num()));
+	}
+
+	if (!Regions.IsEmpty())
+	{
+		Writer.Line(FColor::White, FString::Printf(TEXT("Regions: %d (%d cells, %d extra trackers)"), Regions.Num(),
+		                                           RegionIndex.GetNumCells(), RegionTrackers.Num()));
+	}
+
+	if (!LineOfSightTargets.IsEmpty())
+	{
+		Writer.Line(FColor::White, FString::Printf(TEXT("Line of sight: %d targets, %d extra observers"),
+		                                           LineOfSightTargets.Num(), LineOfSightObservers.Num()));
+	}
+
+	if (RouteTargetMarkerID.IsValid())
+	{
+		Writer.Line(FColor::Yellow, FString::Printf(TEXT("Route: %d path points, %d on map%s"), RouteWorldPoints.Num(),
+		                                            RouteMapPoints.Num(),
+		                                            RoutePendingQueryID != INVALID_NAVQUERYID
+			                                            ? TEXT(" (query pending)")
+			                                            : TEXT("")));
+	}
 }
+#endif
@@ -0,0 +1,61 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "OBNavigationTextureUtils.h"
+
+#include "Engine/Texture2D.h"
+
+UTexture2D* OBNavigation::TextureUtils::CreateOverlayTexture(const int32 Width, const int32 Height,
+                                                             const EPixelFormat PixelFormat, const bool bBilinear,
+                                                             const bool bSRGB)
+{
+	if (Width <= 0 || Height <= 0)
+	{
+		return nullptr;
+	}
+
+	UTexture2D* Texture = UTexture2D::CreateTransient(Width, Height, PixelFormat);
+	if (!Texture)
+	{
+		return nullptr;
+	}
+
+	// Overlays are mostly data textures: no sRGB conversion, no streaming, and clamped so they never bleed at the map
+	// edges.
+	Texture->SRGB = bSRGB;
+	Texture->NeverStream = true;
+	Texture->Filter = bBilinear ? TF_Bilinear : TF_Nearest;
+	Texture->AddressX = TA_Clamp;
+	Texture->AddressY = TA_Clamp;
+	Texture->UpdateResource();
+	return Texture;
+}
+
+void OBNavigation::TextureUtils::UploadTextureRegion(UTexture2D* Texture, const FIntRect& Region,
+                                                     const uint32 BytesPerPixel,
+                                                     const TFunctionRef<void(uint8* RowData, int32 TextureY)> FillRow)
+{
+	if (!Texture || !Texture->GetResource() || Region.IsEmpty())
+	{
+		return;
+	}
+
+	const uint32 RegionWidth = Region.Width();
+	const uint32 RegionHeight = Region.Height();
+	const uint32 Pitch = RegionWidth * BytesPerPixel;
+
+	// The render thread reads this buffer after we return, so it gets its own copy that is freed by the cleanup callback.
+	uint8* Buffer = static_cast<uint8*>(FMemory::Malloc(Pitch * RegionHeight));
+	for (uint32 Row = 0; Row < RegionHeight; ++Row)
+	{
+		FillRow(Buffer + Row * Pitch, Region.Min.Y + Row);
+	}
+
+	FUpdateTextureRegion2D* UpdateRegion = new FUpdateTextureRegion2D(Region.Min.X, Region.Min.Y, 0, 0,
+	                                                                   RegionWidth, RegionHeight);
+	Texture->UpdateTextureRegions(0, 1, UpdateRegion, Pitch, BytesPerPixel, Buffer,
+	                              [](uint8* SrcData, const FUpdateTextureRegion2D* Regions)
+	                              {
+		                              FMemory::Free(SrcData);
+		                              delete Regions;
+	                              });
+}
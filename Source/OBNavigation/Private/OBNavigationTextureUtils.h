@@ -0,0 +1,36 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PixelFormat.h"
+#include "Templates/Function.h"
+
+class UTexture2D;
+
+namespace OBNavigation::TextureUtils
+{
+	/**
+	 * @brief Creates a transient, non-streamed, single-mip texture suitable for CPU driven overlays.
+	 * @param Width Width of the texture in pixels.
+	 * @param Height Height of the texture in pixels.
+	 * @param PixelFormat The pixel format of the texture (e.g., PF_G8 for masks).
+	 * @param bBilinear If true, the texture is sampled with bilinear filtering, otherwise nearest.
+	 * @param bSRGB If true, the pixels are colors rather than data (e.g., a baked map image).
+	 * @return The new texture, or nullptr if it could not be created.
+	 */
+	UTexture2D* CreateOverlayTexture(int32 Width, int32 Height, EPixelFormat PixelFormat, bool bBilinear,
+	                                 bool bSRGB = false);
+
+	/**
+	 * @brief Uploads a sub-rectangle of a texture through UpdateTextureRegions.
+	 * The pixel data is written into a temporary buffer owned by the render command, so the caller's
+	 * data can keep changing immediately after this call returns.
+	 * @param Texture The texture to update. Must have a valid resource.
+	 * @param Region The region (in pixels, max exclusive) to upload.
+	 * @param BytesPerPixel Size of a single pixel in bytes.
+	 * @param FillRow Called once per row of the region with a pointer to the destination row and the texture row index.
+	 */
+	void UploadTextureRegion(UTexture2D* Texture, const FIntRect& Region, uint32 BytesPerPixel,
+	                         TFunctionRef<void(uint8* RowData, int32 TextureY)> FillRow);
+}
@@ -0,0 +1,69 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "OBNavigationWorldSubsystem.h"
+
+#include "OBNavigationSubsystem.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+
+void UOBNavigationWorldSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const UWorld* World = GetWorld();
+	if (const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr)
+	{
+		NavSubsystem = GameInstance->GetSubsystem<UOBNavigationSubsystem>();
+	}
+}
+
+void UOBNavigationWorldSubsystem::Deinitialize()
+{
+	// Leaves the markers alone if the next world already loaded its own
+	UOBNavigationSubsystem* Subsystem = NavSubsystem.Get();
+	if (Subsystem && Subsystem->GetWorld() == GetWorld())
+	{
+		Subsystem->UnloadMapManifest();
+	}
+
+	Super::Deinitialize();
+}
+
+void UOBNavigationWorldSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Runs before the actors of the world begin play
+	if (UOBNavigationSubsystem* Subsystem = NavSubsystem.Get())
+	{
+		Subsystem->LoadMapManifest(&InWorld);
+	}
+}
+
+void UOBNavigationWorldSubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (UOBNavigationSubsystem* Subsystem = NavSubsystem.Get())
+	{
+		Subsystem->Tick(DeltaTime);
+	}
+}
+
+bool UOBNavigationWorldSubsystem::IsTickable() const
+{
+	// A world that is not (or no longer) the game instance world, e.g. one being torn down during travel, is skipped
+	const UOBNavigationSubsystem* Subsystem = NavSubsystem.Get();
+	return Subsystem && Subsystem->GetWorld() == GetWorld() && Subsystem->IsTickNeeded();
+}
+
+TStatId UOBNavigationWorldSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UOBNavigationWorldSubsystem, STATGROUP_Tickables);
+}
+
+bool UOBNavigationWorldSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
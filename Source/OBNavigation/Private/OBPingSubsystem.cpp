@@ -0,0 +1,286 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "OBPingSubsystem.h"
+
+#include "OBMapMarker.h"
+#include "OBNavigation.h"
+#include "OBNavigationSettings.h"
+#include "OBNavigationSubsystem.h"
+#include "Engine/AssetManager.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+
+void UOBPingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const UWorld* World = GetWorld();
+	if (const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr)
+	{
+		NavSubsystem = GameInstance->GetSubsystem<UOBNavigationSubsystem>();
+	}
+
+	const UOBNavigationSettings* Settings = GetDefault<UOBNavigationSettings>();
+	Slots.SetNum(Settings->MaxActivePings);
+	SlotMarkers.SetNum(Settings->MaxActivePings);
+	SlotIndexByMarkerID.Reserve(Settings->MaxActivePings);
+
+	if (!Settings->DefaultPingConfig.IsNull())
+	{
+		DefaultPingConfigHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+			Settings->DefaultPingConfig.ToSoftObjectPath());
+	}
+}
+
+void UOBPingSubsystem::Deinitialize()
+{
+	// The navigation subsystem outlives the world; it must not keep markers owned by this subsystem
+	if (NumActivePings > 0)
+	{
+		for (int32 SlotIndex = 0; SlotIndex < Slots.Num(); ++SlotIndex)
+		{
+			DeactivateSlot(SlotIndex);
+		}
+		NotifyMarkersChanged();
+	}
+
+	if (DefaultPingConfigHandle.IsValid())
+	{
+		DefaultPingConfigHandle->ReleaseHandle();
+		DefaultPingConfigHandle.Reset();
+	}
+
+	Super::Deinitialize();
+}
+
+void UOBPingSubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	bool bAnyExpired = false;
+	for (int32 SlotIndex = 0; SlotIndex < Slots.Num(); ++SlotIndex)
+	{
+		if (Slots[SlotIndex].bActive && Slots[SlotIndex].ExpireTime <= Now)
+		{
+			DeactivateSlot(SlotIndex);
+			bAnyExpired = true;
+		}
+	}
+
+	if (bAnyExpired)
+	{
+		// A single marker list update for every ping that expired this frame
+		NotifyMarkersChanged();
+	}
+}
+
+bool UOBPingSubsystem::IsTickable() const
+{
+	return NumActivePings > 0;
+}
+
+TStatId UOBPingSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UOBPingSubsystem, STATGROUP_Tickables);
+}
+
+bool UOBPingSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+EOBPingResult UOBPingSubsystem::PingLocation(UObject* PingInstigator, const FVector InLocation,
+                                             UOBMarkerConfigAsset* InConfig, FOBPingHandle& OutHandle)
+{
+	OutHandle = FOBPingHandle();
+
+	const UOBNavigationSettings* Settings = GetDefault<UOBNavigationSettings>();
+	UOBMarkerConfigAsset* Config = InConfig ? InConfig : Settings->DefaultPingConfig.Get();
+	UOBNavigationSubsystem* Subsystem = NavSubsystem.Get();
+	if (!PingInstigator || !Config || !Subsystem || Slots.IsEmpty())
+	{
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - Invalid ping (instigator: %s, config: %s)."), *GetName(),
+		       __FUNCTION__, *GetNameSafe(PingInstigator), *GetNameSafe(Config));
+		return EOBPingResult::Invalid;
+	}
+
+	if (!ConsumePingAllowance(PingInstigator))
+	{
+		return EOBPingResult::RateLimited;
+	}
+
+	// Prefer a free slot; once every slot is in use, the ping placed first is replaced
+	int32 SlotIndex = NextSlotIndex;
+	if (NumActivePings < Slots.Num())
+	{
+		while (Slots[SlotIndex].bActive)
+		{
+			SlotIndex = (SlotIndex + 1) % Slots.Num();
+		}
+	}
+	else
+	{
+		for (int32 Index = 0; Index < Slots.Num(); ++Index)
+		{
+			if (Slots[Index].PlacementOrder < Slots[SlotIndex].PlacementOrder)
+			{
+				SlotIndex = Index;
+			}
+		}
+	}
+	NextSlotIndex = (SlotIndex + 1) % Slots.Num();
+
+	FPingSlot& Slot = Slots[SlotIndex];
+	TObjectPtr<UOBMapMarker>& Marker = SlotMarkers[SlotIndex];
+	if (!Marker)
+	{
+		// Owned by this subsystem, so the navigation subsystem treats it as transient (e.g., it is never saved)
+		Marker = NewObject<UOBMapMarker>(this);
+		Marker->MarkerID = FGuid::NewGuid();
+		SlotIndexByMarkerID.Add(Marker->MarkerID, SlotIndex);
+	}
+
+	Marker->Init(Marker->MarkerID, nullptr, Config, Settings->PingLayerName, InLocation);
+	// Expiration is handled here, with the slot
+	Marker->CurrentLifeTime = 0.0f;
+
+	const float LifeTime = Config->LifeTime > 0.0f ? Config->LifeTime : Settings->DefaultPingLifeTime;
+	Slot.ExpireTime = GetWorld()->GetTimeSeconds() + LifeTime;
+	Marker->SetAnimationLifeTime(LifeTime);
+	Slot.NumAcknowledgements = 0;
+	Slot.PlacementOrder = ++NumPlacedPings;
+	++Slot.Generation;
+	if (!Slot.bActive)
+	{
+		Slot.bActive = true;
+		++NumActivePings;
+	}
+
+	// Re-adding a replaced ping's marker only refreshes its entry
+	Subsystem->AddMarker(Marker);
+	NotifyMarkersChanged();
+
+	OutHandle.SlotIndex = SlotIndex;
+	OutHandle.Generation = Slot.Generation;
+	OnMarkerPinged.Broadcast(Marker->MarkerID, PingInstigator, false);
+	return EOBPingResult::Placed;
+}
+
+EOBPingResult UOBPingSubsystem::AcknowledgeMarker(UObject* PingInstigator, const FGuid& MarkerID)
+{
+	const UOBNavigationSubsystem* Subsystem = NavSubsystem.Get();
+	if (!PingInstigator || !Subsystem || !Subsystem->ActiveMarkersMap.Contains(MarkerID))
+	{
+		return EOBPingResult::Invalid;
+	}
+
+	if (!ConsumePingAllowance(PingInstigator))
+	{
+		return EOBPingResult::RateLimited;
+	}
+
+	if (const int32* SlotIndex = SlotIndexByMarkerID.Find(MarkerID); SlotIndex && Slots[*SlotIndex].bActive)
+	{
+		FPingSlot& Slot = Slots[*SlotIndex];
+		Slot.ExpireTime = FMath::Max(Slot.ExpireTime, GetWorld()->GetTimeSeconds() +
+		                             GetDefault<UOBNavigationSettings>()->PingAcknowledgeLifeTime);
+		++Slot.NumAcknowledgements;
+
+		// Push the fade-out back with the expiry
+		SlotMarkers[*SlotIndex]->SetAnimationLifeTime(static_cast<float>(Slot.ExpireTime - GetWorld()->GetTimeSeconds()));
+	}
+
+	OnMarkerPinged.Broadcast(MarkerID, PingInstigator, true);
+	return EOBPingResult::Acknowledged;
+}
+
+void UOBPingSubsystem::CancelPing(const FOBPingHandle& Handle)
+{
+	if (GetPingMarkerID(Handle).IsValid())
+	{
+		DeactivateSlot(Handle.SlotIndex);
+		NotifyMarkersChanged();
+	}
+}
+
+FGuid UOBPingSubsystem::GetPingMarkerID(const FOBPingHandle& Handle) const
+{
+	if (!Slots.IsValidIndex(Handle.SlotIndex) || !Slots[Handle.SlotIndex].bActive ||
+		Slots[Handle.SlotIndex].Generation != Handle.Generation)
+	{
+		return FGuid();
+	}
+	return SlotMarkers[Handle.SlotIndex]->MarkerID;
+}
+
+int32 UOBPingSubsystem::GetPingAcknowledgements(const FOBPingHandle& Handle) const
+{
+	return GetPingMarkerID(Handle).IsValid() ? Slots[Handle.SlotIndex].NumAcknowledgements : 0;
+}
+
+bool UOBPingSubsystem::ConsumePingAllowance(const UObject* PingInstigator)
+{
+	const UOBNavigationSettings* Settings = GetDefault<UOBNavigationSettings>();
+	const double Now = FPlatformTime::Seconds();
+
+	FPingAllowance* Allowance = PingAllowances.Find(PingInstigator);
+	if (!Allowance)
+	{
+		// Instigators that left (e.g., disconnected players) are dropped before a new one is added
+		for (auto It = PingAllowances.CreateIterator(); It; ++It)
+		{
+			if (!It.Key().ResolveObjectPtr())
+			{
+				It.RemoveCurrent();
+			}
+		}
+		Allowance = &PingAllowances.Add(PingInstigator, {static_cast<float>(Settings->PingBurstSize), Now});
+	}
+	else if (Settings->PingRefillInterval <= 0.0f)
+	{
+		Allowance->Tokens = Settings->PingBurstSize;
+	}
+	else
+	{
+		const float Refill = static_cast<float>((Now - Allowance->LastRefillTime) / Settings->PingRefillInterval);
+		Allowance->Tokens = FMath::Min(Allowance->Tokens + Refill, static_cast<float>(Settings->PingBurstSize));
+	}
+	Allowance->LastRefillTime = Now;
+
+	if (Allowance->Tokens < 1.0f)
+	{
+		UE_LOG(LogOBNavigation, Verbose, TEXT("[%s::%hs] - %s is pinging too often."), *GetName(), __FUNCTION__,
+		       *GetNameSafe(PingInstigator));
+		return false;
+	}
+
+	Allowance->Tokens -= 1.0f;
+	return true;
+}
+
+void UOBPingSubsystem::DeactivateSlot(const int32 SlotIndex)
+{
+	FPingSlot& Slot = Slots[SlotIndex];
+	if (!Slot.bActive)
+	{
+		return;
+	}
+
+	Slot.bActive = false;
+	--NumActivePings;
+	if (UOBNavigationSubsystem* Subsystem = NavSubsystem.Get())
+	{
+		Subsystem->RemoveMarker(SlotMarkers[SlotIndex]->MarkerID);
+	}
+}
+
+void UOBPingSubsystem::NotifyMarkersChanged() const
+{
+	if (UOBNavigationSubsystem* Subsystem = NavSubsystem.Get())
+	{
+		Subsystem->RebuildActiveMarkersArray();
+		Subsystem->OnMarkersUpdated.Broadcast();
+	}
+}
@@ -0,0 +1,107 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "OBPointOfInterestComponent.h"
+
+#include "OBNavigation.h"
+#include "OBNavigationSubsystem.h"
+#include "Engine/GameInstance.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "UObject/Package.h"
+
+
+UOBPointOfInterestComponent::UOBPointOfInterestComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UOBPointOfInterestComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Same as character markers: a dedicated server has no map to show them on
+	if (GetNetMode() == NM_DedicatedServer || !MarkerConfig)
+	{
+		return;
+	}
+
+	if (const UGameInstance* GI = GetWorld()->GetGameInstance())
+	{
+		NavSubsystem = GI->GetSubsystem<UOBNavigationSubsystem>();
+	}
+
+	if (!NavSubsystem)
+	{
+		UE_LOG(LogOBNavigation, Error, TEXT("[%s::%hs] - OBNavigationSubsystem is not valid! Cannot register the point of interest."),
+		       *GetName(), __FUNCTION__);
+		return;
+	}
+
+	MarkerID = MakeMarkerID(GetOwner());
+
+	// Stored in the POI database opened at world begin play
+	if (bStoreInPOIDatabase)
+	{
+		POIIndex = NavSubsystem->FindPOIIndex(MarkerID);
+		if (POIIndex != INDEX_NONE)
+		{
+			MarkerID.Invalidate();
+			return;
+		}
+		NavSubsystem->ReportMissingPOI(GetOwner());
+	}
+
+	// Baked into the map manifest and restored at world begin play
+	if (NavSubsystem->HasMarker(MarkerID))
+	{
+		bBakedMarker = true;
+		return;
+	}
+
+	if (!NavSubsystem->RegisterStaticMarkerWithID(MarkerID, MarkerConfig, MarkerLayerName, GetOwner()->GetActorLocation()))
+	{
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - Failed to register the point of interest of '%s'."), *GetName(),
+		       __FUNCTION__, *GetNameSafe(GetOwner()));
+		MarkerID.Invalidate();
+	}
+}
+
+void UOBPointOfInterestComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// The database is read-only, so a destroyed point of interest is hidden instead
+	if (NavSubsystem && POIIndex != INDEX_NONE && EndPlayReason == EEndPlayReason::Destroyed)
+	{
+		NavSubsystem->SetPOIHidden(POIIndex, true);
+	}
+	POIIndex = INDEX_NONE;
+
+	// Baked markers go away with the map manifest, unless the point of interest itself is gone (e.g., a destroyed outpost)
+	if (NavSubsystem && MarkerID.IsValid() && (!bBakedMarker || EndPlayReason == EEndPlayReason::Destroyed))
+	{
+		NavSubsystem->UnregisterMapMarker(MarkerID);
+		MarkerID.Invalidate();
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+FGuid UOBPointOfInterestComponent::MakeMarkerID(const FString& MapPackageName, const FName ActorName)
+{
+	return FGuid::NewDeterministicGuid(MapPackageName + TEXT(":") + ActorName.ToString());
+}
+
+FGuid UOBPointOfInterestComponent::MakeMarkerID(const AActor* InActor)
+{
+	// The level's package is the map package, even for actors saved in their own external package. Actors of a World
+	// Partition map are streamed in with generated cell levels, so its package is taken from the world instead.
+	const ULevel* Level = InActor ? InActor->GetLevel() : nullptr;
+	if (!Level)
+	{
+		return FGuid();
+	}
+	const UWorld* World = InActor->GetWorld();
+	const UPackage* MapPackage = World && World->IsPartitionedWorld() ? World->GetOutermost() : Level->GetOutermost();
+	return MakeMarkerID(UWorld::RemovePIEPrefix(MapPackage->GetName()), InActor->GetFName());
+}
@@ -0,0 +1,317 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "OBPolylineUtils.h"
+
+void OBNavigation::Polyline::SimplifyDouglasPeucker(const TConstArrayView<FVector2D> Points, const double Tolerance,
+                                                    TArray<FVector2D>& OutPoints)
+{
+	OutPoints.Reset();
+	const int32 NumPoints = Points.Num();
+	if (NumPoints <= 2)
+	{
+		OutPoints.Append(Points.GetData(), NumPoints);
+		return;
+	}
+
+	TBitArray<> KeepPoint(false, NumPoints);
+	KeepPoint[0] = true;
+	KeepPoint[NumPoints - 1] = true;
+
+	// Iterative to avoid deep recursion on long, noisy paths
+	TArray<TPair<int32, int32>, TInlineAllocator<32>> Spans;
+	Spans.Emplace(0, NumPoints - 1);
+	const double ToleranceSquared = FMath::Square(Tolerance);
+
+	while (!Spans.IsEmpty())
+	{
+		const TPair<int32, int32> Span = Spans.Pop();
+		const FVector2D& SpanStart = Points[Span.Key];
+		const FVector2D& SpanEnd = Points[Span.Value];
+
+		double MaxDistanceSquared = 0.0;
+		int32 FarthestIndex = INDEX_NONE;
+		for (int32 Index = Span.Key + 1; Index < Span.Value; ++Index)
+		{
+			const FVector2D Closest = FMath::ClosestPointOnSegment2D(Points[Index], SpanStart, SpanEnd);
+			const double DistanceSquared = FVector2D::DistSquared(Points[Index], Closest);
+			if (DistanceSquared > MaxDistanceSquared)
+			{
+				MaxDistanceSquared = DistanceSquared;
+				FarthestIndex = Index;
+			}
+		}
+
+		if (FarthestIndex != INDEX_NONE && MaxDistanceSquared > ToleranceSquared)
+		{
+			KeepPoint[FarthestIndex] = true;
+			Spans.Emplace(Span.Key, FarthestIndex);
+			Spans.Emplace(FarthestIndex, Span.Value);
+		}
+	}
+
+	for (TConstSetBitIterator<> It(KeepPoint); It; ++It)
+	{
+		OutPoints.Add(Points[It.GetIndex()]);
+	}
+}
+
+double OBNavigation::Polyline::DistanceSquaredToPolylineXY(const TConstArrayView<FVector> Points,
+                                                           const FVector& Location)
+{
+	if (Points.IsEmpty())
+	{
+		return MAX_dbl;
+	}
+
+	const FVector2D Location2D(Location);
+	if (Points.Num() == 1)
+	{
+		return FVector2D::DistSquared(Location2D, FVector2D(Points[0]));
+	}
+
+	double MinDistanceSquared = MAX_dbl;
+	for (int32 Index = 0; Index + 1 < Points.Num(); ++Index)
+	{
+		const FVector2D Closest = FMath::ClosestPointOnSegment2D(Location2D, FVector2D(Points[Index]),
+		                                                         FVector2D(Points[Index + 1]));
+		MinDistanceSquared = FMath::Min(MinDistanceSquared, FVector2D::DistSquared(Location2D, Closest));
+	}
+	return MinDistanceSquared;
+}
+
+bool OBNavigation::Polyline::ClipSegment(FVector2D& Start, FVector2D& End, const FVector2D& Center,
+                                         const double Radius, const bool bCircle)
+{
+	const FVector2D Delta = End - Start;
+	double MinT = 0.0;
+	double MaxT = 1.0;
+
+	if (bCircle)
+	{
+		// Solve |Start + Delta * t - Center| = Radius
+		const FVector2D FromCenter = Start - Center;
+		const double A = Delta.SizeSquared();
+		const double C = FromCenter.SizeSquared() - FMath::Square(Radius);
+		if (A <= UE_SMALL_NUMBER)
+		{
+			return C <= 0.0;
+		}
+
+		const double B = 2.0 * FVector2D::DotProduct(FromCenter, Delta);
+		const double Discriminant = B * B - 4.0 * A * C;
+		if (Discriminant < 0.0)
+		{
+			return false;
+		}
+
+		const double Root = FMath::Sqrt(Discriminant);
+		MinT = FMath::Max(MinT, (-B - Root) / (2.0 * A));
+		MaxT = FMath::Min(MaxT, (-B + Root) / (2.0 * A));
+	}
+	else
+	{
+		// Liang-Barsky against the square [Center - Radius, Center + Radius]
+		const double P[4] = {-Delta.X, Delta.X, -Delta.Y, Delta.Y};
+		const double Q[4] = {
+			Start.X - (Center.X - Radius), (Center.X + Radius) - Start.X,
+			Start.Y - (Center.Y - Radius), (Center.Y + Radius) - Start.Y
+		};
+
+		for (int32 Edge = 0; Edge < 4; ++Edge)
+		{
+			if (FMath::IsNearlyZero(P[Edge]))
+			{
+				if (Q[Edge] < 0.0)
+				{
+					return false; // Parallel to and outside this edge
+				}
+				continue;
+			}
+
+			const double T = Q[Edge] / P[Edge];
+			if (P[Edge] < 0.0)
+			{
+				MinT = FMath::Max(MinT, T);
+			}
+			else
+			{
+				MaxT = FMath::Min(MaxT, T);
+			}
+		}
+	}
+
+	if (MinT > MaxT)
+	{
+		return false;
+	}
+
+	// Only touch endpoints that were actually clipped, so unclipped points compare equal to their source
+	const FVector2D ClippedStart = Start + Delta * MinT;
+	if (MaxT < 1.0)
+	{
+		End = Start + Delta * MaxT;
+	}
+	if (MinT > 0.0)
+	{
+		Start = ClippedStart;
+	}
+	return true;
+}
+
+int32 OBNavigation::Polyline::ClipPolyline(const TConstArrayView<FVector2D> Points, const FVector2D& Center,
+                                           const double Radius, const bool bCircle, TArray<TArray<FVector2D>>& OutRuns,
+                                           const int32 FirstRun)
+{
+	int32 NumRuns = FirstRun;
+	bool bRunOpen = false;
+
+	for (int32 Index = 0; Index + 1 < Points.Num(); ++Index)
+	{
+		FVector2D Start = Points[Index];
+		FVector2D End = Points[Index + 1];
+		if (!ClipSegment(Start, End, Center, Radius, bCircle))
+		{
+			bRunOpen = false;
+			continue;
+		}
+
+		// A clipped start means the polyline re-entered the shape, which begins a new run
+		if (!bRunOpen || Start != Points[Index])
+		{
+			if (OutRuns.Num() <= NumRuns)
+			{
+				OutRuns.AddDefaulted();
+			}
+			OutRuns[NumRuns].Reset();
+			OutRuns[NumRuns].Add(Start);
+			++NumRuns;
+		}
+
+		OutRuns[NumRuns - 1].Add(End);
+		bRunOpen = End == Points[Index + 1];
+	}
+
+	return NumRuns - FirstRun;
+}
+
+void OBNavigation::Polyline::ClipConvexPolygon(const TConstArrayView<FVector2D> Points,
+                                               const TConstArrayView<FVector2D> ClipPolygon, TArray<FVector2D>& OutPoints)
+{
+	OutPoints.Reset();
+	OutPoints.Append(Points.GetData(), Points.Num());
+	if (ClipPolygon.Num() < 3)
+	{
+		return;
+	}
+
+	// Inside is on the left of each clip edge for a counter-clockwise clip polygon
+	const double Winding = GetSignedArea(ClipPolygon) >= 0.0 ? 1.0 : -1.0;
+	TArray<FVector2D, TInlineAllocator<16>> Input;
+	for (int32 Edge = 0; Edge < ClipPolygon.Num() && !OutPoints.IsEmpty(); ++Edge)
+	{
+		const FVector2D& EdgeStart = ClipPolygon[Edge];
+		const FVector2D EdgeDirection = ClipPolygon[(Edge + 1) % ClipPolygon.Num()] - EdgeStart;
+		auto GetSide = [&EdgeStart, &EdgeDirection, Winding](const FVector2D& Point)
+		{
+			return Winding * FVector2D::CrossProduct(EdgeDirection, Point - EdgeStart);
+		};
+
+		Input.Reset();
+		Input.Append(OutPoints);
+		OutPoints.Reset();
+		FVector2D Previous = Input.Last();
+		double PreviousSide = GetSide(Previous);
+		for (const FVector2D& Current : Input)
+		{
+			const double CurrentSide = GetSide(Current);
+			if ((CurrentSide >= 0.0) != (PreviousSide >= 0.0))
+			{
+				OutPoints.Add(Previous + (Current - Previous) * (PreviousSide / (PreviousSide - CurrentSide)));
+			}
+			if (CurrentSide >= 0.0)
+			{
+				OutPoints.Add(Current);
+			}
+			Previous = Current;
+			PreviousSide = CurrentSide;
+		}
+	}
+}
+
+bool OBNavigation::Polyline::TriangulatePolygon(const TConstArrayView<FVector2D> Points, TArray<int32>& OutIndices)
+{
+	OutIndices.Reset();
+	const int32 NumPoints = Points.Num();
+	if (NumPoints < 3)
+	{
+		return false;
+	}
+
+	// Work on a counter-clockwise index ring, so ears are the convex corners
+	TArray<int32, TInlineAllocator<32>> Ring;
+	Ring.Reserve(NumPoints);
+	const bool bCounterClockwise = GetSignedArea(Points) >= 0.0;
+	for (int32 Index = 0; Index < NumPoints; ++Index)
+	{
+		Ring.Add(bCounterClockwise ? Index : NumPoints - 1 - Index);
+	}
+
+	int32 Corner = 0;
+	int32 NumFailedCorners = 0;
+	while (Ring.Num() > 3)
+	{
+		// Every remaining corner was tried without finding an ear: the polygon is not simple
+		if (NumFailedCorners >= Ring.Num())
+		{
+			return false;
+		}
+
+		const int32 PrevIndex = Ring[(Corner + Ring.Num() - 1) % Ring.Num()];
+		const int32 EarIndex = Ring[Corner];
+		const int32 NextIndex = Ring[(Corner + 1) % Ring.Num()];
+		const FVector2D& A = Points[PrevIndex];
+		const FVector2D& B = Points[EarIndex];
+		const FVector2D& C = Points[NextIndex];
+
+		bool bIsEar = FVector2D::CrossProduct(B - A, C - B) > 0.0;
+		for (int32 Other = 0; bIsEar && Other < Ring.Num(); ++Other)
+		{
+			const int32 OtherIndex = Ring[Other];
+			if (OtherIndex == PrevIndex || OtherIndex == EarIndex || OtherIndex == NextIndex)
+			{
+				continue;
+			}
+
+			// No other corner may lie inside (or on the edge of) the ear
+			const FVector2D& P = Points[OtherIndex];
+			bIsEar = FVector2D::CrossProduct(B - A, P - A) < 0.0 || FVector2D::CrossProduct(C - B, P - B) < 0.0 ||
+				FVector2D::CrossProduct(A - C, P - C) < 0.0;
+		}
+
+		if (bIsEar)
+		{
+			OutIndices.Append({PrevIndex, EarIndex, NextIndex});
+			Ring.RemoveAt(Corner);
+			Corner %= Ring.Num();
+			NumFailedCorners = 0;
+		}
+		else
+		{
+			Corner = (Corner + 1) % Ring.Num();
+			++NumFailedCorners;
+		}
+	}
+
+	OutIndices.Append({Ring[0], Ring[1], Ring[2]});
+	return true;
+}
+
+double OBNavigation::Polyline::GetSignedArea(const TConstArrayView<FVector2D> Points)
+{
+	double DoubleArea = 0.0;
+	for (int32 Index = 0; Index < Points.Num(); ++Index)
+	{
+		DoubleArea += FVector2D::CrossProduct(Points[Index], Points[(Index + 1) % Points.Num()]);
+	}
+	return DoubleArea * 0.5;
+}
@@ -0,0 +1,64 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace OBNavigation::Polyline
+{
+	/**
+	 * @brief Simplifies a polyline with the Douglas-Peucker algorithm. The first and last points are always kept.
+	 * @param Points The source polyline.
+	 * @param Tolerance Maximum distance between a removed point and the simplified polyline.
+	 * @param OutPoints Receives the simplified polyline. Must not alias Points.
+	 */
+	void SimplifyDouglasPeucker(TConstArrayView<FVector2D> Points, double Tolerance, TArray<FVector2D>& OutPoints);
+
+	// Squared distance (ignoring Z) from a point to the closest segment of a polyline. Returns MAX_dbl for an empty polyline.
+	double DistanceSquaredToPolylineXY(TConstArrayView<FVector> Points, const FVector& Location);
+
+	/**
+	 * @brief Clips a segment against a circle or an axis-aligned square, both centered on Center.
+	 * @param Start Segment start, moved onto the shape boundary if it lies outside.
+	 * @param End Segment end, moved onto the shape boundary if it lies outside.
+	 * @param Center Center of the clipping shape.
+	 * @param Radius Radius of the circle, or half the side length of the square.
+	 * @param bCircle True to clip against the circle, false for the square.
+	 * @return False if no part of the segment is inside the shape.
+	 */
+	bool ClipSegment(FVector2D& Start, FVector2D& End, const FVector2D& Center, double Radius, bool bCircle);
+
+	/**
+	 * @brief Clips a polyline against a circle or square and appends the visible runs.
+	 * @param Points The polyline to clip.
+	 * @param Center Center of the clipping shape.
+	 * @param Radius Radius of the circle, or half the side length of the square.
+	 * @param bCircle True to clip against the circle, false for the square.
+	 * @param OutRuns Receives one connected polyline per visible run. Existing inner arrays are reused.
+	 * @param FirstRun Index of the first run to write, so several polylines can share OutRuns.
+	 * @return The number of runs written to OutRuns.
+	 */
+	int32 ClipPolyline(TConstArrayView<FVector2D> Points, const FVector2D& Center, double Radius, bool bCircle,
+	                   TArray<TArray<FVector2D>>& OutRuns, int32 FirstRun = 0);
+
+	/**
+	 * @brief Clips a polygon against a convex polygon (Sutherland-Hodgman).
+	 * @param Points The polygon to clip. If it is convex, so is the result.
+	 * @param ClipPolygon The convex clipping polygon, in either winding order.
+	 * @param OutPoints Receives the clipped polygon, empty if nothing is inside. Must not alias the inputs.
+	 */
+	void ClipConvexPolygon(TConstArrayView<FVector2D> Points, TConstArrayView<FVector2D> ClipPolygon,
+	                       TArray<FVector2D>& OutPoints);
+
+	/**
+	 * @brief Triangulates a simple polygon (convex or not, without holes) by ear clipping. O(n^2), meant for
+	 * polygons that are triangulated once.
+	 * @param Points The polygon, in either winding order.
+	 * @param OutIndices Receives three indices into Points per triangle.
+	 * @return False if the polygon is degenerate or self-intersecting; OutIndices then holds what could be clipped.
+	 */
+	bool TriangulatePolygon(TConstArrayView<FVector2D> Points, TArray<int32>& OutIndices);
+
+	// Signed area of a polygon, positive for counter-clockwise winding (in a Y-up frame).
+	double GetSignedArea(TConstArrayView<FVector2D> Points);
+}
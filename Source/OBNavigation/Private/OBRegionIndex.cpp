@@ -0,0 +1,134 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "OBRegionIndex.h"
+
+FOBRegionShape::FOBRegionShape(const FVector& InCenter, const FVector& InHalfExtents, const float InYaw)
+	: Center(InCenter)
+	, HalfExtents(InHalfExtents.GetAbs())
+{
+	FMath::SinCos(&Sin, &Cos, FMath::DegreesToRadians(static_cast<double>(InYaw)));
+}
+
+bool FOBRegionShape::Contains(const FVector& Location) const
+{
+	const FVector Offset = Location - Center;
+	const double LocalX = Offset.X * Cos + Offset.Y * Sin;
+	const double LocalY = Offset.Y * Cos - Offset.X * Sin;
+	return FMath::Abs(LocalX) <= HalfExtents.X && FMath::Abs(LocalY) <= HalfExtents.Y &&
+		FMath::Abs(Offset.Z) <= HalfExtents.Z;
+}
+
+FBox FOBRegionShape::GetBounds() const
+{
+	const double AbsSin = FMath::Abs(Sin);
+	const double AbsCos = FMath::Abs(Cos);
+	const FVector Extent(AbsCos * HalfExtents.X + AbsSin * HalfExtents.Y, AbsSin * HalfExtents.X + AbsCos * HalfExtents.Y,
+	                     HalfExtents.Z);
+	return FBox(Center - Extent, Center + Extent);
+}
+
+bool FOBRegionShape::IsSeparatedFrom(const FVector& CubeCenter, const double CubeHalfSize) const
+{
+	const FVector Offset = CubeCenter - Center;
+	const double LocalX = Offset.X * Cos + Offset.Y * Sin;
+	const double LocalY = Offset.Y * Cos - Offset.X * Sin;
+
+	// Half size of the cube's footprint projected on either horizontal axis of the box
+	const double ProjectedHalfSize = CubeHalfSize * (FMath::Abs(Sin) + FMath::Abs(Cos));
+	return FMath::Abs(LocalX) > HalfExtents.X + ProjectedHalfSize ||
+		FMath::Abs(LocalY) > HalfExtents.Y + ProjectedHalfSize || FMath::Abs(Offset.Z) > HalfExtents.Z + CubeHalfSize;
+}
+
+void FOBRegionIndex::Build(const TMap<FName, FOBRegionShape>& InRegions, const double InCellSize,
+                           const int32 MaxCellsPerRegion)
+{
+	CellSize = FMath::Max(InCellSize, 1.0);
+	Names.Reset(InRegions.Num());
+	Shapes.Reset(InRegions.Num());
+	Cells.Reset();
+	UnindexedRegions.Reset();
+	// Skips 0, the version of trackers that were never evaluated
+	Version = Version + 1 != 0 ? Version + 1 : 1;
+
+	const double HalfCellSize = CellSize * 0.5;
+	for (const TPair<FName, FOBRegionShape>& Pair : InRegions)
+	{
+		const int32 RegionIndex = Names.Add(Pair.Key);
+		const FOBRegionShape& Shape = Shapes.Add_GetRef(Pair.Value);
+
+		const FBox Bounds = Shape.GetBounds();
+		const FIntVector MinCell = GetCell(Bounds.Min);
+		const FIntVector MaxCell = GetCell(Bounds.Max);
+		const int64 NumCells = static_cast<int64>(MaxCell.X - MinCell.X + 1) * (MaxCell.Y - MinCell.Y + 1) *
+			(MaxCell.Z - MinCell.Z + 1);
+		if (NumCells > MaxCellsPerRegion)
+		{
+			UnindexedRegions.Add(RegionIndex);
+			continue;
+		}
+
+		for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+			{
+				for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+				{
+					const FVector CellMin = FVector(X, Y, Z) * CellSize;
+					const FVector CellCenter = CellMin + FVector(HalfCellSize);
+					if (Shape.IsSeparatedFrom(CellCenter, HalfCellSize))
+					{
+						continue;
+					}
+
+					// The box is convex: if it holds every corner of the cube, it holds the whole cube
+					bool bContainsCell = true;
+					for (int32 Corner = 0; Corner < 8 && bContainsCell; ++Corner)
+					{
+						const FVector CornerOffset((Corner & 1) ? CellSize : 0.0, (Corner & 2) ? CellSize : 0.0,
+						                           (Corner & 4) ? CellSize : 0.0);
+						bContainsCell = Shape.Contains(CellMin + CornerOffset);
+					}
+
+					FCell& Cell = Cells.FindOrAdd(FIntVector(X, Y, Z));
+					(bContainsCell ? Cell.InsideRegions : Cell.CrossingRegions).Add(RegionIndex);
+				}
+			}
+		}
+	}
+}
+
+FIntVector FOBRegionIndex::GetCell(const FVector& Location) const
+{
+	return FIntVector(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize),
+	                  FMath::FloorToInt32(Location.Z / CellSize));
+}
+
+bool FOBRegionIndex::FindRegions(const FIntVector& Cell, const FVector& Location,
+                                 TArray<FName, TInlineAllocator<4>>& OutRegions) const
+{
+	bool bUniform = UnindexedRegions.IsEmpty();
+	if (const FCell* FoundCell = Cells.Find(Cell))
+	{
+		for (const int32 RegionIndex : FoundCell->InsideRegions)
+		{
+			OutRegions.Add(Names[RegionIndex]);
+		}
+		for (const int32 RegionIndex : FoundCell->CrossingRegions)
+		{
+			if (Shapes[RegionIndex].Contains(Location))
+			{
+				OutRegions.Add(Names[RegionIndex]);
+			}
+		}
+		bUniform &= FoundCell->CrossingRegions.IsEmpty();
+	}
+
+	for (const int32 RegionIndex : UnindexedRegions)
+	{
+		if (Shapes[RegionIndex].Contains(Location))
+		{
+			OutRegions.Add(Names[RegionIndex]);
+		}
+	}
+	return bUniform;
+}
@@ -0,0 +1,67 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "OBRegionVolume.h"
+
+#include "OBNavigation.h"
+#include "OBNavigationSubsystem.h"
+#include "Components/BoxComponent.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+
+AOBRegionVolume::AOBRegionVolume()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	Box = CreateDefaultSubobject<UBoxComponent>(TEXT("Box"));
+	Box->SetBoxExtent(FVector(1000.0f, 1000.0f, 500.0f));
+	Box->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Box->SetCanEverAffectNavigation(false);
+	Box->SetHiddenInGame(true);
+	RootComponent = Box;
+}
+
+void AOBRegionVolume::BeginPlay()
+{
+	Super::BeginPlay();
+
+	const UGameInstance* GI = GetWorld()->GetGameInstance();
+	UOBNavigationSubsystem* NavSubsystem = GI ? GI->GetSubsystem<UOBNavigationSubsystem>() : nullptr;
+	if (!NavSubsystem)
+	{
+		UE_LOG(LogOBNavigation, Warning, TEXT("[%s::%hs] - OBNavigationSubsystem is not valid! Region '%s' is not registered."),
+		       *GetName(), __FUNCTION__, *GetRegionName().ToString());
+		return;
+	}
+
+	// Regions are keyed by name; a second volume would replace the first one's shape and be removed with it
+	if (NavSubsystem->HasRegion(GetRegionName()))
+	{
+		UE_LOG(LogOBNavigation, Warning,
+		       TEXT("[%s::%hs] - Region '%s' is already registered by another volume. This volume is ignored."),
+		       *GetName(), __FUNCTION__, *GetRegionName().ToString());
+		return;
+	}
+
+	NavSubsystem->RegisterBoxRegion(GetRegionName(), Box->GetComponentLocation(), Box->GetScaledBoxExtent(),
+	                                Box->GetComponentRotation().Yaw);
+	bRegisteredRegion = true;
+}
+
+void AOBRegionVolume::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (const UGameInstance* GI = bRegisteredRegion ? GetWorld()->GetGameInstance() : nullptr)
+	{
+		if (UOBNavigationSubsystem* NavSubsystem = GI->GetSubsystem<UOBNavigationSubsystem>())
+		{
+			NavSubsystem->UnregisterRegion(GetRegionName());
+		}
+	}
+	bRegisteredRegion = false;
+
+	Super::EndPlay(EndPlayReason);
+}
+
+FName AOBRegionVolume::GetRegionName() const
+{
+	return RegionName.IsNone() ? GetFName() : RegionName;
+}
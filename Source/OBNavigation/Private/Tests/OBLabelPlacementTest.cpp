@@ -0,0 +1,79 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Core/OBLabelPlacement.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+
+namespace
+{
+	constexpr EAutomationTestFlags::Type LabelTestFlags =
+		EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOBLabelGridOverlapTest, "OBNavigation.Core.Labels.Overlap", LabelTestFlags)
+
+bool FOBLabelGridOverlapTest::RunTest(const FString& Parameters)
+{
+	using OBNavigation::Labels::FLabelCollisionGrid;
+
+	FLabelCollisionGrid Grid(64.0);
+	TestTrue(TEXT("First label"), Grid.TryAdd(FVector2D(10.0, 10.0), FVector2D(50.0, 20.0)));
+	TestFalse(TEXT("Overlapping label"), Grid.TryAdd(FVector2D(40.0, 15.0), FVector2D(90.0, 25.0)));
+	TestFalse(TEXT("Label inside another"), Grid.TryAdd(FVector2D(20.0, 12.0), FVector2D(30.0, 18.0)));
+	TestTrue(TEXT("Label touching an edge"), Grid.TryAdd(FVector2D(50.0, 10.0), FVector2D(80.0, 20.0)));
+	TestTrue(TEXT("Label below"), Grid.TryAdd(FVector2D(10.0, 20.0), FVector2D(50.0, 30.0)));
+
+	// Rectangles larger than a cell and at negative coordinates are found through every cell they cover
+	TestTrue(TEXT("Wide label"), Grid.TryAdd(FVector2D(-300.0, -100.0), FVector2D(-10.0, -80.0)));
+	TestFalse(TEXT("Label overlapping the wide one in another cell"),
+	          Grid.TryAdd(FVector2D(-50.0, -90.0), FVector2D(-40.0, -60.0)));
+	TestEqual(TEXT("Labels kept"), Grid.Num(), 4);
+
+	Grid.Reset();
+	TestEqual(TEXT("Labels after reset"), Grid.Num(), 0);
+	TestTrue(TEXT("Overlapping label after reset"), Grid.TryAdd(FVector2D(40.0, 15.0), FVector2D(90.0, 25.0)));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOBLabelGridPriorityTest, "OBNavigation.Core.Labels.Priority", LabelTestFlags)
+
+bool FOBLabelGridPriorityTest::RunTest(const FString& Parameters)
+{
+	using OBNavigation::Labels::FLabelCollisionGrid;
+
+	struct FCandidate
+	{
+		int32 Priority;
+		FVector2D Min;
+		FVector2D Max;
+	};
+
+	// Offered in priority order, as UOBMinimapWidget does: a label only loses to the ones of higher priority
+	TArray<FCandidate> Candidates = {
+		{0, FVector2D(0.0, 0.0), FVector2D(100.0, 20.0)},
+		{2, FVector2D(50.0, 10.0), FVector2D(150.0, 30.0)},
+		{1, FVector2D(120.0, 0.0), FVector2D(220.0, 20.0)},
+		{2, FVector2D(300.0, 0.0), FVector2D(400.0, 20.0)},
+	};
+	Candidates.StableSort([](const FCandidate& A, const FCandidate& B) { return A.Priority > B.Priority; });
+
+	FLabelCollisionGrid Grid(64.0);
+	TArray<int32> KeptPriorities;
+	for (const FCandidate& Candidate : Candidates)
+	{
+		if (Grid.TryAdd(Candidate.Min, Candidate.Max))
+		{
+			KeptPriorities.Add(Candidate.Priority);
+		}
+	}
+
+	// Both priority 2 labels are kept; the priority 1 and 0 labels overlap the first of them and are dropped
+	TestEqual(TEXT("Labels kept"), KeptPriorities.Num(), 2);
+	TestTrue(TEXT("Only the highest priority labels are kept"),
+	         KeptPriorities.Num() == 2 && KeptPriorities[0] == 2 && KeptPriorities[1] == 2);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,135 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "OBMapMarker.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Components/SceneComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeExit.h"
+
+namespace
+{
+	constexpr EAutomationTestFlags::Type MarkerTestFlags =
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter;
+
+	constexpr double FrameTime = 1.0 / 60.0;
+
+	// A movable actor without velocity, like a replicated actor whose movement component does not run on this machine
+	AActor* SpawnTrackedActor(UWorld* World)
+	{
+		AActor* Actor = World->SpawnActor<AActor>();
+		USceneComponent* Root = NewObject<USceneComponent>(Actor, TEXT("Root"));
+		Root->SetMobility(EComponentMobility::Movable);
+		Actor->SetRootComponent(Root);
+		Root->RegisterComponent();
+		return Actor;
+	}
+
+	UOBMapMarker* MakeDeadReckonedMarker(AActor* TrackedActor, const bool bDeriveVelocity)
+	{
+		UOBMarkerConfigAsset* Config = NewObject<UOBMarkerConfigAsset>(GetTransientPackage());
+		Config->DeadReckoning.bEnabled = true;
+		Config->DeadReckoning.bDeriveVelocity = bDeriveVelocity;
+
+		UOBMapMarker* Marker = NewObject<UOBMapMarker>(GetTransientPackage());
+		Marker->Init(FGuid::NewGuid(), TrackedActor, Config, NAME_None);
+		return Marker;
+	}
+
+	// Moves the actor by Step every frame for NumFrames frames, updating the marker like the subsystem does
+	void MoveEveryFrame(AActor* Actor, UOBMapMarker* Marker, const FVector& Step, const int32 NumFrames, double& Time)
+	{
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			Time += FrameTime;
+			Actor->SetActorLocation(Actor->GetActorLocation() + Step);
+			Marker->UpdateLocation(Time);
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOBMarkerDeadReckoningTest, "OBNavigation.Marker.DeadReckoning", MarkerTestFlags)
+
+bool FOBMarkerDeadReckoningTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	ON_SCOPE_EXIT
+	{
+		World->DestroyWorld(false);
+	};
+
+	const FVector Step(10.0, 0.0, 0.0); // 600 units per second
+
+	// Without a velocity the marker trails the actor, but it must keep following it
+	{
+		AActor* Actor = SpawnTrackedActor(World);
+		UOBMapMarker* Marker = MakeDeadReckonedMarker(Actor, false);
+		double Time = 0.0;
+		MoveEveryFrame(Actor, Marker, Step, 120, Time);
+
+		const double Lag = FVector::Dist(Marker->WorldLocation, Actor->GetActorLocation());
+		TestTrue(FString::Printf(TEXT("Marker follows an actor moving every frame (lag %.1f)"), Lag), Lag < 100.0);
+		TestTrue(TEXT("Marker moved with the actor"), Marker->WorldLocation.X > 1000.0);
+	}
+
+	// With a derived velocity the extrapolation matches the actor and the error blends out
+	{
+		AActor* Actor = SpawnTrackedActor(World);
+		UOBMapMarker* Marker = MakeDeadReckonedMarker(Actor, true);
+		double Time = 0.0;
+		MoveEveryFrame(Actor, Marker, Step, 120, Time);
+
+		const double Lag = FVector::Dist(Marker->WorldLocation, Actor->GetActorLocation());
+		TestTrue(FString::Printf(TEXT("Marker converges on an actor moving every frame (lag %.3f)"), Lag), Lag < 1.0);
+
+		// A teleport beyond SnapDistance is shown at once
+		Time += FrameTime;
+		Actor->SetActorLocation(Actor->GetActorLocation() + FVector(0.0, 10000.0, 0.0));
+		Marker->UpdateLocation(Time);
+		TestTrue(TEXT("Marker snaps to a teleported actor"),
+		         FVector::Dist(Marker->WorldLocation, Actor->GetActorLocation()) < 1.0);
+	}
+
+	// With a derived velocity, an actor that stops is taken as stopped after one sample interval: the marker overshoots
+	// by at most a couple of frames of movement, not MaxExtrapolationTime of it, and settles on the actor
+	{
+		AActor* Actor = SpawnTrackedActor(World);
+		UOBMapMarker* Marker = MakeDeadReckonedMarker(Actor, true);
+		double Time = 0.0;
+		MoveEveryFrame(Actor, Marker, Step, 60, Time);
+
+		double MaxOvershoot = 0.0;
+		for (int32 Frame = 0; Frame < 60; ++Frame)
+		{
+			MoveEveryFrame(Actor, Marker, FVector::ZeroVector, 1, Time);
+			MaxOvershoot = FMath::Max(MaxOvershoot, FVector::Dist(Marker->WorldLocation, Actor->GetActorLocation()));
+		}
+		TestTrue(FString::Printf(TEXT("Marker overshoots a stopped actor by little (%.1f)"), MaxOvershoot),
+		         MaxOvershoot <= 2.0 * Step.Size() + 1.0);
+
+		const double Lag = FVector::Dist(Marker->WorldLocation, Actor->GetActorLocation());
+		TestTrue(FString::Printf(TEXT("Marker settles on a stopped actor (%.3f off)"), Lag), Lag < 1.0);
+	}
+
+	// A sparse sample disagreeing with the marker is blended out over CorrectionTime
+	{
+		AActor* Actor = SpawnTrackedActor(World);
+		UOBMapMarker* Marker = MakeDeadReckonedMarker(Actor, false);
+		double Time = 0.0;
+		MoveEveryFrame(Actor, Marker, FVector::ZeroVector, 1, Time);
+		MoveEveryFrame(Actor, Marker, FVector(500.0, 0.0, 0.0), 1, Time);
+		TestTrue(TEXT("Marker does not jump to a sample"), Marker->WorldLocation.X < 100.0);
+
+		const int32 NumCorrectionFrames = FMath::CeilToInt32(Marker->ConfigAsset->DeadReckoning.CorrectionTime / FrameTime);
+		MoveEveryFrame(Actor, Marker, FVector::ZeroVector, NumCorrectionFrames, Time);
+		TestTrue(FString::Printf(TEXT("Error blended out after CorrectionTime (%.1f left)"),
+		                         500.0 - Marker->WorldLocation.X),
+		         FMath::IsNearlyEqual(Marker->WorldLocation.X, 500.0, 500.0 * 0.05));
+	}
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,151 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Core/OBMarkerSnapshot.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "OBNavigationSubsystem.h"
+#include "Algo/AllOf.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeExit.h"
+
+namespace
+{
+	using namespace OBNavigation::Snapshots;
+
+	constexpr EAutomationTestFlags::Type SnapshotTestFlags =
+		EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+
+	constexpr EAutomationTestFlags::Type SnapshotPublishTestFlags =
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter;
+
+	// Rewrites the whole snapshot, like the subsystem does, so a slot overwritten under a reader is noticed
+	void PublishFrame(FMarkerSnapshotBuffer& Buffer, const uint64 FrameNumber)
+	{
+		Buffer.Publish([FrameNumber](FMarkerSnapshot& Snapshot)
+		{
+			Snapshot.FrameNumber = FrameNumber;
+			Snapshot.Markers.Reset();
+			Snapshot.Markers.AddDefaulted(static_cast<int32>(FrameNumber));
+			for (FMarkerSnapshotEntry& Entry : Snapshot.Markers)
+			{
+				Entry.ConfigIndex = static_cast<int32>(FrameNumber);
+			}
+		});
+	}
+
+	bool IsFrameIntact(const FMarkerSnapshot& Snapshot, const uint64 FrameNumber)
+	{
+		if (Snapshot.FrameNumber != FrameNumber || Snapshot.Markers.Num() != static_cast<int32>(FrameNumber))
+		{
+			return false;
+		}
+		return Algo::AllOf(Snapshot.Markers, [FrameNumber](const FMarkerSnapshotEntry& Entry)
+		{
+			return Entry.ConfigIndex == static_cast<int32>(FrameNumber);
+		});
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOBMarkerSnapshotBufferTest, "OBNavigation.Core.Snapshots.Buffer", SnapshotTestFlags)
+
+bool FOBMarkerSnapshotBufferTest::RunTest(const FString& Parameters)
+{
+	FMarkerSnapshotBuffer Buffer;
+	TestFalse(TEXT("Nothing to read before the first publication"), Buffer.Acquire().IsValid());
+
+	// A reader holding a snapshot keeps it intact while the writer publishes past it
+	PublishFrame(Buffer, 1);
+	FMarkerSnapshotBuffer::FReadScope Held = Buffer.Acquire();
+	if (!TestTrue(TEXT("First publication is readable"), Held.IsValid()))
+	{
+		return false;
+	}
+	const FMarkerSnapshot* HeldSnapshot = &*Held;
+
+	for (uint64 FrameNumber = 2; FrameNumber <= 6; ++FrameNumber)
+	{
+		PublishFrame(Buffer, FrameNumber);
+	}
+	TestEqual(TEXT("Held snapshot keeps its version"), Held.GetVersion(), static_cast<uint64>(1));
+	TestTrue(TEXT("Held snapshot is not overwritten by later publications"), IsFrameIntact(*Held, 1));
+	{
+		const FMarkerSnapshotBuffer::FReadScope Latest = Buffer.Acquire();
+		TestEqual(TEXT("A new reader sees the last publication"), Latest.GetVersion(), Buffer.GetLastVersion());
+		TestTrue(TEXT("Last publication is complete"), Latest.IsValid() && IsFrameIntact(*Latest, 6));
+	}
+
+	// The held slot, the published one and one to fill: the writer cycles through them instead of allocating
+	const int32 NumSlotsWhileHeld = Buffer.GetNumSlots();
+	TestEqual(TEXT("Slots while one is held"), NumSlotsWhileHeld, 3);
+
+	// Once released, the slot goes back to the writer and is filled again
+	Held = FMarkerSnapshotBuffer::FReadScope();
+	bool bHeldSlotReused = false;
+	for (uint64 FrameNumber = 7; FrameNumber <= 12; ++FrameNumber)
+	{
+		PublishFrame(Buffer, FrameNumber);
+		const FMarkerSnapshotBuffer::FReadScope Latest = Buffer.Acquire();
+		bHeldSlotReused |= Latest.IsValid() && &*Latest == HeldSnapshot;
+		TestTrue(FString::Printf(TEXT("Publication %llu is complete"), FrameNumber),
+		         Latest.IsValid() && IsFrameIntact(*Latest, FrameNumber));
+	}
+	TestTrue(TEXT("Released slot is reused"), bHeldSlotReused);
+	TestEqual(TEXT("No slot is added once readers release"), Buffer.GetNumSlots(), NumSlotsWhileHeld);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOBMarkerSnapshotPublishTest, "OBNavigation.Snapshots.Publish", SnapshotPublishTestFlags)
+
+bool FOBMarkerSnapshotPublishTest::RunTest(const FString& Parameters)
+{
+	// A standalone game instance, so that the test needs neither a map nor PIE
+	UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine);
+	GameInstance->AddToRoot();
+	GameInstance->InitializeStandalone();
+	UWorld* World = GameInstance->GetWorld();
+	ON_SCOPE_EXIT
+	{
+		GameInstance->Shutdown();
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+		GameInstance->RemoveFromRoot();
+	};
+
+	UOBNavigationSubsystem* Navigation = GameInstance->GetSubsystem<UOBNavigationSubsystem>();
+	if (!TestNotNull(TEXT("Navigation subsystem"), Navigation))
+	{
+		return false;
+	}
+
+	constexpr float DeltaTime = 1.0f / 60.0f;
+	const uint64 InitialVersion = Navigation->MarkerSnapshots->GetLastVersion();
+
+	// Nobody holds the buffer: publishing would only cost the game thread
+	TestFalse(TEXT("No readers without an external reference"), Navigation->HasMarkerSnapshotReaders());
+	Navigation->Tick(DeltaTime);
+	TestEqual(TEXT("Nothing published without an external reference"), Navigation->MarkerSnapshots->GetLastVersion(),
+	          InitialVersion);
+
+	// A held reference makes every tick publish
+	{
+		const TSharedRef<const FMarkerSnapshotBuffer, ESPMode::ThreadSafe> Snapshots = Navigation->GetMarkerSnapshots();
+		TestTrue(TEXT("Readers once a reference is held"), Navigation->HasMarkerSnapshotReaders());
+		TestTrue(TEXT("The subsystem ticks for its readers"), Navigation->IsTickNeeded());
+		Navigation->Tick(DeltaTime);
+		TestEqual(TEXT("Published while a reference is held"), Snapshots->GetLastVersion(), InitialVersion + 1);
+		TestTrue(TEXT("The publication is readable"), Snapshots->Acquire().IsValid());
+	}
+
+	// Dropping the reference stops publication again
+	TestFalse(TEXT("No readers once the reference is dropped"), Navigation->HasMarkerSnapshotReaders());
+	Navigation->Tick(DeltaTime);
+	TestEqual(TEXT("Nothing published after the reference is dropped"), Navigation->MarkerSnapshots->GetLastVersion(),
+	          InitialVersion + 1);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
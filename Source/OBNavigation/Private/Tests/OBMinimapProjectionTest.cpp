@@ -0,0 +1,164 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Core/OBMinimapProjection.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+
+namespace
+{
+	using namespace OBNavigation::Projection;
+
+	constexpr EAutomationTestFlags::Type ProjectionTestFlags =
+		EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+
+	// A 200 x 200 canvas at zoom 1: one UV unit is 200 canvas units, the clamp radius is 100
+	FFrameParams MakeParams(const double StaticRotation = 0.0, const double ViewYaw = 0.0)
+	{
+		FFrameParams Params;
+		Params.ViewUV = FVector2D(0.5, 0.5);
+		Params.CanvasSize = FVector2D(200.0, 200.0);
+		Params.StaticRotation = StaticRotation;
+		Params.ViewYaw = ViewYaw;
+		return Params;
+	}
+
+	FMarkerInput MakeInput(const double U, const double V, const double WorldYaw = 0.0)
+	{
+		FMarkerInput Input;
+		Input.MapUV = FVector2D(U, V);
+		Input.WorldYaw = WorldYaw;
+		return Input;
+	}
+
+	void TestMarker(FAutomationTestBase& Test, const TCHAR* What, const FMarkerOutput& Output,
+	                const FVector2D& ExpectedPosition, const double ExpectedAngle, const bool bExpectedClamped)
+	{
+		Test.TestTrue(FString::Printf(TEXT("%s: position %s, expected %s"), What, *Output.Position.ToString(),
+		                              *ExpectedPosition.ToString()),
+		              Output.Position.Equals(ExpectedPosition, 1.e-3));
+		Test.TestTrue(FString::Printf(TEXT("%s: indicator angle %f, expected %f"), What, Output.IndicatorAngle,
+		                              ExpectedAngle),
+		              FMath::IsNearlyZero(FRotator::NormalizeAxis(Output.IndicatorAngle - ExpectedAngle), 1.e-3));
+		Test.TestEqual(FString::Printf(TEXT("%s: clamped"), What), Output.bClamped, bExpectedClamped);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOBProjectionFixedTest, "OBNavigation.Core.Projection.Fixed", ProjectionTestFlags)
+
+bool FOBProjectionFixedTest::RunTest(const FString& Parameters)
+{
+	FFrameParams Params = MakeParams(90.0, 45.0);
+	Params.ViewerActorYaw = 120.0;
+
+	// The view yaw is ignored on a fixed map, only the static rotation turns it
+	const TProjector<EMapRotation::Fixed, EClampShape::Circle> Projector(Params);
+	TestMarker(*this, TEXT("Inside"), Projector.ProjectMarker(MakeInput(0.75, 0.5, 30.0)), FVector2D(100.0, 50.0),
+	           30.0 - 90.0, false);
+	TestMarker(*this, TEXT("Center"), Projector.ProjectMarker(MakeInput(0.5, 0.5)), FVector2D(100.0, 100.0), -90.0,
+	           false);
+	TestMarker(*this, TEXT("Viewer"), Projector.ProjectViewer(), FVector2D(100.0, 100.0), 120.0 - 90.0, false);
+	TestTrue(TEXT("ProjectPoint matches ProjectMarker"),
+	         Projector.ProjectPoint(FVector2D(0.75, 0.5)).Equals(FVector2D(100.0, 50.0), 1.e-3));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOBProjectionFollowViewTest, "OBNavigation.Core.Projection.FollowView",
+                                 ProjectionTestFlags)
+
+bool FOBProjectionFollowViewTest::RunTest(const FString& Parameters)
+{
+	FFrameParams Params = MakeParams(0.0, 90.0);
+	Params.ViewerActorYaw = 120.0;
+
+	// The map turns with the view yaw; orientations are relative to the view and the viewer always points up
+	const TProjector<EMapRotation::FollowView, EClampShape::Circle> Projector(Params);
+	TestMarker(*this, TEXT("Inside"), Projector.ProjectMarker(MakeInput(0.75, 0.5, 30.0)), FVector2D(100.0, 50.0),
+	           30.0 - 90.0, false);
+	TestMarker(*this, TEXT("Viewer"), Projector.ProjectViewer(), FVector2D(100.0, 100.0), 0.0, false);
+
+	// The static rotation adds to the view yaw
+	const TProjector<EMapRotation::FollowView, EClampShape::Circle> Rotated(MakeParams(90.0, 90.0));
+	TestMarker(*this, TEXT("Static rotation"), Rotated.ProjectMarker(MakeInput(0.75, 0.5)), FVector2D(50.0, 100.0),
+	           -90.0, false);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOBProjectionCircleClampTest, "OBNavigation.Core.Projection.CircleClamp",
+                                 ProjectionTestFlags)
+
+bool FOBProjectionCircleClampTest::RunTest(const FString& Parameters)
+{
+	const double Diagonal = 100.0 * UE_HALF_SQRT_2;
+
+	const TProjector<EMapRotation::Fixed, EClampShape::Circle> Projector(MakeParams());
+	TestMarker(*this, TEXT("Right edge"), Projector.ProjectMarker(MakeInput(1.5, 0.5, 30.0)), FVector2D(200.0, 100.0),
+	           0.0, true);
+	TestMarker(*this, TEXT("Far corner"), Projector.ProjectMarker(MakeInput(1.5, 1.5)),
+	           FVector2D(100.0 + Diagonal, 100.0 + Diagonal), 45.0, true);
+
+	// Inside the canvas square but outside the circle: pinned to the circle
+	TestMarker(*this, TEXT("Near corner"), Projector.ProjectMarker(MakeInput(0.9, 0.9)),
+	           FVector2D(100.0 + Diagonal, 100.0 + Diagonal), 45.0, true);
+
+	// The indicator of a clamped marker points at it on screen, so it follows the map rotation
+	const TProjector<EMapRotation::FollowView, EClampShape::Circle> Rotated(MakeParams(0.0, 90.0));
+	TestMarker(*this, TEXT("Rotated edge"), Rotated.ProjectMarker(MakeInput(1.5, 0.5)), FVector2D(100.0, 0.0), -90.0,
+	           true);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOBProjectionSquareClampTest, "OBNavigation.Core.Projection.SquareClamp",
+                                 ProjectionTestFlags)
+
+bool FOBProjectionSquareClampTest::RunTest(const FString& Parameters)
+{
+	const TProjector<EMapRotation::Fixed, EClampShape::Square> Projector(MakeParams());
+	TestMarker(*this, TEXT("Right edge"), Projector.ProjectMarker(MakeInput(1.5, 0.5, 30.0)), FVector2D(200.0, 100.0),
+	           0.0, true);
+	TestMarker(*this, TEXT("Top edge"), Projector.ProjectMarker(MakeInput(0.6, -1.5)), FVector2D(105.0, 0.0),
+	           FMath::RadiansToDegrees(FMath::Atan2(-400.0, 20.0)), true);
+
+	// A square minimap shows its corners, so a marker there is visible and must not be pulled onto the inscribed
+	// circle (which would draw it on top of unrelated terrain, away from where it is on the map)
+	TestMarker(*this, TEXT("Near corner"), Projector.ProjectMarker(MakeInput(0.9, 0.9, 30.0)), FVector2D(180.0, 180.0),
+	           30.0, false);
+
+	// Beyond the corner, the marker is pinned where the ray from the center leaves the square
+	TestMarker(*this, TEXT("Far corner"), Projector.ProjectMarker(MakeInput(1.5, 1.5)), FVector2D(200.0, 200.0), 45.0,
+	           true);
+
+	const TProjector<EMapRotation::FollowView, EClampShape::Square> Rotated(MakeParams(0.0, 90.0));
+	TestMarker(*this, TEXT("Rotated edge"), Rotated.ProjectMarker(MakeInput(1.5, 0.5)), FVector2D(100.0, 0.0), -90.0,
+	           true);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOBProjectionDispatchTest, "OBNavigation.Core.Projection.Dispatch",
+                                 ProjectionTestFlags)
+
+bool FOBProjectionDispatchTest::RunTest(const FString& Parameters)
+{
+	// Dispatch must pick the specialization matching the runtime config
+	const FFrameParams Params = MakeParams(0.0, 90.0);
+	const TArray<FMarkerInput> Inputs = {MakeInput(0.75, 0.5), MakeInput(0.9, 0.9)};
+	TArray<FMarkerOutput> Outputs;
+	Outputs.SetNum(Inputs.Num());
+
+	Dispatch(EMapRotation::FollowView, EClampShape::Square, Params, [&](const auto& Projector)
+	{
+		Projector.ProjectMarkers(Inputs, Outputs);
+	});
+
+	const TProjector<EMapRotation::FollowView, EClampShape::Square> Expected(Params);
+	for (int32 Index = 0; Index < Inputs.Num(); ++Index)
+	{
+		const FMarkerOutput ExpectedOutput = Expected.ProjectMarker(Inputs[Index]);
+		TestMarker(*this, *FString::Printf(TEXT("Marker %d"), Index), Outputs[Index], ExpectedOutput.Position,
+		           ExpectedOutput.IndicatorAngle, ExpectedOutput.bClamped);
+	}
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,91 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Benchmark/OBNavigationBenchmark.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && !UE_BUILD_SHIPPING
+
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+
+/**
+ * Marker scaling benchmark, one test per mix. Regressions are checked against the baseline in
+ * Resources/Benchmark/Baseline.csv (or -Baseline=<Path.csv>) with -Tolerance= (default 0.25).
+ * The options of FOBBenchmarkOptions::Parse are read from the command line, e.g., -Counts=100,1000 or
+ * -WriteBaseline to record a new baseline on the machine that runs the test. The baseline holds results recorded on
+ * the reference machine only; phases without a row are reported and not compared.
+ */
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FOBNavigationBenchmarkTest, "OBNavigation.Performance.Benchmark",
+                                  EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+                                  EAutomationTestFlags::PerfFilter)
+
+void FOBNavigationBenchmarkTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	for (const TCHAR* Mix : {TEXT("Static"), TEXT("Moving"), TEXT("Churn"), TEXT("Projection")})
+	{
+		OutBeautifiedNames.Add(Mix);
+		OutTestCommands.Add(Mix);
+	}
+
+	if (FString TracePath; FParse::Value(FCommandLine::Get(), TEXT("Trace="), TracePath, false))
+	{
+		OutBeautifiedNames.Add(TEXT("Trace"));
+		OutTestCommands.Add(TEXT("Trace"));
+	}
+}
+
+bool FOBNavigationBenchmarkTest::RunTest(const FString& Parameters)
+{
+	FOBBenchmarkOptions Options = FOBBenchmarkOptions::Parse(FCommandLine::Get());
+
+	// The mix comes from the test, the trace only runs in its own test
+	Options.Mixes.Reset();
+	if (Parameters == TEXT("Trace"))
+	{
+		Options.MarkerCounts.Reset();
+	}
+	else
+	{
+		Options.TracePath.Reset();
+		Options.Mixes.Add(Parameters == TEXT("Moving")
+			                  ? EOBBenchmarkMix::Moving
+			                  : Parameters == TEXT("Churn")
+			                  ? EOBBenchmarkMix::Churn
+			                  : Parameters == TEXT("Projection")
+			                  ? EOBBenchmarkMix::Projection
+			                  : EOBBenchmarkMix::Static);
+	}
+
+	if (Options.BaselinePath.IsEmpty())
+	{
+		const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("OBNavigation"));
+		if (!TestNotNull(TEXT("OBNavigation plugin"), Plugin.Get()))
+		{
+			return false;
+		}
+		Options.BaselinePath = Plugin->GetBaseDir() / TEXT("Resources/Benchmark/Baseline.csv");
+	}
+
+	// A standalone game instance, so that the test needs neither a map nor PIE
+	UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine);
+	GameInstance->AddToRoot();
+	GameInstance->InitializeStandalone();
+	UWorld* World = GameInstance->GetWorld();
+	ON_SCOPE_EXIT
+	{
+		GameInstance->Shutdown();
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+		GameInstance->RemoveFromRoot();
+	};
+
+	FOBNavigationBenchmark Benchmark(World, Options);
+	return TestTrue(TEXT("No phase regressed against the baseline"), Benchmark.Run());
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS && !UE_BUILD_SHIPPING
@@ -0,0 +1,97 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Data/OBPOIDatabase.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	constexpr EAutomationTestFlags::Type POIDatabaseTestFlags =
+		EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOBPOIDatabaseRoundTripTest, "OBNavigation.Data.POIDatabase.RoundTrip",
+                                 POIDatabaseTestFlags)
+
+bool FOBPOIDatabaseRoundTripTest::RunTest(const FString& Parameters)
+{
+	const FSoftObjectPath ConfigPath(TEXT("/Game/Markers/DA_Collectible.DA_Collectible"));
+	const FGuid NearID = FGuid::NewDeterministicGuid(TEXT("/Game/Maps/Test:Near"));
+	const FGuid OtherNearID = FGuid::NewDeterministicGuid(TEXT("/Game/Maps/Test:OtherNear"));
+	const FGuid FarID = FGuid::NewDeterministicGuid(TEXT("/Game/Maps/Test:Far"));
+
+	FOBPOIDatabaseWriter Writer;
+	TestTrue(TEXT("First POI"), Writer.AddPOI(NearID, ConfigPath, TEXT("PointsOfInterest"), FVector(100.0, 100.0, 10.0)));
+	TestTrue(TEXT("Second POI"), Writer.AddPOI(OtherNearID, ConfigPath, TEXT("Resources"), FVector(200.0, 300.0, 0.0)));
+	TestTrue(TEXT("Far POI"), Writer.AddPOI(FarID, ConfigPath, TEXT("PointsOfInterest"), FVector(5000.0, 5000.0, 0.0)));
+
+	// A POI set entry named like an actor of the map would get the same ID
+	TestFalse(TEXT("Duplicate ID"), Writer.AddPOI(NearID, ConfigPath, TEXT("PointsOfInterest"), FVector::ZeroVector));
+	TestEqual(TEXT("POIs written"), Writer.GetNumPOIs(), 3);
+
+	TArray<uint8> Data;
+	Writer.Write(Data, /*PageSize*/ 1000.0);
+
+	const FString FilePath = FPaths::AutomationTransientDir() / TEXT("OBPOIDatabaseRoundTrip.obpoi");
+	if (!TestTrue(TEXT("Database saved"), FFileHelper::SaveArrayToFile(Data, *FilePath)))
+	{
+		return false;
+	}
+
+	FOBPOIDatabase Database;
+	if (!TestTrue(TEXT("Database opened"), Database.Open(FilePath)))
+	{
+		IFileManager::Get().Delete(*FilePath);
+		return false;
+	}
+
+	TestEqual(TEXT("POIs read"), Database.GetNumPOIs(), 3);
+	TestEqual(TEXT("Configs"), Database.GetConfigPaths().Num(), 1);
+	TestEqual(TEXT("Layers"), Database.GetLayerNames().Num(), 2);
+	TestNotEqual(TEXT("Near POI found"), Database.FindPOI(NearID), INDEX_NONE);
+	TestNotEqual(TEXT("Far POI found"), Database.FindPOI(FarID), INDEX_NONE);
+	TestEqual(TEXT("Unknown POI"), Database.FindPOI(FGuid::NewDeterministicGuid(TEXT("/Game/Maps/Test:Missing"))),
+	          INDEX_NONE);
+
+	// Only the page around the near POIs is made resident; the far one is skipped until its page is
+	const FBox2D NearRegion(FVector2D(0.0, 0.0), FVector2D(500.0, 500.0));
+	const int32 NumLoaded = Database.UpdateResidentPages(MakeArrayView(&NearRegion, 1), /*MaxResidentPages*/ 4,
+	                                                     /*MaxPageLoads*/ 4);
+	TestEqual(TEXT("Pages loaded"), NumLoaded, 1);
+
+	TArray<int32> Found;
+	const FBox2D WorldRegion(FVector2D(-10000.0, -10000.0), FVector2D(10000.0, 10000.0));
+	Database.ForEachResidentPOI(WorldRegion, [this, &Database, &Found](const int32 POIIndex, const FOBPOIRecord& Record)
+	{
+		Found.Add(POIIndex);
+		TestTrue(TEXT("Resident POI near"), Record.GetLocation().X < 500.0 && Record.GetLocation().Y < 500.0);
+		TestTrue(TEXT("Layer index"), Database.GetLayerNames().IsValidIndex(Record.LayerIndex));
+	});
+	TestEqual(TEXT("Resident POIs"), Found.Num(), 2);
+	TestTrue(TEXT("Near POI resident"), Found.Contains(Database.FindPOI(NearID)));
+	TestTrue(TEXT("Other near POI resident"), Found.Contains(Database.FindPOI(OtherNearID)));
+
+	Database.Close();
+	IFileManager::Get().Delete(*FilePath);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOBPOIDatabaseMissingTest, "OBNavigation.Data.POIDatabase.Missing",
+                                 POIDatabaseTestFlags)
+
+bool FOBPOIDatabaseMissingTest::RunTest(const FString& Parameters)
+{
+	// The subsystem then falls back to markers (see UOBNavigationSubsystem::ReportMissingPOI)
+	FOBPOIDatabase Database;
+	TestFalse(TEXT("Missing file"), Database.Open(FPaths::AutomationTransientDir() / TEXT("OBPOIDatabaseMissing.obpoi")));
+	TestFalse(TEXT("Closed"), Database.IsOpen());
+	TestEqual(TEXT("No POIs"), Database.GetNumPOIs(), 0);
+	return true;
+}
+
+#endif
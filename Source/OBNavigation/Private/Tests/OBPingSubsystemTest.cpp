@@ -0,0 +1,97 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "OBPingSubsystem.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "OBMapMarker.h"
+#include "OBNavigationSettings.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeExit.h"
+
+namespace
+{
+	constexpr EAutomationTestFlags::Type PingTestFlags =
+		EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOBPingSlotsTest, "OBNavigation.Pings.Slots", PingTestFlags)
+
+bool FOBPingSlotsTest::RunTest(const FString& Parameters)
+{
+	const int32 NumSlots = GetDefault<UOBNavigationSettings>()->MaxActivePings;
+	if (NumSlots < 3)
+	{
+		AddWarning(TEXT("MaxActivePings is below 3; the slot reuse cases need at least 3 slots."));
+		return true;
+	}
+
+	// A standalone game instance, so that the test needs neither a map nor PIE
+	UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine);
+	GameInstance->AddToRoot();
+	GameInstance->InitializeStandalone();
+	UWorld* World = GameInstance->GetWorld();
+	ON_SCOPE_EXIT
+	{
+		GameInstance->Shutdown();
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+		GameInstance->RemoveFromRoot();
+	};
+
+	UOBPingSubsystem* Pings = World->GetSubsystem<UOBPingSubsystem>();
+	if (!TestNotNull(TEXT("Ping subsystem"), Pings))
+	{
+		return false;
+	}
+
+	UOBMarkerConfigAsset* Config = NewObject<UOBMarkerConfigAsset>(GetTransientPackage());
+
+	// One instigator per ping, so the rate limit never gets in the way
+	auto Ping = [this, Pings, Config](FOBPingHandle& OutHandle)
+	{
+		UObject* Instigator = NewObject<UOBMarkerConfigAsset>(GetTransientPackage());
+		TestEqual(TEXT("Ping placed"), Pings->PingLocation(Instigator, FVector::ZeroVector, Config, OutHandle),
+		          EOBPingResult::Placed);
+	};
+
+	TArray<FOBPingHandle> Handles;
+	Handles.SetNum(NumSlots);
+	for (FOBPingHandle& Handle : Handles)
+	{
+		Ping(Handle);
+	}
+	TestEqual(TEXT("Every slot in use"), Pings->GetNumActivePings(), NumSlots);
+
+	// A freed slot is reused before any ping is replaced
+	const int32 FreedSlot = Handles[1].SlotIndex;
+	Pings->CancelPing(Handles[1]);
+	TestFalse(TEXT("Cancelled handle is stale"), Pings->GetPingMarkerID(Handles[1]).IsValid());
+	Ping(Handles[1]);
+	TestEqual(TEXT("Freed slot reused"), Handles[1].SlotIndex, FreedSlot);
+	TestTrue(TEXT("First ping kept while a slot was free"), Pings->GetPingMarkerID(Handles[0]).IsValid());
+
+	// Full again: the ping placed first is replaced, not the one after the last placement
+	FOBPingHandle Replacing;
+	Ping(Replacing);
+	TestEqual(TEXT("Pings stay capped"), Pings->GetNumActivePings(), NumSlots);
+	TestEqual(TEXT("Oldest ping's slot reused"), Replacing.SlotIndex, Handles[0].SlotIndex);
+	TestFalse(TEXT("Oldest ping replaced"), Pings->GetPingMarkerID(Handles[0]).IsValid());
+	TestTrue(TEXT("Ping after the last placement kept"), Pings->GetPingMarkerID(Handles[2]).IsValid());
+	TestTrue(TEXT("Re-placed ping kept"), Pings->GetPingMarkerID(Handles[1]).IsValid());
+
+	// Pinging an existing marker acknowledges it instead of placing a ping
+	UObject* Acknowledger = NewObject<UOBMarkerConfigAsset>(GetTransientPackage());
+	const FGuid PingMarkerID = Pings->GetPingMarkerID(Handles[2]);
+	TestEqual(TEXT("Existing ping acknowledged"), Pings->AcknowledgeMarker(Acknowledger, PingMarkerID),
+	          EOBPingResult::Acknowledged);
+	TestEqual(TEXT("Acknowledgements"), Pings->GetPingAcknowledgements(Handles[2]), 1);
+	TestEqual(TEXT("No ping placed by an acknowledgement"), Pings->GetNumActivePings(), NumSlots);
+	TestEqual(TEXT("Unknown marker"), Pings->AcknowledgeMarker(Acknowledger, FGuid::NewGuid()), EOBPingResult::Invalid);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,434 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Trace/OBMarkerTrace.h"
+
+#include "OBMapLayerAsset.h"
+#include "OBMapMarker.h"
+#include "OBNavigation.h"
+#include "OBNavigationSubsystem.h"
+#include "Engine/AssetManager.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	// Flushing per frame would mean a write call per tick, so small frames are batched
+	constexpr int32 FlushThreshold = 64 * 1024;
+
+	// Guards against absurd allocations when the tables of a corrupt trace are resolved
+	constexpr uint32 MaxTableIndex = MAX_uint16;
+}
+
+FOBMarkerTraceRecorder::~FOBMarkerTraceRecorder()
+{
+	Close();
+}
+
+bool FOBMarkerTraceRecorder::Open(const FString& FilePath)
+{
+	Close();
+
+	FileWriter.Reset(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!FileWriter)
+	{
+		return false;
+	}
+
+	Writer.WriteHeader();
+	Flush();
+	return true;
+}
+
+void FOBMarkerTraceRecorder::CaptureFrame(const UOBNavigationSubsystem& Subsystem, const float DeltaTime)
+{
+	if (!FileWriter)
+	{
+		return;
+	}
+
+	const int32 Frame = ++NumFrames;
+	Writer.BeginFrame(DeltaTime);
+
+	if (FOBTrackedView View; Subsystem.GetTrackedView(View))
+	{
+		Writer.WriteView(View.Location, View.ActorYaw, View.ControlYaw);
+	}
+
+	if (const UOBMapLayerAsset* Layer = Subsystem.GetCurrentMinimapLayer(); !bLayerRecorded || RecordedLayer.Get() != Layer)
+	{
+		Writer.LayerChanged(Layer ? FSoftObjectPath(Layer).ToString() : FString());
+		RecordedLayer = Layer;
+		bLayerRecorded = true;
+	}
+
+	for (const UOBMapMarker* Marker : Subsystem.GetAllActiveMarkers())
+	{
+		if (!Marker)
+		{
+			continue;
+		}
+
+		const FIntVector Position = FOBMarkerTraceWriter::QuantizePosition(Marker->WorldLocation);
+		if (FRecordedMarker* Recorded = RecordedMarkers.Find(Marker->MarkerID))
+		{
+			Recorded->LastSeenFrame = Frame;
+			if (Recorded->Position != Position)
+			{
+				Writer.Move(Recorded->Index, Position - Recorded->Position);
+				Recorded->Position = Position;
+			}
+			continue;
+		}
+
+		const uint32 ConfigIndex = FindOrDefineConfig(Marker->ConfigAsset);
+		const uint32 LayerNameIndex = FindOrDefineLayerName(Marker->MarkerLayerName);
+		FRecordedMarker& NewMarker = RecordedMarkers.Add(Marker->MarkerID);
+		NewMarker.Index = NextMarkerIndex++;
+		NewMarker.Position = Position;
+		NewMarker.LastSeenFrame = Frame;
+		Writer.Register(NewMarker.Index, ConfigIndex, LayerNameIndex, Position);
+	}
+
+	// Anything not seen this frame was unregistered or expired
+	for (auto It = RecordedMarkers.CreateIterator(); It; ++It)
+	{
+		if (It->Value.LastSeenFrame != Frame)
+		{
+			Writer.Remove(It->Value.Index);
+			It.RemoveCurrent();
+		}
+	}
+
+	Writer.EndFrame();
+	if (Writer.GetBuffer().Num() >= FlushThreshold)
+	{
+		Flush();
+	}
+}
+
+void FOBMarkerTraceRecorder::Close()
+{
+	if (FileWriter)
+	{
+		Flush();
+		FileWriter->Close();
+		FileWriter.Reset();
+	}
+}
+
+uint32 FOBMarkerTraceRecorder::FindOrDefineConfig(const UOBMarkerConfigAsset* Config)
+{
+	const FObjectKey Key(Config);
+	if (const uint32* ExistingIndex = ConfigIndices.Find(Key))
+	{
+		return *ExistingIndex;
+	}
+
+	const uint32 NewIndex = ConfigIndices.Num();
+	ConfigIndices.Add(Key, NewIndex);
+	Writer.DefineConfig(NewIndex, Config ? FSoftObjectPath(Config).ToString() : FString());
+	return NewIndex;
+}
+
+uint32 FOBMarkerTraceRecorder::FindOrDefineLayerName(const FName LayerName)
+{
+	if (const uint32* ExistingIndex = LayerNameIndices.Find(LayerName))
+	{
+		return *ExistingIndex;
+	}
+
+	const uint32 NewIndex = LayerNameIndices.Num();
+	LayerNameIndices.Add(LayerName, NewIndex);
+	Writer.DefineLayerName(NewIndex, LayerName);
+	return NewIndex;
+}
+
+void FOBMarkerTraceRecorder::Flush()
+{
+	const TArray<uint8>& Buffer = Writer.GetBuffer();
+	if (FileWriter && Buffer.Num() > 0)
+	{
+		FileWriter->Serialize(const_cast<uint8*>(Buffer.GetData()), Buffer.Num());
+		NumBytesWritten += Buffer.Num();
+	}
+	Writer.ResetBuffer();
+}
+
+FOBMarkerTraceReplayer::FOBMarkerTraceReplayer(UOBNavigationSubsystem* InSubsystem)
+	: Subsystem(InSubsystem)
+{
+}
+
+bool FOBMarkerTraceReplayer::Open(const FString& FilePath)
+{
+	Stop();
+	if (!FFileHelper::LoadFileToArray(Data, *FilePath) || !Reader.Open(Data))
+	{
+		return false;
+	}
+	RequestConfigs();
+	return true;
+}
+
+void FOBMarkerTraceReplayer::RequestConfigs()
+{
+	// Configs are only named in the frame that first uses them, so the trace is decoded once up front to stream them
+	// all in before the first frame instead of loading each one on the game thread mid-replay
+	TArray<FSoftObjectPath> ConfigPaths;
+	while (Reader.ReadFrame(Frame))
+	{
+		for (const TPair<uint32, FString>& NewConfig : Frame.NewConfigs)
+		{
+			const FSoftObjectPath ConfigPath(NewConfig.Value);
+			if (!ConfigPath.IsNull() && !ConfigPath.ResolveObject())
+			{
+				ConfigPaths.AddUnique(ConfigPath);
+			}
+		}
+	}
+	Reader.Rewind();
+
+	if (!ConfigPaths.IsEmpty())
+	{
+		ConfigsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(ConfigPaths);
+	}
+}
+
+bool FOBMarkerTraceReplayer::ApplyNextFrame(float& OutDeltaTime)
+{
+	UOBNavigationSubsystem* NavSubsystem = Subsystem.Get();
+	if (NavSubsystem && ConfigsHandle.IsValid() && ConfigsHandle->IsLoadingInProgress())
+	{
+		OutDeltaTime = 0.0f;
+		return true;
+	}
+
+	if (!NavSubsystem || !Reader.ReadFrame(Frame))
+	{
+		UE_CLOG(Reader.HasError(), LogOBNavigation, Warning,
+		        TEXT("[%hs] - The trace is truncated or corrupt after %d frames."), __FUNCTION__, NumFramesApplied);
+		return false;
+	}
+
+	for (const TPair<uint32, FString>& NewConfig : Frame.NewConfigs)
+	{
+		if (NewConfig.Key < MaxTableIndex)
+		{
+			if (Configs.Num() <= static_cast<int32>(NewConfig.Key))
+			{
+				Configs.SetNum(static_cast<int32>(NewConfig.Key) + 1);
+			}
+			// Streamed in by RequestConfigs. Configs that no longer exist stay null and use the fallback.
+			Configs[NewConfig.Key].Reset(Cast<UOBMarkerConfigAsset>(FSoftObjectPath(NewConfig.Value).ResolveObject()));
+		}
+	}
+
+	for (const TPair<uint32, FName>& NewLayerName : Frame.NewLayerNames)
+	{
+		if (NewLayerName.Key < MaxTableIndex)
+		{
+			if (LayerNames.Num() <= static_cast<int32>(NewLayerName.Key))
+			{
+				LayerNames.SetNum(static_cast<int32>(NewLayerName.Key) + 1);
+			}
+			LayerNames[NewLayerName.Key] = NewLayerName.Value;
+		}
+	}
+
+	bool bMarkersChanged = false;
+	for (const uint32 MarkerIndex : Frame.Removals)
+	{
+		if (MarkerIDs.IsValidIndex(MarkerIndex) && MarkerIDs[MarkerIndex].IsValid())
+		{
+			NavSubsystem->RemoveMarker(MarkerIDs[MarkerIndex]);
+			MarkerIDs[MarkerIndex].Invalidate();
+			--NumActiveMarkers;
+			bMarkersChanged = true;
+		}
+	}
+
+	for (const FOBMarkerTraceFrame::FRegistration& Registration : Frame.Registrations)
+	{
+		const FName LayerName = LayerNames.IsValidIndex(Registration.LayerNameIndex)
+			                        ? LayerNames[Registration.LayerNameIndex]
+			                        : NAME_None;
+		const FGuid MarkerID = FGuid::NewGuid();
+		if (UOBMapMarker* Marker = NavSubsystem->CreateMarker(MarkerID, nullptr, GetConfig(Registration.ConfigIndex),
+		                                                      LayerName, Registration.WorldLocation))
+		{
+			// Expiry is part of the recorded removals
+			Marker->CurrentLifeTime = 0.0f;
+
+			if (MarkerIDs.Num() <= static_cast<int32>(Registration.MarkerIndex))
+			{
+				MarkerIDs.SetNum(static_cast<int32>(Registration.MarkerIndex) + 1);
+			}
+			MarkerIDs[Registration.MarkerIndex] = MarkerID;
+			++NumActiveMarkers;
+			bMarkersChanged = true;
+		}
+	}
+
+	for (const TPair<uint32, FVector>& Move : Frame.Moves)
+	{
+		if (!MarkerIDs.IsValidIndex(Move.Key))
+		{
+			continue;
+		}
+		if (const TObjectPtr<UOBMapMarker>* Marker = NavSubsystem->ActiveMarkersMap.Find(MarkerIDs[Move.Key]); Marker && *Marker)
+		{
+			(*Marker)->WorldLocation = Move.Value;
+		}
+	}
+
+	if (bMarkersChanged)
+	{
+		NavSubsystem->RebuildActiveMarkersArray();
+		NavSubsystem->OnMarkersUpdated.Broadcast();
+	}
+
+	if (Frame.bLayerChanged)
+	{
+		RecordedLayerPath = Frame.LayerPath;
+	}
+
+	if (Frame.bHasView)
+	{
+		FOBTrackedView View;
+		View.Location = Frame.ViewLocation;
+		View.ActorYaw = Frame.ViewActorYaw;
+		View.ControlYaw = Frame.ViewControlYaw;
+		NavSubsystem->SetTrackedViewOverride(View);
+
+		const UOBMapLayerAsset* Layer = NavSubsystem->FindBestLayerForLocation(View.Location);
+		if ((Layer ? FSoftObjectPath(Layer).ToString() : FString()) != RecordedLayerPath)
+		{
+			++NumLayerMismatches;
+		}
+	}
+
+	OutDeltaTime = Frame.DeltaTime;
+	++NumFramesApplied;
+	return true;
+}
+
+bool FOBMarkerTraceReplayer::Restart()
+{
+	RemoveReplayedMarkers();
+	Reader.Rewind();
+	RecordedLayerPath.Reset();
+	return Data.Num() > 0;
+}
+
+void FOBMarkerTraceReplayer::Stop()
+{
+	RemoveReplayedMarkers();
+	if (UOBNavigationSubsystem* NavSubsystem = Subsystem.Get())
+	{
+		NavSubsystem->ClearTrackedViewOverride();
+	}
+	if (ConfigsHandle.IsValid())
+	{
+		ConfigsHandle->ReleaseHandle();
+		ConfigsHandle.Reset();
+	}
+}
+
+void FOBMarkerTraceReplayer::RemoveReplayedMarkers()
+{
+	UOBNavigationSubsystem* NavSubsystem = Subsystem.Get();
+	if (NavSubsystem && NumActiveMarkers > 0)
+	{
+		for (const FGuid& MarkerID : MarkerIDs)
+		{
+			if (MarkerID.IsValid())
+			{
+				NavSubsystem->RemoveMarker(MarkerID);
+			}
+		}
+		NavSubsystem->RebuildActiveMarkersArray();
+		NavSubsystem->OnMarkersUpdated.Broadcast();
+	}
+
+	MarkerIDs.Reset();
+	NumActiveMarkers = 0;
+}
+
+UOBMarkerConfigAsset* FOBMarkerTraceReplayer::GetConfig(const uint32 ConfigIndex)
+{
+	if (Configs.IsValidIndex(ConfigIndex) && Configs[ConfigIndex].IsValid())
+	{
+		return Configs[ConfigIndex].Get();
+	}
+
+	// Configs that no longer exist still get markers, so the replayed load stays the same
+	if (!FallbackConfig.IsValid())
+	{
+		FallbackConfig.Reset(NewObject<UOBMarkerConfigAsset>(GetTransientPackage()));
+	}
+	return FallbackConfig.Get();
+}
+
+#if !UE_BUILD_SHIPPING
+
+static UOBNavigationSubsystem* GetTraceSubsystem(const UWorld* World)
+{
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UOBNavigationSubsystem>() : nullptr;
+}
+
+static FAutoConsoleCommandWithWorldAndArgs GOBNavigationTraceRecordCommand(
+	TEXT("OBNav.Trace.Record"),
+	TEXT("Starts recording the marker stream. Usage: OBNav.Trace.Record [FilePath]\n")
+	TEXT("Defaults to Saved/Profiling/OBNavigation/MarkerTrace-<timestamp>.obtrace"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, const UWorld* World)
+	{
+		if (UOBNavigationSubsystem* NavSubsystem = GetTraceSubsystem(World))
+		{
+			NavSubsystem->StartTraceRecording(Args.Num() > 0
+				                                  ? Args[0]
+				                                  : FPaths::ProfilingDir() / TEXT("OBNavigation") /
+				                                  FString::Printf(TEXT("MarkerTrace-%s.obtrace"),
+				                                                  *FDateTime::Now().ToString()));
+		}
+	}));
+
+static FAutoConsoleCommandWithWorld GOBNavigationTraceStopRecordingCommand(
+	TEXT("OBNav.Trace.StopRecording"),
+	TEXT("Stops recording the marker stream."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](const UWorld* World)
+	{
+		if (UOBNavigationSubsystem* NavSubsystem = GetTraceSubsystem(World))
+		{
+			NavSubsystem->StopTraceRecording();
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs GOBNavigationTraceReplayCommand(
+	TEXT("OBNav.Trace.Replay"),
+	TEXT("Replays a recorded marker trace. Usage: OBNav.Trace.Replay <FilePath> [-Loop]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, const UWorld* World)
+	{
+		UOBNavigationSubsystem* NavSubsystem = GetTraceSubsystem(World);
+		if (NavSubsystem && Args.Num() > 0)
+		{
+			NavSubsystem->StartTraceReplay(Args[0], Args.Contains(TEXT("-Loop")));
+		}
+	}));
+
+static FAutoConsoleCommandWithWorld GOBNavigationTraceStopReplayCommand(
+	TEXT("OBNav.Trace.StopReplay"),
+	TEXT("Stops the marker trace replay and removes the replayed markers."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](const UWorld* World)
+	{
+		if (UOBNavigationSubsystem* NavSubsystem = GetTraceSubsystem(World))
+		{
+			NavSubsystem->StopTraceReplay();
+		}
+	}));
+
+#endif // !UE_BUILD_SHIPPING
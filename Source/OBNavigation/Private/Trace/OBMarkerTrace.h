@@ -0,0 +1,123 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/OBMarkerTraceData.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/StrongObjectPtr.h"
+
+class UOBMapLayerAsset;
+class UOBMarkerConfigAsset;
+class UOBNavigationSubsystem;
+struct FStreamableHandle;
+
+/**
+ * @class FOBMarkerTraceRecorder
+ * @brief Captures the marker stream of a navigation subsystem into a trace file, one frame per subsystem tick.
+ * Only changes are written: markers are diffed against the previous frame, so a frame where nothing moved costs
+ * a few bytes for the frame time and the view.
+ */
+class FOBMarkerTraceRecorder
+{
+public:
+	~FOBMarkerTraceRecorder();
+
+	// Creates the trace file and writes the header. Returns false if the file could not be created.
+	bool Open(const FString& FilePath);
+
+	// Records the state of the subsystem after its tick.
+	void CaptureFrame(const UOBNavigationSubsystem& Subsystem, float DeltaTime);
+
+	// Flushes and closes the file.
+	void Close();
+
+	int32 GetNumFrames() const { return NumFrames; }
+	int64 GetNumBytesWritten() const { return NumBytesWritten; }
+
+private:
+	uint32 FindOrDefineConfig(const UOBMarkerConfigAsset* Config);
+	uint32 FindOrDefineLayerName(FName LayerName);
+	void Flush();
+
+	struct FRecordedMarker
+	{
+		uint32 Index = 0;
+		FIntVector Position = FIntVector::ZeroValue;
+		int32 LastSeenFrame = 0;
+	};
+
+	TUniquePtr<FArchive> FileWriter;
+	FOBMarkerTraceWriter Writer;
+
+	TMap<FGuid, FRecordedMarker> RecordedMarkers;
+	TMap<FObjectKey, uint32> ConfigIndices;
+	TMap<FName, uint32> LayerNameIndices;
+	uint32 NextMarkerIndex = 0;
+
+	TWeakObjectPtr<const UOBMapLayerAsset> RecordedLayer;
+	bool bLayerRecorded = false;
+
+	int32 NumFrames = 0;
+	int64 NumBytesWritten = 0;
+};
+
+/**
+ * @class FOBMarkerTraceReplayer
+ * @brief Feeds a recorded trace into a navigation subsystem, one frame at a time.
+ * Markers are replayed as static-location markers moved by the recorded positions, so no actors are needed,
+ * and the recorded view replaces the tracked pawn. Removals (including expired lifetimes) are replayed from the
+ * trace, which makes the replay deterministic for a given frame sequence.
+ * The configs of the whole trace are streamed in when it is opened; the first frame waits for them.
+ */
+class FOBMarkerTraceReplayer
+{
+public:
+	explicit FOBMarkerTraceReplayer(UOBNavigationSubsystem* InSubsystem);
+
+	// Loads the trace file. Returns false if it could not be read or is not a valid trace.
+	bool Open(const FString& FilePath);
+
+	/**
+	 * @brief Applies the next recorded frame to the subsystem.
+	 * @param OutDeltaTime Receives the recorded frame time, or 0 while the configs of the trace are streaming in.
+	 * @return False at the end of the trace.
+	 */
+	bool ApplyNextFrame(float& OutDeltaTime);
+
+	// Removes the replayed markers and rewinds to the first frame. Returns false if the trace cannot be replayed.
+	bool Restart();
+
+	// Removes the replayed markers and the view override, and releases the configs of the trace.
+	void Stop();
+
+	int32 GetNumFramesApplied() const { return NumFramesApplied; }
+	int32 GetNumActiveMarkers() const { return NumActiveMarkers; }
+
+	// Frames where the layer the subsystem picked differs from the recorded one (e.g., the map layers changed since)
+	int32 GetNumLayerMismatches() const { return NumLayerMismatches; }
+
+private:
+	void RemoveReplayedMarkers();
+	void RequestConfigs();
+	UOBMarkerConfigAsset* GetConfig(uint32 ConfigIndex);
+
+	TWeakObjectPtr<UOBNavigationSubsystem> Subsystem;
+
+	TArray<uint8> Data;
+	FOBMarkerTraceReader Reader;
+	FOBMarkerTraceFrame Frame;
+
+	// Subsystem marker ID of every trace marker index. Invalid once the marker was removed.
+	TArray<FGuid> MarkerIDs;
+	int32 NumActiveMarkers = 0;
+
+	TArray<TStrongObjectPtr<UOBMarkerConfigAsset>> Configs;
+	TSharedPtr<FStreamableHandle> ConfigsHandle;
+	TStrongObjectPtr<UOBMarkerConfigAsset> FallbackConfig; // Used for configs that cannot be loaded
+	TArray<FName> LayerNames;
+
+	FString RecordedLayerPath;
+	int32 NumFramesApplied = 0;
+	int32 NumLayerMismatches = 0;
+};
@@ -3,10 +3,38 @@
 
 #include "Widget/OBMapMarkerWidget.h"
 
+#include "OBMapMarker.h"
 #include "Components/Image.h"
+#include "Materials/MaterialInstanceDynamic.h"
+
+namespace
+{
+	// Parameters of the icon animation material, see FOBMarkerAnimation
+	const FName IconTextureParam(TEXT("IconTexture"));
+	const FName AnimStartTimeParam(TEXT("AnimStartTime"));
+	const FName AnimEndTimeParam(TEXT("AnimEndTime"));
+	const FName PopDurationParam(TEXT("PopDuration"));
+	const FName PopStartScaleParam(TEXT("PopStartScale"));
+	const FName PulsePeriodParam(TEXT("PulsePeriod"));
+	const FName PulseMinScaleParam(TEXT("PulseMinScale"));
+	const FName FadeOutDurationParam(TEXT("FadeOutDuration"));
+}
 
 void UOBMapMarkerWidget::InitializeMarker(UTexture2D* IdentifierTexture, UMaterialInterface* IndicatorMaterial)
 {
+	if (bIsMarkerInitialized && CurrentIdentifierTexture.Get() == IdentifierTexture &&
+		CurrentIndicatorMaterial.Get() == IndicatorMaterial)
+	{
+		return;
+	}
+	bIsMarkerInitialized = true;
+	CurrentIdentifierTexture = IdentifierTexture;
+	CurrentIndicatorMaterial = IndicatorMaterial;
+
+	// The texture brush below replaces the animation material; UpdateAnimation sets it up again
+	IconMaterialInstance = nullptr;
+	AnimatedMarker = nullptr;
+
 	// Set the static identifier icon's texture and visibility
 	if (IdentifierIcon)
 	{
@@ -23,6 +51,12 @@ void UOBMapMarkerWidget::InitializeMarker(UTexture2D* IdentifierTexture, UMateri
 		DirectionalIndicator->SetBrushFromMaterial(FOVMaterialInstance);
 		DirectionalIndicator->SetVisibility(ESlateVisibility::HitTestInvisible);
 	}
+	else if (DirectionalIndicator && FOVMaterialInstance)
+	{
+		// A recycled widget still shows the indicator of its previous marker
+		FOVMaterialInstance = nullptr;
+		DirectionalIndicator->SetVisibility(ESlateVisibility::Collapsed);
+	}
 }
 
 void UOBMapMarkerWidget::UpdateRotation(const float IndicatorAngle)
@@ -50,6 +84,54 @@ void UOBMapMarkerWidget::UpdateVisuals(const float IndicatorAngle, const float I
 	}
 }
 
+void UOBMapMarkerWidget::UpdateAnimation(const UOBMapMarker* Marker)
+{
+	if (!Marker || (AnimatedMarker.Get() == Marker && AnimatedMarkerSerial == Marker->AnimationSerial))
+	{
+		return;
+	}
+	AnimatedMarker = Marker;
+	AnimatedMarkerSerial = Marker->AnimationSerial;
+
+	const UOBMarkerConfigAsset* Config = Marker->ConfigAsset;
+	UMaterialInterface* AnimationMaterial = Config && Config->Animation.IsAnimated()
+		                                        ? Config->Animation.Material.Get()
+		                                        : nullptr;
+	if (!IdentifierIcon)
+	{
+		return;
+	}
+
+	if (!AnimationMaterial)
+	{
+		// A recycled widget may still draw the animation of its previous marker
+		if (IconMaterialInstance)
+		{
+			IconMaterialInstance = nullptr;
+			IdentifierIcon->SetBrushFromTexture(CurrentIdentifierTexture.Get());
+		}
+		return;
+	}
+
+	if (!IconMaterialInstance || IconMaterialInstance->Parent != AnimationMaterial)
+	{
+		IconMaterialInstance = UMaterialInstanceDynamic::Create(AnimationMaterial, this);
+		IconMaterialInstance->SetTextureParameterValue(IconTextureParam, CurrentIdentifierTexture.Get());
+		IdentifierIcon->SetBrushFromMaterial(IconMaterialInstance);
+		IdentifierIcon->SetVisibility(ESlateVisibility::HitTestInvisible);
+	}
+
+	// Everything the material needs until the timing changes again
+	const FOBMarkerAnimation& Animation = Config->Animation;
+	IconMaterialInstance->SetScalarParameterValue(AnimStartTimeParam, static_cast<float>(Marker->AnimationStartTime));
+	IconMaterialInstance->SetScalarParameterValue(AnimEndTimeParam, static_cast<float>(Marker->AnimationEndTime));
+	IconMaterialInstance->SetScalarParameterValue(PopDurationParam, Animation.bSpawnPop ? Animation.PopDuration : 0.0f);
+	IconMaterialInstance->SetScalarParameterValue(PopStartScaleParam, Animation.PopStartScale);
+	IconMaterialInstance->SetScalarParameterValue(PulsePeriodParam, Animation.bPulse ? Animation.PulsePeriod : 0.0f);
+	IconMaterialInstance->SetScalarParameterValue(PulseMinScaleParam, Animation.PulseMinScale);
+	IconMaterialInstance->SetScalarParameterValue(FadeOutDurationParam, Animation.bFadeOut ? Animation.FadeOutDuration : 0.0f);
+}
+
 void UOBMapMarkerWidget::NativePreConstruct()
 {
 	Super::NativePreConstruct();
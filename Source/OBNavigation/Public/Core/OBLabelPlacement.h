@@ -0,0 +1,95 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Screen-space label placement: labels are offered in priority order and each one is kept only if it does not overlap
+ * a label kept before it. Depends on Core only, like the minimap projection.
+ */
+namespace OBNavigation::Labels
+{
+	/**
+	 * @class FLabelCollisionGrid
+	 * @brief Spatial hash of the rectangles placed so far. A test only visits the cells the rectangle covers, so placing
+	 * N labels of about the cell size costs O(N) instead of the O(N^2) of testing every pair.
+	 * Storage is kept across Reset, so a grid reused every frame does not allocate once it has warmed up.
+	 */
+	class FLabelCollisionGrid
+	{
+	public:
+		explicit FLabelCollisionGrid(const double InCellSize = 64.0)
+			: InvCellSize(1.0 / FMath::Max(InCellSize, 1.0))
+		{
+		}
+
+		void Reset()
+		{
+			CellHeads.Reset();
+			Entries.Reset();
+			Rects.Reset();
+		}
+
+		// Adds the rectangle unless it overlaps one added before. Returns true if it was added.
+		bool TryAdd(const FVector2D& Min, const FVector2D& Max)
+		{
+			const FIntPoint MinCell = ToCell(Min);
+			const FIntPoint MaxCell = ToCell(Max);
+
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+			{
+				for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+				{
+					const int32* Head = CellHeads.Find(FIntPoint(X, Y));
+					for (int32 EntryIndex = Head ? *Head : INDEX_NONE; EntryIndex != INDEX_NONE;
+					     EntryIndex = Entries[EntryIndex].Next)
+					{
+						const FRect& Other = Rects[Entries[EntryIndex].RectIndex];
+						if (Min.X < Other.Max.X && Other.Min.X < Max.X && Min.Y < Other.Max.Y && Other.Min.Y < Max.Y)
+						{
+							return false;
+						}
+					}
+				}
+			}
+
+			// Linked into every covered cell; cell lists are singly linked through Entries, so cells never allocate
+			const int32 RectIndex = Rects.Add({Min, Max});
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+			{
+				for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+				{
+					int32& Head = CellHeads.FindOrAdd(FIntPoint(X, Y), INDEX_NONE);
+					Head = Entries.Add({RectIndex, Head});
+				}
+			}
+			return true;
+		}
+
+		int32 Num() const { return Rects.Num(); }
+
+	private:
+		struct FRect
+		{
+			FVector2D Min;
+			FVector2D Max;
+		};
+
+		struct FEntry
+		{
+			int32 RectIndex;
+			int32 Next;
+		};
+
+		FIntPoint ToCell(const FVector2D& Point) const
+		{
+			return FIntPoint(FMath::FloorToInt32(Point.X * InvCellSize), FMath::FloorToInt32(Point.Y * InvCellSize));
+		}
+
+		double InvCellSize;
+		TMap<FIntPoint, int32> CellHeads; // First entry of each non-empty cell
+		TArray<FEntry> Entries;
+		TArray<FRect> Rects;
+	};
+}
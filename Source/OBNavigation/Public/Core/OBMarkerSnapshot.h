@@ -0,0 +1,166 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * Read-only marker state for threads other than the game thread (worker projection jobs, spectator streams,
+ * telemetry). The subsystem publishes an immutable snapshot per tick; readers take a reference to the latest one
+ * without locks or copies. Depends on Core only, like the minimap projection.
+ */
+namespace OBNavigation::Snapshots
+{
+	// Plain data only: readers never touch UObjects
+	struct FMarkerSnapshotEntry
+	{
+		FGuid MarkerID;
+		FVector WorldLocation = FVector::ZeroVector;
+		FName LayerName;
+		int32 ConfigIndex = INDEX_NONE; // See UOBNavigationSubsystem::GetMarkerConfigByIndex
+		float RemainingLifeTime = 0.0f; // 0 if the marker does not expire
+		bool bTracksActor = false;
+		bool bHiddenByLineOfSight = false;
+	};
+
+	struct FMarkerSnapshot
+	{
+		uint64 FrameNumber = 0; // GFrameCounter of the publishing tick
+		double WorldTime = 0.0;
+		FName MinimapLayerName; // Object name of the current minimap layer, None without one
+		TArray<FMarkerSnapshotEntry> Markers; // In UOBNavigationSubsystem::GetAllActiveMarkers order
+	};
+
+	/**
+	 * @class TSnapshotBuffer
+	 * @brief Single writer, any number of readers, read-copy-update style.
+	 * The writer fills a slot no reader holds and publishes it with one atomic store; readers pin the published slot
+	 * with a counter. Neither side ever waits: a reader only retries when a publication lands between its two loads,
+	 * and the writer allocates another slot when every retired one is still pinned. Slot storage is reused, so
+	 * steady-state publication does not allocate once the snapshots stop growing.
+	 */
+	template <typename SnapshotType>
+	class TSnapshotBuffer
+	{
+		struct FSlot
+		{
+			SnapshotType Snapshot;
+			uint64 Version = 0;
+			mutable std::atomic<int32> NumReaders{0};
+		};
+
+	public:
+		/**
+		 * @class FReadScope
+		 * @brief Pins a snapshot for as long as it lives. Keep it short: a pinned slot cannot be reused by the writer.
+		 */
+		class FReadScope
+		{
+		public:
+			FReadScope() = default;
+			FReadScope(FReadScope&& Other) : Slot(Other.Slot) { Other.Slot = nullptr; }
+			FReadScope& operator=(FReadScope&& Other)
+			{
+				if (this != &Other)
+				{
+					Release();
+					Slot = Other.Slot;
+					Other.Slot = nullptr;
+				}
+				return *this;
+			}
+			FReadScope(const FReadScope&) = delete;
+			FReadScope& operator=(const FReadScope&) = delete;
+			~FReadScope() { Release(); }
+
+			bool IsValid() const { return Slot != nullptr; }
+			explicit operator bool() const { return IsValid(); }
+
+			// Increases by one with every publication, so readers can skip a snapshot they already processed
+			uint64 GetVersion() const { return Slot ? Slot->Version : 0; }
+
+			const SnapshotType& operator*() const { check(Slot); return Slot->Snapshot; }
+			const SnapshotType* operator->() const { check(Slot); return &Slot->Snapshot; }
+
+		private:
+			friend TSnapshotBuffer;
+			explicit FReadScope(const FSlot* InSlot) : Slot(InSlot) {}
+
+			void Release()
+			{
+				if (Slot)
+				{
+					Slot->NumReaders.fetch_sub(1);
+					Slot = nullptr;
+				}
+			}
+
+			const FSlot* Slot = nullptr;
+		};
+
+		TSnapshotBuffer() = default;
+		TSnapshotBuffer(const TSnapshotBuffer&) = delete;
+		TSnapshotBuffer& operator=(const TSnapshotBuffer&) = delete;
+
+		// Any thread. Returns an invalid scope until the first publication.
+		FReadScope Acquire() const
+		{
+			for (;;)
+			{
+				const FSlot* Slot = Current.load();
+				if (!Slot)
+				{
+					return FReadScope();
+				}
+
+				// Sequentially consistent, like the writer's side: either this sees the slot replaced and retries, or
+				// the writer sees it pinned and leaves it alone
+				Slot->NumReaders.fetch_add(1);
+				if (Current.load() == Slot)
+				{
+					return FReadScope(Slot);
+				}
+				Slot->NumReaders.fetch_sub(1);
+			}
+		}
+
+		/**
+		 * @brief Writer thread only. Fills a free slot and publishes it.
+		 * @param Fill Called with the snapshot to overwrite. It holds an older publication, so containers keep their
+		 * capacity; reset everything that is not fully rewritten.
+		 */
+		template <typename FillType>
+		void Publish(FillType&& Fill)
+		{
+			FSlot* Slot = FindFreeSlot();
+			Fill(Slot->Snapshot);
+			Slot->Version = ++LastVersion;
+			Current.store(Slot);
+		}
+
+		uint64 GetLastVersion() const { return LastVersion; }
+		int32 GetNumSlots() const { return Slots.Num(); }
+
+	private:
+		FSlot* FindFreeSlot()
+		{
+			const FSlot* CurrentSlot = Current.load();
+			for (const TUniquePtr<FSlot>& Slot : Slots)
+			{
+				if (Slot.Get() != CurrentSlot && Slot->NumReaders.load() == 0)
+				{
+					return Slot.Get();
+				}
+			}
+			return Slots.Add_GetRef(MakeUnique<FSlot>()).Get();
+		}
+
+		// Owned and grown by the writer; readers only reach slots through Current
+		TArray<TUniquePtr<FSlot>> Slots;
+		std::atomic<const FSlot*> Current{nullptr};
+		uint64 LastVersion = 0;
+	};
+
+	using FMarkerSnapshotBuffer = TSnapshotBuffer<FMarkerSnapshot>;
+}
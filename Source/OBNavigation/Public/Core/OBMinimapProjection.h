@@ -0,0 +1,201 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Minimap projection: maps marker UVs to positions on the minimap canvas and clamps off-screen markers to its edge.
+ * Depends on Core only (no UObject, Slate or Engine), so it can be exercised and measured on its own.
+ *
+ * The rotation mode and the clamp shape are template parameters. Dispatch picks the specialization once per frame
+ * and the per-marker loop runs without branching on the minimap config.
+ */
+namespace OBNavigation::Projection
+{
+	enum class EMapRotation : uint8
+	{
+		Fixed,     // The map keeps its static rotation (offset + alignment)
+		FollowView // The map additionally rotates with the view yaw
+	};
+
+	enum class EClampShape : uint8
+	{
+		Circle,
+		Square
+	};
+
+	/**
+	 * @struct FFrameParams
+	 * @brief Everything the projection of a frame depends on. Angles are in degrees.
+	 */
+	struct FFrameParams
+	{
+		FVector2D ViewUV = FVector2D::ZeroVector; // Map UV of the tracked view, shown at the canvas center
+		FVector2D CanvasSize = FVector2D::ZeroVector;
+		double Zoom = 1.0;
+		double StaticRotation = 0.0; // Map rotation offset plus alignment angle
+		double ViewYaw = 0.0;        // Yaw of the configured rotation source, used when the map follows the view
+		double ViewerActorYaw = 0.0; // Yaw of the viewer's actor, for its own marker on a fixed map
+	};
+
+	struct FMarkerInput
+	{
+		FVector2D MapUV = FVector2D::ZeroVector;
+		double WorldYaw = 0.0; // Yaw of the tracked actor, 0 (world +X) for static markers
+	};
+
+	struct FMarkerOutput
+	{
+		FVector2D Position = FVector2D::ZeroVector; // In canvas space
+		double IndicatorAngle = 0.0;
+		bool bClamped = false; // Off-screen marker pinned to the edge; its indicator points towards it
+	};
+
+	/**
+	 * @class TProjector
+	 * @brief Projects markers for one frame. Construction does the per-frame work (rotation sine and cosine, scale).
+	 */
+	template <EMapRotation Rotation, EClampShape Shape>
+	class TProjector
+	{
+	public:
+		explicit TProjector(const FFrameParams& Params)
+			: ViewUV(Params.ViewUV)
+			, Scale(Params.CanvasSize * Params.Zoom)
+			, Center(Params.CanvasSize * 0.5)
+			, Radius(FMath::Min(Params.CanvasSize.X, Params.CanvasSize.Y) * 0.5)
+		{
+			double MapRotation = Params.StaticRotation;
+			if constexpr (Rotation == EMapRotation::FollowView)
+			{
+				MapRotation += Params.ViewYaw;
+
+				// On a rotating map, in-view markers are oriented relative to the view and the viewer always points up
+				IndicatorReference = Params.ViewYaw;
+				ViewerIndicatorAngle = 0.0;
+			}
+			else
+			{
+				// On a fixed map, orientations are true world orientations compensated for the static rotation
+				IndicatorReference = Params.StaticRotation;
+				ViewerIndicatorAngle = Params.ViewerActorYaw - Params.StaticRotation;
+			}
+
+			// Offsets are rotated against the map (same convention as FVector2D::GetRotated(-MapRotation))
+			FMath::SinCos(&Sin, &Cos, FMath::DegreesToRadians(-MapRotation));
+		}
+
+		// Canvas position of a map point, without clamping.
+		FVector2D ProjectPoint(const FVector2D& MapUV) const
+		{
+			return Center + Rotate((MapUV - ViewUV) * Scale);
+		}
+
+		FMarkerOutput ProjectMarker(const FMarkerInput& Input) const
+		{
+			const FVector2D Offset = Rotate((Input.MapUV - ViewUV) * Scale);
+
+			FMarkerOutput Output;
+			double ClampScale = 1.0;
+			if constexpr (Shape == EClampShape::Circle)
+			{
+				const double SizeSquared = Offset.SizeSquared();
+				Output.bClamped = SizeSquared > FMath::Square(Radius);
+				if (Output.bClamped)
+				{
+					ClampScale = Radius * FMath::InvSqrt(SizeSquared);
+				}
+			}
+			else
+			{
+				// Pinned where the ray from the center crosses the square's edge, not on the inscribed circle
+				const double MaxAxis = FMath::Max(FMath::Abs(Offset.X), FMath::Abs(Offset.Y));
+				Output.bClamped = MaxAxis > Radius;
+				if (Output.bClamped)
+				{
+					ClampScale = Radius / MaxAxis;
+				}
+			}
+
+			if (Output.bClamped)
+			{
+				Output.Position = Center + Offset * ClampScale;
+				Output.IndicatorAngle = FMath::RadiansToDegrees(FMath::Atan2(Offset.Y, Offset.X));
+			}
+			else
+			{
+				Output.Position = Center + Offset;
+				Output.IndicatorAngle = Input.WorldYaw - IndicatorReference;
+			}
+			return Output;
+		}
+
+		// The viewer's own marker: always at the center.
+		FMarkerOutput ProjectViewer() const
+		{
+			FMarkerOutput Output;
+			Output.Position = Center;
+			Output.IndicatorAngle = ViewerIndicatorAngle;
+			return Output;
+		}
+
+		void ProjectMarkers(const TConstArrayView<FMarkerInput> Inputs, const TArrayView<FMarkerOutput> Outputs) const
+		{
+			check(Inputs.Num() == Outputs.Num());
+			for (int32 Index = 0; Index < Inputs.Num(); ++Index)
+			{
+				Outputs[Index] = ProjectMarker(Inputs[Index]);
+			}
+		}
+
+		const FVector2D& GetCenter() const { return Center; }
+		double GetRadius() const { return Radius; }
+
+	private:
+		FVector2D Rotate(const FVector2D& Vector) const
+		{
+			return FVector2D(Cos * Vector.X - Sin * Vector.Y, Sin * Vector.X + Cos * Vector.Y);
+		}
+
+		FVector2D ViewUV;
+		FVector2D Scale;
+		FVector2D Center;
+		double Radius = 0.0;
+		double Sin = 0.0;
+		double Cos = 1.0;
+		double IndicatorReference = 0.0;
+		double ViewerIndicatorAngle = 0.0;
+	};
+
+	/**
+	 * @brief Builds the projector specialization for a frame and passes it to Func.
+	 * @param Func Called once with a const TProjector<...>&, typically a generic lambda wrapping the marker loop.
+	 */
+	template <typename FuncType>
+	void Dispatch(const EMapRotation Rotation, const EClampShape Shape, const FFrameParams& Params, FuncType&& Func)
+	{
+		if (Rotation == EMapRotation::FollowView)
+		{
+			if (Shape == EClampShape::Circle)
+			{
+				Func(TProjector<EMapRotation::FollowView, EClampShape::Circle>(Params));
+			}
+			else
+			{
+				Func(TProjector<EMapRotation::FollowView, EClampShape::Square>(Params));
+			}
+		}
+		else
+		{
+			if (Shape == EClampShape::Circle)
+			{
+				Func(TProjector<EMapRotation::Fixed, EClampShape::Circle>(Params));
+			}
+			else
+			{
+				Func(TProjector<EMapRotation::Fixed, EClampShape::Square>(Params));
+			}
+		}
+	}
+}
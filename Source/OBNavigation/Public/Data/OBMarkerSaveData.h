@@ -0,0 +1,110 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+
+class UOBMarkerConfigAsset;
+
+/**
+ * Binary layout of a saved marker set (all values little-endian):
+ *   Header    : Magic, Version, config count, layer count, marker count, quantization origin and step
+ *   Configs   : Soft object path of each referenced UOBMarkerConfigAsset (length-prefixed UTF-8)
+ *   Layers    : Each referenced marker layer name (length-prefixed UTF-8)
+ *   Records   : One fixed-size record per marker (see FOBMarkerSaveFormat::RecordSize)
+ *
+ * Positions are quantized to 16 bits per axis inside the bounding box of the saved markers.
+ * Remaining lifetimes are stored in tenths of a second, 0 meaning infinite.
+ */
+struct FOBMarkerSaveFormat
+{
+	static constexpr uint32 Magic = 0x4B4D424F; // "OBMK"
+	static constexpr uint16 Version = 1;
+
+	// Guid (16) + config index (2) + layer index (2) + quantized XYZ (6) + lifetime (2)
+	static constexpr int32 RecordSize = 28;
+
+	// Longest lifetime that fits in a record, in seconds. Longer lifetimes are clamped.
+	static constexpr float MaxLifeTime = 6553.5f;
+};
+
+/**
+ * @struct FOBSavedMarkerRecord
+ * @brief A single decoded marker. Config and layer are indices into the reader's tables.
+ */
+struct FOBSavedMarkerRecord
+{
+	FGuid MarkerID;
+	uint16 ConfigIndex = 0;
+	uint16 LayerIndex = 0;
+	FVector WorldLocation = FVector::ZeroVector;
+	float RemainingLifeTime = 0.0f; // 0.0 means infinite
+};
+
+/**
+ * @class FOBMarkerSaveWriter
+ * @brief Collects markers and encodes them into the compact saved marker format.
+ */
+class OBNAVIGATION_API FOBMarkerSaveWriter
+{
+public:
+	void Reserve(int32 NumMarkers);
+
+	// Adds a marker to the set. Markers without a config are ignored.
+	void AddMarker(const FGuid& MarkerID, const UOBMarkerConfigAsset* Config, FName LayerName,
+	               const FVector& WorldLocation, float RemainingLifeTime);
+
+	int32 GetNumMarkers() const { return Markers.Num(); }
+
+	// Encodes all added markers, replacing the contents of OutData.
+	void Write(TArray<uint8>& OutData) const;
+
+private:
+	struct FPendingMarker
+	{
+		FGuid MarkerID;
+		uint16 ConfigIndex;
+		uint16 LayerIndex;
+		FVector WorldLocation;
+		float RemainingLifeTime;
+	};
+
+	TArray<FPendingMarker> Markers;
+	TArray<FSoftObjectPath> ConfigTable;
+	TMap<const UOBMarkerConfigAsset*, uint16> ConfigIndices;
+	TArray<FName> LayerTable;
+	TMap<FName, uint16> LayerIndices;
+};
+
+/**
+ * @class FOBMarkerSaveReader
+ * @brief Decodes saved marker data in place.
+ * The reader only parses the header and the small config/layer tables up front. Records are decoded on demand
+ * straight from the source bytes, so the data can be a memory-mapped file and nothing is allocated per marker.
+ * The source data must outlive the reader.
+ */
+class OBNAVIGATION_API FOBMarkerSaveReader
+{
+public:
+	// Validates the header and reads the tables. Returns false if the data is truncated or has an unknown version.
+	bool Open(TArrayView<const uint8> InData);
+
+	int32 GetNumMarkers() const { return NumMarkers; }
+	const TArray<FSoftObjectPath>& GetConfigTable() const { return ConfigTable; }
+	const TArray<FName>& GetLayerTable() const { return LayerTable; }
+
+	// Decodes the record at the given index. Index must be in [0, GetNumMarkers()).
+	bool ReadMarker(int32 Index, FOBSavedMarkerRecord& OutRecord) const;
+
+private:
+	TArrayView<const uint8> Data;
+	int64 RecordsOffset = 0;
+	int32 NumMarkers = 0;
+
+	FVector QuantizationOrigin = FVector::ZeroVector;
+	FVector QuantizationStep = FVector::ZeroVector;
+
+	TArray<FSoftObjectPath> ConfigTable;
+	TArray<FName> LayerTable;
+};
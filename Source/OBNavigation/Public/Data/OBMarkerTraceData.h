@@ -0,0 +1,143 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Binary layout of a marker trace (all values little-endian):
+ *   Header : Magic, Version
+ *   Frames : One event stream per recorded frame, from BeginFrame to EndFrame
+ *
+ * Each event is a one-byte EOBMarkerTraceEvent followed by its payload. Integers are LEB128 varints (signed values
+ * zig-zag encoded), floats are raw 32-bit values. Markers are identified by a trace-local index that is assigned on
+ * registration and never reused, and configs and layer names by indices defined the first time they are used.
+ * Positions are in whole centimeters; registrations carry the absolute position, moves only the delta.
+ */
+struct FOBMarkerTraceFormat
+{
+	static constexpr uint32 Magic = 0x544D424F; // "OBMT"
+	static constexpr uint16 Version = 1;
+};
+
+enum class EOBMarkerTraceEvent : uint8
+{
+	EndFrame = 0,    // (no payload)
+	BeginFrame,      // DeltaTime
+	View,            // Location XYZ, actor yaw, control yaw
+	DefineConfig,    // Config index, config soft object path
+	DefineLayerName, // Layer name index, layer name
+	Register,        // Marker index, config index, layer name index, position XYZ
+	Remove,          // Marker index
+	Move,            // Marker index, position delta XYZ
+	LayerChanged,    // Soft object path of the new minimap layer (empty for none)
+
+	Count
+};
+
+/**
+ * @struct FOBMarkerTraceFrame
+ * @brief Everything recorded in a single frame, decoded by FOBMarkerTraceReader. Reused between frames.
+ */
+struct FOBMarkerTraceFrame
+{
+	struct FRegistration
+	{
+		uint32 MarkerIndex = 0;
+		uint32 ConfigIndex = 0;
+		uint32 LayerNameIndex = 0;
+		FVector WorldLocation = FVector::ZeroVector;
+	};
+
+	float DeltaTime = 0.0f;
+
+	bool bHasView = false;
+	FVector ViewLocation = FVector::ZeroVector;
+	float ViewActorYaw = 0.0f;
+	float ViewControlYaw = 0.0f;
+
+	// Table entries defined in this frame
+	TArray<TPair<uint32, FString>> NewConfigs;
+	TArray<TPair<uint32, FName>> NewLayerNames;
+
+	TArray<FRegistration> Registrations;
+	TArray<uint32> Removals;
+	TArray<TPair<uint32, FVector>> Moves; // Absolute positions, resolved from the recorded deltas
+
+	bool bLayerChanged = false;
+	FString LayerPath;
+
+	void Reset();
+};
+
+/**
+ * @class FOBMarkerTraceWriter
+ * @brief Encodes trace events into a memory buffer. The owner flushes the buffer, typically once per frame.
+ */
+class OBNAVIGATION_API FOBMarkerTraceWriter
+{
+public:
+	void WriteHeader();
+
+	void BeginFrame(float DeltaTime);
+	void WriteView(const FVector& Location, float ActorYaw, float ControlYaw);
+	void DefineConfig(uint32 ConfigIndex, const FString& ConfigPath);
+	void DefineLayerName(uint32 LayerNameIndex, FName LayerName);
+	void Register(uint32 MarkerIndex, uint32 ConfigIndex, uint32 LayerNameIndex, const FIntVector& Position);
+	void Remove(uint32 MarkerIndex);
+	void Move(uint32 MarkerIndex, const FIntVector& Delta);
+	void LayerChanged(const FString& LayerPath);
+	void EndFrame();
+
+	const TArray<uint8>& GetBuffer() const { return Buffer; }
+	void ResetBuffer() { Buffer.Reset(); }
+
+	// Converts a world location to the centimeter grid positions are recorded on.
+	static FIntVector QuantizePosition(const FVector& WorldLocation);
+
+private:
+	void WriteEvent(EOBMarkerTraceEvent Event);
+	void WriteVarUInt(uint32 Value);
+	void WriteVarInt(int32 Value);
+	void WriteFloat(float Value);
+	void WriteString(const FString& String);
+
+	TArray<uint8> Buffer;
+};
+
+/**
+ * @class FOBMarkerTraceReader
+ * @brief Decodes a trace frame by frame. The source data must outlive the reader.
+ */
+class OBNAVIGATION_API FOBMarkerTraceReader
+{
+public:
+	// Validates the header. Returns false if the data is not a trace or has an unknown version.
+	bool Open(TArrayView<const uint8> InData);
+
+	/**
+	 * @brief Decodes the next frame.
+	 * @param OutFrame Receives the frame. Its arrays are reset, not reallocated.
+	 * @return False at the end of the trace or if the data is corrupt (see HasError).
+	 */
+	bool ReadFrame(FOBMarkerTraceFrame& OutFrame);
+
+	// Restarts reading at the first frame.
+	void Rewind();
+
+	bool HasError() const { return bError; }
+
+private:
+	bool ReadVarUInt(uint32& OutValue);
+	bool ReadVarInt(int32& OutValue);
+	bool ReadFloat(float& OutValue);
+	bool ReadString(FString& OutString);
+
+	TArrayView<const uint8> Data;
+	int32 FirstFrameOffset = 0;
+	int32 Offset = 0;
+	bool bError = false;
+
+	// Last known position of every marker, indexed by marker index, to resolve move deltas
+	TArray<FIntVector> MarkerPositions;
+};
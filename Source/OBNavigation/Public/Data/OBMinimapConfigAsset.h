@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "OBMapMarker.h"
 #include "Engine/DataAsset.h"
+#include "Fonts/SlateFontInfo.h"
 #include "OBMinimapConfigAsset.generated.h"
 
 class UMaterialInterface;
@@ -98,6 +99,53 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Minimap Settings")
 	EMinimapShape MinimapShape = EMinimapShape::Circle;
 
+	// --- ROUTE SETTINGS ---
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Route Settings")
+	FLinearColor RouteColor = FLinearColor(0.2f, 0.8f, 1.0f, 1.0f);
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Route Settings", meta = (ClampMin = "0.5"))
+	float RouteThickness = 3.0f;
+
+	// --- BREADCRUMB SETTINGS ---
+	// Draws the recent path of the tracked pawn (see UOBNavigationSettings for how it is sampled)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Breadcrumb Settings")
+	bool bShowBreadcrumbs = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Breadcrumb Settings",
+		meta = (EditCondition = "bShowBreadcrumbs"))
+	FLinearColor BreadcrumbColor = FLinearColor(1.0f, 1.0f, 1.0f, 0.5f);
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Breadcrumb Settings",
+		meta = (EditCondition = "bShowBreadcrumbs", ClampMin = "0.5"))
+	float BreadcrumbThickness = 2.0f;
+
+	// --- LABEL SETTINGS ---
+	// Draws the labels of markers whose config enables them (see UOBMarkerConfigAsset::bShowLabel)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Label Settings")
+	bool bShowLabels = true;
+
+	// If no font is set, the default Slate font is used
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Label Settings", meta = (EditCondition = "bShowLabels"))
+	FSlateFontInfo LabelFont;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Label Settings", meta = (EditCondition = "bShowLabels"))
+	FLinearColor LabelColor = FLinearColor::White;
+
+	// Offset (in pixels) of a label's top center from the bottom center of its marker
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Label Settings", meta = (EditCondition = "bShowLabels"))
+	FVector2D LabelOffset = FVector2D(0.0f, 2.0f);
+
+	// Minimum gap (in pixels) between two labels. Closer labels count as overlapping.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Label Settings",
+		meta = (EditCondition = "bShowLabels", ClampMin = "0.0"))
+	float LabelSpacing = 4.0f;
+
+	// --- POINT OF INTEREST SETTINGS ---
+	// Draws the POIs of the map's POI database as plain icons (their config's identifier icon and size). They have no
+	// widget, no indicator and no label, and are not pinned to the edge when off the minimap.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Point of Interest Settings")
+	bool bShowPointsOfInterest = true;
+
 	// --- COMPASS SETTINGS ---
 	
 	// // The padding (in pixels) between the edge of the minimap and the compass marker ring.
@@ -105,6 +153,7 @@ public:
 	// float CompassPadding = 1.0f;
 
 	// --- DEBUG SETTINGS ---
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Debug Settings")
-	bool bShowDebugMessages = false;
+	// Replaced by the "OBNav.Debug.Overlay" console variable
+	UPROPERTY()
+	bool bShowDebugMessages_DEPRECATED = false;
 };
@@ -0,0 +1,133 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+
+/**
+ * Binary layout of a navigation manifest (all values little-endian):
+ *   Header    : Magic, Version, layer count, marker config count, static marker data size
+ *   Layers    : Soft object path (length-prefixed UTF-8) and priority of each map layer, highest priority first
+ *   Grid      : The layer grid built over the layer bounds (see FOBLayerGrid)
+ *   Configs   : Soft object path of every marker config, ordered by package name
+ *   Markers   : Static markers, in the saved marker format (see FOBMarkerSaveFormat)
+ *
+ * The project manifest carries the layers and configs and replaces the asset registry scans of the subsystem
+ * startup. A map manifest only carries the static markers of the level-placed points of interest of that map.
+ * Both are written by the OBNavigationManifest commandlet. The manifest directory is not an asset directory; the
+ * module stages it as a runtime dependency when it exists at build time (see OBNavigation.Build.cs and the README).
+ */
+struct FOBNavigationManifestFormat
+{
+	static constexpr uint32 Magic = 0x4D4E424F; // "OBNM"
+	static constexpr uint16 Version = 1;
+
+	// <ProjectContent>/OBNavigation/Manifests/Project.obnav
+	static OBNAVIGATION_API FString GetProjectManifestPath();
+
+	// <ProjectContent>/OBNavigation/Manifests/Maps/<MapPackageName>.obnav. Expects a map package name without PIE prefix.
+	static OBNAVIGATION_API FString GetMapManifestPath(const FString& MapPackageName);
+};
+
+/**
+ * @class FOBLayerGrid
+ * @brief Uniform XY grid answering "which is the highest priority layer containing this point".
+ * Every cell lists the layers overlapping it in priority order, so a lookup tests the bounds of a few layers instead
+ * of every layer of the project.
+ */
+class OBNAVIGATION_API FOBLayerGrid
+{
+public:
+	static constexpr int32 MaxCellsPerAxis = 64;
+
+	// Builds the grid. Bounds must be ordered by descending priority; FindLayer returns indices into this order.
+	void Build(TConstArrayView<FBox> InLayerBounds);
+
+	void Reset();
+
+	// Returns the index of the highest priority layer whose bounds contain the location in XY, or INDEX_NONE.
+	int32 FindLayer(const FVector& WorldLocation) const;
+
+	int32 GetNumLayers() const { return LayerBounds.Num(); }
+
+	void Write(FArchive& Ar) const;
+
+	// Reads a grid written by Write. Returns false, leaving the grid empty, if the data is truncated or inconsistent.
+	bool Read(FArchive& Ar);
+
+private:
+	TArray<FBox2D> LayerBounds;
+
+	FVector2D Origin = FVector2D::ZeroVector;
+	FVector2D InvCellSize = FVector2D::ZeroVector;
+	FIntPoint NumCells = FIntPoint::ZeroValue;
+
+	// Layers of cell i are CellLayers[CellStarts[i], CellStarts[i + 1])
+	TArray<uint32> CellStarts;
+	TArray<uint16> CellLayers;
+};
+
+/**
+ * @class FOBNavigationManifestWriter
+ * @brief Collects the layers, marker configs and static markers of a manifest and encodes them.
+ */
+class OBNAVIGATION_API FOBNavigationManifestWriter
+{
+public:
+	void AddLayer(const FSoftObjectPath& LayerPath, const FBox& WorldBounds, int32 Priority);
+
+	// Configs are written in the order they are added. The subsystem indexes them in package name order.
+	void AddMarkerConfig(const FSoftObjectPath& ConfigPath);
+
+	// Sets the static markers, encoded by FOBMarkerSaveWriter.
+	void SetStaticMarkers(TArray<uint8>&& InMarkerData);
+
+	// Encodes the manifest, replacing the contents of OutData. Layers are ordered by priority first.
+	void Write(TArray<uint8>& OutData) const;
+
+private:
+	struct FPendingLayer
+	{
+		FSoftObjectPath Path;
+		FBox WorldBounds;
+		int32 Priority;
+	};
+
+	TArray<FPendingLayer> Layers;
+	TArray<FSoftObjectPath> MarkerConfigs;
+	TArray<uint8> StaticMarkerData;
+};
+
+/**
+ * @class FOBNavigationManifestReader
+ * @brief Decodes a manifest. The static marker data is returned as a view of the source bytes, which must outlive
+ * the reader.
+ */
+class OBNAVIGATION_API FOBNavigationManifestReader
+{
+public:
+	// Calls Visitor with the contents of a manifest file, memory-mapped when the platform allows it.
+	// Returns false without calling Visitor if the file does not exist or cannot be read.
+	static bool VisitFile(const FString& FilePath, TFunctionRef<void(TArrayView<const uint8>)> Visitor);
+
+	// Validates the header and decodes the tables. Returns false if the data is truncated or has an unknown version.
+	bool Open(TArrayView<const uint8> InData);
+
+	// Layer paths and priorities, highest priority first (the order of the layer grid)
+	const TArray<FSoftObjectPath>& GetLayerPaths() const { return LayerPaths; }
+	const TArray<int32>& GetLayerPriorities() const { return LayerPriorities; }
+	const FOBLayerGrid& GetLayerGrid() const { return LayerGrid; }
+
+	const TArray<FSoftObjectPath>& GetMarkerConfigPaths() const { return MarkerConfigPaths; }
+
+	// Empty if the manifest has no static markers
+	TArrayView<const uint8> GetStaticMarkerData() const { return StaticMarkerData; }
+
+private:
+	TArray<FSoftObjectPath> LayerPaths;
+	TArray<int32> LayerPriorities;
+	FOBLayerGrid LayerGrid;
+	TArray<FSoftObjectPath> MarkerConfigPaths;
+	TArrayView<const uint8> StaticMarkerData;
+};
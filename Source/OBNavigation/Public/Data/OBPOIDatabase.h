@@ -0,0 +1,232 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/MappedFileHandle.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "UObject/SoftObjectPath.h"
+
+class UOBMarkerConfigAsset;
+
+/**
+ * Binary layout of a point of interest database (all values little-endian):
+ *   Header    : Magic, Version, header size, POI count, content hash, page grid (origin, page size, page counts)
+ *   Configs   : Soft object path (length-prefixed UTF-8) of every marker config used by the POIs
+ *   Layers    : Logical layer name (length-prefixed UTF-8) of every layer used by the POIs
+ *   Pages     : First POI and POI count of every page of the grid, row by row
+ *   Records   : Every POI as a FOBPOIRecord, grouped by page, starting at the header size (16-byte aligned)
+ *   IDs       : FGuid and POI index of every POI, ordered by FGuid
+ *
+ * Meant for large sets of static points of interest (collectibles, resource nodes...) that would cost too much as
+ * marker objects. Only the header, tables and page directory are read on open; the records of a page are mapped (or
+ * read) when the page is needed and released when it is evicted. A POI is identified by its index, stable for a given
+ * database build. The database is read-only; per-POI runtime state is kept by its owner (see
+ * UOBNavigationSubsystem::SetPOIHidden).
+ */
+struct FOBPOIDatabaseFormat
+{
+	static constexpr uint32 Magic = 0x4450424F; // "OBPD"
+	static constexpr uint16 Version = 1;
+
+	// Bounds the page directory to 256 KB
+	static constexpr int32 MaxPagesPerAxis = 128;
+
+	// <ProjectContent>/OBNavigation/Manifests/Maps/<MapPackageName>.obpoi, next to the map manifest.
+	// Expects a map package name without PIE prefix.
+	static OBNAVIGATION_API FString GetMapDatabasePath(const FString& MapPackageName);
+};
+
+/**
+ * @struct FOBPOIRecord
+ * @brief A point of interest as stored in a page, read in place from the mapped file.
+ */
+struct FOBPOIRecord
+{
+	float X = 0.0f;
+	float Y = 0.0f;
+	float Z = 0.0f;
+	uint16 ConfigIndex = 0; // Into the database's config table
+	uint16 LayerIndex = 0;  // Into the database's layer name table
+
+	FVector GetLocation() const { return FVector(X, Y, Z); }
+};
+
+static_assert(sizeof(FOBPOIRecord) == 16, "FOBPOIRecord is part of the POI database format");
+
+/**
+ * @struct FOBLightweightMarker
+ * @brief A resident point of interest as handed to the minimap. Never backed by a UOBMapMarker: it is rebuilt from
+ * the page records every time it is gathered (see UOBNavigationSubsystem::GatherLightweightMarkers).
+ */
+struct FOBLightweightMarker
+{
+	FVector WorldLocation = FVector::ZeroVector;
+	const UOBMarkerConfigAsset* Config = nullptr;
+	FName LayerName;
+	int32 POIIndex = INDEX_NONE;
+};
+
+/**
+ * @class FOBPOIDatabaseWriter
+ * @brief Collects points of interest and encodes them into a paged database.
+ */
+class OBNAVIGATION_API FOBPOIDatabaseWriter
+{
+public:
+	// Returns false, skipping the POI, if its ID was already added or its config or layer table is full.
+	bool AddPOI(const FGuid& ID, const FSoftObjectPath& ConfigPath, FName LayerName, const FVector& WorldLocation);
+
+	int32 GetNumPOIs() const { return POIs.Num(); }
+
+	/**
+	 * @brief Encodes the database, replacing the contents of OutData.
+	 * @param PageSize Side (in world units) of a square page. Grown if the POI bounds would need more than
+	 * MaxPagesPerAxis pages along an axis.
+	 */
+	void Write(TArray<uint8>& OutData, double PageSize) const;
+
+private:
+	struct FPendingPOI
+	{
+		FGuid ID;
+		FVector Location;
+		uint16 ConfigIndex;
+		uint16 LayerIndex;
+	};
+
+	TArray<FPendingPOI> POIs;
+	TSet<FGuid> AddedIDs;
+	TArray<FSoftObjectPath> ConfigPaths;
+	TMap<FSoftObjectPath, uint16> ConfigIndices;
+	TArray<FName> LayerNames;
+	TMap<FName, uint16> LayerIndices;
+};
+
+/**
+ * @class FOBPOIDatabase
+ * @brief Read-only view of a POI database file keeping only the pages around the regions of interest resident.
+ * Pages are memory-mapped when the platform allows it, otherwise read from an open file handle. Game thread only.
+ */
+class OBNAVIGATION_API FOBPOIDatabase
+{
+public:
+	FOBPOIDatabase() = default;
+	~FOBPOIDatabase();
+	UE_NONCOPYABLE(FOBPOIDatabase);
+
+	// Reads the header, tables and page directory. Returns false, leaving the database closed, if the file does not
+	// exist, is corrupt or has an unknown version.
+	bool Open(const FString& FilePath);
+
+	// Releases every page and the file.
+	void Close();
+
+	bool IsOpen() const { return MappedFile.IsValid() || FileHandle.IsValid(); }
+
+	int32 GetNumPOIs() const { return static_cast<int32>(NumPOIs); }
+
+	// Hash of the records and IDs. Runtime state saved against one build is only valid for the same hash.
+	uint32 GetContentHash() const { return ContentHash; }
+
+	const TArray<FSoftObjectPath>& GetConfigPaths() const { return ConfigPaths; }
+	const TArray<FName>& GetLayerNames() const { return LayerNames; }
+
+	// Returns the index of a POI from its ID, or INDEX_NONE. Binary search in the ID table.
+	int32 FindPOI(const FGuid& ID) const;
+
+	/**
+	 * @brief Makes the pages overlapping Regions resident and evicts the least recently used pages beyond
+	 * MaxResidentPages. Pages of earlier regions are loaded first; at most MaxPageLoads pages are loaded per call, the
+	 * others on the following calls.
+	 * @return The number of pages loaded.
+	 */
+	int32 UpdateResidentPages(TConstArrayView<FBox2D> Regions, int32 MaxResidentPages, int32 MaxPageLoads);
+
+	int32 GetNumResidentPages() const { return ResidentPages.Num(); }
+
+	/**
+	 * @brief Calls Func(int32 POIIndex, const FOBPOIRecord& Record) for every POI of the resident pages overlapping
+	 * Region whose location is inside it. POIs of pages that are not resident are skipped.
+	 */
+	template <typename FuncType>
+	void ForEachResidentPOI(const FBox2D& Region, FuncType&& Func) const
+	{
+		const FIntRect PageRect = GetPageRect(Region);
+		for (int32 PageY = PageRect.Min.Y; PageY < PageRect.Max.Y; ++PageY)
+		{
+			for (int32 PageX = PageRect.Min.X; PageX < PageRect.Max.X; ++PageX)
+			{
+				const int32 PageIndex = PageY * NumPages.X + PageX;
+				const FResidentPage* Page = ResidentPages.Find(PageIndex);
+				if (!Page)
+				{
+					continue;
+				}
+
+				const FPageEntry& Entry = Pages[PageIndex];
+				for (uint32 Index = 0; Index < Entry.NumPOIs; ++Index)
+				{
+					const FOBPOIRecord& Record = Page->Records[Index];
+					if (Record.X >= Region.Min.X && Record.X <= Region.Max.X && Record.Y >= Region.Min.Y &&
+						Record.Y <= Region.Max.Y)
+					{
+						Func(static_cast<int32>(Entry.FirstPOI + Index), Record);
+					}
+				}
+			}
+		}
+	}
+
+private:
+	struct FPageEntry
+	{
+		uint32 FirstPOI = 0;
+		uint32 NumPOIs = 0;
+	};
+
+	struct FResidentPage
+	{
+		// Exactly one of the two holds the records
+		TUniquePtr<IMappedFileRegion> MappedRegion;
+		TArray<uint8> Data;
+
+		const FOBPOIRecord* Records = nullptr;
+		uint64 LastUsed = 0;
+	};
+
+	// Pages overlapping a region, clamped to the grid. Max is exclusive.
+	FIntRect GetPageRect(const FBox2D& Region) const;
+
+	// Maps or reads the records of a page. Returns false if the file could not be read.
+	bool LoadPage(int32 PageIndex, FResidentPage& OutPage) const;
+
+	// Releases the least recently used page not used since UseStamp. Returns false if every page is in use.
+	bool EvictLeastRecentlyUsedPage(uint64 UseStamp);
+
+	// Exactly one of the two is valid while the database is open
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IFileHandle> FileHandle;
+	FString FilePath;
+
+	FVector2D Origin = FVector2D::ZeroVector;
+	double InvPageSize = 0.0;
+	FIntPoint NumPages = FIntPoint::ZeroValue;
+	int64 RecordsOffset = 0;
+	uint32 NumPOIs = 0;
+	uint32 ContentHash = 0;
+
+	TArray<FSoftObjectPath> ConfigPaths;
+	TArray<FName> LayerNames;
+	TArray<FPageEntry> Pages;
+	TBitArray<> UnreadablePages; // Pages that failed to load once are not retried
+
+	// The ID table: mapped when the records are, read at open otherwise
+	TUniquePtr<IMappedFileRegion> IDRegion;
+	TArray<uint8> IDData;
+	TArrayView<const uint8> IDTable;
+
+	// Keyed by page index
+	TMap<int32, FResidentPage> ResidentPages;
+	uint64 UseCounter = 0;
+};
@@ -0,0 +1,56 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "OBPOISetAsset.generated.h"
+
+class UOBMarkerConfigAsset;
+class UWorld;
+
+/**
+ * @struct FOBPOISetEntry
+ * @brief A point of interest authored without an actor.
+ */
+USTRUCT(BlueprintType)
+struct FOBPOISetEntry
+{
+	GENERATED_BODY()
+
+	// Identifies the POI in its map (see UOBPOISetAsset). Must not be shared with another entry or with an actor of
+	// the map.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Point of Interest")
+	FName Name;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Point of Interest")
+	TObjectPtr<UOBMarkerConfigAsset> Config;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Point of Interest")
+	FName LayerName = TEXT("PointsOfInterest");
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Point of Interest")
+	FVector Location = FVector::ZeroVector;
+};
+
+/**
+ * @class UOBPOISetAsset
+ * @brief Points of interest of a map authored as data (e.g., imported collectibles or resource nodes), for sets too
+ * large to be placed as actors. The OBNavigationManifest commandlet bakes every set of a map into its POI database;
+ * the asset itself is editor-only and never cooked, so no object is loaded at runtime for these points of interest.
+ * The POI ID of an entry is UOBPointOfInterestComponent::MakeMarkerID(<Map package name>, Name).
+ */
+UCLASS(BlueprintType)
+class OBNAVIGATION_API UOBPOISetAsset : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool IsEditorOnly() const override { return true; }
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Points of Interest")
+	TSoftObjectPtr<UWorld> Map;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Points of Interest")
+	TArray<FOBPOISetEntry> POIs;
+};
@@ -0,0 +1,49 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "OBProxyMarkerSetAsset.generated.h"
+
+class AActor;
+class UOBMarkerConfigAsset;
+
+/**
+ * @struct FOBProxyMarkerEntry
+ * @brief A marker for an actor that may live in an unloaded World Partition cell.
+ */
+USTRUCT(BlueprintType)
+struct FOBProxyMarkerEntry
+{
+	GENERATED_BODY()
+
+	// The actor the marker follows while it is loaded
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Proxy Marker")
+	TSoftObjectPtr<AActor> Actor;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Proxy Marker")
+	TObjectPtr<UOBMarkerConfigAsset> Config;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Proxy Marker")
+	FName LayerName;
+
+	// Where the marker is shown until the actor has been loaded once (usually the actor's authored location)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Proxy Marker")
+	FVector Location = FVector::ZeroVector;
+};
+
+/**
+ * @class UOBProxyMarkerSetAsset
+ * @brief Proxy markers authored or baked for a map (e.g., every vendor and resource node of a World Partition level).
+ * Registered as a whole with UOBNavigationSubsystem::RegisterProxyMarkerSet.
+ */
+UCLASS(BlueprintType)
+class OBNAVIGATION_API UOBProxyMarkerSetAsset : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Proxy Markers")
+	TArray<FOBProxyMarkerEntry> Markers;
+};
@@ -0,0 +1,78 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OBAreaMarker.generated.h"
+
+UENUM(BlueprintType)
+enum class EOBAreaShape : uint8
+{
+	Circle,
+	Rectangle,
+	Polygon
+};
+
+/**
+ * @struct FOBAreaMarkerStyle
+ * @brief How an area marker is drawn on the minimap.
+ */
+USTRUCT(BlueprintType)
+struct FOBAreaMarkerStyle
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Area Marker")
+	FLinearColor FillColor = FLinearColor(1.0f, 0.2f, 0.2f, 0.25f);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Area Marker")
+	FLinearColor OutlineColor = FLinearColor(1.0f, 0.2f, 0.2f, 0.8f);
+
+	// Thickness (in pixels) of the outline. 0 draws no outline.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Area Marker", meta = (ClampMin = "0.0"))
+	float OutlineThickness = 2.0f;
+};
+
+/**
+ * @struct FOBAreaMarker
+ * @brief A zone on the map (capture zone, safe circle, danger area), as opposed to a point marker.
+ * The outline is built once in local world units around the center. Moving or resizing the area only animates its
+ * center and scale, so the outline and its triangulation are never rebuilt; for circles, the scale is the radius.
+ */
+struct OBNAVIGATION_API FOBAreaMarker
+{
+	// Number of outline points of a circle
+	static constexpr int32 NumCircleSegments = 64;
+
+	EOBAreaShape Shape = EOBAreaShape::Circle;
+	FOBAreaMarkerStyle Style;
+
+	// Outline in world XY units relative to the center, at scale 1
+	TArray<FVector2D> LocalOutline;
+	// Three indices into LocalOutline per triangle. Polygons only: circles and rectangles are convex.
+	TArray<int32> TriangleIndices;
+
+	// Center and scale are interpolated from the start to the target values over the animation (world time)
+	FVector2D StartCenter = FVector2D::ZeroVector;
+	FVector2D TargetCenter = FVector2D::ZeroVector;
+	double StartScale = 1.0;
+	double TargetScale = 1.0;
+	double AnimationStartTime = 0.0;
+	double AnimationDuration = 0.0;
+
+	static FOBAreaMarker MakeCircle(const FVector2D& Center, double Radius);
+	static FOBAreaMarker MakeRectangle(const FVector2D& Center, const FVector2D& HalfExtents, double Yaw);
+	// Returns an area without outline if the polygon cannot be triangulated (e.g., it intersects itself).
+	static FOBAreaMarker MakePolygon(TConstArrayView<FVector2D> WorldPoints);
+
+	bool IsValid() const { return LocalOutline.Num() >= 3; }
+	bool IsConvex() const { return Shape != EOBAreaShape::Polygon; }
+
+	// Center and scale at the given world time
+	void Evaluate(double Time, FVector2D& OutCenter, double& OutScale) const;
+
+	// Starts moving and resizing from the current state (at Time) to the target. A zero duration snaps immediately.
+	void Animate(double Time, const FVector2D& InTargetCenter, double InTargetScale, double Duration);
+
+	bool IsInside(const FVector& WorldLocation, double Time) const;
+};
@@ -0,0 +1,94 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "OBExplorationMask.generated.h"
+
+class UOBMapLayerAsset;
+class UTexture2D;
+
+/**
+ * @class UOBExplorationMask
+ * @brief Per map layer fog-of-war bitmask. One bit per exploration cell.
+ * Cells are laid out exactly like the layer's map UVs (columns follow world +Y, rows follow world -X),
+ * so the mask texture can be sampled with the same UVs as the map texture.
+ * Only the cells touched since the last flush are uploaded to the GPU.
+ */
+UCLASS(BlueprintType)
+class OBNAVIGATION_API UOBExplorationMask : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	// Largest supported grid size per axis. Cell size is increased if the layer would need more.
+	static constexpr int32 MaxGridSize = 4096;
+
+	// Sets up the grid from the layer's bounds (as used by the subsystem, see GetLayerBounds) and cell size.
+	// Clears any existing exploration state.
+	void Init(const UOBMapLayerAsset* InLayer, const FBox& InWorldBounds);
+
+	/**
+	 * @brief Marks every cell whose center lies within the given circle as explored.
+	 * @param WorldLocation Center of the revealed area.
+	 * @param Radius Radius of the revealed area in world units.
+	 * @return True if at least one cell was newly explored.
+	 */
+	bool RevealCircle(const FVector& WorldLocation, float Radius);
+
+	// Returns the cell containing the world location, or (-1, -1) if it lies outside the layer bounds.
+	FIntPoint WorldToCell(const FVector& WorldLocation) const;
+
+	// Returns the world location (Z = 0) of the center of a cell.
+	FVector GetCellCenter(const FIntPoint& Cell) const;
+
+	UFUNCTION(BlueprintPure, Category = "OBNavigation|Exploration")
+	bool IsExplored(const FVector& WorldLocation) const;
+
+	// Fraction (0-1) of the layer that has been explored.
+	UFUNCTION(BlueprintPure, Category = "OBNavigation|Exploration")
+	float GetExploredFraction() const;
+
+	// Forgets all explored cells.
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Exploration")
+	void ResetExploration();
+
+	// Returns the mask texture (white = explored), creating it on first use.
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Exploration")
+	UTexture2D* GetMaskTexture();
+
+	// Uploads the cells changed since the last flush. Does nothing if the texture has never been requested.
+	void FlushTextureUpdates();
+
+	// Writes the explored bits as run-length encoded data, suitable for save games.
+	void SaveRLE(TArray<uint8>& OutData) const;
+
+	// Restores the explored bits from SaveRLE data. Fails if the data was saved for a different grid size.
+	bool LoadRLE(const TArray<uint8>& InData);
+
+	FIntPoint GetGridSize() const { return GridSize; }
+
+private:
+	void MarkDirty(const FIntPoint& Cell);
+	void MarkAllDirty();
+
+	FIntPoint GridSize = FIntPoint::ZeroValue;
+
+	// World bounds of the layer (XY only) and the world size of one cell along each axis.
+	FVector2D BoundsMin = FVector2D::ZeroVector;
+	FVector2D BoundsMax = FVector2D::ZeroVector;
+	double CellSizeX = 1.0; // World X per row
+	double CellSizeY = 1.0; // World Y per column
+
+	// Row-major bits, Index = Row * GridSize.X + Column
+	TBitArray<> ExploredBits;
+	int32 ExploredCount = 0;
+
+	// Region (in cells, max exclusive) changed since the last texture upload
+	FIntRect DirtyRect;
+	bool bHasDirtyCells = false;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UTexture2D> MaskTexture;
+};
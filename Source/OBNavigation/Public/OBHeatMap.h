@@ -0,0 +1,125 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "OBHeatMap.generated.h"
+
+class UOBMapLayerAsset;
+class UTexture2D;
+
+/**
+ * @struct FOBHeatMapEvent
+ * @brief A single contribution to a heat map (e.g., a kill, a death, a pawn passing by).
+ */
+USTRUCT(BlueprintType)
+struct FOBHeatMapEvent
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Heat Map")
+	FVector Location = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Heat Map")
+	float Weight = 1.0f;
+
+	// Heat map channel, stored in the R, G, B or A component of the texture (e.g., kills, deaths, traffic).
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Heat Map", meta = (ClampMin = "0", ClampMax = "3"))
+	int32 Channel = 0;
+};
+
+/**
+ * @class UOBHeatMap
+ * @brief Per map layer event density grid with up to four channels, fading out with a half-life.
+ * Cells are laid out like the layer's map UVs, same as UOBExplorationMask.
+ *
+ * Decay is never applied per cell per frame. Heat is stored relative to a shared epoch: an event adds its weight scaled
+ * up by the decay since the epoch, and reading scales down by the decay until now. The texture holds the same values,
+ * and the minimap material applies the decay with a single scalar (GetTextureScale). Once the decay since the epoch
+ * reaches a half-life, the next batch rebases every cell onto a new epoch and the whole texture is uploaded; otherwise
+ * only the tiles touched since the last flush are uploaded. Without events, nothing is done at all.
+ */
+UCLASS(BlueprintType)
+class OBNAVIGATION_API UOBHeatMap : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	static constexpr int32 NumChannels = 4;
+
+	// Largest supported grid size per axis. Cell size is increased if the layer would need more.
+	static constexpr int32 MaxGridSize = 1024;
+
+	// Size (in cells) of the tiles tracked for partial uploads
+	static constexpr int32 TileSize = 32;
+
+	// Sets up the grid from the layer's bounds (as used by the subsystem, see GetLayerBounds) and heat map settings.
+	// Clears any existing heat.
+	void Init(const UOBMapLayerAsset* InLayer, const FBox& InWorldBounds, double InTime);
+
+	/**
+	 * @brief Accumulates a batch of events. Events outside the layer bounds or with an invalid channel are ignored.
+	 * @param InTime The current world time.
+	 * @return The number of events accumulated.
+	 */
+	int32 AddEvents(TConstArrayView<FOBHeatMapEvent> Events, double InTime);
+
+	// Returns the cell containing the world location, or (-1, -1) if it lies outside the layer bounds.
+	FIntPoint WorldToCell(const FVector& WorldLocation) const;
+
+	// Gets the decayed heat of a channel at a world location.
+	UFUNCTION(BlueprintPure, Category = "OBNavigation|Heat Map")
+	float GetHeat(const FVector& WorldLocation, int32 Channel, double InTime) const;
+
+	// Forgets all heat.
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Heat Map")
+	void ResetHeat();
+
+	// Returns the heat texture, creating it on first use. Texel = heat at the texture epoch / (2 * saturation).
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Heat Map")
+	UTexture2D* GetHeatTexture();
+
+	// The material multiplies the texture by this (and saturates) to get the heat at InTime in the 0-1 range.
+	float GetTextureScale(double InTime) const;
+
+	// Uploads the tiles changed since the last flush. Does nothing if the texture has never been requested.
+	void FlushTextureUpdates();
+
+	FIntPoint GetGridSize() const { return GridSize; }
+
+private:
+	// Decay factor between the epoch and InTime (1 without decay)
+	double GetDecay(double InTime) const;
+
+	// Moves the epoch to InTime, decaying every cell once.
+	void Rebase(double InTime);
+
+	void MarkDirty(const FIntPoint& Cell);
+	void MarkAllDirty();
+
+	FIntPoint GridSize = FIntPoint::ZeroValue;
+	FIntPoint NumTiles = FIntPoint::ZeroValue;
+
+	// World bounds of the layer (XY only) and the world size of one cell along each axis.
+	FVector2D BoundsMin = FVector2D::ZeroVector;
+	FVector2D BoundsMax = FVector2D::ZeroVector;
+	double CellSizeX = 1.0; // World X per row
+	double CellSizeY = 1.0; // World Y per column
+
+	// Decay rate (ln 2 / half-life), 0 for heat that never fades
+	double DecayRate = 0.0;
+	// Heat at which a cell shows at full intensity
+	float Saturation = 1.0f;
+
+	// Row-major heat at the epoch, channels interleaved: Index = (Row * GridSize.X + Column) * NumChannels + Channel
+	TArray<float> Heat;
+	double Epoch = 0.0;
+
+	// One bit per tile changed since the last texture upload
+	TBitArray<> DirtyTiles;
+	bool bHasDirtyTiles = false;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UTexture2D> HeatTexture;
+};
@@ -0,0 +1,149 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "UObject/Object.h"
+#include "OBMapBake.generated.h"
+
+class UOBMapLayerAsset;
+class UTexture2D;
+class UWorld;
+
+/**
+ * @struct FOBMapBakeSettings
+ * @brief How a map layer image is rasterized from the world.
+ */
+USTRUCT(BlueprintType)
+struct OBNAVIGATION_API FOBMapBakeSettings
+{
+	GENERATED_BODY()
+
+	// Pixels along the longer side of the layer. The other side follows the aspect ratio of the bounds, so pixels are square.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Map Bake", meta = (ClampMin = "16", ClampMax = "8192"))
+	int32 Resolution = 1024;
+
+	// If true, the layer is mapped to the navigable area (or the level bounds without a navmesh) instead of its
+	// WorldBounds. Meant for layers whose bounds were never authored, e.g., a generated dungeon. At runtime the fitted
+	// bounds only override the layer's bounds in the subsystem; the OBMapBake commandlet saves them to the asset.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Map Bake")
+	bool bFitBounds = false;
+
+	// Margin (in world units) added around fitted bounds.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Map Bake", meta = (EditCondition = "bFitBounds", ClampMin = "0.0"))
+	float BoundsPadding = 500.0f;
+
+	// If true, the ground (collision and landscape) is shaded by height from one downward trace per pixel.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Map Bake|Height")
+	bool bTraceHeight = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Map Bake|Height", meta = (EditCondition = "bTraceHeight"))
+	TEnumAsByte<ECollisionChannel> TraceChannel = ECC_WorldStatic;
+
+	// Colors of the lowest and highest ground of the layer. Steep surfaces are darkened.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Map Bake|Height", meta = (EditCondition = "bTraceHeight"))
+	FColor LowColor = FColor(38, 40, 46);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Map Bake|Height", meta = (EditCondition = "bTraceHeight"))
+	FColor HighColor = FColor(196, 192, 178);
+
+	// If true, the walkable navmesh polygons are blended over the ground.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Map Bake|Nav Mesh")
+	bool bDrawNavMesh = true;
+
+	// Color of the walkable area. Alpha is the blend weight over the ground.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Map Bake|Nav Mesh", meta = (EditCondition = "bDrawNavMesh"))
+	FColor WalkableColor = FColor(92, 156, 214, 140);
+
+	// Color of pixels with neither ground nor navmesh.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Map Bake")
+	FColor EmptyColor = FColor(0, 0, 0, 0);
+};
+
+/**
+ * @class UOBMapBake
+ * @brief Top-down image of a map layer, rasterized on the CPU from the world's collision and navmesh.
+ * Pixels are laid out exactly like the layer's map UVs (columns follow world +Y, rows follow world -X), and the image
+ * is kept on the CPU so a change in the world only re-rasterizes and uploads the pixels it covers.
+ */
+UCLASS(BlueprintType)
+class OBNAVIGATION_API UOBMapBake : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	// Largest supported image size per axis.
+	static constexpr int32 MaxImageSize = 8192;
+
+	/**
+	 * @brief Computes bounds covering the navigable area of the world, or its persistent level without a navmesh.
+	 * @return Invalid bounds if the world has neither.
+	 */
+	static FBox ComputeFitBounds(UWorld* World, float Padding);
+
+	/**
+	 * @brief Sets up the image for the given bounds of the layer and rasterizes all of it.
+	 * Issues one trace per pixel when tracing height, so this is a loading-time (or offline) operation.
+	 * @param InWorldBounds The bounds the layer's map UVs are computed from, fitted or the layer's WorldBounds.
+	 * @return False if the bounds are not usable.
+	 */
+	bool Bake(UWorld* InWorld, const UOBMapLayerAsset* InLayer, const FBox& InWorldBounds,
+	          const FOBMapBakeSettings& InSettings);
+
+	/**
+	 * @brief Rasterizes the pixels covered by a world box again and uploads only them.
+	 * Heights keep the range found by the full bake, so patched pixels match their neighbors.
+	 * @param DirtyBounds The changed area (XY; Z is ignored), e.g., the bounds of a destroyed bridge.
+	 */
+	void Patch(const FBox& DirtyBounds);
+
+	// Returns the image as a texture, creating it on first use.
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Map Bake")
+	UTexture2D* GetTexture();
+
+	// Rows of BGRA pixels, Index = Row * GetImageSize().X + Column.
+	const TArray<FColor>& GetPixels() const { return Pixels; }
+	FIntPoint GetImageSize() const { return ImageSize; }
+
+private:
+	// Rasterizes a region (in pixels, max exclusive). bFitHeightRange is only set for the full bake.
+	void Rasterize(const FIntRect& Region, bool bFitHeightRange);
+	void TraceHeights(const FIntRect& Region, bool bFitHeightRange);
+	void RasterizeNavMesh(const FIntRect& Region);
+	void UploadRegion(const FIntRect& Region);
+
+	// Pixel region covering a world box, clamped to the image. Empty if the box lies outside the bounds.
+	FIntRect WorldBoxToRegion(const FBox& WorldBox) const;
+	FVector2D WorldToPixel(const FVector& WorldLocation) const;
+	FVector2D GetPixelCenter(int32 Column, int32 Row) const;
+
+	TWeakObjectPtr<UWorld> World;
+	FOBMapBakeSettings Settings;
+
+	FIntPoint ImageSize = FIntPoint::ZeroValue;
+
+	// World bounds of the layer (XY) and the world size of one pixel along each axis
+	FVector2D BoundsMin = FVector2D::ZeroVector;
+	FVector2D BoundsMax = FVector2D::ZeroVector;
+	double PixelSizeX = 1.0; // World X per row
+	double PixelSizeY = 1.0; // World Y per column
+
+	// Vertical range traced and searched for navmesh polygons
+	double MinZ = 0.0;
+	double MaxZ = 0.0;
+
+	// Ground heights mapped to LowColor and HighColor
+	double LowHeight = 0.0;
+	double HighHeight = 1.0;
+
+	TArray<FColor> Pixels;
+
+	// Per-region scratch, kept between patches to avoid reallocating
+	TArray<float> SampleHeights;
+	TArray<float> SampleSlopes;
+	TBitArray<> WalkableBits;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UTexture2D> Texture;
+};
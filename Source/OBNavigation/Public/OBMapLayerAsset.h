@@ -32,4 +32,43 @@ public:
 	// when the player is inside the dungeon's WorldBounds.
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Map Layer")
 	int32 Priority = 0;
+
+	// --- EXPLORATION (FOG OF WAR) ---
+
+	// If true, unexplored parts of this layer stay hidden on the minimap until a revealer passes near them.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Exploration")
+	bool bEnableExploration = false;
+
+	// World size (in units) of a single exploration cell. Smaller cells give smoother edges but a bigger mask.
+	// The cell is stretched slightly so that a whole number of cells covers WorldBounds.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Exploration",
+		meta = (EditCondition = "bEnableExploration", ClampMin = "10.0"))
+	float ExplorationCellSize = 500.0f;
+
+	// Radius (in world units) revealed around the tracked player pawn while it is on this layer.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Exploration",
+		meta = (EditCondition = "bEnableExploration", ClampMin = "0.0"))
+	float PlayerRevealRadius = 2000.0f;
+
+	// --- HEAT MAP ---
+
+	// If true, events submitted to the navigation subsystem (kills, deaths, traffic...) accumulate into a heat map
+	// that the minimap material can blend over this layer.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Heat Map")
+	bool bEnableHeatMap = false;
+
+	// World size (in units) of a single heat map cell. Heat maps are meant to be coarse.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Heat Map",
+		meta = (EditCondition = "bEnableHeatMap", ClampMin = "50.0"))
+	float HeatMapCellSize = 1000.0f;
+
+	// Time (in seconds) for the heat of a cell to halve. 0 keeps the heat forever.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Heat Map",
+		meta = (EditCondition = "bEnableHeatMap", ClampMin = "0.0"))
+	float HeatMapHalfLife = 60.0f;
+
+	// Heat (sum of event weights) at which a cell is shown at full intensity.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Heat Map",
+		meta = (EditCondition = "bEnableHeatMap", ClampMin = "0.01"))
+	float HeatMapSaturation = 10.0f;
 };
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
 #include "UObject/Object.h"
 #include "OBMapMarker.generated.h"
 
@@ -25,6 +26,11 @@ struct FMarkerVisibilityOptions
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Visibility")
 	bool bShowOnCompass = false;
 
+	// Only show the marker while its tracked actor is in line of sight of an observer (the tracked pawn or a registered
+	// teammate, see UOBNavigationSubsystem::RegisterLineOfSightObserver), e.g., for enemy players in competitive modes.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Visibility")
+	bool bRequiresLineOfSight = false;
+
 	FMarkerVisibilityOptions(const bool bShowOnMinimap, const bool bShowOnFullMap, const bool bShowOnCompass)
 		: bShowOnMinimap(bShowOnMinimap),
 		  bShowOnFullMap(bShowOnFullMap),
@@ -37,21 +43,138 @@ struct FMarkerVisibilityOptions
 	}
 };
 
+/**
+ * @struct FOBMarkerAnimation
+ * @brief Animation of a marker's identifier icon, evaluated on the GPU by the icon's material.
+ * The CPU only sends the timing when the marker appears or its expiry changes (see UOBMapMarker::StartAnimation),
+ * never per frame. The material reads the scalar parameters below and the Time node, and computes the icon's scale and
+ * opacity itself:
+ *   IconTexture (texture), AnimStartTime, AnimEndTime (0 if the marker does not expire),
+ *   PopDuration, PopStartScale, PulsePeriod, PulseMinScale, FadeOutDuration.
+ * Times are in the clock of the Time node of UI materials. A duration or period of 0 means the effect is off.
+ */
+USTRUCT(BlueprintType)
+struct FOBMarkerAnimation
+{
+	GENERATED_BODY()
+
+	// UI material drawing the identifier icon in place of its texture. Without it the marker is not animated.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Animation", meta = (AssetBundles = "Icons"))
+	TSoftObjectPtr<UMaterialInterface> Material;
+
+	// Grow the icon in when the marker appears
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Animation")
+	bool bSpawnPop = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Animation",
+		meta = (EditCondition = "bSpawnPop", ClampMin = "0.01"))
+	float PopDuration = 0.25f;
+
+	// Scale the icon grows from, relative to its full size
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Animation",
+		meta = (EditCondition = "bSpawnPop", ClampMin = "0.0", ClampMax = "1.0"))
+	float PopStartScale = 0.3f;
+
+	// Breathe between PulseMinScale and full size for as long as the marker exists (e.g., objectives)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Animation")
+	bool bPulse = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Animation",
+		meta = (EditCondition = "bPulse", ClampMin = "0.05"))
+	float PulsePeriod = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Animation",
+		meta = (EditCondition = "bPulse", ClampMin = "0.0", ClampMax = "1.0"))
+	float PulseMinScale = 0.8f;
+
+	// Fade the icon out over the last FadeOutDuration seconds of the marker's lifetime (e.g., pings)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Animation")
+	bool bFadeOut = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Animation",
+		meta = (EditCondition = "bFadeOut", ClampMin = "0.01"))
+	float FadeOutDuration = 1.0f;
+
+	bool IsAnimated() const { return !Material.IsNull() && (bSpawnPop || bPulse || bFadeOut); }
+};
+
+/**
+ * @struct FOBMarkerDeadReckoning
+ * @brief Extrapolation of markers whose position is only known from sparse samples, e.g., replicated actors with a
+ * low net update rate or remote units fed through UOBNavigationSubsystem::SetMarkerPositionSample.
+ * Between samples the marker moves along the last sampled velocity. When a new sample disagrees with the position
+ * shown, the error is blended out over CorrectionTime, or dropped at once if it exceeds SnapDistance. The blend decays
+ * continuously rather than restarting with each sample, so a marker fed every frame still follows its source.
+ */
+USTRUCT(BlueprintType)
+struct FOBMarkerDeadReckoning
+{
+	GENERATED_BODY()
+
+	// Extrapolate between position samples instead of showing the last one. A tracked actor yields a sample whenever
+	// its location changes (e.g., a replication update arrives).
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Dead Reckoning")
+	bool bEnabled = false;
+
+	// Estimate the velocity of tracked actors from their last two samples instead of using their velocity. For actors
+	// that do not replicate a velocity. An actor that has not moved for longer than its last sample interval is taken
+	// as stopped, so the marker overshoots by at most one interval of movement and then settles back on it.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Dead Reckoning", meta = (EditCondition = "bEnabled"))
+	bool bDeriveVelocity = false;
+
+	// Seconds after the last sample during which the marker keeps moving. It then holds its position, which bounds
+	// the error when samples stop (e.g., the actor lost relevancy). Should cover a couple of sample intervals.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Dead Reckoning",
+		meta = (EditCondition = "bEnabled", ClampMin = "0.0"))
+	float MaxExtrapolationTime = 1.0f;
+
+	// Seconds over which the error between the shown and the sampled position is blended out (95% of it; the blend
+	// is exponential, so errors of consecutive samples add up instead of restarting it)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Dead Reckoning",
+		meta = (EditCondition = "bEnabled", ClampMin = "0.0"))
+	float CorrectionTime = 0.25f;
+
+	// Errors longer than this (in world units) snap immediately, e.g., a teleport or a respawn
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Dead Reckoning",
+		meta = (EditCondition = "bEnabled", ClampMin = "0.0"))
+	float SnapDistance = 2000.0f;
+};
+
+/**
+ * @class UOBMarkerConfigAsset
+ * @brief Appearance and behavior shared by every marker of a kind (e.g., "Vendor", "Ping").
+ * Registered as a primary asset. Icon resources are soft references in the "Icons" bundle, loaded asynchronously by
+ * UOBNavigationSubsystem when the first marker using the config registers.
+ */
 UCLASS(BlueprintType)
-class OBNAVIGATION_API UOBMarkerConfigAsset : public UDataAsset
+class OBNAVIGATION_API UOBMarkerConfigAsset : public UPrimaryDataAsset
 {
 	GENERATED_BODY()
 
 public:
+	// Primary asset type of marker configs (e.g., for the Asset Manager settings)
+	static const FPrimaryAssetType PrimaryAssetType;
+
+	// Asset bundle holding the icon resources
+	static const FName IconBundleName;
+
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+
+	// Whether every icon resource that is set is resident. Markers are not displayed until it is.
+	bool AreIconsLoaded() const;
+
+	// Appends the paths of the icon resources that are set.
+	void GetIconPaths(TArray<FSoftObjectPath>& OutPaths) const;
+
 	// The icon that identifies the object (e.g., a quest exclamation mark, a player number).
 	// This part will NOT rotate.
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Marker Config")
-	TObjectPtr<UTexture2D> IdentifierIconTexture;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Marker Config", meta = (AssetBundles = "Icons"))
+	TSoftObjectPtr<UTexture2D> IdentifierIconTexture;
 
 	// The icon that indicates the direction (e.g., an arrow, a cone).
 	// This part WILL rotate. If null, no directional indicator will be shown.
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Marker Config")
-	TObjectPtr<UMaterialInterface> IndicatorMaterial;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Marker Config", meta = (AssetBundles = "Icons"))
+	TSoftObjectPtr<UMaterialInterface> IndicatorMaterial;
 
 	// The pivot point for the Directional Indicator's rotation, in normalized 0-1 space.
 	// (0.5, 0.5) is the center. (0.5, 0.0) is the top-center edge.
@@ -67,9 +190,29 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Marker Config")
 	FMarkerVisibilityOptions Visibility = FMarkerVisibilityOptions(true, true, true);
 
+	// Show a text label under the marker on the minimap. Overlapping labels are culled by priority.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Label")
+	bool bShowLabel = false;
+
+	// Text of markers without a label of their own (see UOBNavigationSubsystem::SetMarkerLabel), e.g., a POI name
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Label", meta = (EditCondition = "bShowLabel"))
+	FText DefaultLabel;
+
+	// Where labels overlap, the higher priority one is shown. Equal priorities keep the marker registration order.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Label", meta = (EditCondition = "bShowLabel"))
+	int32 LabelPriority = 0;
+
 	// Optional: For markers that should disappear after a duration (like pings)
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Marker Config")
 	float LifeTime = 0.0f; // 0.0 means infinite
+
+	// Spawn pop, pulse and fade-out of the identifier icon, evaluated by its material
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Animation")
+	FOBMarkerAnimation Animation;
+
+	// Smooth movement from sparse position updates (remote teammates, vehicles)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Dead Reckoning")
+	FOBMarkerDeadReckoning DeadReckoning;
 };
 
 /**
@@ -95,6 +238,11 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category="Marker")
 	TWeakObjectPtr<AActor> TrackedActor;
 
+	// Optional: The actor this marker stands in for while it is not loaded (e.g., its World Partition cell is unloaded).
+	// TrackedActor is bound to it while it is loaded; otherwise WorldLocation stays at its last known position.
+	UPROPERTY(BlueprintReadOnly, Category="Marker")
+	TSoftObjectPtr<AActor> ProxyActor;
+
 	// The configuration asset that defines this marker's appearance
 	UPROPERTY(BlueprintReadOnly, Category="Marker")
 	TObjectPtr<UOBMarkerConfigAsset> ConfigAsset;
@@ -107,10 +255,64 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category="Marker")
 	float CurrentLifeTime;
 
+	// Label text of this marker (e.g., a party member's name). If empty, the config's DefaultLabel is shown.
+	UPROPERTY(BlueprintReadOnly, Category="Marker")
+	FText Label;
+
+	// Set while the marker requires line of sight and no observer sees its actor. Refreshed by the subsystem.
+	UPROPERTY(BlueprintReadOnly, Category="Marker")
+	bool bHiddenByLineOfSight = false;
+
+	// Animation timing in the GetAnimationTime clock, sent to the icon material by the marker widgets
+	double AnimationStartTime = 0.0;
+	double AnimationEndTime = 0.0; // 0 if the marker does not expire
+	uint32 AnimationSerial = 0;    // Bumped on every change, so widgets only send the timing again when it changed
+
+	// Last authoritative position sample, extrapolated when the config enables dead reckoning. Times are world seconds.
+	FVector SampleLocation = FVector::ZeroVector;
+	FVector SampleVelocity = FVector::ZeroVector;
+	FVector CorrectionOffset = FVector::ZeroVector; // Shown minus extrapolated position at the last sample, decaying
+	double SampleTime = 0.0;
+	double MoveSampleTime = 0.0;     // Last sample where the tracked actor moved; derived velocities are measured from it
+	double MoveSampleInterval = 0.0; // Between the last two samples where the tracked actor moved
+	bool bHasPositionSample = false;
+
 	// Initializes the marker. Called by the subsystem.
 	void Init(const FGuid& InID, AActor* InTrackedActor, UOBMarkerConfigAsset* InConfig, FName InLayerName,
 	          FVector InStaticLocation = FVector::ZeroVector);
 
-	// Updates the marker's world location (if tracking an actor)
-	void UpdateLocation();
+	// Updates the marker's world location: follows the tracked actor, and extrapolates with dead reckoning.
+	void UpdateLocation(double CurrentTime);
+
+	/**
+	 * @brief Feeds an authoritative position. Without dead reckoning the marker simply moves there.
+	 * @param InTime World time of the sample, in seconds.
+	 */
+	void AddPositionSample(const FVector& InLocation, const FVector& InVelocity, double InTime);
+
+	// Forgets the samples; the marker stays at WorldLocation and the next sample is shown as is.
+	void ResetPositionSamples();
+
+	// Where the marker is shown at a time with dead reckoning: the extrapolated sample plus what is left of the
+	// correction. Requires a position sample.
+	FVector GetDeadReckonedLocation(const FOBMarkerDeadReckoning& DeadReckoning, double Time) const;
+
+	// Restarts the animation (e.g., a recycled ping). InLifeTime, in seconds, places the fade-out; 0 means infinite.
+	void StartAnimation(float InLifeTime);
+
+	// Moves the end of the animation without restarting it (e.g., an acknowledged ping lives longer).
+	void SetAnimationLifeTime(float InRemainingLifeTime);
+
+	// Clock of the Time node in UI materials: real seconds since engine start. Unlike marker lifetimes, it keeps
+	// running while the world is paused or dilated, so a fade-out can run ahead of a paused lifetime.
+	static double GetAnimationTime();
+
+	// Whether the marker outlives its actor (see ProxyActor)
+	bool IsProxy() const { return !ProxyActor.IsNull(); }
+
+	// The config's dead reckoning settings, or nullptr if it is disabled
+	const FOBMarkerDeadReckoning* GetDeadReckoning() const
+	{
+		return ConfigAsset && ConfigAsset->DeadReckoning.bEnabled ? &ConfigAsset->DeadReckoning : nullptr;
+	}
 };
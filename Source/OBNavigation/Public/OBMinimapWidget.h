@@ -5,15 +5,24 @@
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
 #include "Components/CanvasPanel.h"
+#include "Core/OBLabelPlacement.h"
+#include "Core/OBMinimapProjection.h"
 #include "Data/OBMinimapConfigAsset.h"
+#include "Data/OBPOIDatabase.h"
+#include "Rendering/RenderingCommon.h"
+#include "Styling/SlateBrush.h"
+#include "UObject/ObjectKey.h"
 #include "Widget/OBMapMarkerWidget.h"
 #include "OBMinimapWidget.generated.h"
 
 class UImage;
 class UOBNavigationSubsystem;
+struct FOBTrackedView;
 class UOBMapLayerAsset;
+class UOBHeatMap;
 class UMaterialInstanceDynamic;
 class UOBMinimapConfigAsset;
+class UCanvas;
 
 /**
  * @class UOBMinimapWidget
@@ -24,6 +33,9 @@ class OBNAVIGATION_API UOBMinimapWidget : public UUserWidget
 {
 	GENERATED_BODY()
 
+	// Drives NativeTick directly to measure it in isolation
+	friend class FOBNavigationBenchmark;
+
 public:
 
 	/**
@@ -54,7 +66,11 @@ public:
 	UOBMinimapConfigAsset* GetConfig() const { return ConfigAsset; }
 
 protected:
+	virtual void NativeDestruct() override;
 	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+	virtual int32 NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry,
+	                          const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId,
+	                          const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
 
 	// Called when the subsystem detects a map layer change
 	UFUNCTION()
@@ -81,7 +97,52 @@ protected:
 private:
 	// Helper function to get the base rotation angle from the alignment enum.
 	float GetAlignmentAngle() const;
-	void UpdateMinimapMarkers(const APawn* TrackedPawn, float InTotalStaticRotation, TSet<FGuid>& OutHandledMarkerIDs);
+
+	// Yaw of the configured rotation source (camera or character forward).
+	float GetRotationSourceYaw(const FOBTrackedView& TrackedView) const;
+
+	void UpdateMinimapMarkers(const FOBTrackedView& TrackedView, float InTotalStaticRotation,
+	                          TSet<FGuid>& OutHandledMarkerIDs);
+
+	// Projects the subsystem's route into canvas space and clips it to the minimap shape.
+	void UpdateRoutePolyline(const FVector2D& PlayerUV, float InMapRotation);
+
+	// Same for the tracked pawn's trail, which is extended to the pawn itself (the canvas center).
+	void UpdateBreadcrumbPolyline(const FVector2D& PlayerUV, float InMapRotation);
+
+	// Projects the subsystem's area markers: fills become one vertex/index batch, outlines become clipped runs.
+	void UpdateAreaMarkers(const UOBMapLayerAsset* InLayer, const FVector2D& PlayerUV, float InMapRotation);
+
+	// Clips a convex canvas-space polygon to the minimap and appends it to the fill batch as a triangle fan.
+	void AppendAreaFill(TConstArrayView<FVector2D> Points, const FLinearColor& Color);
+
+	// Places the labels of this tick's visible markers, hiding lower priority labels that overlap.
+	void UpdateMarkerLabels();
+
+	// Projects the resident POIs of the map's POI database that fall inside the minimap.
+	void UpdatePOIIcons(const FOBTrackedView& TrackedView, const UOBMapLayerAsset* InLayer, const FVector2D& PlayerUV,
+	                    float InTotalStaticRotation);
+
+	// Size of a label's text in LabelFont, measured once per string.
+	FVector2D GetLabelSize(const FText& Text);
+
+#if !UE_BUILD_SHIPPING
+	// Draws the projection state of the last tick while "OBNav.Debug.Overlay" is enabled.
+	void DrawDebugOverlay(UCanvas* Canvas, APlayerController* PlayerController);
+
+	// Values of the last tick, kept only for the debug overlay
+	struct FDebugState
+	{
+		float CharacterWorldYaw = 0.0f;
+		float AlignmentAngle = 0.0f;
+		float TotalStaticRotation = 0.0f;
+		float DynamicMapYaw = 0.0f;
+		int32 NumVisibleMarkers = 0;
+		int32 NumMarkerWidgetsCreated = 0;
+		int32 NumLabelCandidates = 0;
+	};
+	FDebugState DebugState;
+#endif
 
 	// --- CACHED POINTERS ---
 	// Cached the pointer to our subsystem for quick access
@@ -92,10 +153,18 @@ private:
 	UPROPERTY(Transient)
 	TObjectPtr<UMaterialInstanceDynamic> MinimapMaterialInstance;
 
+	// Heat map of the current layer, if it has one
+	UPROPERTY(Transient)
+	TObjectPtr<UOBHeatMap> CurrentHeatMap;
+
 	// --- UNIFIED WIDGET POOL ---
 	// A single map to hold all active marker widgets, regardless of where they are displayed.
 	UPROPERTY(Transient)
 	TMap<FGuid, TObjectPtr<UOBMapMarkerWidget>> ActiveMinimapMarkerWidgets; 
+
+	// Collapsed widgets of removed markers, reused before creating new ones
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UOBMapMarkerWidget>> FreeMarkerWidgets;
 	
 	// --- CONFIGURATION ---
 	// Configuration asset for visual resources. Set via InitializeAndStartTracking.
@@ -112,4 +181,83 @@ private:
 
 	FGuid PlayerMarkerID; // Store the player's own marker ID
 
+	// Visible runs of the route polyline in MinimapMarkerCanvas space. Rebuilt each tick, drawn in NativePaint.
+	TArray<TArray<FVector2D>> RoutePaintRuns;
+	TArray<FVector2D> RouteProjectedPoints;
+	int32 NumRoutePaintRuns = 0;
+
+	// Area fills in canvas space, drawn with a single MakeCustomVerts call
+	struct FAreaFillVertex
+	{
+		FVector2f Position;
+		FLinearColor Color;
+	};
+	TArray<FAreaFillVertex> AreaFillVertices;
+	TArray<SlateIndex> AreaFillIndices;
+	// Converted to window space at paint time
+	mutable TArray<FSlateVertex> AreaSlateVertices;
+
+	// Visible runs of the area outlines, and the color and thickness of each run
+	TArray<TArray<FVector2D>> AreaOutlinePaintRuns;
+	TArray<TPair<FLinearColor, float>> AreaOutlineRunStyles;
+
+	// Scratch buffers reused every tick
+	TArray<FVector2D> AreaProjectedPoints;
+	TArray<FVector2D> AreaClipPolygon;
+	TArray<FVector2D> AreaClippedPoints;
+
+	// Visible runs of the breadcrumb trail, same as the route
+	TArray<TArray<FVector2D>> BreadcrumbPaintRuns;
+	TArray<FVector2D> BreadcrumbProjectedPoints;
+	int32 NumBreadcrumbPaintRuns = 0;
+
+	// Markers shown this tick with their widgets, parallel to the projection inputs and outputs. Reused every tick.
+	struct FVisibleMarker
+	{
+		const UOBMapMarker* Marker = nullptr;
+		UOBMapMarkerWidget* Widget = nullptr;
+	};
+	TArray<FVisibleMarker> VisibleMarkers;
+	TArray<OBNavigation::Projection::FMarkerInput> MarkerProjectionInputs;
+	TArray<OBNavigation::Projection::FMarkerOutput> MarkerProjectionOutputs;
+
+	// Labels kept by the collision culling this tick, in canvas space. Drawn in NativePaint with LabelFont.
+	struct FMarkerLabel
+	{
+		FText Text;
+		FVector2D Position = FVector2D::ZeroVector; // Top left corner
+		FVector2D Size = FVector2D::ZeroVector;
+	};
+	TArray<FMarkerLabel> MarkerLabels;
+
+	// Labels that want to be shown this tick, placed in priority order. Reused every tick.
+	struct FLabelCandidate
+	{
+		int32 VisibleMarkerIndex = INDEX_NONE;
+		int32 Priority = 0;
+	};
+	TArray<FLabelCandidate> LabelCandidates;
+	OBNavigation::Labels::FLabelCollisionGrid LabelGrid;
+
+	// POIs shown this tick, drawn in NativePaint as one box each. Neither a widget nor a UOBMapMarker backs them.
+	struct FPOIIcon
+	{
+		FVector2D Position = FVector2D::ZeroVector; // Top left corner, in canvas space
+		FVector2D Size = FVector2D::ZeroVector;
+		int32 BrushIndex = INDEX_NONE;
+	};
+	TArray<FPOIIcon> POIIcons;
+	TArray<FOBLightweightMarker> LightweightMarkers; // Reused every tick
+
+	// One brush per marker config, built the first time one of its POIs is shown
+	TArray<FSlateBrush> POIBrushes;
+	TMap<TObjectKey<UOBMarkerConfigAsset>, int32> POIBrushIndices;
+
+	// Text layout is measured once per string; only label positions are computed every tick
+	TMap<FString, FVector2D> LabelSizeCache;
+	FSlateFontInfo LabelFont; // The config's label font, or the default Slate font
+
+	// Debug draw registration, only valid while the debug overlay is enabled
+	FDelegateHandle DebugOverlayHandle;
+
 };
@@ -2,8 +2,11 @@
 
 #pragma once
 
+#include "Logging/LogMacros.h"
 #include "Modules/ModuleManager.h"
 
+OBNAVIGATION_API DECLARE_LOG_CATEGORY_EXTERN(LogOBNavigation, Log, All);
+
 class FOBNavigationModule : public IModuleInterface
 {
 public:
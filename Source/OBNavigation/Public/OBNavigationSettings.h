@@ -0,0 +1,151 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "Engine/EngineTypes.h"
+#include "OBNavigationSettings.generated.h"
+
+class UOBMarkerConfigAsset;
+
+/**
+ * @class UOBNavigationSettings
+ * @brief Project-wide tuning for the navigation subsystem (Project Settings > Plugins > OB Navigation).
+ * Visual settings that can differ per widget live in UOBMinimapConfigAsset instead.
+ */
+UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "OB Navigation"))
+class OBNAVIGATION_API UOBNavigationSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UOBNavigationSettings();
+
+	// --- ROUTE GUIDANCE ---
+
+	// Half width (in world units) of the corridor around the current route. Leaving it triggers a re-path.
+	UPROPERTY(Config, EditAnywhere, Category = "Route Guidance", meta = (ClampMin = "10.0"))
+	float RouteCorridorWidth = 300.0f;
+
+	// Distance (in world units) the route target must move before the route is recomputed.
+	UPROPERTY(Config, EditAnywhere, Category = "Route Guidance", meta = (ClampMin = "0.0"))
+	float RouteRepathTargetDistance = 500.0f;
+
+	// Minimum time (in seconds) between two path queries, no matter how often re-path conditions trigger.
+	UPROPERTY(Config, EditAnywhere, Category = "Route Guidance", meta = (ClampMin = "0.0"))
+	float RouteMinRepathInterval = 0.5f;
+
+	// Douglas-Peucker tolerance (in world units) used when simplifying the route in map space.
+	UPROPERTY(Config, EditAnywhere, Category = "Route Guidance", meta = (ClampMin = "0.0"))
+	float RouteSimplifyTolerance = 150.0f;
+
+	// --- BREADCRUMBS ---
+
+	// Number of points kept in the tracked pawn's trail. Older points are overwritten; memory does not grow.
+	UPROPERTY(Config, EditAnywhere, Category = "Breadcrumbs", meta = (ClampMin = "0", ClampMax = "8192"))
+	int32 MaxBreadcrumbs = 512;
+
+	// Minimum distance (in world units) between two trail points.
+	UPROPERTY(Config, EditAnywhere, Category = "Breadcrumbs", meta = (ClampMin = "1.0"))
+	float BreadcrumbMinSpacing = 150.0f;
+
+	// Points closer than this (in world units) to the straight line through their neighbors are merged away.
+	UPROPERTY(Config, EditAnywhere, Category = "Breadcrumbs", meta = (ClampMin = "0.0"))
+	float BreadcrumbCollinearTolerance = 50.0f;
+
+	// A jump longer than this (in world units) between two samples (respawn, teleport) starts a new trail.
+	UPROPERTY(Config, EditAnywhere, Category = "Breadcrumbs", meta = (ClampMin = "1.0"))
+	float BreadcrumbTeleportDistance = 5000.0f;
+
+	// --- LINE OF SIGHT ---
+
+	// Asynchronous traces issued per frame to refresh markers requiring line of sight. Targets are refreshed
+	// round-robin, so more targets or observers delay refreshes instead of costing more traces.
+	UPROPERTY(Config, EditAnywhere, Category = "Line of Sight", meta = (ClampMin = "1", ClampMax = "255"))
+	int32 LineOfSightTraceBudget = 32;
+
+	// Time (in seconds) a line of sight result is kept before the target is traced again.
+	UPROPERTY(Config, EditAnywhere, Category = "Line of Sight", meta = (ClampMin = "0.0"))
+	float LineOfSightCacheDuration = 0.25f;
+
+	// Observers farther than this (in world units) do not see a target and are not traced. 0 means no limit.
+	UPROPERTY(Config, EditAnywhere, Category = "Line of Sight", meta = (ClampMin = "0.0"))
+	float LineOfSightMaxDistance = 0.0f;
+
+	// Channel blocking line of sight.
+	UPROPERTY(Config, EditAnywhere, Category = "Line of Sight")
+	TEnumAsByte<ECollisionChannel> LineOfSightTraceChannel = ECC_Visibility;
+
+	// --- REGIONS ---
+
+	// Size (in world units) of the cubic cells of the region index. A tracked actor is only tested against regions again
+	// once it leaves its cell, or at every update while a region boundary runs through the cell.
+	UPROPERTY(Config, EditAnywhere, Category = "Regions", meta = (ClampMin = "100.0"))
+	float RegionGridCellSize = 2000.0f;
+
+	// Regions covering more cells than this are not indexed but tested at every update of every tracked actor.
+	UPROPERTY(Config, EditAnywhere, Category = "Regions", meta = (ClampMin = "1"))
+	int32 MaxRegionCells = 4096;
+
+	// --- MANIFEST ---
+
+	// If true, the subsystem starts from the navigation manifests written by the OBNavigationManifest commandlet when
+	// they exist, instead of scanning the asset registry and loading every map layer. Re-run the commandlet whenever
+	// layers, marker configs or points of interest change, and before packaging; a stale manifest is used as is.
+	UPROPERTY(Config, EditAnywhere, Category = "Manifest")
+	bool bUseNavigationManifest = true;
+
+	// If true, the editor (including PIE) uses the manifests too. Off by default: the editor always has the asset
+	// registry, and a manifest that was not re-baked would hide new layers, configs and points of interest.
+	UPROPERTY(Config, EditAnywhere, Category = "Manifest", meta = (EditCondition = "bUseNavigationManifest"))
+	bool bUseNavigationManifestInEditor = false;
+
+	// Whether the manifests are used in this process (see bUseNavigationManifest and bUseNavigationManifestInEditor).
+	bool ShouldUseNavigationManifest() const;
+
+	// --- POINTS OF INTEREST ---
+
+	// Half size (in world units) of the square around the tracked view whose POI database pages are kept resident.
+	// Should cover what the minimap shows at its widest zoom.
+	UPROPERTY(Config, EditAnywhere, Category = "Points of Interest", meta = (ClampMin = "1000.0"))
+	float POIStreamingRadius = 20000.0f;
+
+	// Maximum number of POI database pages resident at once. The least recently used pages are released first.
+	UPROPERTY(Config, EditAnywhere, Category = "Points of Interest", meta = (ClampMin = "1"))
+	int32 MaxResidentPOIPages = 256;
+
+	// Maximum number of POI database pages loaded per update. The remaining pages are loaded on the next updates.
+	UPROPERTY(Config, EditAnywhere, Category = "Points of Interest", meta = (ClampMin = "1"))
+	int32 MaxPOIPageLoadsPerUpdate = 8;
+
+	// --- PINGS ---
+
+	// Maximum number of pings shown at once. Their slots are recycled, oldest ping first.
+	UPROPERTY(Config, EditAnywhere, Category = "Pings", meta = (ClampMin = "1", ClampMax = "256"))
+	int32 MaxActivePings = 16;
+
+	// Number of pings (or acknowledgements) a player can send in a quick burst.
+	UPROPERTY(Config, EditAnywhere, Category = "Pings", meta = (ClampMin = "1"))
+	int32 PingBurstSize = 3;
+
+	// Time (in seconds) for a player to get one ping of the burst back.
+	UPROPERTY(Config, EditAnywhere, Category = "Pings", meta = (ClampMin = "0.0"))
+	float PingRefillInterval = 1.0f;
+
+	// Time (in seconds) a ping stays on the map when its marker config has no LifeTime.
+	UPROPERTY(Config, EditAnywhere, Category = "Pings", meta = (ClampMin = "0.1"))
+	float DefaultPingLifeTime = 5.0f;
+
+	// Time (in seconds) an acknowledgement keeps a ping on the map, at least.
+	UPROPERTY(Config, EditAnywhere, Category = "Pings", meta = (ClampMin = "0.0"))
+	float PingAcknowledgeLifeTime = 3.0f;
+
+	// The logical layer of ping markers.
+	UPROPERTY(Config, EditAnywhere, Category = "Pings")
+	FName PingLayerName = TEXT("Pings");
+
+	// Marker config of pings placed without an explicit one.
+	UPROPERTY(Config, EditAnywhere, Category = "Pings")
+	TSoftObjectPtr<UOBMarkerConfigAsset> DefaultPingConfig;
+};
@@ -3,12 +3,33 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "OBAreaMarker.h"
+#include "OBHeatMap.h"
+#include "OBMapBake.h"
 #include "OBMapMarker.h"
+#include "OBRegionIndex.h"
+#include "Core/OBMarkerSnapshot.h"
+#include "Data/OBNavigationManifest.h"
+#include "Data/OBPOIDatabase.h"
+#include "AI/Navigation/NavigationTypes.h"
+#include "Containers/MpscQueue.h"
+#include "Engine/EngineTypes.h"
+#include "UObject/ObjectKey.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "UObject/SoftObjectPath.h"
 #include "OBNavigationSubsystem.generated.h"
 
 class UOBMapLayerAsset;
 class UOBMarkerConfigAsset;
+class UOBExplorationMask;
+class UOBProxyMarkerSetAsset;
+class ULevel;
+struct FStreamableHandle;
+class UCanvas;
+class FOBMarkerTraceRecorder;
+class FOBMarkerTraceReplayer;
+struct FTraceHandle;
+struct FTraceDatum;
 
 // Delegate for broadcasting minimap layer changes
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnMinimapLayerChanged, UOBMapLayerAsset*, NewLayer);
@@ -16,6 +37,25 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnMinimapLayerChanged, UOBMapLayerA
 // Delegate for broadcasting marker list changes
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnMarkersUpdated);
 
+// Delegate for broadcasting route guidance changes (new path, route cleared)
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnRouteUpdated);
+
+// Delegates for broadcasting an actor entering or leaving a named region
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnRegionChanged, AActor*, Actor, FName, RegionName);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnRegionChangedNative, AActor* /*Actor*/, FName /*RegionName*/);
+
+/**
+ * @struct FOBTrackedView
+ * @brief The location and orientation the minimap is centered on.
+ * Taken from the tracked player pawn, or from a view override (e.g., while a marker trace is replayed).
+ */
+struct FOBTrackedView
+{
+	FVector Location = FVector::ZeroVector;
+	float ActorYaw = 0.0f;
+	float ControlYaw = 0.0f;
+};
+
 /**
  * @class UOBNavigationSubsystem
  * @brief Manages all map, compass, marker, and navigation logic.
@@ -26,6 +66,16 @@ class OBNAVIGATION_API UOBNavigationSubsystem : public UGameInstanceSubsystem
 {
 	GENERATED_BODY()
 
+	// Drives Tick and the update phases directly to measure them in isolation
+	friend class FOBNavigationBenchmark;
+	friend class FOBMarkerTraceReplayer;
+	// Ticks the subsystem from the world tick
+	friend class UOBNavigationWorldSubsystem;
+	// Adds and removes its recycled ping markers directly
+	friend class UOBPingSubsystem;
+	// Ticks the subsystem to check when marker snapshots are published
+	friend class FOBMarkerSnapshotPublishTest;
+
 public:
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual void Deinitialize() override;
@@ -38,12 +88,47 @@ public:
 	UFUNCTION(BlueprintPure, Category = "OBNavigation")
 	APawn* GetTrackedPlayerPawn() const { return TrackedPlayerPawn.Get(); }
 
+	// Gets the view the minimap is centered on. Returns false if there is neither a tracked pawn nor a view override.
+	bool GetTrackedView(FOBTrackedView& OutView) const;
+
+	// Uses a fixed view instead of the tracked pawn until ClearTrackedViewOverride is called.
+	void SetTrackedViewOverride(const FOBTrackedView& InView);
+	void ClearTrackedViewOverride();
+
+	// --- MARKER CONFIG REGISTRY ---
+
+	/**
+	 * @brief Finds a marker config by asset name (e.g., "MC_Vendor").
+	 * Configs are loaded asynchronously at initialization. One that is not resident yet is loaded synchronously,
+	 * which stalls the game thread and is logged as a warning.
+	 */
+	UFUNCTION(BlueprintPure, Category = "OBNavigation|Markers")
+	UOBMarkerConfigAsset* FindMarkerConfig(FName ConfigName) const;
+
+	// Small index of a config in the registry, stable for the session. INDEX_NONE if the config is not registered.
+	int32 GetMarkerConfigIndex(const UOBMarkerConfigAsset* InConfig) const;
+
+	// Resolves an index from GetMarkerConfigIndex. Never loads: returns nullptr for an invalid index or a config
+	// that is still streaming in.
+	UOBMarkerConfigAsset* GetMarkerConfigByIndex(int32 Index) const;
+
+	int32 GetNumMarkerConfigs() const { return MarkerConfigPaths.Num(); }
+
+	// Starts streaming in the icons of a config. Called for every marker registration; does nothing once resident.
+	void RequestMarkerConfigIcons(const UOBMarkerConfigAsset* InConfig);
+
+	// Gets the first marker registered for the actor, or an invalid FGuid if it has none.
 	UFUNCTION(BlueprintPure, Category = "OBNavigation|Markers")
 	FGuid GetMarkerIDForActor(AActor* InActor) const;
 
+	// Gets every marker registered for the actor (e.g., its player icon and a quest marker), in registration order.
+	UFUNCTION(BlueprintPure, Category = "OBNavigation|Markers")
+	TArray<FGuid> GetMarkerIDsForActor(AActor* InActor) const;
+
 	/**
 	 * @brief Registers a new marker.
-	 * @param InTrackedActor The actor to track. If nullptr, use InStaticLocation.
+	 * @param InTrackedActor The actor to track. If nullptr, use InStaticLocation. An actor can carry several markers;
+	 * they are unregistered automatically when it is destroyed or leaves play.
 	 * @param InConfig The marker's configuration asset.
 	 * @param InLayerName The logical layer name for this marker (e.g., "Quests", "Party").
 	 * @param InStaticLocation If not tracking an actor, this is the fixed world location.
@@ -53,6 +138,28 @@ public:
 	FGuid RegisterMapMarker(AActor* InTrackedActor, UOBMarkerConfigAsset* InConfig, FName InLayerName,
 							FVector InStaticLocation = FVector::ZeroVector);
 
+	/**
+	 * @brief Registers a marker for an actor that is not necessarily loaded (e.g., it lives in a World Partition cell).
+	 * The marker follows the actor while it is loaded and stays at its last known location while it is not. Streaming
+	 * the actor in or out rebinds the marker without re-registering it; destroying the actor removes it.
+	 * @param InActor The actor the marker stands in for.
+	 * @param InConfig The marker's configuration asset.
+	 * @param InLayerName The logical layer name for this marker.
+	 * @param InLocation Where the marker is shown until the actor is loaded for the first time.
+	 * @return The unique ID of the registered marker, or an invalid FGuid on failure.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Markers")
+	FGuid RegisterProxyMarker(const TSoftObjectPtr<AActor>& InActor, UOBMarkerConfigAsset* InConfig, FName InLayerName,
+	                          FVector InLocation);
+
+	/**
+	 * @brief Registers every proxy marker of a set, with a single marker list update.
+	 * @param OutMarkerIDs Receives the IDs of the registered markers, e.g., to unregister the set later.
+	 * @return The number of markers registered.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Markers")
+	int32 RegisterProxyMarkerSet(const UOBProxyMarkerSetAsset* InSet, TArray<FGuid>& OutMarkerIDs);
+
 	/**
 	 * @brief Unregisters a marker by its ID.
 	 * @param MarkerID The ID of the marker to unregister.
@@ -60,34 +167,610 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Markers")
 	void UnregisterMapMarker(const FGuid& MarkerID);
 
+	/**
+	 * @brief Registers a static-location marker under a known ID (e.g., one derived from a level-placed actor), so
+	 * a baked registration and a runtime one of the same point of interest resolve to the same marker.
+	 * @return False if the config is null or the ID is invalid or already registered.
+	 */
+	bool RegisterStaticMarkerWithID(const FGuid& MarkerID, UOBMarkerConfigAsset* InConfig, FName InLayerName,
+	                                const FVector& InLocation);
+
+	UFUNCTION(BlueprintPure, Category = "OBNavigation|Markers")
+	bool HasMarker(const FGuid& MarkerID) const { return ActiveMarkersMap.Contains(MarkerID); }
+
+	// --- THREAD-SAFE MARKER COMMANDS ---
+	// Callable from any thread (AI perception, spawners, async load callbacks). Commands are queued without locking and
+	// applied in submission order at the start of the next subsystem tick, with a single marker list update for the
+	// whole batch. Use the queued calls consistently for a marker: a game-thread UnregisterMapMarker does not see a
+	// registration that is still queued.
+
+	/**
+	 * @brief Queues the registration of a marker. Same parameters as RegisterMapMarker.
+	 * The config must stay loaded until the command is applied; the actor is only weakly referenced, and the marker is
+	 * not created if it was destroyed in the meantime.
+	 * @return The ID the marker will have, usable in further commands right away.
+	 */
+	FGuid EnqueueRegisterMarker(AActor* InTrackedActor, UOBMarkerConfigAsset* InConfig, FName InLayerName,
+	                            const FVector& InStaticLocation = FVector::ZeroVector);
+
+	void EnqueueUnregisterMarker(const FGuid& MarkerID);
+
+	// Moves a static-location marker, as SetMarkerPositionSample. Markers tracking an actor keep following it.
+	void EnqueueMoveMarker(const FGuid& MarkerID, const FVector& InWorldLocation,
+	                       const FVector& InVelocity = FVector::ZeroVector);
+
+	// Sets the remaining lifetime of a marker, in seconds. 0 makes it permanent.
+	void EnqueueSetMarkerLifeTime(const FGuid& MarkerID, float InLifeTime);
+
+	// Sets the text shown under a marker whose config enables labels (e.g., a party member's name).
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Markers")
+	void SetMarkerLabel(const FGuid& MarkerID, const FText& InLabel);
+
+	/**
+	 * @brief Feeds an authoritative position to a marker that does not track an actor (e.g., a remote unit received a
+	 * few times per second). With dead reckoning enabled in its config, the marker extrapolates along InVelocity until
+	 * the next sample and blends out the error; otherwise it simply moves to InLocation.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Markers")
+	void SetMarkerPositionSample(const FGuid& MarkerID, FVector InLocation, FVector InVelocity);
+
+	// --- PERSISTENCE ---
+
+	/**
+	 * @brief Saves every static-location marker (markers not tracking an actor) in the compact binary marker format.
+	 * @param OutData Receives the encoded marker set.
+	 * @param LayerFilter If set, only markers on this logical layer (e.g., "Waypoints") are saved.
+	 * @return The number of markers saved.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Persistence")
+	int32 SaveStaticMarkers(TArray<uint8>& OutData, FName LayerFilter = NAME_None) const;
+
+	/**
+	 * @brief Restores markers saved by SaveStaticMarkers, keeping their original IDs.
+	 * Markers whose ID is already registered are skipped.
+	 * @return The number of markers restored.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Persistence")
+	int32 LoadStaticMarkers(const TArray<uint8>& InData);
+
+	// Writes SaveStaticMarkers data to a file. Returns false if the file could not be written.
+	bool SaveStaticMarkersToFile(const FString& FilePath, FName LayerFilter = NAME_None) const;
+
+	// Restores markers from a file written by SaveStaticMarkersToFile. The file is memory-mapped when the platform allows it.
+	int32 LoadStaticMarkersFromFile(const FString& FilePath);
+
+	// Restores markers from encoded data that stays valid for the duration of the call (e.g., a mapped file region).
+	// The IDs of the restored markers are appended to OutMarkerIDs if given.
+	int32 LoadStaticMarkersFromView(TArrayView<const uint8> InData, TArray<FGuid>* OutMarkerIDs = nullptr);
+
 	// Get all active markers for UI display
 	UFUNCTION(BlueprintPure, Category = "OBNavigation|Markers")
 	const TArray<UOBMapMarker*>& GetAllActiveMarkers() const { return ActiveMarkers; }
 
+	/**
+	 * @brief Read-only marker state for other threads (worker jobs, spectator streams, telemetry).
+	 * Keep the reference and call Acquire() on it from any thread: it pins the snapshot of the last tick without
+	 * locking or copying, and the game thread never waits for it. Snapshots are published at the end of each tick
+	 * while a reference is held, so the first one arrives on the next tick. A read scope must not outlive the buffer.
+	 */
+	TSharedRef<const OBNavigation::Snapshots::FMarkerSnapshotBuffer, ESPMode::ThreadSafe> GetMarkerSnapshots() const
+	{
+		return MarkerSnapshots;
+	}
+
 	// Utility to convert world location to map UV
 	UFUNCTION(BlueprintPure, Category = "OBNavigation|Utilities")
 	bool WorldToMapUV(const UOBMapLayerAsset* MapLayer, const FVector& WorldLocation, FVector2D& OutMapUV) const;
 
+	// Bounds the layer's map UVs are computed from: the bounds fitted by BakeMapLayer if any, else its WorldBounds.
+	const FBox& GetLayerBounds(const UOBMapLayerAsset* MapLayer) const;
+
+	// --- EXPLORATION (FOG OF WAR) ---
+
+	/**
+	 * @brief Adds an actor that reveals unexplored cells around itself on whichever layer it stands in.
+	 * The tracked player pawn is always a revealer and does not need to be registered.
+	 * @param InRevealer The actor revealing the map (e.g., a scout, a ward).
+	 * @param InRevealRadius Radius (in world units) revealed around the actor.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Exploration")
+	void RegisterExplorationRevealer(AActor* InRevealer, float InRevealRadius);
+
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Exploration")
+	void UnregisterExplorationRevealer(AActor* InRevealer);
+
+	// Returns the exploration mask of a layer, creating it on first use. Returns nullptr if exploration is disabled for the layer.
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Exploration")
+	UOBExplorationMask* FindOrCreateExplorationMask(UOBMapLayerAsset* MapLayer);
+
+	/**
+	 * @brief Serializes the explored cells of a layer as compact RLE data for save games.
+	 * @return False if exploration is disabled for the layer.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Exploration")
+	bool SaveExplorationData(UOBMapLayerAsset* MapLayer, TArray<uint8>& OutData);
+
+	/**
+	 * @brief Restores the explored cells of a layer from data written by SaveExplorationData.
+	 * @return False if the data is invalid or was saved for a different layer setup.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Exploration")
+	bool LoadExplorationData(UOBMapLayerAsset* MapLayer, const TArray<uint8>& InData);
+
+	// --- LINE OF SIGHT ---
+
+	/**
+	 * @brief Adds an actor whose sight reveals markers requiring line of sight (e.g., a teammate).
+	 * The tracked player pawn is always an observer and does not need to be registered.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Line of Sight")
+	void RegisterLineOfSightObserver(AActor* InObserver);
+
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Line of Sight")
+	void UnregisterLineOfSightObserver(AActor* InObserver);
+
+	// --- REGIONS ---
+
+	/**
+	 * @brief Registers a named region (e.g., a town, for discovery popups or music changes). Enter and exit events fire
+	 * for the tracked player pawn and the registered region trackers.
+	 * @param RegionName Identifies the region in events. Registering a name again replaces its volume.
+	 * @param Center Center of the region's box.
+	 * @param HalfExtents Half size of the box along its own axes.
+	 * @param Yaw Rotation (in degrees) of the box around Z.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Regions")
+	void RegisterBoxRegion(FName RegionName, FVector Center, FVector HalfExtents, float Yaw = 0.0f);
+
+	// Actors inside the region get an exit event at the next update.
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Regions")
+	void UnregisterRegion(FName RegionName);
+
+	UFUNCTION(BlueprintPure, Category = "OBNavigation|Regions")
+	bool HasRegion(const FName RegionName) const { return Regions.Contains(RegionName); }
+
+	// Adds an actor whose region transitions are reported in addition to the tracked pawn's (e.g., an escorted NPC).
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Regions")
+	void RegisterRegionTracker(AActor* InActor);
+
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Regions")
+	void UnregisterRegionTracker(AActor* InActor);
+
+	// Gets the regions the actor was in at the last update. Empty if the actor is not tracked.
+	UFUNCTION(BlueprintPure, Category = "OBNavigation|Regions")
+	TArray<FName> GetActorRegions(AActor* InActor) const;
+
+	// --- AREA MARKERS ---
+
+	// Registers a circular zone (e.g., a capture point or the battle royale safe zone).
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Areas")
+	FGuid RegisterCircleArea(FVector InCenter, float InRadius, const FOBAreaMarkerStyle& InStyle);
+
+	// Registers a rectangular zone, rotated by InYaw (degrees) around its center.
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Areas")
+	FGuid RegisterRectangleArea(FVector InCenter, FVector2D InHalfExtents, float InYaw, const FOBAreaMarkerStyle& InStyle);
+
+	/**
+	 * @brief Registers a polygonal zone. Z is ignored.
+	 * @return The unique ID of the area, or an invalid FGuid if the polygon has fewer than 3 points or intersects itself.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Areas")
+	FGuid RegisterPolygonArea(const TArray<FVector>& InWorldPoints, const FOBAreaMarkerStyle& InStyle);
+
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Areas")
+	void UnregisterArea(const FGuid& AreaID);
+
+	/**
+	 * @brief Moves and resizes an area smoothly, e.g., to shrink the safe zone. The minimap interpolates the center and
+	 * scale each frame; nothing is rebuilt.
+	 * @param InTargetCenter Where the area's center ends up.
+	 * @param InTargetScale The final radius for circles, or scale (1 = as registered) for other shapes.
+	 * @param InDuration Time (in seconds of world time) to get there. 0 applies it immediately.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Areas")
+	void AnimateArea(const FGuid& AreaID, FVector InTargetCenter, float InTargetScale, float InDuration);
+
+	// Returns true if the location (XY) is inside the area right now, e.g., to test whether a player left the safe zone.
+	UFUNCTION(BlueprintPure, Category = "OBNavigation|Areas")
+	bool IsInsideArea(const FGuid& AreaID, FVector WorldLocation) const;
+
+	const TMap<FGuid, FOBAreaMarker>& GetAreaMarkers() const { return AreaMarkers; }
+
+	// --- HEAT MAP ---
+
+	/**
+	 * @brief Accumulates a batch of events into the heat maps. Only the touched tiles are uploaded, once per tick.
+	 * Ignored on a dedicated server, which has no heat map to display.
+	 * @param Events The events, e.g., the kills of the last second.
+	 * @param MapLayer The layer receiving every event. If nullptr, each event goes to the best layer for its location.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Heat Map")
+	void SubmitHeatMapEvents(const TArray<FOBHeatMapEvent>& Events, UOBMapLayerAsset* MapLayer = nullptr);
+
+	// Returns the heat map of a layer, creating it on first use. Returns nullptr if heat maps are disabled for the layer.
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Heat Map")
+	UOBHeatMap* FindOrCreateHeatMap(UOBMapLayerAsset* MapLayer);
+
+	// --- MAP BAKING ---
+
+	/**
+	 * @brief Rasterizes a top-down image of a layer from the current world and shows it for that layer for the rest of
+	 * the session. Meant for layers without authored art, e.g., generated dungeon floors; authored layers are baked
+	 * offline by the OBMapBake commandlet. Traces one ray per pixel, so call it while loading.
+	 * With Settings.bFitBounds, the fitted bounds replace the layer's WorldBounds for this subsystem only (see
+	 * GetLayerBounds); the shared layer asset is not modified.
+	 * @return The baked texture, or nullptr if the layer has no usable bounds.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Map Bake")
+	UTexture2D* BakeMapLayer(UOBMapLayerAsset* MapLayer, const FOBMapBakeSettings& Settings);
+
+	/**
+	 * @brief Re-rasterizes the part of a baked layer covered by DirtyBounds and uploads only those pixels.
+	 * Call it once the change is in the world; when the navmesh is drawn, after the tiles around it have been rebuilt.
+	 * Does nothing for layers that were not baked with BakeMapLayer.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Map Bake")
+	void PatchMapLayer(UOBMapLayerAsset* MapLayer, const FBox& DirtyBounds);
+
+	// Returns the image shown for a layer: the texture baked by BakeMapLayer if any, else the layer's MapTexture.
+	UFUNCTION(BlueprintPure, Category = "OBNavigation|Map Bake")
+	UTexture2D* GetMapTexture(UOBMapLayerAsset* MapLayer) const;
+
+	// --- POINT OF INTEREST DATABASE ---
+	// Points of interest baked by the OBNavigationManifest commandlet into the paged database of the current map (see
+	// FOBPOIDatabaseFormat). The pages around the tracked view, and around the POI view region if one is set, are kept
+	// resident; the minimap draws their POIs without creating markers. POIs are identified by their database index.
+
+	// Also keeps the pages of this XY region resident (e.g., the part of the world a full-screen map shows) until cleared.
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Points of Interest")
+	void SetPOIViewRegion(const FBox2D& WorldRegion);
+
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Points of Interest")
+	void ClearPOIViewRegion();
+
+	// Appends the POIs of the resident pages inside the XY region that are not hidden and have a loaded config.
+	void GatherLightweightMarkers(const FBox2D& WorldRegion, TArray<FOBLightweightMarker>& OutMarkers) const;
+
+	// Number of POIs in the database of the current map, 0 if it has none.
+	UFUNCTION(BlueprintPure, Category = "OBNavigation|Points of Interest")
+	int32 GetNumPOIs() const { return POIDatabase.GetNumPOIs(); }
+
+	// Returns the index of a POI from its ID (see UOBPointOfInterestComponent::MakeMarkerID), or INDEX_NONE.
+	UFUNCTION(BlueprintPure, Category = "OBNavigation|Points of Interest")
+	int32 FindPOIIndex(const FGuid& POIID) const;
+
+	// Called by a point of interest meant for the database but not found in it, which falls back to a marker. Warns
+	// once per map that the database is missing or stale, unless manifests are not used (e.g., in the editor) and the
+	// fallback is expected.
+	void ReportMissingPOI(const AActor* POIActor);
+
+	// Hides a POI (e.g., once collected) or shows it again. The state is one bit per POI, kept apart from the database.
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Points of Interest")
+	void SetPOIHidden(int32 POIIndex, bool bHidden);
+
+	UFUNCTION(BlueprintPure, Category = "OBNavigation|Points of Interest")
+	bool IsPOIHidden(int32 POIIndex) const;
+
+	// Saves the hidden state of every POI of the current map, one bit per POI.
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Persistence")
+	void SavePOIStates(TArray<uint8>& OutData) const;
+
+	/**
+	 * @brief Restores POI states saved by SavePOIStates. Call it once the map began play.
+	 * @return False if the states were saved against another map or another build of its database.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Persistence")
+	bool LoadPOIStates(const TArray<uint8>& InData);
+
+	// --- ROUTE GUIDANCE ---
+
+	/**
+	 * @brief Starts guiding the tracked player pawn to a marker along the navmesh.
+	 * Paths are queried asynchronously and only re-queried when the pawn leaves the route corridor
+	 * or the target moves far enough (see UOBNavigationSettings).
+	 * @param TargetMarkerID The marker to navigate to.
+	 * @return False if the marker does not exist.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Route")
+	bool StartRouteToMarker(const FGuid& TargetMarkerID);
+
+	// Stops route guidance and clears the displayed route.
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Route")
+	void StopRoute();
+
+	UFUNCTION(BlueprintPure, Category = "OBNavigation|Route")
+	bool HasActiveRoute() const { return RouteTargetMarkerID.IsValid(); }
+
+	UFUNCTION(BlueprintPure, Category = "OBNavigation|Route")
+	FGuid GetRouteTargetMarkerID() const { return RouteTargetMarkerID; }
+
+	// The simplified route in map UV space of the current minimap layer. Empty if there is no route to display.
+	const TArray<FVector2D>& GetRouteMapPoints() const { return RouteMapPoints; }
+
+	// --- BREADCRUMBS ---
+
+	// Forgets the trail of the tracked pawn.
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Breadcrumbs")
+	void ClearBreadcrumbs();
+
+	/**
+	 * @brief Gets the trail of the tracked pawn in map UV space of the current minimap layer, oldest point first.
+	 * The trail is stored in a ring buffer, so it comes in two parts: OutOlder is followed by OutNewer.
+	 */
+	void GetBreadcrumbMapPoints(TConstArrayView<FVector2D>& OutOlder, TConstArrayView<FVector2D>& OutNewer) const;
+
+	UFUNCTION(BlueprintPure, Category = "OBNavigation|Breadcrumbs")
+	int32 GetNumBreadcrumbs() const { return NumBreadcrumbs; }
+
+	// --- MARKER TRACES ---
+
+	/**
+	 * @brief Starts recording the marker stream (registrations, removals, positions, view and layer changes)
+	 * into a compact binary trace file, one frame per tick. Replaces a running recording.
+	 * @param FilePath The trace file to write.
+	 * @return False if the file could not be created.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Trace")
+	bool StartTraceRecording(const FString& FilePath);
+
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Trace")
+	void StopTraceRecording();
+
+	UFUNCTION(BlueprintPure, Category = "OBNavigation|Trace")
+	bool IsRecordingTrace() const { return TraceRecorder.IsValid(); }
+
+	/**
+	 * @brief Replays a recorded trace, one recorded frame per tick, using the recorded frame times.
+	 * Replayed markers are added next to the live ones and do not need actors. The recorded view replaces
+	 * the tracked pawn until the replay ends.
+	 * @param FilePath The trace file to replay.
+	 * @param bLoop If true, the replay restarts at the end of the trace.
+	 * @return False if the file could not be read or is not a valid trace.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Trace")
+	bool StartTraceReplay(const FString& FilePath, bool bLoop = false);
+
+	// Stops the replay and removes the replayed markers.
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Trace")
+	void StopTraceReplay();
+
+	UFUNCTION(BlueprintPure, Category = "OBNavigation|Trace")
+	bool IsReplayingTrace() const { return TraceReplayer.IsValid(); }
+
+	UPROPERTY(BlueprintAssignable, Category = "OBNavigation|Delegates")
+	FOnRouteUpdated OnRouteUpdated;
+
 	UPROPERTY(BlueprintAssignable, Category = "OBNavigation|Delegates")
 	FOnMinimapLayerChanged OnMinimapLayerChanged;
 
 	UPROPERTY(BlueprintAssignable, Category = "OBNavigation|Delegates")
 	FOnMarkersUpdated OnMarkersUpdated; // Broadcast when markers are added/removed/updated
 
+	UPROPERTY(BlueprintAssignable, Category = "OBNavigation|Delegates")
+	FOnRegionChanged OnRegionEntered;
+
+	// Also broadcast when a tracked actor is destroyed or the tracked pawn changes. Actor is null if the actor was
+	// already garbage collected.
+	UPROPERTY(BlueprintAssignable, Category = "OBNavigation|Delegates")
+	FOnRegionChanged OnRegionExited;
+
+	// Native versions of the region events, broadcast before the Blueprint ones
+	FOnRegionChangedNative OnRegionEnteredNative;
+	FOnRegionChangedNative OnRegionExitedNative;
+
 protected:
-	bool Tick(float DeltaTime);
+	// Runs one update. Driven by UOBNavigationWorldSubsystem after actors moved, with the dilated world delta time.
+	void Tick(float DeltaTime);
+
+	// Returns false while updating would have no effect: no view to center on, no capture or replay running, no
+	// marker whose lifetime has to run out, none requiring line of sight and no region to watch.
+	bool IsTickNeeded() const;
 
 private:
+	// Creates and stores a marker without rebuilding the cached array or broadcasting. Returns nullptr on failure.
+	UOBMapMarker* CreateMarker(const FGuid& InMarkerID, AActor* InTrackedActor, UOBMarkerConfigAsset* InConfig,
+	                           FName InLayerName, const FVector& InStaticLocation);
+
+	// Stores a marker object created elsewhere (e.g., a recycled ping slot) without rebuilding or broadcasting.
+	void AddMarker(UOBMapMarker* InMarker);
+
+	// Removes a marker without rebuilding the cached array or broadcasting. Returns false if it does not exist.
+	bool RemoveMarker(const FGuid& InMarkerID);
+
+	// Adds a marker to the actor index, binding the actor's end-of-life notifications for its first marker.
+	void AddTrackedActorMarker(AActor* InActor, const FGuid& InMarkerID);
+
+	// Removes a marker from the actor index, unbinding the notifications once the actor has no marker left.
+	void RemoveTrackedActorMarker(AActor* InActor, const FGuid& InMarkerID);
+
+	// Unregisters every marker of an actor that is being destroyed or removed from the world.
+	UFUNCTION()
+	void OnTrackedActorDestroyed(AActor* DestroyedActor);
+
+	UFUNCTION()
+	void OnTrackedActorEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+
+	// Unregisters the markers of an actor leaving play. Proxy markers are unbound instead if bKeepProxyMarkers is set.
+	void ReleaseTrackedActor(AActor* InActor, bool bKeepProxyMarkers);
+
+	// Creates an unbound proxy marker without rebuilding the cached array or broadcasting.
+	UOBMapMarker* CreateProxyMarker(const TSoftObjectPtr<AActor>& InActor, UOBMarkerConfigAsset* InConfig,
+	                                FName InLayerName, const FVector& InLocation);
+
+	// Attaches a proxy marker to its loaded actor, or detaches it at the actor's last location.
+	void BindProxyMarker(UOBMapMarker* Marker, AActor* Actor);
+	void UnbindProxyMarker(UOBMapMarker* Marker, AActor* Actor);
+
+	// Binds the unbound proxy markers to the actors of a level (or World Partition cell) that streamed in.
+	void OnLevelAddedToWorld(ULevel* InLevel, UWorld* InWorld);
+	void BindProxyMarkers(const ULevel* InLevel);
+
+	// Adds a config to the registry. Configs sharing an asset name after the first are only usable by pointer.
+	void IndexMarkerConfig(FName AssetName, const FSoftObjectPath& ConfigPath);
+
+	// Starts from the project manifest instead of the asset registry. Returns false if there is no usable manifest.
+	bool LoadProjectManifest();
+	void OnManifestLayersLoaded();
+
+	// Builds LayerGrid from the bounds of AllMapLayers
+	void RebuildLayerGrid();
+
+	// Restores the baked points of interest of a world beginning play, and removes them when it ends.
+	// Called by UOBNavigationWorldSubsystem.
+	void LoadMapManifest(const UWorld* InWorld);
+	void UnloadMapManifest();
+
+	// Opens the POI database of a map, streaming its configs in, and closes it. Opened with the map manifest.
+	void OpenPOIDatabase(const FString& MapPackageName);
+	void OnPOIConfigsLoaded();
+	void ClosePOIDatabase();
+
+	// Makes the database pages around the tracked view and the POI view region resident.
+	void UpdatePOIPages();
+
+	// Applies the queued marker commands. Runs first in Tick, so the rest of the frame sees the new markers.
+	void ProcessMarkerCommands();
+
+	// Publishes the marker state of this tick for readers of GetMarkerSnapshots. Runs last in Tick.
+	void PublishMarkerSnapshot();
+	bool HasMarkerSnapshotReaders() const { return MarkerSnapshots.GetSharedReferenceCount() > 1; }
+
 	void UpdateActiveMinimapLayer();
 	void UpdateAllMarkers(float DeltaTime);
+	void UpdateExploration();
+	void UpdateHeatMaps();
+	void UpdateLineOfSight();
+	void UpdateRegions();
+
+	// Stores a new area marker. Returns an invalid FGuid if its shape is invalid.
+	FGuid AddAreaMarker(FOBAreaMarker&& InArea, const FOBAreaMarkerStyle& InStyle);
+	double GetWorldTime() const;
+	void UpdateBreadcrumbs();
+	void UpdateRoute();
+
+	// Issues an asynchronous path query from the tracked pawn to the route target.
+	void RequestRoutePath(const FVector& TargetLocation);
+	void OnRoutePathFound(uint32 QueryID, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path);
+
+	// Re-projects and simplifies RouteWorldPoints into RouteMapPoints for the current layer.
+	void RebuildRouteMapPoints();
+
+	// Appends a trail point, overwriting the oldest one once the ring buffer is full.
+	void AppendBreadcrumb(const FVector& WorldLocation);
+	// Moves the newest trail point, merging the previous sample into the last segment.
+	void MoveLastBreadcrumb(const FVector& WorldLocation);
+	// Re-projects the whole trail onto the current layer.
+	void RebuildBreadcrumbMapPoints();
+	FVector2D GetBreadcrumbMapPoint(const FVector& WorldLocation) const;
+	int32 GetBreadcrumbIndex(const int32 Index) const { return (BreadcrumbStart + Index) % BreadcrumbWorldPoints.Num(); }
+
+	// Returns the highest priority layer containing the location, or nullptr.
+	UOBMapLayerAsset* FindBestLayerForLocation(const FVector& WorldLocation) const;
 
-	// All available map layer assets loaded at initialization
+	// Runtime state of a single exploration revealer.
+	struct FExplorationRevealer
+	{
+		TWeakObjectPtr<AActor> Actor;
+		float RevealRadius = 0.0f;
+
+		// Mask and cell revealed last time. Revealing is skipped until the actor enters another cell.
+		TWeakObjectPtr<UOBExplorationMask> LastMask;
+		FIntPoint LastCell = FIntPoint(INDEX_NONE, INDEX_NONE);
+	};
+
+	void UpdateExplorationRevealer(FExplorationRevealer& Revealer, UOBMapLayerAsset* Layer, const FVector& Location);
+
+	// Region state of a tracked actor.
+	struct FRegionTracker
+	{
+		TWeakObjectPtr<AActor> Actor;
+		TArray<FName, TInlineAllocator<4>> Regions; // The regions it is in
+		FIntVector Cell = FIntVector::ZeroValue; // Index cell the regions were found in
+		uint32 IndexVersion = 0; // Version of the index the regions were found with; 0 until the first update
+		bool bUniformCell = false; // No region boundary runs through Cell: nothing to test while the actor stays in it
+	};
+
+	// A region transition, broadcast once every tracker was updated
+	struct FRegionEvent
+	{
+		TWeakObjectPtr<AActor> Actor;
+		FName RegionName;
+		bool bEntered = false;
+	};
+
+	// Refreshes the regions of a tracker, queuing its exits, then its entries.
+	void UpdateRegionTracker(FRegionTracker& Tracker, AActor* Actor);
+
+	// Visibility state of a marker requiring line of sight. A query traces the observers in batches until one of them
+	// sees the target or all of them were traced; its result is then cached until ExpireTime.
+	struct FLineOfSightTarget
+	{
+		FGuid MarkerID;
+		double ExpireTime = 0.0;
+		// Traced alone first: a target usually stays in sight of the same observer
+		TWeakObjectPtr<const AActor> LastSeenBy;
+		TArray<TWeakObjectPtr<const AActor>, TInlineAllocator<4>> BatchObservers; // Observers of the traces in flight
+		int32 NextObserver = 0; // Observers of this frame's list traced so far in the current query
+		int32 PendingTraces = 0;
+		uint8 QuerySerial = 0; // Traces of an earlier query (or of a removed target in the same slot) are ignored
+		bool bQueryActive = false;
+		bool bTriedLastSeenBy = false;
+		bool bTracedAllObservers = false;
+		bool bSeenInQuery = false;
+	};
+
+	// Adds a marker to the targets refreshed by UpdateLineOfSight. It stays hidden until an observer sees it.
+	void AddLineOfSightTarget(UOBMapMarker* InMarker);
+	void RemoveLineOfSightTarget(const FGuid& InMarkerID);
+
+	// Issues up to MaxTraces traces of a target's current query. Returns the number of traces issued.
+	int32 IssueLineOfSightTraces(FLineOfSightTarget& Target, int32 TargetIndex, const AActor* TargetActor,
+	                             TConstArrayView<const AActor*> Observers, int32 MaxTraces);
+	void FinishLineOfSightQuery(FLineOfSightTarget& Target);
+	void OnLineOfSightTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum);
+
+#if !UE_BUILD_SHIPPING
+	// Draws the subsystem state while "OBNav.Debug.Overlay" is enabled.
+	void DrawDebugOverlay(UCanvas* Canvas, APlayerController* PlayerController);
+#endif
+
+	// All available map layer assets, highest priority first. When starting from the manifest, entries stay null until
+	// the layers have streamed in.
 	UPROPERTY()
 	TArray<TObjectPtr<UOBMapLayerAsset>> AllMapLayers;
 
-	// All available markers config assets loaded at initialization (for a quick lookup)
+	// Finds the best layer for a location without testing every layer. Indices match AllMapLayers.
+	FOBLayerGrid LayerGrid;
+
+	// Layers listed by the project manifest, and the handle keeping them resident
+	TArray<FSoftObjectPath> ManifestLayerPaths;
+	TSharedPtr<FStreamableHandle> MapLayersHandle;
+
+	// Markers restored from the manifest of the current map
+	TArray<FGuid> ManifestMarkerIDs;
+
+	// POI database of the current map, and its configs, indexed like the database's config table. A config is null
+	// until it has streamed in, and its POIs are not shown until then.
+	FOBPOIDatabase POIDatabase;
 	UPROPERTY()
-	TMap<FName, TObjectPtr<UOBMarkerConfigAsset>> AllMarkerConfigs;
+	TArray<TObjectPtr<UOBMarkerConfigAsset>> POIConfigs;
+	TSharedPtr<FStreamableHandle> POIConfigsHandle;
+
+	// One bit per POI of the database, set while the POI is hidden
+	TBitArray<> HiddenPOIs;
+	TOptional<FBox2D> POIViewRegion;
+
+	// Database file of the current map, set even if it is missing
+	FString POIDatabasePath;
+	bool bReportedMissingPOI = false;
+
+	// Every marker config in the project, indexed by position and by asset name
+	TArray<FSoftObjectPath> MarkerConfigPaths;
+	TMap<FName, int32> MarkerConfigIndices;
+
+	// Keep the configs, and the icons requested so far, resident for the session
+	TSharedPtr<FStreamableHandle> MarkerConfigsHandle;
+	TMap<FObjectKey, TSharedPtr<FStreamableHandle>> MarkerIconHandles;
 
 	TWeakObjectPtr<APawn> TrackedPlayerPawn;
 	UPROPERTY()
@@ -101,12 +784,120 @@ private:
 	UPROPERTY()
 	TArray<TObjectPtr<UOBMapMarker>> ActiveMarkers;
 
-	FTickerDelegate TickerDelegate;
-	FTSTicker::FDelegateHandle TickerHandle;
-
 	void RebuildActiveMarkersArray(); // Helper to update ActiveMarkers array
 
-	// Reverse lookup map to quickly find a marker's ID from the actor it tracks.
+	// Markers of every tracked actor, in registration order. Weakly keyed so the subsystem never keeps a destroyed
+	// actor reachable; entries are removed from the actor's OnDestroyed/OnEndPlay notifications.
+	TMap<TObjectKey<AActor>, TArray<FGuid, TInlineAllocator<2>>> TrackedActorMarkers;
+
+	// Proxy markers waiting for their actor to stream in, keyed by the actor's object name. Names are unique within a
+	// World Partition world and survive streaming, unlike the path of the cell level an actor is loaded into.
+	TMap<FName, TArray<FGuid, TInlineAllocator<1>>> UnboundProxyMarkers;
+	FDelegateHandle LevelAddedToWorldHandle;
+
+	// Fog-of-war masks, created on demand for layers with exploration enabled
+	UPROPERTY()
+	TMap<TObjectPtr<UOBMapLayerAsset>, TObjectPtr<UOBExplorationMask>> ExplorationMasks;
+
+	// Actors revealing the map in addition to the tracked player pawn
+	TArray<FExplorationRevealer> ExplorationRevealers;
+	FExplorationRevealer TrackedPawnRevealer;
+
+	// Markers requiring line of sight. Sparse, so a target keeps its index (carried by its traces) until it is removed.
+	TSparseArray<FLineOfSightTarget> LineOfSightTargets;
+	TMap<FGuid, int32> LineOfSightTargetIndices;
+	int32 LineOfSightCursor = 0; // Where the round-robin resumes next frame
+	uint8 LineOfSightQuerySerial = 0;
+
+	// Actors seeing for the team in addition to the tracked player pawn
+	TArray<TWeakObjectPtr<AActor>> LineOfSightObservers;
+
+	// Named regions and their grid, rebuilt on the next update after the set changed
+	TMap<FName, FOBRegionShape> Regions;
+	FOBRegionIndex RegionIndex;
+	bool bRegionIndexDirty = false;
+
+	// Actors watched for region transitions in addition to the tracked player pawn
+	TArray<FRegionTracker> RegionTrackers;
+	FRegionTracker TrackedPawnRegionTracker;
+	TArray<FRegionEvent> PendingRegionEvents;
+
+	// Zones drawn as batched geometry by the minimap
+	TMap<FGuid, FOBAreaMarker> AreaMarkers;
+
+	// Heat maps, created on demand for layers with heat maps enabled
 	UPROPERTY()
-	TMap<TObjectPtr<AActor>, FGuid> TrackedActorToMarkerIDMap;
+	TMap<TObjectPtr<UOBMapLayerAsset>, TObjectPtr<UOBHeatMap>> HeatMaps;
+	bool bHasHeatMapUpdates = false; // Events were submitted since the last upload
+
+	// Images baked at runtime, shown instead of the layers' MapTexture
+	UPROPERTY()
+	TMap<TObjectPtr<UOBMapLayerAsset>, TObjectPtr<UOBMapBake>> MapBakes;
+
+	// Bounds fitted by BakeMapLayer, used instead of the layers' WorldBounds
+	TMap<TObjectKey<UOBMapLayerAsset>, FBox> LayerBoundsOverrides;
+
+	// --- Breadcrumb trail state ---
+	// Ring buffers allocated once (UOBNavigationSettings::MaxBreadcrumbs); the oldest point is at BreadcrumbStart.
+	// Map points are projected once, when their world point is added, and again only when the layer changes.
+	TArray<FVector> BreadcrumbWorldPoints;
+	TArray<FVector2D> BreadcrumbMapPoints;
+	int32 BreadcrumbStart = 0;
+	int32 NumBreadcrumbs = 0;
+	TWeakObjectPtr<UOBMapLayerAsset> BreadcrumbMapLayer; // Layer BreadcrumbMapPoints were projected on
+	TWeakObjectPtr<const APawn> BreadcrumbPawn; // The trail restarts when another pawn is tracked
+
+	// Samples merged into the last segment since the point before it. Merging stops once it is full.
+	TArray<FVector, TFixedAllocator<16>> BreadcrumbMergedPoints;
+
+	// --- Route guidance state ---
+	FGuid RouteTargetMarkerID;
+	TArray<FVector> RouteWorldPoints; // Full navmesh path of the last successful query
+	TArray<FVector2D> RouteMapPoints; // RouteWorldPoints simplified in map UV space
+	TWeakObjectPtr<UOBMapLayerAsset> RouteMapLayer; // Layer RouteMapPoints were projected on
+	FVector RouteQueriedTargetLocation = FVector::ZeroVector;
+	uint32 RoutePendingQueryID = INVALID_NAVQUERYID;
+	double RouteLastQueryTime = -UE_BIG_NUMBER;
+
+	TOptional<FOBTrackedView> TrackedViewOverride;
+
+	// Whether a marker may still have a limited lifetime. Set on creation, refreshed by UpdateAllMarkers.
+	bool bHasExpiringMarkers = false;
+
+	// A marker change submitted from any thread through the Enqueue functions
+	struct FMarkerCommand
+	{
+		enum class EType : uint8
+		{
+			Register,
+			Unregister,
+			Move,
+			SetLifeTime
+		};
+
+		EType Type = EType::Register;
+		bool bTracksActor = false; // Tells an actor destroyed before the command ran from a static marker
+		FGuid MarkerID;
+		TWeakObjectPtr<AActor> TrackedActor;
+		TWeakObjectPtr<UOBMarkerConfigAsset> Config;
+		FName LayerName;
+		FVector Location = FVector::ZeroVector;
+		FVector Velocity = FVector::ZeroVector;
+		float LifeTime = 0.0f;
+	};
+
+	// Lock-free, multiple producers; only the game thread dequeues, in ProcessMarkerCommands
+	TMpscQueue<FMarkerCommand> MarkerCommands;
+
+	// Published every tick while someone outside the subsystem holds a reference
+	TSharedRef<OBNavigation::Snapshots::FMarkerSnapshotBuffer, ESPMode::ThreadSafe> MarkerSnapshots =
+		MakeShared<OBNavigation::Snapshots::FMarkerSnapshotBuffer, ESPMode::ThreadSafe>();
+
+	// Shared pointers, so the classes can stay private to the module
+	TSharedPtr<FOBMarkerTraceRecorder> TraceRecorder;
+	TSharedPtr<FOBMarkerTraceReplayer> TraceReplayer;
+	bool bLoopTraceReplay = false;
+
+	// Debug draw registration, only valid while the debug overlay is enabled
+	FDelegateHandle DebugOverlayHandle;
 };
@@ -0,0 +1,40 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "OBNavigationWorldSubsystem.generated.h"
+
+class UOBNavigationSubsystem;
+
+/**
+ * @class UOBNavigationWorldSubsystem
+ * @brief Drives UOBNavigationSubsystem from the tick of the world it runs in.
+ * Tickable objects are ticked after every tick group, so markers read actor locations after physics and movement
+ * of the same frame, and the minimap widgets (ticked by Slate afterwards) never lag a frame behind. The world tick
+ * also brings pause and time dilation for free, and the tick is skipped while the subsystem has nothing to update.
+ * It also restores the baked points of interest of its world from the map's navigation manifest.
+ */
+UCLASS()
+class OBNAVIGATION_API UOBNavigationWorldSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// Only set when this world is the one the game instance subsystem belongs to
+	TWeakObjectPtr<UOBNavigationSubsystem> NavSubsystem;
+};
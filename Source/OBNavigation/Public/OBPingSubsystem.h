@@ -0,0 +1,154 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "OBPingSubsystem.generated.h"
+
+class UOBMapMarker;
+class UOBMarkerConfigAsset;
+class UOBNavigationSubsystem;
+struct FStreamableHandle;
+
+// Delegate for broadcasting pings, both new ones and acknowledgements of an existing marker
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnMarkerPinged, FGuid, MarkerID, UObject*, PingInstigator,
+                                               bool, bAcknowledged);
+
+UENUM(BlueprintType)
+enum class EOBPingResult : uint8
+{
+	Placed,       // A new ping is on the map
+	Acknowledged, // An existing marker was pinged
+	RateLimited,  // The instigator pinged too often; nothing happened
+	Invalid       // Missing instigator, config or marker
+};
+
+/**
+ * @struct FOBPingHandle
+ * @brief Identifies a placed ping. Goes stale once the ping expires or its slot is recycled for a newer ping.
+ */
+USTRUCT(BlueprintType)
+struct FOBPingHandle
+{
+	GENERATED_BODY()
+
+	int32 SlotIndex = INDEX_NONE;
+	uint32 Generation = 0;
+
+	bool IsSet() const { return SlotIndex != INDEX_NONE; }
+};
+
+/**
+ * @class UOBPingSubsystem
+ * @brief Short-lived map pings, rate-limited per instigator and capped in number.
+ * Pings live in a fixed ring of slots (UOBNavigationSettings::MaxActivePings). Each slot owns one marker object with a
+ * GUID that never changes, so placing a ping reuses the marker, and the minimap keeps (or takes back from its pool)
+ * the slot's widget. When every slot is in use, the ping placed first is replaced. Pinging an existing marker acknowledges
+ * it instead of placing a new ping.
+ * Pings are local to this world: replicating them is left to the game (e.g., a server RPC calling PingLocation).
+ */
+UCLASS()
+class OBNAVIGATION_API UOBPingSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * @brief Places a ping at a world location.
+	 * @param PingInstigator Who pings (e.g., a player state). Rate limits are tracked per instigator.
+	 * @param InLocation The world location of the ping.
+	 * @param InConfig The ping's marker config. If nullptr, UOBNavigationSettings::DefaultPingConfig is used.
+	 * @param OutHandle Receives the handle of the placed ping.
+	 * @return Placed on success.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Pings")
+	EOBPingResult PingLocation(UObject* PingInstigator, FVector InLocation, UOBMarkerConfigAsset* InConfig,
+	                           FOBPingHandle& OutHandle);
+
+	/**
+	 * @brief Pings an existing marker (another ping, a quest marker, a player...). Nothing is allocated: a ping is kept
+	 * on the map a little longer, and any other marker is only announced through OnMarkerPinged.
+	 * @return Acknowledged on success.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Pings")
+	EOBPingResult AcknowledgeMarker(UObject* PingInstigator, const FGuid& MarkerID);
+
+	// Removes a ping before it expires. Does nothing if the handle is stale.
+	UFUNCTION(BlueprintCallable, Category = "OBNavigation|Pings")
+	void CancelPing(const FOBPingHandle& Handle);
+
+	// Gets the marker ID of a ping, or an invalid FGuid if the handle is stale.
+	UFUNCTION(BlueprintPure, Category = "OBNavigation|Pings")
+	FGuid GetPingMarkerID(const FOBPingHandle& Handle) const;
+
+	// Gets how many times a ping has been acknowledged, or 0 if the handle is stale.
+	UFUNCTION(BlueprintPure, Category = "OBNavigation|Pings")
+	int32 GetPingAcknowledgements(const FOBPingHandle& Handle) const;
+
+	UFUNCTION(BlueprintPure, Category = "OBNavigation|Pings")
+	int32 GetNumActivePings() const { return NumActivePings; }
+
+	UPROPERTY(BlueprintAssignable, Category = "OBNavigation|Pings")
+	FOnMarkerPinged OnMarkerPinged;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// Takes one ping from the instigator's burst. Returns false if it is used up.
+	bool ConsumePingAllowance(const UObject* PingInstigator);
+
+	// Removes the slot's marker from the navigation subsystem. The caller rebuilds and broadcasts the marker list.
+	void DeactivateSlot(int32 SlotIndex);
+
+	// Rebuilds the navigation subsystem's marker list and notifies the UI
+	void NotifyMarkersChanged() const;
+
+	struct FPingSlot
+	{
+		double ExpireTime = 0.0;          // World time, so pings are paused and dilated along with the game
+		uint32 Generation = 0;            // Bumped each time the slot is reused, invalidating older handles
+		uint64 PlacementOrder = 0;        // Rank of the ping among all placed pings; the lowest is the oldest
+		int32 NumAcknowledgements = 0;
+		bool bActive = false;
+	};
+
+	// Token bucket of one instigator
+	struct FPingAllowance
+	{
+		float Tokens = 0.0f;
+		double LastRefillTime = 0.0; // Real time, so pausing the game does not hand out pings
+	};
+
+	TArray<FPingSlot> Slots;
+
+	// The recycled marker of each slot, created the first time the slot is used
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UOBMapMarker>> SlotMarkers;
+
+	// Reverse lookup of the slot markers' fixed IDs
+	TMap<FGuid, int32> SlotIndexByMarkerID;
+
+	TMap<TObjectKey<UObject>, FPingAllowance> PingAllowances;
+
+	// Where the search for a free slot starts. Pings expire or are cancelled out of order, so it is not the oldest
+	// ping once every slot is in use; that one is found from the placement order.
+	int32 NextSlotIndex = 0;
+	int32 NumActivePings = 0;
+	uint64 NumPlacedPings = 0;
+
+	TWeakObjectPtr<UOBNavigationSubsystem> NavSubsystem;
+
+	// Keeps the default ping config loaded
+	TSharedPtr<FStreamableHandle> DefaultPingConfigHandle;
+};
@@ -0,0 +1,64 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "OBPointOfInterestComponent.generated.h"
+
+class UOBMarkerConfigAsset;
+class UOBNavigationSubsystem;
+
+/**
+ * @class UOBPointOfInterestComponent
+ * @brief Shows a level-placed actor (vendor, landmark, fast travel point...) as a static marker at its location.
+ * The marker ID is derived from the map and the actor name, so markers baked into the map's navigation manifest by
+ * the OBNavigationManifest commandlet are already registered when the actor begins play, and registration is skipped.
+ * With bStoreInPOIDatabase, the commandlet stores the point of interest in the map's POI database instead, and no
+ * marker is registered for it at all.
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class OBNAVIGATION_API UOBPointOfInterestComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UOBPointOfInterestComponent();
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// Stable marker ID of a point of interest. MapPackageName must not carry a PIE prefix.
+	static FGuid MakeMarkerID(const FString& MapPackageName, FName ActorName);
+
+	// Stable marker ID of the point of interest placed on InActor.
+	static FGuid MakeMarkerID(const AActor* InActor);
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "OBNavigation")
+	TObjectPtr<UOBMarkerConfigAsset> MarkerConfig;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "OBNavigation")
+	FName MarkerLayerName = TEXT("PointsOfInterest");
+
+	// For maps with very many points of interest (collectibles, resource nodes...): baked into the map's paged POI
+	// database and drawn by the minimap without a marker object. Falls back to a marker, with a warning, while the
+	// database is missing or stale. For sets too large to place as actors at all, see UOBPOISetAsset.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "OBNavigation")
+	bool bStoreInPOIDatabase = false;
+
+	// Index of this point of interest in the map's POI database (see UOBNavigationSubsystem::SetPOIHidden), or
+	// INDEX_NONE if it is shown as a marker.
+	UFUNCTION(BlueprintPure, Category = "OBNavigation")
+	int32 GetPOIIndex() const { return POIIndex; }
+
+private:
+	UPROPERTY(Transient)
+	TObjectPtr<UOBNavigationSubsystem> NavSubsystem;
+
+	FGuid MarkerID;
+
+	int32 POIIndex = INDEX_NONE;
+
+	// The marker was restored from the map manifest rather than registered by this component
+	bool bBakedMarker = false;
+};
@@ -0,0 +1,77 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @struct FOBRegionShape
+ * @brief A named region's volume: a box rotated around Z.
+ */
+struct OBNAVIGATION_API FOBRegionShape
+{
+	FOBRegionShape() = default;
+	FOBRegionShape(const FVector& InCenter, const FVector& InHalfExtents, float InYaw);
+
+	bool Contains(const FVector& Location) const;
+
+	// World-space bounds of the rotated box.
+	FBox GetBounds() const;
+
+	// True if the box cannot overlap the axis-aligned cube (a separating axis is one of the box's own axes).
+	// Conservative: a cube close to a corner may be reported as overlapping.
+	bool IsSeparatedFrom(const FVector& CubeCenter, double CubeHalfSize) const;
+
+	FVector Center = FVector::ZeroVector;
+	FVector HalfExtents = FVector::ZeroVector;
+	double Sin = 0.0;
+	double Cos = 1.0;
+};
+
+/**
+ * @class FOBRegionIndex
+ * @brief Uniform grid over the registered regions. Each cell lists the regions covering it entirely and the regions
+ * crossing it, so a location is only tested against the regions whose boundary runs through its cell. A cell crossed by
+ * no boundary has the same regions everywhere: while a tracked actor stays inside it, nothing needs to be tested.
+ * Built once per change of the region set; regions are authored zones that rarely change at runtime.
+ */
+class OBNAVIGATION_API FOBRegionIndex
+{
+public:
+	/**
+	 * @brief Rebuilds the grid.
+	 * @param InCellSize Size (in world units) of the cubic cells.
+	 * @param MaxCellsPerRegion Regions covering more cells than this are not indexed but tested at every query.
+	 */
+	void Build(const TMap<FName, FOBRegionShape>& InRegions, double InCellSize, int32 MaxCellsPerRegion);
+
+	FIntVector GetCell(const FVector& Location) const;
+
+	/**
+	 * @brief Gets the regions containing a location.
+	 * @param Cell The cell of Location (see GetCell).
+	 * @return True if every location of the cell is in the same regions, so the result stays valid while the location
+	 * stays inside the cell.
+	 */
+	bool FindRegions(const FIntVector& Cell, const FVector& Location, TArray<FName, TInlineAllocator<4>>& OutRegions) const;
+
+	// Changes with every Build; results of an earlier version are stale. Never 0.
+	uint32 GetVersion() const { return Version; }
+
+	int32 GetNumRegions() const { return Names.Num(); }
+	int32 GetNumCells() const { return Cells.Num(); }
+
+private:
+	struct FCell
+	{
+		TArray<int32, TInlineAllocator<2>> InsideRegions;
+		TArray<int32, TInlineAllocator<2>> CrossingRegions;
+	};
+
+	double CellSize = 1.0;
+	TArray<FName> Names;
+	TArray<FOBRegionShape> Shapes;
+	TMap<FIntVector, FCell> Cells;
+	TArray<int32> UnindexedRegions;
+	uint32 Version = 0;
+};
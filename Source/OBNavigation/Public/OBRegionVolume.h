@@ -0,0 +1,43 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "OBRegionVolume.generated.h"
+
+class UBoxComponent;
+
+/**
+ * @class AOBRegionVolume
+ * @brief A named region placed in a level (e.g., a town or a dungeon wing). Registers its box with the
+ * UOBNavigationSubsystem while it is in play, which reports the tracked actors entering and leaving it.
+ * Only the yaw of the box is used; pitch and roll are ignored.
+ */
+UCLASS(meta = (DisplayName = "OB Region Volume"))
+class OBNAVIGATION_API AOBRegionVolume : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AOBRegionVolume();
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// The name reported by the enter and exit events. If None, the actor's name is used.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Region")
+	FName RegionName;
+
+	UFUNCTION(BlueprintPure, Category = "Region")
+	FName GetRegionName() const;
+
+protected:
+	// The region's volume. Editor-only visualization; it has no collision.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Region")
+	TObjectPtr<UBoxComponent> Box;
+
+private:
+	// Whether this volume registered its region, so that only the owner of a name unregisters it
+	bool bRegisteredRegion = false;
+};
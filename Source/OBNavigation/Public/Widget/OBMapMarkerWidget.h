@@ -7,6 +7,7 @@
 #include "OBMapMarkerWidget.generated.h"
 
 class UImage;
+class UOBMapMarker;
 class UTexture2D;
 /**
  * @class UOBMapMarkerWidget
@@ -22,7 +23,7 @@ public:
 	
 	/**
 	 * @brief Sets up the static visual properties of the marker.
-	 * Call this ONLY ONCE when the widget is created.
+	 * Call this when the widget is created or recycled for another marker; it does nothing if the visuals are unchanged.
 	 * @param IdentifierTexture The texture for the non-rotating identifier icon.
 	 * @param IndicatorMaterial The material for the rotating directional indicator. Can be null.
 	 */
@@ -46,6 +47,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Map Marker")
 	void UpdateVisuals(float IndicatorAngle, float InViewAngle, float InViewDistance);
 
+	/**
+	 * @brief Draws the identifier icon with the animation material of the marker's config, if it has one.
+	 * The material evaluates the animation on the GPU (see FOBMarkerAnimation); parameters are only written when the
+	 * widget shows another marker or the marker's animation timing changed, so calling this every frame is cheap.
+	 * Call it after InitializeMarker.
+	 */
+	void UpdateAnimation(const UOBMapMarker* Marker);
+
 
 protected:
 	// This function is called when the widget is constructed in the game.
@@ -69,4 +78,17 @@ protected:
 	// Dynamic material instance for the FOV cone here
 	UPROPERTY(Transient)
 	TObjectPtr<UMaterialInstanceDynamic> FOVMaterialInstance;
+
+	// Dynamic instance of the animation material drawing the identifier icon, while the marker is animated
+	UPROPERTY(Transient)
+	TObjectPtr<UMaterialInstanceDynamic> IconMaterialInstance;
+
+	// What the widget currently shows, so a recycled widget only rebuilds its brushes when they change
+	TWeakObjectPtr<UTexture2D> CurrentIdentifierTexture;
+	TWeakObjectPtr<UMaterialInterface> CurrentIndicatorMaterial;
+	bool bIsMarkerInitialized = false;
+
+	// The marker and timing whose animation parameters were sent last
+	TWeakObjectPtr<const UOBMapMarker> AnimatedMarker;
+	uint32 AnimatedMarkerSerial = 0;
 };